@@ -21,6 +21,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QString>
 
+#include <ResourceCache.h>
 #include <ServerPathUtils.h>
 
 #include "NetworkLogging.h"
@@ -39,12 +40,6 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     // so the ideal is greater than the number of cores on the system.
     static const int TASK_POOL_THREAD_COUNT = 50;
     _taskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
-
-    auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListener(PacketType::AssetGet, this, "handleAssetGet");
-    packetReceiver.registerListener(PacketType::AssetGetInfo, this, "handleAssetGetInfo");
-    packetReceiver.registerListener(PacketType::AssetUpload, this, "handleAssetUpload");
-    packetReceiver.registerListener(PacketType::AssetMappingOperation, this, "handleAssetMappingOperation");
 }
 
 void AssetServer::run() {
@@ -121,6 +116,15 @@ void AssetServer::completeSetup() {
         return;
     }
 
+    static const QString HOT_ASSETS_CACHE_SIZE_OPTION = "hot_assets_cache_size";
+    auto hotAssetsCacheSizeFloat = assetServerObject[HOT_ASSETS_CACHE_SIZE_OPTION].toDouble(-1);
+    qint64 hotAssetsCacheSize = MappedAssetCache::DEFAULT_MAXIMUM_SIZE;
+    if (hotAssetsCacheSizeFloat >= 0.0) {
+        hotAssetsCacheSize = hotAssetsCacheSizeFloat * BYTES_PER_MEGABYTES;
+    }
+    _assetCache = std::make_shared<MappedAssetCache>(_filesDirectory, hotAssetsCacheSize);
+    qInfo() << "Keeping up to" << hotAssetsCacheSize / BYTES_PER_MEGABYTES << "MB of hot assets mapped.";
+
     // load whatever mappings we currently have from the local file
     loadMappingsFromFile();
 
@@ -132,10 +136,24 @@ void AssetServer::completeSetup() {
     QRegExp hashFileRegex { ASSET_HASH_REGEX_STRING };
     auto hashedFiles = files.filter(hashFileRegex);
 
+    // remove what is left of uploads that were interrupted
+    for (const auto& file : files) {
+        if (file.endsWith(UploadAssetStream::TEMPORARY_FILE_EXTENSION)) {
+            _filesDirectory.remove(file);
+        }
+    }
+
     qInfo() << "There are" << hashedFiles.size() << "asset files in the asset directory.";
 
     performMappingMigration();
 
+    // requests are only handled once there are files, a cache and migrated mappings to serve them from
+    auto& packetReceiver = nodeList->getPacketReceiver();
+    packetReceiver.registerListener(PacketType::AssetGet, this, "handleAssetGet");
+    packetReceiver.registerListener(PacketType::AssetGetInfo, this, "handleAssetGetInfo");
+    packetReceiver.registerListener(PacketType::AssetUpload, this, "handleAssetUpload", true);
+    packetReceiver.registerListener(PacketType::AssetMappingOperation, this, "handleAssetMappingOperation");
+
     nodeList->addNodeTypeToInterestSet(NodeType::Agent);
 }
 
@@ -349,7 +367,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _assetCache);
     _taskPool.start(task);
 }
 
@@ -358,8 +376,26 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (senderNode->getCanRez()) {
         qDebug() << "Starting an UploadAssetTask for upload from" << uuidStringWithoutCurlyBraces(senderNode->getUUID());
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory);
-        _taskPool.start(task);
+        // the upload is written out as it arrives, by a task for each batch of packets
+        auto stream = std::make_shared<UploadAssetStream>(message, senderNode, _filesDirectory, _assetCache);
+        _taskPool.start(new UploadAssetTask(stream));
+
+        if (!message->isComplete()) {
+            connect(message.data(), &ReceivedMessage::progress, this, [this, stream] {
+                _taskPool.start(new UploadAssetTask(stream));
+            });
+            connect(message.data(), &ReceivedMessage::completed, this, [this, message, stream] {
+                _taskPool.start(new UploadAssetTask(stream));
+                // the connections hold the stream, which holds the message
+                message->disconnect(this);
+            });
+
+            // in case the last packet arrived before the connections were made
+            if (message->isComplete()) {
+                message->disconnect(this);
+                _taskPool.start(new UploadAssetTask(stream));
+            }
+        }
     } else {
         // this is a node the domain told us is not allowed to rez entities
         // for now this also means it isn't allowed to add assets
@@ -367,8 +403,9 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
 
         auto permissionErrorPacket = NLPacket::create(PacketType::AssetUploadReply, sizeof(MessageID) + sizeof(AssetServerError));
 
+        // the rest of the message may still be arriving, only its head is safe to read
         MessageID messageID;
-        message->readPrimitive(&messageID);
+        message->readHeadPrimitive(&messageID);
 
         // write the message ID and a permission denied error
         permissionErrorPacket->writePrimitive(messageID);
@@ -445,6 +482,24 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     }
 
+    if (_assetCache) {
+        static const int NUM_MOST_REQUESTED_ASSETS = 10;
+        QJsonObject cacheStats;
+        cacheStats["1. Hits"] = _assetCache->getNumHits();
+        cacheStats["2. Misses"] = _assetCache->getNumMisses();
+        cacheStats["3. Hit Rate (%)"] = _assetCache->getHitRate() * 100.0f;
+        cacheStats["4. Mapped Assets"] = _assetCache->getNumEntries();
+        cacheStats["5. Mapped (MB)"] = (double)_assetCache->getSize() / BYTES_PER_MEGABYTES;
+        cacheStats["6. Evictions"] = _assetCache->getNumEvictions();
+
+        QJsonObject mostRequested;
+        for (const auto& asset : _assetCache->getMostRequested(NUM_MOST_REQUESTED_ASSETS)) {
+            mostRequested[asset.first] = asset.second;
+        }
+        cacheStats["7. Most Requested"] = mostRequested;
+        serverStats["Asset Cache"] = cacheStats;
+    }
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
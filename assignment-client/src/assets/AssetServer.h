@@ -12,12 +12,15 @@
 #ifndef hifi_AssetServer_h
 #define hifi_AssetServer_h
 
+#include <memory>
+
 #include <QtCore/QDir>
 #include <QtCore/QThreadPool>
 
 #include <ThreadedAssignment.h>
 
 #include "AssetUtils.h"
+#include "MappedAssetCache.h"
 #include "ReceivedMessage.h"
 
 class AssetServer : public ThreadedAssignment {
@@ -66,6 +69,7 @@ private:
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
+    std::shared_ptr<MappedAssetCache> _assetCache;
     QThreadPool _taskPool;
 };
 
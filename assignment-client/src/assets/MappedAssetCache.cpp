@@ -0,0 +1,139 @@
+//
+//  MappedAssetCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MappedAssetCache.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <QtCore/QMutexLocker>
+
+#include <ResourceCache.h>
+
+const qint64 MappedAssetCache::DEFAULT_MAXIMUM_SIZE = BYTES_PER_GIGABYTES;
+
+MappedAsset::MappedAsset(const QString& filePath) :
+    _file(filePath)
+{
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    _size = _file.size();
+    if (_size > 0) {
+        _mapped = _file.map(0, _size);
+        if (_mapped) {
+            _data = reinterpret_cast<const char*>(_mapped);
+        } else {
+            _contents = _file.readAll();
+            _data = _contents.constData();
+            _size = _contents.size();
+        }
+    }
+}
+
+MappedAsset::~MappedAsset() {
+    if (_mapped) {
+        _file.unmap(_mapped);
+    }
+}
+
+MappedAssetCache::MappedAssetCache(const QDir& filesDirectory, qint64 maximumSize) :
+    _filesDirectory(filesDirectory),
+    _maximumSize(maximumSize)
+{
+}
+
+MappedAsset::Pointer MappedAssetCache::getAsset(const AssetHash& hash) {
+    {
+        QMutexLocker locker(&_mutex);
+        _requestCounts[hash]++;
+        auto entry = _entryIndex.find(hash);
+        if (entry != _entryIndex.end()) {
+            _entries.splice(_entries.begin(), _entries, entry.value());
+            _numHits++;
+            return _entries.front().asset;
+        }
+    }
+
+    // mapped outside of the lock, another thread may map the same file in the meantime
+    _numMisses++;
+    std::shared_ptr<MappedAsset> asset(new MappedAsset(_filesDirectory.filePath(hash)));
+    if (!asset->_file.isOpen() || !asset->isValid()) {
+        QMutexLocker locker(&_mutex);
+        _requestCounts.remove(hash);
+        return nullptr;
+    }
+
+    QMutexLocker locker(&_mutex);
+    auto entry = _entryIndex.find(hash);
+    if (entry != _entryIndex.end()) {
+        return entry.value()->asset;
+    }
+    _entries.push_front({ hash, asset });
+    _entryIndex[hash] = _entries.begin();
+    _size += asset->getSize();
+    evict();
+    return asset;
+}
+
+void MappedAssetCache::removeAsset(const AssetHash& hash) {
+    QMutexLocker locker(&_mutex);
+    auto entry = _entryIndex.find(hash);
+    if (entry != _entryIndex.end()) {
+        _size -= entry.value()->asset->getSize();
+        _entries.erase(entry.value());
+        _entryIndex.erase(entry);
+    }
+}
+
+void MappedAssetCache::evict() {
+    // requests in flight keep their asset mapped until they are done with it
+    while (_size > _maximumSize && !_entries.empty()) {
+        auto last = std::prev(_entries.end());
+        _size -= last->asset->getSize();
+        _entryIndex.remove(last->hash);
+        _entries.erase(last);
+        _numEvictions++;
+    }
+}
+
+void MappedAssetCache::setMaximumSize(qint64 maximumSize) {
+    QMutexLocker locker(&_mutex);
+    _maximumSize = maximumSize;
+    evict();
+}
+
+int MappedAssetCache::getNumEntries() const {
+    QMutexLocker locker(&_mutex);
+    return (int)_entries.size();
+}
+
+float MappedAssetCache::getHitRate() const {
+    int numRequests = _numHits + _numMisses;
+    return (numRequests > 0) ? (float)_numHits / (float)numRequests : 0.0f;
+}
+
+std::vector<std::pair<AssetHash, int>> MappedAssetCache::getMostRequested(int count) const {
+    std::vector<std::pair<AssetHash, int>> result;
+    {
+        QMutexLocker locker(&_mutex);
+        result.reserve(_requestCounts.size());
+        for (auto it = _requestCounts.constBegin(); it != _requestCounts.constEnd(); it++) {
+            result.emplace_back(it.key(), it.value());
+        }
+    }
+    auto middle = result.begin() + std::min(count, (int)result.size());
+    std::partial_sort(result.begin(), middle, result.end(), [](const std::pair<AssetHash, int>& a,
+                                                                const std::pair<AssetHash, int>& b) {
+        return a.second > b.second;
+    });
+    result.erase(middle, result.end());
+    return result;
+}
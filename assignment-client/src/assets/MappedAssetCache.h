@@ -0,0 +1,101 @@
+//
+//  MappedAssetCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MappedAssetCache_h
+#define hifi_MappedAssetCache_h
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+
+#include "AssetUtils.h"
+
+/// The contents of an asset file, memory mapped.  Stays valid for as long as it is referenced, even once the
+/// cache let go of it.
+class MappedAsset {
+public:
+    using Pointer = std::shared_ptr<const MappedAsset>;
+
+    ~MappedAsset();
+
+    const char* getData() const { return _data; }
+    qint64 getSize() const { return _size; }
+
+private:
+    friend class MappedAssetCache;
+
+    MappedAsset(const QString& filePath);
+    bool isValid() const { return _data != nullptr || _size == 0; }
+
+    QFile _file;
+    uchar* _mapped { nullptr };
+    QByteArray _contents;  // only used when the file can't be mapped
+    const char* _data { nullptr };
+    qint64 _size { 0 };
+};
+
+/// Keeps the most recently requested asset files mapped, up to a maximum total size, so popular assets are
+/// served from the page cache without opening and reading the file for every request.  Thread safe.
+class MappedAssetCache {
+public:
+    static const qint64 DEFAULT_MAXIMUM_SIZE;
+
+    MappedAssetCache(const QDir& filesDirectory, qint64 maximumSize = DEFAULT_MAXIMUM_SIZE);
+
+    /// Returns nullptr if there is no such asset.
+    MappedAsset::Pointer getAsset(const AssetHash& hash);
+
+    /// Drops the mapping of an asset whose file was replaced.
+    void removeAsset(const AssetHash& hash);
+
+    void setMaximumSize(qint64 maximumSize);
+    qint64 getMaximumSize() const { return _maximumSize; }
+    qint64 getSize() const { return _size; }
+    int getNumEntries() const;
+
+    int getNumHits() const { return _numHits; }
+    int getNumMisses() const { return _numMisses; }
+    int getNumEvictions() const { return _numEvictions; }
+    float getHitRate() const;
+
+    /// Returns the most requested assets with their number of requests, most requested first.
+    std::vector<std::pair<AssetHash, int>> getMostRequested(int count) const;
+
+private:
+    struct Entry {
+        AssetHash hash;
+        MappedAsset::Pointer asset;
+    };
+    using Entries = std::list<Entry>;
+
+    void evict();
+
+    QDir _filesDirectory;
+    std::atomic<qint64> _maximumSize;
+    std::atomic<qint64> _size { 0 };
+
+    // most recently used first
+    mutable QMutex _mutex;
+    Entries _entries;
+    QHash<AssetHash, Entries::iterator> _entryIndex;
+    QHash<AssetHash, int> _requestCounts;
+
+    std::atomic<int> _numHits { 0 };
+    std::atomic<int> _numMisses { 0 };
+    std::atomic<int> _numEvictions { 0 };
+};
+
+#endif // hifi_MappedAssetCache_h
@@ -11,8 +11,6 @@
 
 #include "SendAssetTask.h"
 
-#include <QFile>
-
 #include <DependencyManager.h>
 #include <NetworkLogging.h>
 #include <NLPacket.h>
@@ -22,11 +20,12 @@
 
 #include "AssetUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode,
+                             std::shared_ptr<MappedAssetCache> assetCache) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _assetCache(assetCache)
 {
     
 }
@@ -58,25 +57,22 @@ void SendAssetTask::run() {
     if (end <= start) {
         replyPacketList->writePrimitive(AssetServerError::InvalidByteRange);
     } else {
-        QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
-        QFile file { filePath };
+        auto asset = _assetCache->getAsset(hexHash);
 
-        if (file.open(QIODevice::ReadOnly)) {
-            if (file.size() < end) {
+        if (asset) {
+            if (asset->getSize() < end) {
                 replyPacketList->writePrimitive(AssetServerError::InvalidByteRange);
                 qCDebug(networking) << "Bad byte range: " << hexHash << " " << start << ":" << end;
             } else {
                 auto size = end - start;
-                file.seek(start);
                 replyPacketList->writePrimitive(AssetServerError::NoError);
                 replyPacketList->writePrimitive(size);
-                replyPacketList->write(file.read(size));
+                // written straight from the mapped file, the asset stays mapped until this task is done with it
+                replyPacketList->write(asset->getData() + start, size);
                 qCDebug(networking) << "Sending asset: " << hexHash;
             }
-            file.close();
         } else {
-            qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
+            qCDebug(networking) << "Asset not found: " << hexHash;
             replyPacketList->writePrimitive(AssetServerError::AssetNotFound);
         }
     }
@@ -12,6 +12,8 @@
 #ifndef hifi_SendAssetTask_h
 #define hifi_SendAssetTask_h
 
+#include <memory>
+
 #include <QtCore/QByteArray>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QString>
@@ -19,20 +21,22 @@
 
 #include "AssetUtils.h"
 #include "AssetServer.h"
+#include "MappedAssetCache.h"
 #include "Node.h"
 
 class NLPacket;
 
 class SendAssetTask : public QRunnable {
 public:
-    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir);
+    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode,
+                  std::shared_ptr<MappedAssetCache> assetCache);
 
     void run();
 
 private:
     QSharedPointer<ReceivedMessage> _message;
     SharedNodePointer _senderNode;
-    QDir _resourcesDir;
+    std::shared_ptr<MappedAssetCache> _assetCache;
 };
 
 #endif
@@ -0,0 +1,220 @@
+//
+//  UploadAssetStream.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UploadAssetStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSaveFile>
+#include <QtCore/QUuid>
+
+#include <NodeList.h>
+#include <UUID.h>
+
+const QString UploadAssetStream::TEMPORARY_FILE_EXTENSION = ".upload";
+const QString UploadAssetStream::HASH_FILE_EXTENSION = ".hash";
+
+static const int UPLOAD_HEADER_SIZE = sizeof(MessageID) + sizeof(uint64_t);
+
+UploadAssetStream::UploadAssetStream(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode,
+                                     const QDir& filesDir, std::shared_ptr<MappedAssetCache> assetCache) :
+    _message(message),
+    _senderNode(senderNode),
+    _filesDir(filesDir),
+    _assetCache(assetCache)
+{
+}
+
+UploadAssetStream::~UploadAssetStream() {
+    discardTemporaryFile();
+}
+
+// the record next to an asset file is its size followed by its hex hash
+static QString hashFilePath(const QDir& filesDir, const AssetHash& hexHash) {
+    return filesDir.filePath(hexHash + UploadAssetStream::HASH_FILE_EXTENSION);
+}
+
+static void writeHashFile(const QDir& filesDir, const AssetHash& hexHash, qint64 size) {
+    QSaveFile file(hashFilePath(filesDir, hexHash));
+    if (!file.open(QIODevice::WriteOnly) || file.write(QString("%1 %2").arg(size).arg(hexHash).toLatin1()) < 0 ||
+        !file.commit()) {
+        qWarning() << "Could not record the hash of" << hexHash;
+    }
+}
+
+bool UploadAssetStream::isExistingFileValid(const QDir& filesDir, const AssetHash& hexHash) {
+    QFileInfo fileInfo { filesDir.filePath(hexHash) };
+    if (!fileInfo.exists()) {
+        return false;
+    }
+
+    QFile hashFile { hashFilePath(filesDir, hexHash) };
+    if (hashFile.open(QIODevice::ReadOnly)) {
+        auto record = QString::fromLatin1(hashFile.readAll()).split(' ');
+        return record.size() == 2 && record[0].toLongLong() == fileInfo.size() && record[1] == hexHash;
+    }
+
+    // files from before the records were kept are hashed once, a chunk at a time
+    QFile file { fileInfo.filePath() };
+    QCryptographicHash hash { QCryptographicHash::Sha256 };
+    if (!file.open(QIODevice::ReadOnly) || !hash.addData(&file) || hash.result().toHex() != hexHash) {
+        return false;
+    }
+    writeHashFile(filesDir, hexHash, fileInfo.size());
+    return true;
+}
+
+void UploadAssetStream::processAvailable() {
+    QMutexLocker locker(&_mutex);
+    if (_isFinished) {
+        return;
+    }
+
+    if (_message->failed()) {
+        qDebug() << "Upload from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID()) << "failed to arrive.";
+        _isFinished = true;
+        discardTemporaryFile();
+        return;
+    }
+
+    // checked before reading, so nothing appended in between is missed
+    bool isComplete = _message->isComplete();
+    QByteArray data = _message->readAvailable();
+
+    if (!_hasHeader && !readHeader(data)) {
+        if (isComplete && !_isFinished) {
+            qWarning() << "Received an upload too short to hold its header from"
+                << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
+            _isFinished = true;
+        }
+        return;
+    }
+
+    if (writeData(data) && isComplete) {
+        finish();
+    }
+}
+
+bool UploadAssetStream::readHeader(QByteArray& data) {
+    _header.append(data);
+    if (_header.size() < UPLOAD_HEADER_SIZE) {
+        return false;
+    }
+    memcpy(&_messageID, _header.constData(), sizeof(MessageID));
+    memcpy(&_fileSize, _header.constData() + sizeof(MessageID), sizeof(uint64_t));
+    data = _header.mid(UPLOAD_HEADER_SIZE);
+    _header.clear();
+    _hasHeader = true;
+
+    qDebug() << "UploadAssetStream reading a file of " << _fileSize << "bytes from"
+        << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
+
+    if (_fileSize > MAX_UPLOAD_SIZE) {
+        reply(AssetServerError::AssetTooLarge);
+        return false;
+    }
+
+    _temporaryFile.setFileName(_filesDir.filePath(uuidStringWithoutCurlyBraces(QUuid::createUuid()) +
+                                                  TEMPORARY_FILE_EXTENSION));
+    if (!_temporaryFile.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not open" << _temporaryFile.fileName() << "for an upload - upload failed.";
+        reply(AssetServerError::FileOperationFailed);
+        return false;
+    }
+    return true;
+}
+
+bool UploadAssetStream::writeData(const QByteArray& data) {
+    // anything past the announced size is not part of the file
+    qint64 size = std::min((uint64_t)data.size(), _fileSize - _bytesWritten);
+    if (size <= 0) {
+        return true;
+    }
+
+    _hash.addData(data.constData(), size);
+    if (_temporaryFile.write(data.constData(), size) != size) {
+        qWarning() << "Failed to write to" << _temporaryFile.fileName() << "- upload failed.";
+        discardTemporaryFile();
+        reply(AssetServerError::FileOperationFailed);
+        return false;
+    }
+    _bytesWritten += size;
+    return true;
+}
+
+void UploadAssetStream::finish() {
+    if (_bytesWritten != _fileSize) {
+        qWarning() << "Upload ended after" << _bytesWritten << "of" << _fileSize << "bytes - upload failed.";
+        discardTemporaryFile();
+        reply(AssetServerError::FileOperationFailed);
+        return;
+    }
+
+    auto hash = _hash.result();
+    AssetHash hexHash = hash.toHex();
+
+    qDebug() << "Hash for uploaded file from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID())
+        << "is: (" << hexHash << ") ";
+
+    _temporaryFile.close();
+
+    if (isExistingFileValid(_filesDir, hexHash)) {
+        qDebug() << "Not overwriting existing verified file: " << hexHash;
+        discardTemporaryFile();
+        reply(AssetServerError::NoError, hash);
+        return;
+    }
+
+    QString filePath = _filesDir.filePath(hexHash);
+    if (QFile::exists(filePath)) {
+        qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
+        QFile::remove(hashFilePath(_filesDir, hexHash));
+        QFile::remove(filePath);
+        _assetCache->removeAsset(hexHash);
+    }
+
+    // the file only appears under its hash once it is complete
+    if (!_temporaryFile.rename(filePath)) {
+        qWarning() << "Failed to move upload" << hexHash << "into place - upload failed.";
+        discardTemporaryFile();
+        reply(AssetServerError::FileOperationFailed);
+        return;
+    }
+    writeHashFile(_filesDir, hexHash, _bytesWritten);
+
+    qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
+    reply(AssetServerError::NoError, hash);
+}
+
+void UploadAssetStream::reply(AssetServerError error, const QByteArray& hash) {
+    _isFinished = true;
+
+    auto replyPacket = NLPacket::create(PacketType::AssetUploadReply);
+    replyPacket->writePrimitive(_messageID);
+    replyPacket->writePrimitive(error);
+    if (error == AssetServerError::NoError) {
+        replyPacket->write(hash);
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->sendPacket(std::move(replyPacket), *_senderNode);
+}
+
+void UploadAssetStream::discardTemporaryFile() {
+    if (_temporaryFile.fileName().endsWith(TEMPORARY_FILE_EXTENSION) && _temporaryFile.exists()) {
+        _temporaryFile.close();
+        if (!_temporaryFile.remove()) {
+            qWarning() << "Removal of failed upload file" << _temporaryFile.fileName() << "failed.";
+        }
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  UploadAssetStream.h
+//  assignment-client/src/assets
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UploadAssetStream_h
+#define hifi_UploadAssetStream_h
+
+#include <memory>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QMutex>
+#include <QtCore/QSharedPointer>
+
+#include <AssetUtils.h>
+
+#include "MappedAssetCache.h"
+#include "ReceivedMessage.h"
+
+class Node;
+
+/// An upload that is hashed and written to a temporary file as its packets arrive, then renamed to its hash once
+/// the message is complete.
+class UploadAssetStream {
+public:
+    static const QString TEMPORARY_FILE_EXTENSION;
+    static const QString HASH_FILE_EXTENSION;
+
+    UploadAssetStream(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, const QDir& filesDir,
+                      std::shared_ptr<MappedAssetCache> assetCache);
+    ~UploadAssetStream();
+
+    /// Hashes and writes whatever arrived since the last call, and replies to the uploader once the message is
+    /// complete.  Calls may come from any thread.
+    void processAvailable();
+
+    /// Returns true if the file for the hash exists and matches the size and hash recorded next to it.  Files
+    /// without a record are hashed once, and get one if they match.
+    static bool isExistingFileValid(const QDir& filesDir, const AssetHash& hexHash);
+
+private:
+    bool readHeader(QByteArray& data);
+    bool writeData(const QByteArray& data);
+    void finish();
+    void reply(AssetServerError error, const QByteArray& hash = QByteArray());
+    void discardTemporaryFile();
+
+    QSharedPointer<ReceivedMessage> _message;
+    QSharedPointer<Node> _senderNode;
+    QDir _filesDir;
+    std::shared_ptr<MappedAssetCache> _assetCache;
+
+    QMutex _mutex;
+    QByteArray _header;
+    bool _hasHeader { false };
+    bool _isFinished { false };
+    MessageID _messageID { 0 };
+    uint64_t _fileSize { 0 };
+    uint64_t _bytesWritten { 0 };
+    QCryptographicHash _hash { QCryptographicHash::Sha256 };
+    QFile _temporaryFile;
+};
+
+#endif // hifi_UploadAssetStream_h
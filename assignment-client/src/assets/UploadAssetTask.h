@@ -14,26 +14,21 @@
 #ifndef hifi_UploadAssetTask_h
 #define hifi_UploadAssetTask_h
 
-#include <QtCore/QDir>
-#include <QtCore/QObject>
-#include <QtCore/QRunnable>
-#include <QtCore/QSharedPointer>
+#include <memory>
 
-#include "ReceivedMessage.h"
+#include <QtCore/QRunnable>
 
-class NLPacketList;
-class Node;
+#include "UploadAssetStream.h"
 
+/// Processes the part of an upload that arrived since the last task ran for it.
 class UploadAssetTask : public QRunnable {
 public:
-    UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, const QDir& resourcesDir);
+    UploadAssetTask(std::shared_ptr<UploadAssetStream> stream);
     
     void run();
     
 private:
-    QSharedPointer<ReceivedMessage> _receivedMessage;
-    QSharedPointer<Node> _senderNode;
-    QDir _resourcesDir;
+    std::shared_ptr<UploadAssetStream> _stream;
 };
 
 #endif // hifi_UploadAssetTask_h
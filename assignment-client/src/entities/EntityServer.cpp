@@ -11,6 +11,7 @@
 
 #include <QTimer>
 #include <EntityTree.h>
+#include <ServerPhysicalEntitySimulation.h>
 #include <SimpleEntitySimulation.h>
 
 #include "EntityServer.h"
@@ -69,6 +70,16 @@ OctreePointer EntityServer::createTree() {
 }
 
 void EntityServer::beforeRun() {
+    if (_wantServerPhysics && !_physicsSimulation) {
+        // the tree is still empty here (the persist file is loaded after this), so the simulations can be swapped
+        EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+        _physicsSimulation = new ServerPhysicalEntitySimulation();
+        _physicsSimulation->init(tree);
+        tree->setSimulation(_physicsSimulation);
+        delete _entitySimulation;
+        _entitySimulation = nullptr;
+    }
+
     _pruneDeletedEntitiesTimer = new QTimer();
     connect(_pruneDeletedEntitiesTimer, SIGNAL(timeout()), this, SLOT(pruneDeletedEntities()));
     const int PRUNE_DELETED_MODELS_INTERVAL_MSECS = 1 * 1000; // once every second
@@ -267,6 +278,9 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
     readOptionBool(QString("wantTerseEditLogging"), settingsSectionObject, wantTerseEditLogging);
     qDebug("wantTerseEditLogging=%s", debug::valueOf(wantTerseEditLogging));
 
+    readOptionBool(QString("wantServerPhysics"), settingsSectionObject, _wantServerPhysics);
+    qDebug("wantServerPhysics=%s", debug::valueOf(_wantServerPhysics));
+
     EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
     tree->setWantEditLogging(wantEditLogging);
     tree->setWantTerseEditLogging(wantTerseEditLogging);
@@ -300,6 +314,9 @@ void EntityServer::trackViewerGone(const QUuid& sessionID) {
     if (_entitySimulation) {
         _entitySimulation->clearOwnership(sessionID);
     }
+    if (_physicsSimulation) {
+        _physicsSimulation->clearOwnership(sessionID);
+    }
 }
 
 QString EntityServer::serverSubclassStats() {
@@ -312,6 +329,15 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    if (_physicsSimulation) {
+        statsString += "<b>Entity Server Physics Statistics</b>\r\n";
+        statsString += QString("   Physical entities: %1\r\n")
+            .arg(locale.toString(_physicsSimulation->getNumPhysicalEntities()));
+        statsString += QString("   Average step time: %1 usecs\r\n")
+            .arg(locale.toString((qulonglong)_physicsSimulation->getAverageStepUsecs()));
+        statsString += "\r\n\r\n";
+    }
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
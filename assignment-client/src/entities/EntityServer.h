@@ -27,6 +27,7 @@ struct ViewerSendingStats {
     quint64 lastEdited;
 };
 
+class ServerPhysicalEntitySimulation;
 class SimpleEntitySimulation;
 
 class EntityServer : public OctreeServer, public NewlyCreatedEntityHook {
@@ -70,6 +71,8 @@ private slots:
 
 private:
     SimpleEntitySimulation* _entitySimulation;
+    ServerPhysicalEntitySimulation* _physicsSimulation { nullptr }; // replaces _entitySimulation if wantServerPhysics
+    bool _wantServerPhysics { false };
     QTimer* _pruneDeletedEntitiesTimer = nullptr;
 
     QReadWriteLock _viewerSendingStatsLock;
@@ -226,6 +226,7 @@ static const QString DESKTOP_LOCATION = QStandardPaths::writableLocation(QStanda
 
 const QString DEFAULT_SCRIPTS_JS_URL = "http://s3.amazonaws.com/hifi-public/scripts/defaultScripts.js";
 Setting::Handle<int> maxOctreePacketsPerSecond("maxOctreePPS", DEFAULT_MAX_OCTREE_PPS);
+Setting::Handle<int> physicsWorkerThreadCount("physicsWorkerThreadCount", 0);
 
 const QHash<QString, Application::AcceptURLMethod> Application::_acceptedExtensions {
     { SNAPSHOT_EXTENSION, &Application::acceptSnapshot },
@@ -2943,6 +2944,7 @@ void Application::init() {
     getEntities()->setViewFrustum(getViewFrustum());
 
     ObjectMotionState::setShapeManager(&_shapeManager);
+    _physicsEngine->setNumWorkerThreads(physicsWorkerThreadCount.get());
     _physicsEngine->init();
 
     EntityTreePointer tree = getEntities()->getTree();
@@ -19,8 +19,8 @@
 OctreePacketProcessor::OctreePacketProcessor() {
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     
-    packetReceiver.registerDirectListenerForTypes({ PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase },
-                                                  this, "handleOctreePacket");
+    packetReceiver.registerMessageHandler({ PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase },
+                                          this, &OctreePacketProcessor::handleOctreePacket);
 }
 
 void OctreePacketProcessor::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -28,7 +28,7 @@ signals:
 protected:
     virtual void processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) override;
 
-private slots:
+private:
     void handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 };
 #endif // hifi_OctreePacketProcessor_h
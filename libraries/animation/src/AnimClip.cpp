@@ -50,11 +50,11 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt,
         _networkAnim.reset();
     }
 
-    if (_anim.size()) {
+    if (_clipData && _clipData->getFrameCount() > 0) {
 
-        // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
-            buildMirrorAnim();
+        // lazy lookup of mirrored animation frames.
+        if (_mirrorFlag && !_mirrorClipData) {
+            _mirrorClipData = AnimClipData::getMirroredClipData(_url, *_clipData, *_skeleton, usePreAndPostPoseFromAnim);
         }
 
         int prevIndex = (int)glm::floor(_frame);
@@ -67,15 +67,16 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt,
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = _clipData->getFrameCount();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
+        const AnimClipData& clipData = _mirrorFlag ? *_mirrorClipData : *_clipData;
+        clipData.sampleFrame(prevIndex, _prevFrame);
+        clipData.sampleFrame(nextIndex, _nextFrame);
         float alpha = glm::fract(_frame);
 
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        ::blend(_poses.size(), &_prevFrame[0], &_nextFrame[0], alpha, &_poses[0]);
     }
 
     return _poses;
@@ -96,95 +97,16 @@ void AnimClip::setCurrentFrameInternal(float frame) {
 
 void AnimClip::copyFromNetworkAnim() {
     assert(_networkAnim && _networkAnim->isLoaded() && _skeleton);
-    _anim.clear();
 
-    // build a mapping from animation joint indices to skeleton joint indices.
-    // by matching joints with the same name.
-    const FBXGeometry& geom = _networkAnim->getGeometry();
-    AnimSkeleton animSkeleton(geom);
-    const auto animJointCount = animSkeleton.getNumJoints();
-    const auto skeletonJointCount = _skeleton->getNumJoints();
-    std::vector<int> jointMap;
-    jointMap.reserve(animJointCount);
-    for (int i = 0; i < animJointCount; i++) {
-        int skeletonJoint = _skeleton->nameToJointIndex(animSkeleton.getJointName(i));
-        if (skeletonJoint == -1) {
-            qCWarning(animation) << "animation contains joint =" << animSkeleton.getJointName(i) << " which is not in the skeleton, url =" << _url;
-        }
-        jointMap.push_back(skeletonJoint);
-    }
-
-    const int frameCount = geom.animationFrames.size();
-    _anim.resize(frameCount);
-
-    for (int frame = 0; frame < frameCount; frame++) {
-
-        const FBXAnimationFrame& fbxAnimFrame = geom.animationFrames[frame];
-
-        // init all joints in animation to default pose
-        // this will give us a resonable result for bones in the model skeleton but not in the animation.
-        _anim[frame].reserve(skeletonJointCount);
-        for (int skeletonJoint = 0; skeletonJoint < skeletonJointCount; skeletonJoint++) {
-            _anim[frame].push_back(_skeleton->getRelativeDefaultPose(skeletonJoint));
-        }
+    _clipData = AnimClipData::getClipData(_url, *_networkAnim, *_skeleton, usePreAndPostPoseFromAnim);
 
-        for (int animJoint = 0; animJoint < animJointCount; animJoint++) {
-            int skeletonJoint = jointMap[animJoint];
-
-            const glm::vec3& fbxAnimTrans = fbxAnimFrame.translations[animJoint];
-            const glm::quat& fbxAnimRot = fbxAnimFrame.rotations[animJoint];
-
-            // skip joints that are in the animation but not in the skeleton.
-            if (skeletonJoint >= 0 && skeletonJoint < skeletonJointCount) {
-
-                AnimPose preRot, postRot;
-                if (usePreAndPostPoseFromAnim) {
-                    preRot = animSkeleton.getPreRotationPose(animJoint);
-                    postRot = animSkeleton.getPostRotationPose(animJoint);
-                } else {
-                    // In order to support Blender, which does not have preRotation FBX support, we use the models defaultPose as the reference frame for the animations.
-                    preRot = AnimPose(glm::vec3(1.0f), _skeleton->getRelativeBindPose(skeletonJoint).rot, glm::vec3());
-                    postRot = AnimPose::identity;
-                }
-
-                // cancel out scale
-                preRot.scale = glm::vec3(1.0f);
-                postRot.scale = glm::vec3(1.0f);
-
-                AnimPose rot(glm::vec3(1.0f), fbxAnimRot, glm::vec3());
-
-                // adjust translation offsets, so large translation animatons on the reference skeleton
-                // will be adjusted when played on a skeleton with short limbs.
-                const glm::vec3& fbxZeroTrans = geom.animationFrames[0].translations[animJoint];
-                const AnimPose& relDefaultPose = _skeleton->getRelativeDefaultPose(skeletonJoint);
-                float boneLengthScale = 1.0f;
-                const float EPSILON = 0.0001f;
-                if (fabsf(glm::length(fbxZeroTrans)) > EPSILON) {
-                    boneLengthScale = glm::length(relDefaultPose.trans) / glm::length(fbxZeroTrans);
-                }
-
-                AnimPose trans = AnimPose(glm::vec3(1.0f), glm::quat(), relDefaultPose.trans + boneLengthScale * (fbxAnimTrans - fbxZeroTrans));
-
-                _anim[frame][skeletonJoint] = trans * preRot * rot * postRot;
-            }
-        }
-    }
-
-    // mirrorAnim will be re-built on demand, if needed.
-    _mirrorAnim.clear();
+    // mirrorClipData will be looked up on demand, if needed.
+    _mirrorClipData.reset();
 
+    const auto skeletonJointCount = _skeleton->getNumJoints();
     _poses.resize(skeletonJointCount);
-}
-
-void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
-
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
-    }
+    _prevFrame.resize(skeletonJointCount);
+    _nextFrame.resize(skeletonJointCount);
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
@@ -13,6 +13,7 @@
 
 #include <string>
 #include "AnimationCache.h"
+#include "AnimClipData.h"
 #include "AnimNode.h"
 
 // Playback a single animation timeline.
@@ -59,7 +60,6 @@ protected:
     virtual void setCurrentFrameInternal(float frame) override;
 
     void copyFromNetworkAnim();
-    void buildMirrorAnim();
 
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
@@ -67,9 +67,13 @@ protected:
     AnimationPointer _networkAnim;
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // shared between all clips playing the same url on an equivalent skeleton.
+    AnimClipData::Pointer _clipData;
+    AnimClipData::Pointer _mirrorClipData;
+
+    // scratch space for the two frames we blend between.
+    AnimPoseVec _prevFrame;
+    AnimPoseVec _nextFrame;
 
     QString _url;
     float _startFrame;
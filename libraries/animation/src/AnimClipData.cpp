@@ -0,0 +1,341 @@
+//
+//  AnimClipData.cpp
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimClipData.h"
+
+#include <algorithm>
+#include <assert.h>
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <GLMHelpers.h>
+
+#include "AnimationLogging.h"
+#include "AnimUtil.h"
+
+// frames further than this from a linear interpolation of their neighbors become keys.
+static const float ROTATION_TOLERANCE = 0.001f;     // quaternion component distance
+static const float TRANSLATION_TOLERANCE = 0.0002f; // meters
+static const float SCALE_TOLERANCE = 0.00001f;
+
+// bounds the cost of keyframe reduction, at the cost of a few redundant keys for static tracks.
+static const int MAX_KEY_SPAN = 128;
+
+static const int MAX_FRAME_COUNT = 0xffff;
+static const float ROTATION_QUANTIZATION = 32767.0f;
+static const float TRANSLATION_QUANTIZATION = 65535.0f;
+
+static QMutex clipDataMutex;
+static QHash<QByteArray, std::weak_ptr<const AnimClipData>> clipDataMap;
+
+static QByteArray makeKey(const QString& url, const AnimSkeleton& skeleton, bool mirrored, bool usePreAndPostPoseFromAnim) {
+    QByteArray key = url.toUtf8();
+    key.append('\0');
+    key.append(skeleton.getFingerprint());
+    key.append(mirrored ? 'm' : '-');
+    key.append(usePreAndPostPoseFromAnim ? 'p' : '-');
+    return key;
+}
+
+// build the uncompressed relative poses for every frame, with joints in skeleton order.
+static std::vector<AnimPoseVec> buildFrames(const QString& url, const Animation& networkAnim, const AnimSkeleton& skeleton,
+                                            bool usePreAndPostPoseFromAnim) {
+    std::vector<AnimPoseVec> frames;
+
+    // build a mapping from animation joint indices to skeleton joint indices.
+    // by matching joints with the same name.
+    const FBXGeometry& geom = networkAnim.getGeometry();
+    AnimSkeleton animSkeleton(geom);
+    const auto animJointCount = animSkeleton.getNumJoints();
+    const auto skeletonJointCount = skeleton.getNumJoints();
+    std::vector<int> jointMap;
+    jointMap.reserve(animJointCount);
+    for (int i = 0; i < animJointCount; i++) {
+        int skeletonJoint = skeleton.nameToJointIndex(animSkeleton.getJointName(i));
+        if (skeletonJoint == -1) {
+            qCWarning(animation) << "animation contains joint =" << animSkeleton.getJointName(i) << " which is not in the skeleton, url =" << url;
+        }
+        jointMap.push_back(skeletonJoint);
+    }
+
+    int frameCount = geom.animationFrames.size();
+    if (frameCount > MAX_FRAME_COUNT) {
+        qCWarning(animation) << "animation has" << frameCount << "frames, truncating to" << MAX_FRAME_COUNT << ", url =" << url;
+        frameCount = MAX_FRAME_COUNT;
+    }
+    frames.resize(frameCount);
+
+    for (int frame = 0; frame < frameCount; frame++) {
+
+        const FBXAnimationFrame& fbxAnimFrame = geom.animationFrames[frame];
+
+        // init all joints in animation to default pose
+        // this will give us a resonable result for bones in the model skeleton but not in the animation.
+        frames[frame] = skeleton.getRelativeDefaultPoses();
+
+        for (int animJoint = 0; animJoint < animJointCount; animJoint++) {
+            int skeletonJoint = jointMap[animJoint];
+
+            const glm::vec3& fbxAnimTrans = fbxAnimFrame.translations[animJoint];
+            const glm::quat& fbxAnimRot = fbxAnimFrame.rotations[animJoint];
+
+            // skip joints that are in the animation but not in the skeleton.
+            if (skeletonJoint >= 0 && skeletonJoint < skeletonJointCount) {
+
+                AnimPose preRot, postRot;
+                if (usePreAndPostPoseFromAnim) {
+                    preRot = animSkeleton.getPreRotationPose(animJoint);
+                    postRot = animSkeleton.getPostRotationPose(animJoint);
+                } else {
+                    // In order to support Blender, which does not have preRotation FBX support, we use the models defaultPose as the reference frame for the animations.
+                    preRot = AnimPose(glm::vec3(1.0f), skeleton.getRelativeBindPose(skeletonJoint).rot, glm::vec3());
+                    postRot = AnimPose::identity;
+                }
+
+                // cancel out scale
+                preRot.scale = glm::vec3(1.0f);
+                postRot.scale = glm::vec3(1.0f);
+
+                AnimPose rot(glm::vec3(1.0f), fbxAnimRot, glm::vec3());
+
+                // adjust translation offsets, so large translation animatons on the reference skeleton
+                // will be adjusted when played on a skeleton with short limbs.
+                const glm::vec3& fbxZeroTrans = geom.animationFrames[0].translations[animJoint];
+                const AnimPose& relDefaultPose = skeleton.getRelativeDefaultPose(skeletonJoint);
+                float boneLengthScale = 1.0f;
+                const float EPSILON = 0.0001f;
+                if (fabsf(glm::length(fbxZeroTrans)) > EPSILON) {
+                    boneLengthScale = glm::length(relDefaultPose.trans) / glm::length(fbxZeroTrans);
+                }
+
+                AnimPose trans = AnimPose(glm::vec3(1.0f), glm::quat(), relDefaultPose.trans + boneLengthScale * (fbxAnimTrans - fbxZeroTrans));
+
+                frames[frame][skeletonJoint] = trans * preRot * rot * postRot;
+            }
+        }
+    }
+    return frames;
+}
+
+AnimClipData::Pointer AnimClipData::getClipData(const QString& url, const Animation& networkAnim, const AnimSkeleton& skeleton,
+                                                bool usePreAndPostPoseFromAnim) {
+    QByteArray key = makeKey(url, skeleton, false, usePreAndPostPoseFromAnim);
+
+    // NOTE: the lock is held while building, so that two clips never compress the same animation twice.
+    QMutexLocker locker(&clipDataMutex);
+    Pointer clipData = clipDataMap.value(key).lock();
+    if (!clipData) {
+        std::vector<AnimPoseVec> frames = buildFrames(url, networkAnim, skeleton, usePreAndPostPoseFromAnim);
+        clipData = std::make_shared<AnimClipData>(frames, skeleton.getNumJoints());
+        clipDataMap[key] = clipData;
+    }
+    return clipData;
+}
+
+AnimClipData::Pointer AnimClipData::getMirroredClipData(const QString& url, const AnimClipData& clipData, const AnimSkeleton& skeleton,
+                                                        bool usePreAndPostPoseFromAnim) {
+    QByteArray key = makeKey(url, skeleton, true, usePreAndPostPoseFromAnim);
+
+    QMutexLocker locker(&clipDataMutex);
+    Pointer mirrorClipData = clipDataMap.value(key).lock();
+    if (!mirrorClipData) {
+        std::vector<AnimPoseVec> frames(clipData.getFrameCount());
+        for (int frame = 0; frame < clipData.getFrameCount(); frame++) {
+            frames[frame].resize(clipData.getJointCount());
+            clipData.sampleFrame(frame, frames[frame]);
+            skeleton.mirrorRelativePoses(frames[frame]);
+        }
+        mirrorClipData = std::make_shared<AnimClipData>(frames, clipData.getJointCount());
+        clipDataMap[key] = mirrorClipData;
+    }
+    return mirrorClipData;
+}
+
+int AnimClipData::getInstanceCount() {
+    QMutexLocker locker(&clipDataMutex);
+    int count = 0;
+    for (auto iter = clipDataMap.begin(); iter != clipDataMap.end();) {
+        if (iter.value().expired()) {
+            iter = clipDataMap.erase(iter);
+        } else {
+            count++;
+            ++iter;
+        }
+    }
+    return count;
+}
+
+size_t AnimClipData::getTotalMemoryUsage() {
+    QMutexLocker locker(&clipDataMutex);
+    size_t total = 0;
+    for (auto& weakClipData : clipDataMap) {
+        Pointer clipData = weakClipData.lock();
+        if (clipData) {
+            total += clipData->getMemoryUsage();
+        }
+    }
+    return total;
+}
+
+AnimClipData::AnimClipData(const std::vector<AnimPoseVec>& frames, int jointCount) :
+    _frameCount((int)frames.size())
+{
+    assert(_frameCount <= MAX_FRAME_COUNT);
+    _tracks.resize(jointCount);
+    if (_frameCount > 0) {
+        for (int joint = 0; joint < jointCount; joint++) {
+            compressTrack(frames, joint, _tracks[joint]);
+        }
+    }
+}
+
+size_t AnimClipData::getMemoryUsage() const {
+    size_t size = sizeof(AnimClipData) + _tracks.capacity() * sizeof(Track);
+    for (auto& track : _tracks) {
+        size += track.keyFrames.capacity() * sizeof(uint16_t);
+        size += track.rotations.capacity() * sizeof(int16_t);
+        size += track.translations.capacity() * sizeof(uint16_t);
+        size += track.scales.capacity() * sizeof(glm::vec3);
+    }
+    return size;
+}
+
+// returns true if every frame between start and end can be linearly interpolated from those two frames.
+static bool canInterpolate(const std::vector<AnimPoseVec>& frames, int joint, int start, int end) {
+    const AnimPose& startPose = frames[start][joint];
+    const AnimPose& endPose = frames[end][joint];
+    for (int frame = start + 1; frame < end; frame++) {
+        float alpha = (float)(frame - start) / (float)(end - start);
+        AnimPose interp;
+        ::blend(1, &startPose, &endPose, alpha, &interp);
+
+        const AnimPose& actual = frames[frame][joint];
+        glm::quat rot = (glm::dot(interp.rot, actual.rot) < 0.0f) ? -actual.rot : actual.rot;
+        if (glm::length(glm::vec4(interp.rot.x - rot.x, interp.rot.y - rot.y, interp.rot.z - rot.z, interp.rot.w - rot.w)) > ROTATION_TOLERANCE ||
+            glm::distance(interp.trans, actual.trans) > TRANSLATION_TOLERANCE ||
+            glm::distance(interp.scale, actual.scale) > SCALE_TOLERANCE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AnimClipData::compressTrack(const std::vector<AnimPoseVec>& frames, int joint, Track& track) {
+    std::vector<int> keys;
+    keys.push_back(0);
+
+    // joints that are not animated only need a single key.
+    bool constantTrack = true;
+    for (int frame = 1; frame < _frameCount && constantTrack; frame++) {
+        constantTrack =
+            glm::distance(frames[frame][joint].trans, frames[0][joint].trans) <= TRANSLATION_TOLERANCE &&
+            glm::distance(frames[frame][joint].scale, frames[0][joint].scale) <= SCALE_TOLERANCE &&
+            fabsf(glm::dot(frames[frame][joint].rot, frames[0][joint].rot)) >= 1.0f - ROTATION_TOLERANCE * ROTATION_TOLERANCE;
+    }
+
+    if (!constantTrack) {
+        // greedily extend each key span for as long as the skipped frames stay within tolerance.
+        int start = 0;
+        while (start < _frameCount - 1) {
+            int end = start + 1;
+            int maxEnd = std::min(start + MAX_KEY_SPAN, _frameCount - 1);
+            while (end < maxEnd && canInterpolate(frames, joint, start, end + 1)) {
+                end++;
+            }
+            keys.push_back(end);
+            start = end;
+        }
+    }
+
+    // find translation bounds and detect constant scale
+    glm::vec3 transMin = frames[0][joint].trans;
+    glm::vec3 transMax = transMin;
+    bool constantScale = true;
+    for (auto key : keys) {
+        const AnimPose& pose = frames[key][joint];
+        transMin = glm::min(transMin, pose.trans);
+        transMax = glm::max(transMax, pose.trans);
+        if (glm::distance(pose.scale, frames[0][joint].scale) > SCALE_TOLERANCE) {
+            constantScale = false;
+        }
+    }
+    track.transMin = transMin;
+    track.transRange = transMax - transMin;
+    track.constantScale = frames[0][joint].scale;
+
+    track.keyFrames.reserve(keys.size());
+    track.rotations.reserve(4 * keys.size());
+    track.translations.reserve(3 * keys.size());
+    if (!constantScale) {
+        track.scales.reserve(keys.size());
+    }
+
+    for (auto key : keys) {
+        const AnimPose& pose = frames[key][joint];
+        track.keyFrames.push_back((uint16_t)key);
+
+        glm::quat rot = glm::normalize(pose.rot);
+        track.rotations.push_back((int16_t)glm::round(rot.x * ROTATION_QUANTIZATION));
+        track.rotations.push_back((int16_t)glm::round(rot.y * ROTATION_QUANTIZATION));
+        track.rotations.push_back((int16_t)glm::round(rot.z * ROTATION_QUANTIZATION));
+        track.rotations.push_back((int16_t)glm::round(rot.w * ROTATION_QUANTIZATION));
+
+        for (int i = 0; i < 3; i++) {
+            float range = track.transRange[i];
+            float t = (range > 0.0f) ? (pose.trans[i] - transMin[i]) / range : 0.0f;
+            track.translations.push_back((uint16_t)glm::round(glm::clamp(t, 0.0f, 1.0f) * TRANSLATION_QUANTIZATION));
+        }
+
+        if (!constantScale) {
+            track.scales.push_back(pose.scale);
+        }
+    }
+}
+
+AnimPose AnimClipData::decompressKey(const Track& track, int key) const {
+    const int16_t* r = &track.rotations[4 * key];
+    glm::quat rot = glm::normalize(glm::quat((float)r[3], (float)r[0], (float)r[1], (float)r[2]));
+
+    const uint16_t* t = &track.translations[3 * key];
+    glm::vec3 trans = track.transMin + track.transRange * (glm::vec3((float)t[0], (float)t[1], (float)t[2]) / TRANSLATION_QUANTIZATION);
+
+    glm::vec3 scale = track.scales.empty() ? track.constantScale : track.scales[key];
+
+    return AnimPose(scale, rot, trans);
+}
+
+void AnimClipData::sampleFrame(int frame, AnimPoseVec& poses) const {
+    assert((int)poses.size() >= getJointCount());
+    frame = std::min(std::max(0, frame), _frameCount - 1);
+
+    for (int joint = 0; joint < (int)_tracks.size(); joint++) {
+        const Track& track = _tracks[joint];
+        if (track.keyFrames.empty()) {
+            continue;
+        }
+
+        // find the last key at or before this frame.
+        auto iter = std::upper_bound(track.keyFrames.begin(), track.keyFrames.end(), (uint16_t)frame);
+        int key = (int)(iter - track.keyFrames.begin()) - 1;
+        assert(key >= 0);
+
+        if (track.keyFrames[key] == frame || key + 1 >= (int)track.keyFrames.size()) {
+            poses[joint] = decompressKey(track, key);
+        } else {
+            int startFrame = track.keyFrames[key];
+            int endFrame = track.keyFrames[key + 1];
+            float alpha = (float)(frame - startFrame) / (float)(endFrame - startFrame);
+            AnimPose startPose = decompressKey(track, key);
+            AnimPose endPose = decompressKey(track, key + 1);
+            ::blend(1, &startPose, &endPose, alpha, &poses[joint]);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  AnimClipData.h
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimClipData_h
+#define hifi_AnimClipData_h
+
+#include <memory>
+#include <vector>
+
+#include "AnimationCache.h"
+#include "AnimSkeleton.h"
+
+// Immutable, compressed animation frames for a single (url, skeleton) pair.
+// Every AnimClip that plays the same url on an equivalent skeleton shares one instance.
+// Each joint track only stores the frames that cannot be linearly interpolated from their neighbors,
+// and rotations & translations are quantized to 16 bits per component.
+class AnimClipData {
+public:
+    using Pointer = std::shared_ptr<const AnimClipData>;
+
+    // returns the shared clip data for this url & skeleton, building it from the loaded networkAnim if necessary.
+    static Pointer getClipData(const QString& url, const Animation& networkAnim, const AnimSkeleton& skeleton,
+                               bool usePreAndPostPoseFromAnim);
+
+    // returns the shared, mirrored version of the clip, building it on first use.
+    static Pointer getMirroredClipData(const QString& url, const AnimClipData& clipData, const AnimSkeleton& skeleton,
+                                       bool usePreAndPostPoseFromAnim);
+
+    // number of live shared instances, and their total memory usage in bytes.
+    static int getInstanceCount();
+    static size_t getTotalMemoryUsage();
+
+    int getFrameCount() const { return _frameCount; }
+    int getJointCount() const { return (int)_tracks.size(); }
+    size_t getMemoryUsage() const;
+
+    // decompress the relative poses for a single frame, poses must have getJointCount() elements.
+    void sampleFrame(int frame, AnimPoseVec& poses) const;
+
+    // builds clip data directly from uncompressed frames, _anim[frame][joint]
+    AnimClipData(const std::vector<AnimPoseVec>& frames, int jointCount);
+
+protected:
+    struct Track {
+        std::vector<uint16_t> keyFrames;
+        std::vector<int16_t> rotations;       // 4 per key, x, y, z, w
+        std::vector<uint16_t> translations;   // 3 per key, mapped into [transMin, transMin + transRange]
+        std::vector<glm::vec3> scales;        // 1 per key, empty if the scale is constant
+        glm::vec3 transMin;
+        glm::vec3 transRange;
+        glm::vec3 constantScale;
+    };
+
+    void compressTrack(const std::vector<AnimPoseVec>& frames, int joint, Track& track);
+    AnimPose decompressKey(const Track& track, int key) const;
+
+    std::vector<Track> _tracks;
+    int _frameCount { 0 };
+
+    // no copies
+    AnimClipData(const AnimClipData&) = delete;
+    AnimClipData& operator=(const AnimClipData&) = delete;
+};
+
+#endif // hifi_AnimClipData_h
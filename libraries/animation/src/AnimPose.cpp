@@ -43,12 +43,31 @@ glm::vec3 AnimPose::xformVector(const glm::vec3& rhs) const {
     return transInvMat * rhs;
 }
 
+bool AnimPose::hasUniformScale() const {
+    const float UNIFORM_SCALE_EPSILON = 0.0001f;
+    return scale.x > 0.0f &&
+        fabsf(scale.x - scale.y) <= UNIFORM_SCALE_EPSILON * scale.x &&
+        fabsf(scale.x - scale.z) <= UNIFORM_SCALE_EPSILON * scale.x;
+}
+
 AnimPose AnimPose::operator*(const AnimPose& rhs) const {
-    return AnimPose(static_cast<glm::mat4>(*this) * static_cast<glm::mat4>(rhs));
+    if (hasUniformScale()) {
+        // when lhs scale is uniform, the product of the two poses is exactly representable as scale, rot & trans,
+        // so we can compose the parts directly instead of building and decomposing matrices.
+        return AnimPose(scale.x * rhs.scale, glm::normalize(rot * rhs.rot), trans + rot * (scale.x * rhs.trans));
+    } else {
+        return AnimPose(static_cast<glm::mat4>(*this) * static_cast<glm::mat4>(rhs));
+    }
 }
 
 AnimPose AnimPose::inverse() const {
-    return AnimPose(glm::inverse(static_cast<glm::mat4>(*this)));
+    if (hasUniformScale()) {
+        float invScale = 1.0f / scale.x;
+        glm::quat invRot = glm::conjugate(rot);
+        return AnimPose(glm::vec3(invScale), invRot, invRot * (-invScale * trans));
+    } else {
+        return AnimPose(glm::inverse(static_cast<glm::mat4>(*this)));
+    }
 }
 
 // mirror about x-axis without applying negative scale.
@@ -31,6 +31,7 @@ struct AnimPose {
 
     AnimPose inverse() const;
     AnimPose mirror() const;
+    bool hasUniformScale() const;
     operator glm::mat4() const;
 
     glm::vec3 scale;
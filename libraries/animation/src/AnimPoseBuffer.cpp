@@ -0,0 +1,310 @@
+//
+//  AnimPoseBuffer.cpp
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBuffer.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+
+static const float IDENTITY_COMPONENTS[AnimPoseBuffer::NumComponents] = {
+    1.0f, 1.0f, 1.0f,       // scale
+    0.0f, 0.0f, 0.0f, 1.0f, // rot
+    0.0f, 0.0f, 0.0f        // trans
+};
+
+void AnimPoseBuffer::resize(size_t size) {
+    _size = size;
+    _stride = (size + LANE_WIDTH - 1) & ~(LANE_WIDTH - 1);
+    _data.resize(NumComponents * _stride);
+
+    // fill the padding with identity, so kernels can safely operate on whole lanes.
+    for (int c = 0; c < NumComponents; c++) {
+        float* stream = getComponent((Component)c);
+        for (size_t i = _size; i < _stride; i++) {
+            stream[i] = IDENTITY_COMPONENTS[c];
+        }
+    }
+}
+
+AnimPose AnimPoseBuffer::get(size_t index) const {
+    assert(index < _size);
+    const float* data = _data.data() + index;
+    return AnimPose(glm::vec3(data[ScaleX * _stride], data[ScaleY * _stride], data[ScaleZ * _stride]),
+                    glm::quat(data[RotW * _stride], data[RotX * _stride], data[RotY * _stride], data[RotZ * _stride]),
+                    glm::vec3(data[TransX * _stride], data[TransY * _stride], data[TransZ * _stride]));
+}
+
+void AnimPoseBuffer::set(size_t index, const AnimPose& pose) {
+    assert(index < _size);
+    float* data = _data.data() + index;
+    data[ScaleX * _stride] = pose.scale.x;
+    data[ScaleY * _stride] = pose.scale.y;
+    data[ScaleZ * _stride] = pose.scale.z;
+    data[RotX * _stride] = pose.rot.x;
+    data[RotY * _stride] = pose.rot.y;
+    data[RotZ * _stride] = pose.rot.z;
+    data[RotW * _stride] = pose.rot.w;
+    data[TransX * _stride] = pose.trans.x;
+    data[TransY * _stride] = pose.trans.y;
+    data[TransZ * _stride] = pose.trans.z;
+}
+
+void AnimPoseBuffer::load(const AnimPoseVec& poses) {
+    resize(poses.size());
+    for (size_t i = 0; i < _size; i++) {
+        set(i, poses[i]);
+    }
+}
+
+void AnimPoseBuffer::store(AnimPoseVec& poses) const {
+    poses.resize(_size);
+    for (size_t i = 0; i < _size; i++) {
+        poses[i] = get(i);
+    }
+}
+
+static bool isUniformScale(float x, float y, float z) {
+    const float UNIFORM_SCALE_EPSILON = 0.0001f;
+    return x > 0.0f && fabsf(x - y) <= UNIFORM_SCALE_EPSILON * x && fabsf(x - z) <= UNIFORM_SCALE_EPSILON * x;
+}
+
+// returns true if every parent in the group has a uniform scale, which is required by the lane kernels.
+static bool parentsHaveUniformScale(const AnimPoseBuffer& buffer, const int* parents, size_t count) {
+    const float* sx = buffer.getComponent(AnimPoseBuffer::ScaleX);
+    const float* sy = buffer.getComponent(AnimPoseBuffer::ScaleY);
+    const float* sz = buffer.getComponent(AnimPoseBuffer::ScaleZ);
+    for (size_t k = 0; k < count; k++) {
+        int p = parents[k];
+        if (!isUniformScale(sx[p], sy[p], sz[p])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// copy up to LANE_WIDTH poses into lane order, padding the remainder with identity.
+static void gatherLanes(const AnimPoseBuffer& buffer, const int* indices, size_t count,
+                        float lanes[AnimPoseBuffer::NumComponents][AnimPoseBuffer::LANE_WIDTH]) {
+    for (int c = 0; c < AnimPoseBuffer::NumComponents; c++) {
+        const float* stream = buffer.getComponent((AnimPoseBuffer::Component)c);
+        for (size_t k = 0; k < AnimPoseBuffer::LANE_WIDTH; k++) {
+            lanes[c][k] = (k < count) ? stream[indices[k]] : IDENTITY_COMPONENTS[c];
+        }
+    }
+}
+
+static void scatterLanes(AnimPoseBuffer& buffer, const int* indices, size_t count,
+                         const float lanes[AnimPoseBuffer::NumComponents][AnimPoseBuffer::LANE_WIDTH]) {
+    for (int c = 0; c < AnimPoseBuffer::NumComponents; c++) {
+        float* stream = buffer.getComponent((AnimPoseBuffer::Component)c);
+        for (size_t k = 0; k < count; k++) {
+            stream[indices[k]] = lanes[c][k];
+        }
+    }
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+// four poses, one per lane
+struct PoseLanes {
+    __m128 sx, sy, sz;
+    __m128 rx, ry, rz, rw;
+    __m128 tx, ty, tz;
+};
+
+static inline void loadLanes(const float src[AnimPoseBuffer::NumComponents][AnimPoseBuffer::LANE_WIDTH], PoseLanes& p) {
+    p.sx = _mm_loadu_ps(src[AnimPoseBuffer::ScaleX]);
+    p.sy = _mm_loadu_ps(src[AnimPoseBuffer::ScaleY]);
+    p.sz = _mm_loadu_ps(src[AnimPoseBuffer::ScaleZ]);
+    p.rx = _mm_loadu_ps(src[AnimPoseBuffer::RotX]);
+    p.ry = _mm_loadu_ps(src[AnimPoseBuffer::RotY]);
+    p.rz = _mm_loadu_ps(src[AnimPoseBuffer::RotZ]);
+    p.rw = _mm_loadu_ps(src[AnimPoseBuffer::RotW]);
+    p.tx = _mm_loadu_ps(src[AnimPoseBuffer::TransX]);
+    p.ty = _mm_loadu_ps(src[AnimPoseBuffer::TransY]);
+    p.tz = _mm_loadu_ps(src[AnimPoseBuffer::TransZ]);
+}
+
+static inline void storeLanes(const PoseLanes& p, float dst[AnimPoseBuffer::NumComponents][AnimPoseBuffer::LANE_WIDTH]) {
+    _mm_storeu_ps(dst[AnimPoseBuffer::ScaleX], p.sx);
+    _mm_storeu_ps(dst[AnimPoseBuffer::ScaleY], p.sy);
+    _mm_storeu_ps(dst[AnimPoseBuffer::ScaleZ], p.sz);
+    _mm_storeu_ps(dst[AnimPoseBuffer::RotX], p.rx);
+    _mm_storeu_ps(dst[AnimPoseBuffer::RotY], p.ry);
+    _mm_storeu_ps(dst[AnimPoseBuffer::RotZ], p.rz);
+    _mm_storeu_ps(dst[AnimPoseBuffer::RotW], p.rw);
+    _mm_storeu_ps(dst[AnimPoseBuffer::TransX], p.tx);
+    _mm_storeu_ps(dst[AnimPoseBuffer::TransY], p.ty);
+    _mm_storeu_ps(dst[AnimPoseBuffer::TransZ], p.tz);
+}
+
+// rotate (vx, vy, vz) by quaternion (qx, qy, qz, qw), in place.
+// v' = v + qw * t + cross(q, t), where t = 2 * cross(q, v)
+static inline void rotateLanes(__m128 qx, __m128 qy, __m128 qz, __m128 qw, __m128& vx, __m128& vy, __m128& vz) {
+    const __m128 two = _mm_set1_ps(2.0f);
+    __m128 tx = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qy, vz), _mm_mul_ps(qz, vy)));
+    __m128 ty = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qz, vx), _mm_mul_ps(qx, vz)));
+    __m128 tz = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qx, vy), _mm_mul_ps(qy, vx)));
+    vx = _mm_add_ps(vx, _mm_add_ps(_mm_mul_ps(qw, tx), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty))));
+    vy = _mm_add_ps(vy, _mm_add_ps(_mm_mul_ps(qw, ty), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz))));
+    vz = _mm_add_ps(vz, _mm_add_ps(_mm_mul_ps(qw, tz), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx))));
+}
+
+// r = normalize(a * b)
+static inline void multiplyQuatLanes(__m128 ax, __m128 ay, __m128 az, __m128 aw,
+                                     __m128 bx, __m128 by, __m128 bz, __m128 bw,
+                                     __m128& rx, __m128& ry, __m128& rz, __m128& rw) {
+    __m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)), _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+    __m128 y = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ax, bz)), _mm_add_ps(_mm_mul_ps(ay, bw), _mm_mul_ps(az, bx)));
+    __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(ax, by)), _mm_sub_ps(_mm_mul_ps(az, bw), _mm_mul_ps(ay, bx)));
+    __m128 w = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_add_ps(_mm_mul_ps(ay, by), _mm_mul_ps(az, bz)));
+
+    __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+    __m128 invLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSquared));
+    rx = _mm_mul_ps(x, invLength);
+    ry = _mm_mul_ps(y, invLength);
+    rz = _mm_mul_ps(z, invLength);
+    rw = _mm_mul_ps(w, invLength);
+}
+
+// c = p * c, assumes p has uniform scale
+static void composeLanes(const PoseLanes& p, PoseLanes& c) {
+    __m128 s = p.sx;
+
+    rotateLanes(p.rx, p.ry, p.rz, p.rw, c.tx, c.ty, c.tz);
+    c.tx = _mm_add_ps(p.tx, _mm_mul_ps(s, c.tx));
+    c.ty = _mm_add_ps(p.ty, _mm_mul_ps(s, c.ty));
+    c.tz = _mm_add_ps(p.tz, _mm_mul_ps(s, c.tz));
+
+    multiplyQuatLanes(p.rx, p.ry, p.rz, p.rw, c.rx, c.ry, c.rz, c.rw, c.rx, c.ry, c.rz, c.rw);
+
+    c.sx = _mm_mul_ps(s, c.sx);
+    c.sy = _mm_mul_ps(s, c.sy);
+    c.sz = _mm_mul_ps(s, c.sz);
+}
+
+// c = p.inverse() * c, assumes p has uniform scale
+static void composeInverseLanes(const PoseLanes& p, PoseLanes& c) {
+    __m128 invScale = _mm_div_ps(_mm_set1_ps(1.0f), p.sx);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 invRx = _mm_xor_ps(p.rx, signMask);
+    __m128 invRy = _mm_xor_ps(p.ry, signMask);
+    __m128 invRz = _mm_xor_ps(p.rz, signMask);
+
+    // trans = conjugate(p.rot) * (c.trans - p.trans) / p.scale
+    c.tx = _mm_mul_ps(invScale, _mm_sub_ps(c.tx, p.tx));
+    c.ty = _mm_mul_ps(invScale, _mm_sub_ps(c.ty, p.ty));
+    c.tz = _mm_mul_ps(invScale, _mm_sub_ps(c.tz, p.tz));
+    rotateLanes(invRx, invRy, invRz, p.rw, c.tx, c.ty, c.tz);
+
+    multiplyQuatLanes(invRx, invRy, invRz, p.rw, c.rx, c.ry, c.rz, c.rw, c.rx, c.ry, c.rz, c.rw);
+
+    c.sx = _mm_mul_ps(invScale, c.sx);
+    c.sy = _mm_mul_ps(invScale, c.sy);
+    c.sz = _mm_mul_ps(invScale, c.sz);
+}
+
+void AnimPoseBuffer::composeWithParents(const int* children, const int* parents, size_t count) {
+    float parentLanes[NumComponents][LANE_WIDTH];
+    float childLanes[NumComponents][LANE_WIDTH];
+    for (size_t i = 0; i < count; i += LANE_WIDTH) {
+        size_t n = std::min((size_t)LANE_WIDTH, count - i);
+        if (parentsHaveUniformScale(*this, parents + i, n)) {
+            gatherLanes(*this, parents + i, n, parentLanes);
+            gatherLanes(*this, children + i, n, childLanes);
+            PoseLanes p, c;
+            loadLanes(parentLanes, p);
+            loadLanes(childLanes, c);
+            composeLanes(p, c);
+            storeLanes(c, childLanes);
+            scatterLanes(*this, children + i, n, childLanes);
+        } else {
+            for (size_t k = i; k < i + n; k++) {
+                set(children[k], get(parents[k]) * get(children[k]));
+            }
+        }
+    }
+}
+
+void AnimPoseBuffer::composeWithInverseParents(const int* children, const int* parents, size_t count) {
+    float parentLanes[NumComponents][LANE_WIDTH];
+    float childLanes[NumComponents][LANE_WIDTH];
+    for (size_t i = 0; i < count; i += LANE_WIDTH) {
+        size_t n = std::min((size_t)LANE_WIDTH, count - i);
+        if (parentsHaveUniformScale(*this, parents + i, n)) {
+            gatherLanes(*this, parents + i, n, parentLanes);
+            gatherLanes(*this, children + i, n, childLanes);
+            PoseLanes p, c;
+            loadLanes(parentLanes, p);
+            loadLanes(childLanes, c);
+            composeInverseLanes(p, c);
+            storeLanes(c, childLanes);
+            scatterLanes(*this, children + i, n, childLanes);
+        } else {
+            for (size_t k = i; k < i + n; k++) {
+                set(children[k], get(parents[k]).inverse() * get(children[k]));
+            }
+        }
+    }
+}
+
+// flip the sign of every element in a stream
+static void negateStream(float* stream, size_t stride) {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    for (size_t i = 0; i < stride; i += AnimPoseBuffer::LANE_WIDTH) {
+        _mm_storeu_ps(&stream[i], _mm_xor_ps(_mm_loadu_ps(&stream[i]), signMask));
+    }
+}
+
+#else   // portable reference code
+
+void AnimPoseBuffer::composeWithParents(const int* children, const int* parents, size_t count) {
+    for (size_t k = 0; k < count; k++) {
+        set(children[k], get(parents[k]) * get(children[k]));
+    }
+}
+
+void AnimPoseBuffer::composeWithInverseParents(const int* children, const int* parents, size_t count) {
+    for (size_t k = 0; k < count; k++) {
+        set(children[k], get(parents[k]).inverse() * get(children[k]));
+    }
+}
+
+static void negateStream(float* stream, size_t stride) {
+    for (size_t i = 0; i < stride; i++) {
+        stream[i] = -stream[i];
+    }
+}
+
+#endif
+
+// mirror about x-axis without applying negative scale, see AnimPose::mirror()
+void AnimPoseBuffer::mirror(const std::vector<int>& mirrorMap) {
+    assert(mirrorMap.size() >= _size);
+
+    negateStream(getComponent(RotY), _stride);
+    negateStream(getComponent(RotZ), _stride);
+    negateStream(getComponent(TransX), _stride);
+
+    // swap left and right joints
+    _scratch.resize(_stride);
+    for (int c = 0; c < NumComponents; c++) {
+        float* stream = getComponent((Component)c);
+        std::copy(stream, stream + _size, _scratch.begin());
+        for (size_t i = 0; i < _size; i++) {
+            stream[mirrorMap[i]] = _scratch[i];
+        }
+    }
+}
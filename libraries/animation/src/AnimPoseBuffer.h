@@ -0,0 +1,77 @@
+//
+//  AnimPoseBuffer.h
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBuffer
+#define hifi_AnimPoseBuffer
+
+#include <vector>
+
+#include "AnimPose.h"
+
+// Structure-of-arrays storage for a set of poses.
+// Each component (scale.x, rot.w, trans.z, etc) is kept in its own contiguous float stream,
+// so that bulk operations such as blending and mirroring can be processed four joints at a time.
+// Streams are padded to a multiple of four with identity poses.
+class AnimPoseBuffer {
+public:
+    enum Component {
+        ScaleX = 0,
+        ScaleY,
+        ScaleZ,
+        RotX,
+        RotY,
+        RotZ,
+        RotW,
+        TransX,
+        TransY,
+        TransZ,
+        NumComponents
+    };
+
+    static const size_t LANE_WIDTH = 4;
+
+    AnimPoseBuffer() {}
+    explicit AnimPoseBuffer(size_t size) { resize(size); }
+    explicit AnimPoseBuffer(const AnimPoseVec& poses) { load(poses); }
+
+    void resize(size_t size);
+    size_t size() const { return _size; }
+
+    // number of floats in each component stream, always a multiple of LANE_WIDTH
+    size_t getStride() const { return _stride; }
+
+    float* getComponent(Component component) { return _data.data() + component * _stride; }
+    const float* getComponent(Component component) const { return _data.data() + component * _stride; }
+
+    AnimPose get(size_t index) const;
+    void set(size_t index, const AnimPose& pose);
+
+    // AoS <-> SoA conversion
+    void load(const AnimPoseVec& poses);
+    void store(AnimPoseVec& poses) const;
+
+    // for each k in [0, count): pose[children[k]] = pose[parents[k]] * pose[children[k]]
+    // no index in children may also appear in parents.
+    void composeWithParents(const int* children, const int* parents, size_t count);
+
+    // for each k in [0, count): pose[children[k]] = pose[parents[k]].inverse() * pose[children[k]]
+    // no index in children may also appear in parents.
+    void composeWithInverseParents(const int* children, const int* parents, size_t count);
+
+    // mirror about the x-axis and swap left/right joints, mirrorMap[i] is the destination of joint i.
+    void mirror(const std::vector<int>& mirrorMap);
+
+protected:
+    std::vector<float> _data;
+    std::vector<float> _scratch;
+    size_t _size { 0 };
+    size_t _stride { 0 };
+};
+
+#endif
@@ -10,6 +10,10 @@
 
 #include "AnimSkeleton.h"
 
+#include <assert.h>
+
+#include <QCryptographicHash>
+
 #include <glm/gtx/transform.hpp>
 
 #include <GLMHelpers.h>
@@ -120,6 +124,44 @@ void AnimSkeleton::mirrorAbsolutePoses(AnimPoseVec& poses) const {
     }
 }
 
+void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseBuffer& poses) const {
+    // poses start off relative and leave in absolute frame
+    if ((int)poses.size() < (int)_joints.size()) {
+        AnimPoseVec temp;
+        poses.store(temp);
+        convertRelativePosesToAbsolute(temp);
+        poses.load(temp);
+        return;
+    }
+    for (auto& level : _jointLevels) {
+        poses.composeWithParents(level.joints.data(), level.parents.data(), level.joints.size());
+    }
+}
+
+void AnimSkeleton::convertAbsolutePosesToRelative(AnimPoseBuffer& poses) const {
+    // poses start off absolute and leave in relative frame
+    if ((int)poses.size() < (int)_joints.size()) {
+        AnimPoseVec temp;
+        poses.store(temp);
+        convertAbsolutePosesToRelative(temp);
+        poses.load(temp);
+        return;
+    }
+    for (auto iter = _jointLevels.rbegin(); iter != _jointLevels.rend(); ++iter) {
+        poses.composeWithInverseParents(iter->joints.data(), iter->parents.data(), iter->joints.size());
+    }
+}
+
+void AnimSkeleton::mirrorRelativePoses(AnimPoseBuffer& poses) const {
+    convertRelativePosesToAbsolute(poses);
+    mirrorAbsolutePoses(poses);
+    convertAbsolutePosesToRelative(poses);
+}
+
+void AnimSkeleton::mirrorAbsolutePoses(AnimPoseBuffer& poses) const {
+    poses.mirror(_mirrorMap);
+}
+
 void AnimSkeleton::buildSkeletonFromJoints(const std::vector<FBXJoint>& joints) {
     _joints = joints;
 
@@ -193,6 +235,31 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<FBXJoint>& joints)
             _mirrorMap.push_back(i);
         }
     }
+
+    // group joints by depth, so that AnimPoseBuffer can convert a whole level at once.
+    std::vector<int> depths(_joints.size(), 0);
+    for (int i = 0; i < (int)_joints.size(); i++) {
+        int parentIndex = _joints[i].parentIndex;
+        if (parentIndex >= 0) {
+            assert(parentIndex < i);
+            depths[i] = depths[parentIndex] + 1;
+            if ((int)_jointLevels.size() < depths[i]) {
+                _jointLevels.resize(depths[i]);
+            }
+            JointLevel& level = _jointLevels[depths[i] - 1];
+            level.joints.push_back(i);
+            level.parents.push_back(parentIndex);
+        }
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (int i = 0; i < (int)_joints.size(); i++) {
+        hash.addData(_joints[i].name.toUtf8());
+        hash.addData((const char*)&_joints[i].parentIndex, sizeof(int));
+        hash.addData((const char*)&_relativeDefaultPoses[i], sizeof(AnimPose));
+        hash.addData((const char*)&_relativeBindPoses[i], sizeof(AnimPose));
+    }
+    _fingerprint = hash.result();
 }
 
 #ifndef NDEBUG
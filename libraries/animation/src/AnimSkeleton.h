@@ -17,6 +17,7 @@
 
 #include <FBXReader.h>
 #include "AnimPose.h"
+#include "AnimPoseBuffer.h"
 
 class AnimSkeleton {
 public:
@@ -50,6 +51,10 @@ public:
 
     int getParentIndex(int jointIndex) const;
 
+    // hash of the joint names, hierarchy and default & bind poses.
+    // skeletons with equal fingerprints will produce identical animation clips.
+    const QByteArray& getFingerprint() const { return _fingerprint; }
+
     AnimPose getAbsolutePose(int jointIndex, const AnimPoseVec& poses) const;
 
     void convertRelativePosesToAbsolute(AnimPoseVec& poses) const;
@@ -58,6 +63,13 @@ public:
     void mirrorRelativePoses(AnimPoseVec& poses) const;
     void mirrorAbsolutePoses(AnimPoseVec& poses) const;
 
+    // structure-of-arrays versions of the above, joints at the same depth are processed four at a time.
+    void convertRelativePosesToAbsolute(AnimPoseBuffer& poses) const;
+    void convertAbsolutePosesToRelative(AnimPoseBuffer& poses) const;
+
+    void mirrorRelativePoses(AnimPoseBuffer& poses) const;
+    void mirrorAbsolutePoses(AnimPoseBuffer& poses) const;
+
 #ifndef NDEBUG
     void dump() const;
     void dump(const AnimPoseVec& poses) const;
@@ -75,6 +87,15 @@ protected:
     AnimPoseVec _relativePostRotationPoses;
     std::vector<int> _mirrorMap;
 
+    // non-root joints grouped by depth in the hierarchy, parents are always in an earlier level than their children.
+    struct JointLevel {
+        std::vector<int> joints;
+        std::vector<int> parents;
+    };
+    std::vector<JointLevel> _jointLevels;
+
+    QByteArray _fingerprint;
+
     // no copies
     AnimSkeleton(const AnimSkeleton&) = delete;
     AnimSkeleton& operator=(const AnimSkeleton&) = delete;
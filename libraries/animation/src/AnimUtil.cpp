@@ -11,8 +11,10 @@
 #include "AnimUtil.h"
 #include "GLMHelpers.h"
 
+#include <assert.h>
+
 // TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
+// NOTE: see the AnimPoseBuffer overload below for a simd version.
 
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
@@ -33,6 +35,100 @@ void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, A
     }
 }
 
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static void lerpStream(const float* a, const float* b, __m128 alpha, float* result, size_t stride) {
+    for (size_t i = 0; i < stride; i += AnimPoseBuffer::LANE_WIDTH) {
+        __m128 x = _mm_loadu_ps(&a[i]);
+        __m128 y = _mm_loadu_ps(&b[i]);
+        _mm_storeu_ps(&result[i], _mm_add_ps(x, _mm_mul_ps(alpha, _mm_sub_ps(y, x))));
+    }
+}
+
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    size_t stride = a.getStride();
+    __m128 alphaLanes = _mm_set1_ps(alpha);
+
+    lerpStream(a.getComponent(AnimPoseBuffer::ScaleX), b.getComponent(AnimPoseBuffer::ScaleX), alphaLanes, result.getComponent(AnimPoseBuffer::ScaleX), stride);
+    lerpStream(a.getComponent(AnimPoseBuffer::ScaleY), b.getComponent(AnimPoseBuffer::ScaleY), alphaLanes, result.getComponent(AnimPoseBuffer::ScaleY), stride);
+    lerpStream(a.getComponent(AnimPoseBuffer::ScaleZ), b.getComponent(AnimPoseBuffer::ScaleZ), alphaLanes, result.getComponent(AnimPoseBuffer::ScaleZ), stride);
+    lerpStream(a.getComponent(AnimPoseBuffer::TransX), b.getComponent(AnimPoseBuffer::TransX), alphaLanes, result.getComponent(AnimPoseBuffer::TransX), stride);
+    lerpStream(a.getComponent(AnimPoseBuffer::TransY), b.getComponent(AnimPoseBuffer::TransY), alphaLanes, result.getComponent(AnimPoseBuffer::TransY), stride);
+    lerpStream(a.getComponent(AnimPoseBuffer::TransZ), b.getComponent(AnimPoseBuffer::TransZ), alphaLanes, result.getComponent(AnimPoseBuffer::TransZ), stride);
+
+    const float* ax = a.getComponent(AnimPoseBuffer::RotX);
+    const float* ay = a.getComponent(AnimPoseBuffer::RotY);
+    const float* az = a.getComponent(AnimPoseBuffer::RotZ);
+    const float* aw = a.getComponent(AnimPoseBuffer::RotW);
+    const float* bx = b.getComponent(AnimPoseBuffer::RotX);
+    const float* by = b.getComponent(AnimPoseBuffer::RotY);
+    const float* bz = b.getComponent(AnimPoseBuffer::RotZ);
+    const float* bw = b.getComponent(AnimPoseBuffer::RotW);
+    float* rx = result.getComponent(AnimPoseBuffer::RotX);
+    float* ry = result.getComponent(AnimPoseBuffer::RotY);
+    float* rz = result.getComponent(AnimPoseBuffer::RotZ);
+    float* rw = result.getComponent(AnimPoseBuffer::RotW);
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    for (size_t i = 0; i < stride; i += AnimPoseBuffer::LANE_WIDTH) {
+        __m128 x1 = _mm_loadu_ps(&ax[i]);
+        __m128 y1 = _mm_loadu_ps(&ay[i]);
+        __m128 z1 = _mm_loadu_ps(&az[i]);
+        __m128 w1 = _mm_loadu_ps(&aw[i]);
+        __m128 x2 = _mm_loadu_ps(&bx[i]);
+        __m128 y2 = _mm_loadu_ps(&by[i]);
+        __m128 z2 = _mm_loadu_ps(&bz[i]);
+        __m128 w2 = _mm_loadu_ps(&bw[i]);
+
+        // adjust signs if necessary
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x1, x2), _mm_mul_ps(y1, y2)), _mm_add_ps(_mm_mul_ps(z1, z2), _mm_mul_ps(w1, w2)));
+        __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, zero), signMask);
+        x2 = _mm_xor_ps(x2, flip);
+        y2 = _mm_xor_ps(y2, flip);
+        z2 = _mm_xor_ps(z2, flip);
+        w2 = _mm_xor_ps(w2, flip);
+
+        __m128 x = _mm_add_ps(x1, _mm_mul_ps(alphaLanes, _mm_sub_ps(x2, x1)));
+        __m128 y = _mm_add_ps(y1, _mm_mul_ps(alphaLanes, _mm_sub_ps(y2, y1)));
+        __m128 z = _mm_add_ps(z1, _mm_mul_ps(alphaLanes, _mm_sub_ps(z2, z1)));
+        __m128 w = _mm_add_ps(w1, _mm_mul_ps(alphaLanes, _mm_sub_ps(w2, w1)));
+
+        // normalize
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+        __m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(lengthSquared));
+        _mm_storeu_ps(&rx[i], _mm_mul_ps(x, invLength));
+        _mm_storeu_ps(&ry[i], _mm_mul_ps(y, invLength));
+        _mm_storeu_ps(&rz[i], _mm_mul_ps(z, invLength));
+        _mm_storeu_ps(&rw[i], _mm_mul_ps(w, invLength));
+    }
+}
+
+#else   // portable reference code
+
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        AnimPose pose;
+        AnimPose aPose = a.get(i);
+        AnimPose bPose = b.get(i);
+        blend(1, &aPose, &bPose, alpha, &pose);
+        result.set(i, pose);
+    }
+}
+
+#endif
+
 float accumulateTime(float startFrame, float endFrame, float timeScale, float currentFrame, float dt, bool loopFlag,
                      const QString& id, AnimNode::Triggers& triggersOut) {
 
@@ -12,10 +12,14 @@
 #define hifi_AnimUtil_h
 
 #include "AnimNode.h"
+#include "AnimPoseBuffer.h"
 
 // this is where the magic happens
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result);
 
+// same as above, but operates on four joints at a time.
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result);
+
 float accumulateTime(float startFrame, float endFrame, float timeScale, float currentFrame, float dt, bool loopFlag,
                      const QString& id, AnimNode::Triggers& triggersOut);
 
@@ -0,0 +1,129 @@
+//
+//  BlendshapeEngine.cpp
+//  libraries/animation/src/
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BlendshapeEngine.h"
+
+#include <cstring>
+
+#include <QMutexLocker>
+
+#include <shared/NsightHelpers.h>
+
+const float BlendshapeEngine::COEFFICIENT_EPSILON = 0.0001f;
+const float BlendshapeEngine::NORMAL_COEFFICIENT_SCALE = 0.01f;
+const int BlendshapeEngine::MAX_INCREMENTAL_BLENDS = 256;
+
+BlendshapeEngine::BlendshapeEngine(std::shared_ptr<const PackedBlendshapes> blendshapes) :
+    _blendshapes(blendshapes) {
+}
+
+BlendshapeEngine::BlendshapeEngine(const QVector<FBXMesh>& meshes) :
+    _blendshapes(std::make_shared<PackedBlendshapes>(meshes)) {
+}
+
+size_t BlendshapeEngine::getMemoryUsage() const {
+    size_t outputSize = 0;
+    for (const auto& output : _outputs) {
+        outputSize += (output.vertices.capacity() + output.normals.capacity()) * sizeof(glm::vec3) +
+            output.coefficients.capacity() * sizeof(float);
+    }
+    return _blendshapes->getMemoryUsage() + outputSize;
+}
+
+void BlendshapeEngine::reset(Output& output) const {
+    // the extra element lets the 4 wide kernel read and write the last vertex
+    int numVertices = _blendshapes->numVertices;
+    output.vertices.resize(numVertices + 1);
+    output.normals.resize(numVertices + 1);
+    memcpy(output.vertices.data(), _blendshapes->baseVertices.constData(), numVertices * sizeof(glm::vec3));
+    memcpy(output.normals.data(), _blendshapes->baseNormals.constData(), numVertices * sizeof(glm::vec3));
+    output.vertices[numVertices] = glm::vec3();
+    output.normals[numVertices] = glm::vec3();
+    output.coefficients.assign(_blendshapes->blendshapes.size(), 0.0f);
+    output.numIncrementalBlends = 0;
+    output.isValid = true;
+}
+
+// on x86 architecture, assume that SSE2 is present
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+// adds coefficient * delta to each indexed element.  Each update reads and writes 4 floats, the x of the
+// following element has 0 added to it.
+static void applyDeltas(const int* indices, const glm::vec4* deltas, int numDeltas, float coefficient, glm::vec3* output) {
+    float* out = (float*)output;
+    __m128 scale = _mm_set1_ps(coefficient);
+    for (int i = 0; i < numDeltas; i++) {
+        float* element = out + 3 * indices[i];
+        __m128 delta = _mm_mul_ps(_mm_loadu_ps((const float*)&deltas[i]), scale);
+        _mm_storeu_ps(element, _mm_add_ps(_mm_loadu_ps(element), delta));
+    }
+}
+
+#else
+
+static void applyDeltas(const int* indices, const glm::vec4* deltas, int numDeltas, float coefficient, glm::vec3* output) {
+    for (int i = 0; i < numDeltas; i++) {
+        output[indices[i]] += glm::vec3(deltas[i]) * coefficient;
+    }
+}
+
+#endif
+
+void BlendshapeEngine::blend(const QVector<float>& coefficients, QVector<glm::vec3>& vertices, QVector<glm::vec3>& normals) {
+    PROFILE_RANGE(__FUNCTION__);
+    QMutexLocker locker(&_mutex);
+
+    Output& output = _outputs[_nextOutput];
+    _nextOutput = 1 - _nextOutput;
+    if (!output.isValid || output.numIncrementalBlends >= MAX_INCREMENTAL_BLENDS) {
+        reset(output);
+    } else {
+        output.numIncrementalBlends++;
+    }
+
+    // detaches only if the caller still holds the copies from two blends ago
+    glm::vec3* outputVertices = output.vertices.data();
+    glm::vec3* outputNormals = output.normals.data();
+
+    int numBlendshapesApplied = 0;
+    int numDeltasApplied = 0;
+    const PackedBlendshapes& packed = *_blendshapes;
+    for (size_t i = 0; i < packed.blendshapes.size(); i++) {
+        const PackedBlendshapes::Blendshape& blendshape = packed.blendshapes[i];
+        float coefficient = 0.0f;
+        if (blendshape.coefficientIndex < coefficients.size()) {
+            coefficient = coefficients.at(blendshape.coefficientIndex);
+            if (coefficient < COEFFICIENT_EPSILON) {
+                coefficient = 0.0f;
+            }
+        }
+
+        float change = coefficient - output.coefficients[i];
+        if (change == 0.0f) {
+            continue;
+        }
+        output.coefficients[i] = coefficient;
+
+        const int* indices = packed.indices.data() + blendshape.firstDelta;
+        applyDeltas(indices, packed.vertexDeltas.data() + blendshape.firstDelta, blendshape.numDeltas, change,
+                    outputVertices);
+        applyDeltas(indices, packed.normalDeltas.data() + blendshape.firstDelta, blendshape.numDeltas,
+                    change * NORMAL_COEFFICIENT_SCALE, outputNormals);
+        numBlendshapesApplied++;
+        numDeltasApplied += blendshape.numDeltas;
+    }
+
+    vertices = output.vertices;
+    normals = output.normals;
+    _lastNumBlendshapesApplied = numBlendshapesApplied;
+    _lastNumDeltasApplied = numDeltasApplied;
+}
@@ -0,0 +1,81 @@
+//
+//  BlendshapeEngine.h
+//  libraries/animation/src/
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BlendshapeEngine_h
+#define hifi_BlendshapeEngine_h
+
+#include <memory>
+#include <vector>
+
+#include <QMutex>
+#include <QVector>
+
+#include <glm/glm.hpp>
+
+#include <FBXReader.h>
+#include <PackedBlendshapes.h>
+
+// Applies blendshape coefficients to the meshes of a model, for use from the Blender jobs.
+//
+// The blendshapes come packed, and are shared with the other models of the same geometry; what an engine owns
+// is its model's output. Blends are written into one of two output buffers in turn, and each buffer remembers
+// the coefficients it was blended with, so a blend only applies the difference for blendshapes whose
+// coefficient changed since that buffer was last written.
+//
+// The outputs hold the vertices and normals of the blended meshes back to back, in mesh order, followed by
+// one unused element.
+class BlendshapeEngine {
+public:
+    // below this a coefficient counts as zero
+    static const float COEFFICIENT_EPSILON;
+
+    // normals move less than vertices for the same coefficient
+    static const float NORMAL_COEFFICIENT_SCALE;
+
+    // every so many blends a buffer is rebuilt from the base mesh, so rounding errors can't build up
+    static const int MAX_INCREMENTAL_BLENDS;
+
+    explicit BlendshapeEngine(std::shared_ptr<const PackedBlendshapes> blendshapes);
+    explicit BlendshapeEngine(const QVector<FBXMesh>& meshes);
+
+    // Thread safe. Blends into the next output buffer and returns shared copies of it, which don't need to be
+    // released before the next call but should be by the one after, otherwise that one has to copy the buffer.
+    void blend(const QVector<float>& coefficients, QVector<glm::vec3>& vertices, QVector<glm::vec3>& normals);
+
+    int getNumVertices() const { return _blendshapes->numVertices; }
+    int getNumBlendshapes() const { return (int)_blendshapes->blendshapes.size(); }
+    size_t getMemoryUsage() const; // including the shared blendshapes
+
+    // stats from the most recent blend
+    int getLastNumBlendshapesApplied() const { return _lastNumBlendshapesApplied; }
+    int getLastNumDeltasApplied() const { return _lastNumDeltasApplied; }
+
+protected:
+    struct Output {
+        QVector<glm::vec3> vertices;
+        QVector<glm::vec3> normals;
+        std::vector<float> coefficients;  // per packed blendshape
+        int numIncrementalBlends { 0 };
+        bool isValid { false };
+    };
+
+    void reset(Output& output) const;
+
+    const std::shared_ptr<const PackedBlendshapes> _blendshapes;
+
+    QMutex _mutex;
+    Output _outputs[2];
+    int _nextOutput { 0 };
+
+    int _lastNumBlendshapesApplied { 0 };
+    int _lastNumDeltasApplied { 0 };
+};
+
+#endif // hifi_BlendshapeEngine_h
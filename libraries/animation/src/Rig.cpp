@@ -852,15 +852,24 @@ void Rig::updateAnimationStateHandlers() { // called on avatar update thread (wh
 }
 
 void Rig::updateAnimations(float deltaTime, glm::mat4 rootTransform) {
+    prepareAnimations(deltaTime, rootTransform);
+    evaluateAnimations(deltaTime);
+}
 
-    PROFILE_RANGE_EX(__FUNCTION__, 0xffff00ff, 0);
-
+void Rig::prepareAnimations(float deltaTime, glm::mat4 rootTransform) {
     setModelOffset(rootTransform);
 
     if (_animNode) {
-
         updateAnimationStateHandlers();
         _animVars.setRigToGeometryTransform(_rigToGeometryTransform);
+    }
+}
+
+void Rig::evaluateAnimations(float deltaTime) {
+
+    PROFILE_RANGE_EX(__FUNCTION__, 0xffff00ff, 0);
+
+    if (_animNode) {
 
         // evaluate the animation
         AnimNode::Triggers triggersOut;
@@ -155,8 +155,16 @@ public:
     void computeMotionAnimationState(float deltaTime, const glm::vec3& worldPosition, const glm::vec3& worldVelocity, const glm::quat& worldRotation, CharacterControllerState ccState);
 
     // Regardless of who started the animations or how many, update the joints.
+    // same as prepareAnimations() followed by evaluateAnimations().
     void updateAnimations(float deltaTime, glm::mat4 rootTransform);
 
+    // main thread only: sets the root transform and runs the script state handlers.
+    void prepareAnimations(float deltaTime, glm::mat4 rootTransform);
+
+    // evaluates the anim graph, IK and absolute poses.  Does not touch any script or shared state,
+    // so different rigs may be evaluated concurrently on worker threads, see RigJobQueue.
+    void evaluateAnimations(float deltaTime);
+
     // legacy
     void inverseKinematics(int endIndex, glm::vec3 targetPosition, const glm::quat& targetRotation, float priority,
                            const QVector<int>& freeLineage, glm::mat4 rootTransform);
@@ -0,0 +1,99 @@
+//
+//  RigJobQueue.cpp
+//  libraries/animation/src/
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RigJobQueue.h"
+
+#include <atomic>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <SharedUtil.h>
+#include <shared/NsightHelpers.h>
+
+// don't bother waking a worker for fewer rigs than this.
+static const int MIN_JOBS_PER_WORKER = 2;
+
+// shared between the queue and its workers, so that a worker which starts late never touches a finished batch.
+struct RigJobQueue::Batch {
+    std::vector<Job> jobs;
+    std::atomic<int> nextJob { 0 };
+    std::atomic<int> remainingJobs { 0 };
+    QMutex mutex;
+    QWaitCondition finished;
+
+    // evaluate jobs until there are none left to claim.
+    void run() {
+        int numJobs = (int)jobs.size();
+        int index = nextJob++;
+        while (index < numJobs) {
+            jobs[index].rig->evaluateAnimations(jobs[index].deltaTime);
+            if (--remainingJobs == 0) {
+                QMutexLocker locker(&mutex);
+                finished.wakeAll();
+            }
+            index = nextJob++;
+        }
+    }
+};
+
+class RigJobWorker : public QRunnable {
+public:
+    RigJobWorker(std::shared_ptr<RigJobQueue::Batch> batch) : _batch(batch) {}
+    virtual void run() override { _batch->run(); }
+private:
+    std::shared_ptr<RigJobQueue::Batch> _batch;
+};
+
+RigJobQueue::RigJobQueue(int numThreads) {
+    if (numThreads <= 0) {
+        numThreads = std::max(1, QThread::idealThreadCount() - 1);
+    }
+    _threadPool.setMaxThreadCount(numThreads);
+}
+
+RigJobQueue::~RigJobQueue() {
+    _threadPool.waitForDone();
+}
+
+void RigJobQueue::push(RigPointer rig, float deltaTime, const glm::mat4& rootTransform) {
+    rig->prepareAnimations(deltaTime, rootTransform);
+    _jobs.push_back({ rig, deltaTime });
+}
+
+void RigJobQueue::evaluate() {
+    PROFILE_RANGE(__FUNCTION__);
+    quint64 start = usecTimestampNow();
+
+    auto batch = std::make_shared<Batch>();
+    batch->jobs.swap(_jobs);
+    int numJobs = (int)batch->jobs.size();
+    batch->remainingJobs = numJobs;
+
+    int numWorkers = std::min(_threadPool.maxThreadCount(), numJobs / MIN_JOBS_PER_WORKER);
+    for (int i = 0; i < numWorkers; i++) {
+        _threadPool.start(new RigJobWorker(batch));
+    }
+
+    // help out on this thread, then wait for any rigs still being evaluated by workers.
+    batch->run();
+    {
+        QMutexLocker locker(&batch->mutex);
+        while (batch->remainingJobs > 0) {
+            batch->finished.wait(&batch->mutex);
+        }
+    }
+
+    _lastNumEvaluated = numJobs;
+    _lastEvaluateUsecs = usecTimestampNow() - start;
+}
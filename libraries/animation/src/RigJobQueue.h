@@ -0,0 +1,60 @@
+//
+//  RigJobQueue.h
+//  libraries/animation/src/
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RigJobQueue_h
+#define hifi_RigJobQueue_h
+
+#include <memory>
+#include <vector>
+
+#include <QThreadPool>
+
+#include "Rig.h"
+
+// Evaluates the animation of many independent rigs in parallel.
+//
+// Usage, once per frame on the main thread:
+//    queue.push(rig, deltaTime, rootTransform);  // for every avatar, runs Rig::prepareAnimations immediately
+//    ...
+//    queue.evaluate();  // sync point: returns once every queued rig has been evaluated.
+//
+// Joint data must not be read from a queued rig until evaluate() returns.  The calling thread
+// also evaluates rigs, so evaluate() makes progress even if every worker is busy.
+class RigJobQueue {
+public:
+    // numThreads <= 0 uses one less than the ideal thread count, leaving a core for the calling thread.
+    explicit RigJobQueue(int numThreads = 0);
+    ~RigJobQueue();
+
+    void push(RigPointer rig, float deltaTime, const glm::mat4& rootTransform);
+    void evaluate();
+
+    int getNumQueued() const { return (int)_jobs.size(); }
+    int getNumThreads() const { return _threadPool.maxThreadCount(); }
+
+    // stats from the most recent call to evaluate()
+    int getLastNumEvaluated() const { return _lastNumEvaluated; }
+    quint64 getLastEvaluateUsecs() const { return _lastEvaluateUsecs; }
+
+    struct Job {
+        RigPointer rig;
+        float deltaTime;
+    };
+
+    struct Batch;
+
+private:
+    QThreadPool _threadPool;
+    std::vector<Job> _jobs;
+    int _lastNumEvaluated { 0 };
+    quint64 _lastEvaluateUsecs { 0 };
+};
+
+#endif // hifi_RigJobQueue_h
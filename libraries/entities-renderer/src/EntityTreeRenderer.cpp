@@ -9,6 +9,9 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
+#include <glm/gtx/norm.hpp>
 #include <glm/gtx/quaternion.hpp>
 
 #include <QEventLoop>
@@ -22,6 +25,7 @@
 #include <PerfStat.h>
 #include <SceneScriptingInterface.h>
 #include <ScriptEngine.h>
+#include <SettingHandle.h>
 #include <procedural/ProceduralSkybox.h>
 
 #include "EntityTreeRenderer.h"
@@ -43,11 +47,18 @@
 #include "AddressManager.h"
 #include <Rig.h>
 
+static const int DEFAULT_ENTITY_SCRIPT_ENGINE_COUNT = 1;
+Setting::Handle<int> entityScriptEngineCount("entityScriptEngineCount", DEFAULT_ENTITY_SCRIPT_ENGINE_COUNT);
+
+// the entities that could contain the avatar are found for this far around it at once
+static const float CONTAINMENT_QUERY_RADIUS = 2.0f; // meters
+// and found again at least this often, to catch entities that moved in without being edited
+static const quint64 CONTAINMENT_REFRESH_PERIOD = USECS_PER_SECOND;
+
 EntityTreeRenderer::EntityTreeRenderer(bool wantScripts, AbstractViewStateInterface* viewState,
                                             AbstractScriptingServicesInterface* scriptingServices) :
     OctreeRenderer(),
     _wantScripts(wantScripts),
-    _entitiesScriptEngine(NULL),
     _lastMouseEventValid(false),
     _viewState(viewState),
     _scriptingServices(scriptingServices),
@@ -71,8 +82,12 @@ EntityTreeRenderer::EntityTreeRenderer(bool wantScripts, AbstractViewStateInterf
 }
 
 EntityTreeRenderer::~EntityTreeRenderer() {
-    // NOTE: we don't need to delete _entitiesScriptEngine because it is registered with the application and has a
-    // signal tied to call it's deleteLater on doneRunning
+    // NOTE: we don't need to delete the engines of _entitiesScriptEngine because they are registered with the
+    // application and have a signal tied to call their deleteLater on doneRunning
+    auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    if (_entitiesScriptEngine && entityScriptingInterface) {
+        entityScriptingInterface->setEntitiesScriptEngine(nullptr);
+    }
 }
 
 void EntityTreeRenderer::clear() {
@@ -105,13 +120,16 @@ void EntityTreeRenderer::init() {
     entityTree->setFBXService(this);
 
     if (_wantScripts) {
-        _entitiesScriptEngine = new ScriptEngine(NO_SCRIPT, "Entities");
-        _scriptingServices->registerScriptEngineWithApplicationServices(_entitiesScriptEngine);
-        _entitiesScriptEngine->runInThread();
-        DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(_entitiesScriptEngine);
+        // with more than one engine, entity scripts are spread over that many threads
+        _entitiesScriptEngine.reset(new EntityScriptEnginePool(entityScriptEngineCount.get(), [this](ScriptEngine* engine) {
+            _scriptingServices->registerScriptEngineWithApplicationServices(engine);
+            engine->runInThread();
+        }));
+        DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(_entitiesScriptEngine.get());
     }
 
     forceRecheckEntities(); // setup our state to force checking our inside/outsideness of entities
+    entityTree->setCollectChangedBounds(true);
 
     connect(entityTree.get(), &EntityTree::deletingEntity, this, &EntityTreeRenderer::deletingEntity, Qt::QueuedConnection);
     connect(entityTree.get(), &EntityTree::addingEntity, this, &EntityTreeRenderer::addingEntity, Qt::QueuedConnection);
@@ -127,21 +145,23 @@ void EntityTreeRenderer::shutdown() {
 void EntityTreeRenderer::setTree(OctreePointer newTree) {
     OctreeRenderer::setTree(newTree);
     std::static_pointer_cast<EntityTree>(_tree)->setFBXService(this);
+    std::static_pointer_cast<EntityTree>(_tree)->setCollectChangedBounds(true);
 }
 
 void EntityTreeRenderer::update() {
     if (_tree && !_shuttingDown) {
         EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
         tree->update();
+        checkChangedBounds(tree->takeEntitiesWithChangedBounds());
 
         // Handle enter/leave entity logic
         bool updated = checkEnterLeaveEntities();
 
-        // If we haven't already updated and previously attempted to load a texture,
-        // check if the texture loaded and apply it
-        if (!updated && (
+        // The zone is applied here, outside of the tree lock, whether it changed or we previously attempted
+        // to load a texture that has now loaded
+        if (updated ||
             (_pendingSkyboxTexture && (!_skyboxTexture || _skyboxTexture->isLoaded())) ||
-            (_pendingAmbientTexture && (!_ambientTexture || _ambientTexture->isLoaded())))) {
+            (_pendingAmbientTexture && (!_ambientTexture || _ambientTexture->isLoaded()))) {
             applyZonePropertiesToScene(_bestZone);
         }
 
@@ -157,24 +177,51 @@ void EntityTreeRenderer::update() {
     deleteReleasedModels();
 }
 
-bool EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(const glm::vec3& avatarPosition, QVector<EntityItemID>* entitiesContainingAvatar) {
-    bool didUpdate = false;
-    float radius = 1.0f; // for now, assume 1 meter radius
-    QVector<EntityItemPointer> foundEntities;
+void EntityTreeRenderer::findContainmentCandidates(const glm::vec3& avatarPosition) {
+    // the tree keeps its spatial index between our queries, so while entities aren't being added, deleted or
+    // moved between elements this doesn't walk the tree
+    QVector<EntitySpatialQuery> queries { EntitySpatialQuery::sphere(avatarPosition, CONTAINMENT_QUERY_RADIUS) };
+    QVector<EntitySpatialQueryResult> results;
 
     // find the entities near us
     // don't let someone else change our tree while we search
     _tree->withReadLock([&] {
-        std::static_pointer_cast<EntityTree>(_tree)->findEntities(avatarPosition, radius, foundEntities);
+        std::static_pointer_cast<EntityTree>(_tree)->findEntities(queries, results);
+
+        _containmentCandidates.clear();
+        foreach(EntityItemPointer entity, results.front().entities) {
+            bool success;
+            AABox bounds = entity->getAABox(success);
+            if (success) {
+                _containmentCandidates.push_back({ entity, entity->getEntityItemID(), bounds });
+            }
+        }
+    });
+    _containmentQueryCenter = avatarPosition;
+    _nextContainmentRefresh = usecTimestampNow() + CONTAINMENT_REFRESH_PERIOD;
+}
 
-        // Whenever you're in an intersection between zones, we will always choose the smallest zone.
-        auto oldBestZone = _bestZone;
-        _bestZone = nullptr; // NOTE: Is this what we want?
-        _bestZoneVolume = std::numeric_limits<float>::max();
+bool EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(const glm::vec3& avatarPosition, QVector<EntityItemID>* entitiesContainingAvatar) {
+    // Whenever you're in an intersection between zones, we will always choose the smallest zone.
+    auto oldBestZone = _bestZone;
+    _bestZone = nullptr; // NOTE: Is this what we want?
+    _bestZoneVolume = std::numeric_limits<float>::max();
 
+    // only the candidates whose bounds hold the avatar can contain it, if there are none we needn't lock the tree
+    bool anyBoundsContainAvatar = std::any_of(_containmentCandidates.begin(), _containmentCandidates.end(),
+        [&](const ContainmentCandidate& candidate) { return candidate.bounds.contains(avatarPosition); });
+    if (!anyBoundsContainAvatar) {
+        return _bestZone != oldBestZone;
+    }
+
+    _tree->withReadLock([&] {
         // create a list of entities that actually contain the avatar's position
-        foreach(EntityItemPointer entity, foundEntities) {
-            if (entity->contains(avatarPosition)) {
+        for (auto& candidate : _containmentCandidates) {
+            if (!candidate.bounds.contains(avatarPosition)) {
+                continue;
+            }
+            EntityItemPointer entity = candidate.entity.lock();
+            if (entity && entity->contains(avatarPosition)) {
                 if (entitiesContainingAvatar) {
                     *entitiesContainingAvatar << entity->getEntityItemID();
                 }
@@ -209,21 +256,29 @@ bool EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(const glm::vec3&
                 }
             }
         }
-
-        if (_bestZone != oldBestZone) {
-            applyZonePropertiesToScene(_bestZone);
-            didUpdate = true;
-        }
     });
-    return didUpdate;
+
+    // the caller applies the new zone to the scene once the tree is unlocked
+    return _bestZone != oldBestZone;
 }
+
 bool EntityTreeRenderer::checkEnterLeaveEntities() {
     bool didUpdate = false;
 
     if (_tree && !_shuttingDown) {
         glm::vec3 avatarPosition = _viewState->getAvatarPosition();
 
-        if (avatarPosition != _lastAvatarPosition) {
+        // the cached candidates are good until the avatar leaves the region they were found for, or something
+        // near it is added, deleted or changed
+        bool candidatesChanged = false;
+        if (_containmentDirty.exchange(false) || usecTimestampNow() > _nextContainmentRefresh ||
+                glm::distance2(avatarPosition, _containmentQueryCenter) >
+                    CONTAINMENT_QUERY_RADIUS * CONTAINMENT_QUERY_RADIUS) {
+            findContainmentCandidates(avatarPosition);
+            candidatesChanged = true;
+        }
+
+        if (candidatesChanged || avatarPosition != _lastAvatarPosition) {
             QVector<EntityItemID> entitiesContainingAvatar;
             didUpdate = findBestZoneAndMaybeContainingEntities(avatarPosition, &entitiesContainingAvatar);
             
@@ -248,8 +303,11 @@ bool EntityTreeRenderer::checkEnterLeaveEntities() {
             }
             _currentEntitiesInside = entitiesContainingAvatar;
             _lastAvatarPosition = avatarPosition;
-        } else {
-            didUpdate = findBestZoneAndMaybeContainingEntities(avatarPosition, nullptr);
+        }
+
+        // a changed zone's properties need applying again even if it is still the best one
+        if (_zoneChanged.exchange(false) && _bestZone) {
+            didUpdate = true;
         }
     }
     return didUpdate;
@@ -269,9 +327,8 @@ void EntityTreeRenderer::leaveAllEntities() {
 }
 
 void EntityTreeRenderer::forceRecheckEntities() {
-    // make sure our "last avatar position" is something other than our current position, 
-    // so that on our next chance, we'll check for enter/leave entity events.
-    _lastAvatarPosition = _viewState->getAvatarPosition() + glm::vec3((float)TREE_SCALE);
+    // make sure we find the entities around us again on our next chance, and check for enter/leave entity events.
+    _containmentDirty = true;
 }
 
 
@@ -694,7 +751,11 @@ void EntityTreeRenderer::deletingEntity(const EntityItemID& entityID) {
         _entitiesScriptEngine->unloadEntityScript(entityID);
     }
 
-    forceRecheckEntities(); // reset our state to force checking our inside/outsideness of entities
+    // only an entity that might contain us can change our inside/outsideness of entities
+    if (std::any_of(_containmentCandidates.begin(), _containmentCandidates.end(),
+            [&](const ContainmentCandidate& candidate) { return candidate.id == entityID; })) {
+        forceRecheckEntities();
+    }
 
     // here's where we remove the entity payload from the scene
     if (_entitiesInScene.contains(entityID)) {
@@ -707,14 +768,42 @@ void EntityTreeRenderer::deletingEntity(const EntityItemID& entityID) {
 }
 
 void EntityTreeRenderer::addingEntity(const EntityItemID& entityID) {
-    forceRecheckEntities(); // reset our state to force checking our inside/outsideness of entities
     checkAndCallPreload(entityID);
     auto entity = std::static_pointer_cast<EntityTree>(_tree)->findEntityByID(entityID);
     if (entity) {
+        // only an entity added near us can change our inside/outsideness of entities
+        bool success;
+        AABox bounds = entity->getAABox(success);
+        if (!success || bounds.touchesSphere(_containmentQueryCenter, CONTAINMENT_QUERY_RADIUS)) {
+            forceRecheckEntities();
+        }
         addEntityToScene(entity);
     }
 }
 
+void EntityTreeRenderer::checkChangedBounds(const QSet<EntityItemID>& entityIDs) {
+    // moving out of our way counts as much as moving into it, so look at where it was as well as where it is now
+    for (const auto& candidate : _containmentCandidates) {
+        if (entityIDs.contains(candidate.id)) {
+            forceRecheckEntities();
+            return;
+        }
+    }
+
+    auto tree = std::static_pointer_cast<EntityTree>(_tree);
+    for (const auto& entityID : entityIDs) {
+        auto entity = tree->findEntityByID(entityID);
+        if (entity) {
+            bool success;
+            AABox bounds = entity->getAABox(success);
+            if (!success || bounds.touchesSphere(_containmentQueryCenter, CONTAINMENT_QUERY_RADIUS)) {
+                forceRecheckEntities();
+                return;
+            }
+        }
+    }
+}
+
 void EntityTreeRenderer::addEntityToScene(EntityItemPointer entity) {
     // here's where we add the entity payload to the scene
     render::PendingChanges pendingChanges;
@@ -867,19 +956,8 @@ void EntityTreeRenderer::updateEntityRenderStatus(bool shouldRenderEntities) {
 }
 
 void EntityTreeRenderer::updateZone(const EntityItemID& id) {
-    if (!_bestZone) {
-        // Get in the zone!
-        auto zone = getTree()->findEntityByEntityItemID(id);
-        if (zone && zone->contains(_lastAvatarPosition)) {
-            _currentEntitiesInside << id;
-            emit enterEntity(id);
-            _entitiesScriptEngine->callEntityScriptMethod(id, "enterEntity");
-            if (zone->getVisible()) {
-                _bestZone = std::dynamic_pointer_cast<ZoneEntityItem>(zone);
-            }
-        }
-    }
-    if (_bestZone && _bestZone->getID() == id) {
-        applyZonePropertiesToScene(_bestZone);
-    }
+    // this is called from whichever thread changed the zone, so we only flag it here: update() finds out
+    // whether we are in it and applies it to the scene, outside of the tree lock
+    _containmentDirty = true;
+    _zoneChanged = true;
 }
@@ -12,10 +12,15 @@
 #ifndef hifi_EntityTreeRenderer_h
 #define hifi_EntityTreeRenderer_h
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include <QSet>
 #include <QStack>
 
 #include <AbstractAudioInterface.h>
+#include <EntityScriptEnginePool.h>
 #include <EntityScriptingInterface.h> // for RayToEntityIntersectionResult
 #include <EntityTree.h>
 #include <MouseEvent.h>
@@ -127,6 +132,7 @@ protected:
 
 private:
     void addEntityToScene(EntityItemPointer entity);
+    void findContainmentCandidates(const glm::vec3& avatarPosition);
     bool findBestZoneAndMaybeContainingEntities(const glm::vec3& avatarPosition, QVector<EntityItemID>* entitiesContainingAvatar);
 
     void applyZonePropertiesToScene(std::shared_ptr<ZoneEntityItem> zone);
@@ -142,12 +148,27 @@ private:
 
     QScriptValueList createEntityArgs(const EntityItemID& entityID);
     bool checkEnterLeaveEntities();
+    void checkChangedBounds(const QSet<EntityItemID>& entityIDs);
     void leaveAllEntities();
     void forceRecheckEntities();
 
     glm::vec3 _lastAvatarPosition { 0.0f };
     QVector<EntityItemID> _currentEntitiesInside;
 
+    // The entities that could contain the avatar anywhere within CONTAINMENT_QUERY_RADIUS of the center they were
+    // found around.  While the avatar stays in that region and nothing near it changes, enter/leave and the best
+    // zone are worked out from these alone, and only those whose bounds hold the avatar need the tree locked.
+    struct ContainmentCandidate {
+        EntityItemWeakPointer entity;
+        EntityItemID id;
+        AABox bounds;
+    };
+    std::vector<ContainmentCandidate> _containmentCandidates;
+    glm::vec3 _containmentQueryCenter { 0.0f };
+    quint64 _nextContainmentRefresh { 0 };
+    std::atomic<bool> _containmentDirty { true };
+    std::atomic<bool> _zoneChanged { false };
+
     bool _pendingSkyboxTexture { false };
     NetworkTexturePointer _skyboxTexture;
 
@@ -155,7 +176,7 @@ private:
     NetworkTexturePointer _ambientTexture;
 
     bool _wantScripts;
-    ScriptEngine* _entitiesScriptEngine;
+    std::unique_ptr<EntityScriptEnginePool> _entitiesScriptEngine;
 
     bool isCollisionOwner(const QUuid& myNodeID, EntityTreePointer entityTree,
                           const EntityItemID& id, const Collision& collision);
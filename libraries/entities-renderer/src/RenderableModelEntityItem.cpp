@@ -17,9 +17,11 @@
 
 #include <AbstractViewStateInterface.h>
 #include <Model.h>
+#include <NumericalConstants.h>
 #include <PerfStat.h>
 #include <render/Scene.h>
 #include <DependencyManager.h>
+#include <ViewFrustum.h>
 
 #include "EntityTreeRenderer.h"
 #include "EntitiesRendererLogging.h"
@@ -352,6 +354,20 @@ void RenderableModelEntityItem::updateModelBounds() {
 }
 
 
+// Approximates the size of the model on screen, so that near and large models are downloaded first, with the
+// ones outside of the view behind all of those in it.
+float RenderableModelEntityItem::computeLoadPriority(const ViewFrustum& viewFrustum) const {
+    const float OUT_OF_VIEW_PRIORITY_SCALE = 0.01f;
+    glm::vec3 position = getPosition();
+    float radius = getRadius();
+    float distance = glm::distance(viewFrustum.getPosition(), position);
+    float priority = radius / glm::max(distance, glm::max(radius, EPSILON));
+    if (!viewFrustum.sphereIntersectsFrustum(position, radius)) {
+        priority *= OUT_OF_VIEW_PRIORITY_SCALE;
+    }
+    return priority;
+}
+
 // NOTE: this only renders the "meta" portion of the Model, namely it renders debugging items, and it handles
 // the per frame simulation/update that might be required if the models properties changed.
 void RenderableModelEntityItem::render(RenderArgs* args) {
@@ -397,6 +413,10 @@ void RenderableModelEntityItem::render(RenderArgs* args) {
             }
 
             if (_model) {
+                if (args->_viewFrustum && !_model->isLoadComplete()) {
+                    _model->setLoadPriority(computeLoadPriority(*args->_viewFrustum));
+                }
+
                 if (hasAnimation()) {
                     if (!jointsMapped()) {
                         QStringList modelJointNames = _model->getJointNames();
@@ -19,6 +19,7 @@
 
 class Model;
 class EntityTreeRenderer;
+class ViewFrustum;
 
 class RenderableModelEntityItem : public ModelEntityItem {
 public:
@@ -85,6 +86,7 @@ public:
 private:
     QVariantMap parseTexturesToMap(QString textures);
     void remapTextures();
+    float computeLoadPriority(const ViewFrustum& viewFrustum) const;
 
     ModelPointer _model = nullptr;
     bool _needsInitialSimulation = true;
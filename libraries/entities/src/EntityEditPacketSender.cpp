@@ -20,12 +20,13 @@
 
 EntityEditPacketSender::EntityEditPacketSender() {
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerDirectListener(PacketType::EntityEditNack, this, "processEntityEditNackPacket");
+    packetReceiver.registerPacketHandler({ PacketType::EntityEditNack }, this,
+                                         &EntityEditPacketSender::processEntityEditNackPacket);
 }
 
-void EntityEditPacketSender::processEntityEditNackPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+void EntityEditPacketSender::processEntityEditNackPacket(ReceivedMessage& message, SharedNodePointer sendingNode) {
     if (_shouldProcessNack) {
-        processNackPacket(*message, sendingNode);
+        processNackPacket(message, sendingNode);
     }
 }
 
@@ -53,6 +54,22 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type, EntityItemI
     }
 }
 
+void EntityEditPacketSender::queueEditEntityMessages(PacketType type, const EntityEdits& edits) {
+    if (!_shouldSend || edits.isEmpty()) {
+        return; // bail early
+    }
+
+    QVector<QByteArray> editMessages;
+    editMessages.reserve(edits.size());
+    for (auto& edit : edits) {
+        QByteArray bufferOut(NLPacket::maxPayloadSize(type), 0);
+        if (EntityItemProperties::encodeEntityEditPacket(type, edit.first, edit.second, bufferOut)) {
+            editMessages.push_back(bufferOut);
+        }
+    }
+    queueOctreeEditMessages(type, editMessages);
+}
+
 void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityItemID) {
     if (!_shouldSend) {
         return; // bail early
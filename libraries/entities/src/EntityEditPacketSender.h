@@ -20,6 +20,8 @@
 class EntityEditPacketSender :  public OctreeEditPacketSender {
     Q_OBJECT
 public:
+    typedef QVector<QPair<EntityItemID, EntityItemProperties>> EntityEdits;
+
     EntityEditPacketSender();
 
     /// Queues an array of several voxel edit messages. Will potentially send a pending multi-command packet. Determines
@@ -28,14 +30,18 @@ public:
     /// NOTE: EntityItemProperties assumes that all distances are in meter units
     void queueEditEntityMessage(PacketType type, EntityItemID modelID, const EntityItemProperties& properties);
 
+    /// Queues several edits of one type at once, so that they are packed together into each server's packets.
+    void queueEditEntityMessages(PacketType type, const EntityEdits& edits);
+
     void queueEraseEntityMessage(const EntityItemID& entityItemID);
 
     // My server type is the model server
     virtual char getMyNodeType() const { return NodeType::EntityServer; }
     virtual void adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, int clockSkew);
 
+    void processEntityEditNackPacket(ReceivedMessage& message, SharedNodePointer sendingNode);
+
 public slots:
-    void processEntityEditNackPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
     void toggleNackPackets() { _shouldProcessNack = !_shouldProcessNack; }
 
 private:
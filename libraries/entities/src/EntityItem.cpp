@@ -201,7 +201,7 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
     bool successPropertyFlagsFits = false;
     int propertyFlagsOffset = 0;
     int oldPropertyFlagsLength = 0;
-    QByteArray encodedPropertyFlags;
+    uint8_t encodedPropertyFlags[EntityPropertyFlags::MAX_ENCODED_LENGTH];
     int propertyCount = 0;
 
     successIDFits = packetData->appendRawData(encodedID);
@@ -223,9 +223,8 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     if (successLastSimulatedFits) {
         propertyFlagsOffset = packetData->getUncompressedByteOffset();
-        encodedPropertyFlags = propertyFlags;
-        oldPropertyFlagsLength = encodedPropertyFlags.length();
-        successPropertyFlagsFits = packetData->appendRawData(encodedPropertyFlags);
+        oldPropertyFlagsLength = propertyFlags.encode(encodedPropertyFlags);
+        successPropertyFlagsFits = packetData->appendRawData(encodedPropertyFlags, oldPropertyFlagsLength);
     }
 
     bool headerFits = successIDFits && successTypeFits && successCreatedFits && successLastEditedFits
@@ -286,10 +285,8 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     if (propertyCount > 0) {
         int endOfEntityItemData = packetData->getUncompressedByteOffset();
-        encodedPropertyFlags = propertyFlags;
-        int newPropertyFlagsLength = encodedPropertyFlags.length();
-        packetData->updatePriorBytes(propertyFlagsOffset,
-                (const unsigned char*)encodedPropertyFlags.constData(), encodedPropertyFlags.length());
+        int newPropertyFlagsLength = propertyFlags.encode(encodedPropertyFlags);
+        packetData->updatePriorBytes(propertyFlagsOffset, encodedPropertyFlags, newPropertyFlagsLength);
 
         // if the size of the PropertyFlags shrunk, we need to shift everything down to front of packet.
         if (newPropertyFlagsLength < oldPropertyFlagsLength) {
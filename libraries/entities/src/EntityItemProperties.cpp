@@ -968,9 +968,9 @@ bool EntityItemProperties::encodeEntityEditPacket(PacketType command, EntityItem
         bool successLastUpdatedFits = packetData->appendRawData(encodedUpdateDelta);
 
         int propertyFlagsOffset = packetData->getUncompressedByteOffset();
-        QByteArray encodedPropertyFlags = propertyFlags;
-        int oldPropertyFlagsLength = encodedPropertyFlags.length();
-        bool successPropertyFlagsFits = packetData->appendRawData(encodedPropertyFlags);
+        uint8_t encodedPropertyFlags[EntityPropertyFlags::MAX_ENCODED_LENGTH];
+        int oldPropertyFlagsLength = propertyFlags.encode(encodedPropertyFlags);
+        bool successPropertyFlagsFits = packetData->appendRawData(encodedPropertyFlags, oldPropertyFlagsLength);
         int propertyCount = 0;
 
         bool headerFits = successIDFits && successTypeFits && successLastEditedFits
@@ -1136,10 +1136,8 @@ bool EntityItemProperties::encodeEntityEditPacket(PacketType command, EntityItem
         if (propertyCount > 0) {
             int endOfEntityItemData = packetData->getUncompressedByteOffset();
 
-            encodedPropertyFlags = propertyFlags;
-            int newPropertyFlagsLength = encodedPropertyFlags.length();
-            packetData->updatePriorBytes(propertyFlagsOffset,
-                                         (const unsigned char*)encodedPropertyFlags.constData(), encodedPropertyFlags.length());
+            int newPropertyFlagsLength = propertyFlags.encode(encodedPropertyFlags);
+            packetData->updatePriorBytes(propertyFlagsOffset, encodedPropertyFlags, newPropertyFlagsLength);
 
             // if the size of the PropertyFlags shrunk, we need to shift everything down to front of packet.
             if (newPropertyFlagsLength < oldPropertyFlagsLength) {
@@ -1272,8 +1270,8 @@ bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int
     //quint64 lastUpdated = lastEdited + updateDelta; // don't adjust for clock skew since we already did that for lastEdited
 
     // Property Flags...
-    QByteArray encodedPropertyFlags((const char*)dataAt, (bytesToRead - processedBytes));
-    EntityPropertyFlags propertyFlags = encodedPropertyFlags;
+    EntityPropertyFlags propertyFlags;
+    propertyFlags.decode(dataAt, bytesToRead - processedBytes);
     dataAt += propertyFlags.getEncodedLength();
     processedBytes += propertyFlags.getEncodedLength();
 
@@ -14,6 +14,7 @@
 #ifndef hifi_EntityScriptingInterface_h
 #define hifi_EntityScriptingInterface_h
 
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QStringList>
 #include <QtQml/QJSValue>
@@ -71,7 +72,7 @@ public:
 
     void setEntityTree(EntityTreePointer modelTree);
     EntityTreePointer getEntityTree() { return _entityTree; }
-    void setEntitiesScriptEngine(EntitiesScriptEngineProvider* engine) { _entitiesScriptEngine = engine; }
+    void setEntitiesScriptEngine(EntitiesScriptEngineProvider* engine);
     float calculateCost(float mass, float oldVelocity, float newVelocity);
 public slots:
 
@@ -214,6 +215,8 @@ private:
         bool precisionPicking, const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard);
 
     EntityTreePointer _entityTree;
+    // cleared by its owner before it goes, calls from script threads hold the lock while they use it
+    QMutex _entitiesScriptEngineLock;
     EntitiesScriptEngineProvider* _entitiesScriptEngine { nullptr };
     
     bool _bidOnSimulationOwnership { false };
@@ -0,0 +1,200 @@
+//
+//  EntitySpatialIndex.cpp
+//  libraries/entities/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndex.h"
+
+#include "EntityTreeElement.h"
+
+EntitySpatialQuery EntitySpatialQuery::sphere(const glm::vec3& center, float radius) {
+    EntitySpatialQuery query;
+    query.type = Sphere;
+    query.position = center;
+    query.radius = radius;
+    return query;
+}
+
+EntitySpatialQuery EntitySpatialQuery::box(const AABox& box) {
+    EntitySpatialQuery query;
+    query.type = Box;
+    query.position = box.getCorner();
+    query.vector = box.getDimensions();
+    return query;
+}
+
+EntitySpatialQuery EntitySpatialQuery::ray(const glm::vec3& origin, const glm::vec3& direction, bool precisionPicking) {
+    EntitySpatialQuery query;
+    query.type = Ray;
+    query.position = origin;
+    query.vector = direction;
+    query.precisionPicking = precisionPicking;
+    return query;
+}
+
+void EntitySpatialIndex::clear() {
+    _elements.clear();
+    _entities.clear();
+}
+
+void EntitySpatialIndex::build(const EntityTreeElementPointer& root) {
+    clear();
+    if (root) {
+        addElement(root);
+    }
+}
+
+void EntitySpatialIndex::addElement(const EntityTreeElementPointer& element) {
+    uint32_t index = (uint32_t)_elements.size();
+    uint32_t firstEntity = (uint32_t)_entities.size();
+    _elements.push_back({ element->getAACube(), firstEntity, 0, 0 });
+
+    element->forEachEntity([&](EntityItemPointer entity) {
+        _entities.push_back(entity);
+    });
+    uint32_t numEntities = (uint32_t)_entities.size() - firstEntity;
+
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        EntityTreeElementPointer child = std::static_pointer_cast<EntityTreeElement>(element->getChildAtIndex(i));
+        if (child) {
+            addElement(child);
+        }
+    }
+
+    // elements with no entities in or below them can't add anything to a query
+    if (index > 0 && numEntities == 0 && _elements.size() == index + 1) {
+        _elements.pop_back();
+        return;
+    }
+    _elements[index].numEntities = numEntities;
+    _elements[index].subtreeEnd = (uint32_t)_elements.size();
+}
+
+static bool queryTouchesCube(const EntitySpatialQuery& query, const EntitySpatialQueryResult& result,
+                             const AACube& cube) {
+    switch (query.type) {
+        case EntitySpatialQuery::Sphere: {
+            glm::vec3 penetration;
+            return cube.findSpherePenetration(query.position, query.radius, penetration);
+        }
+        case EntitySpatialQuery::Box:
+            return cube.touches(AABox(query.position, query.vector));
+        case EntitySpatialQuery::Ray: {
+            // nothing in a cube further away than the closest hit so far can be closer
+            float distance;
+            BoxFace face;
+            glm::vec3 surfaceNormal;
+            return cube.findRayIntersection(query.position, query.vector, distance, face, surfaceNormal) &&
+                distance < result.distance;
+        }
+    }
+    return false;
+}
+
+static void testEntity(const EntitySpatialQuery& query, EntitySpatialQueryResult& result,
+                       const EntityItemPointer& entity, const AABox& entityBox) {
+    switch (query.type) {
+        case EntitySpatialQuery::Sphere: {
+            glm::vec3 penetration;
+            if (entityBox.findSpherePenetration(query.position, query.radius, penetration) &&
+                    EntityTreeElement::entityShapeTouchesSphere(entity, query.position, query.radius)) {
+                result.entities.push_back(entity);
+            }
+            break;
+        }
+        case EntitySpatialQuery::Box:
+            if (entityBox.touches(AABox(query.position, query.vector))) {
+                result.entities.push_back(entity);
+            }
+            break;
+        case EntitySpatialQuery::Ray: {
+            float distance;
+            BoxFace face;
+            glm::vec3 surfaceNormal;
+            if (!entityBox.findRayIntersection(query.position, query.vector, distance, face, surfaceNormal) ||
+                    distance >= result.distance) {
+                break;
+            }
+            bool keepSearching = true;
+            OctreeElementPointer element;
+            void* intersectedObject = nullptr;
+            if (EntityTreeElement::findRayIntersectionWithEntity(entity, query.position, query.vector, keepSearching,
+                    element, result.distance, result.face, result.surfaceNormal, &intersectedObject,
+                    query.precisionPicking)) {
+                result.entities.clear();
+                result.entities.push_back(entity);
+            }
+            break;
+        }
+    }
+}
+
+void EntitySpatialIndex::findEntities(const QVector<EntitySpatialQuery>& queries,
+                                      QVector<EntitySpatialQueryResult>& results) const {
+    results.clear();
+    results.resize(queries.size());
+    if (_elements.empty() || queries.isEmpty()) {
+        return;
+    }
+
+    // the queries still touching each element on the path down from the root are stacked in active, a level at
+    // a time, so every element is visited once for the whole batch and subtrees no query touches are skipped
+    struct Level {
+        uint32_t subtreeEnd;
+        size_t activeBegin;
+    };
+    std::vector<uint32_t> active;
+    std::vector<Level> levels;
+    active.reserve(queries.size() * 2);
+    for (int i = 0; i < queries.size(); i++) {
+        active.push_back((uint32_t)i);
+    }
+    levels.push_back({ (uint32_t)_elements.size(), 0 });
+
+    uint32_t index = 0;
+    while (index < _elements.size()) {
+        while (index >= levels.back().subtreeEnd) {
+            active.resize(levels.back().activeBegin);
+            levels.pop_back();
+        }
+
+        const Element& element = _elements[index];
+        size_t parentBegin = levels.back().activeBegin;
+        size_t parentEnd = active.size();
+        for (size_t i = parentBegin; i < parentEnd; i++) {
+            uint32_t queryIndex = active[i];
+            if (queryTouchesCube(queries[queryIndex], results[queryIndex], element.cube)) {
+                active.push_back(queryIndex);
+            }
+        }
+        if (active.size() == parentEnd) {
+            index = element.subtreeEnd;
+            continue;
+        }
+
+        // each element is visited once per batch, so entity bounds are computed once for all of its queries
+        for (uint32_t entityIndex = element.firstEntity; entityIndex < element.firstEntity + element.numEntities;
+                entityIndex++) {
+            EntityItemPointer entity = _entities[entityIndex].lock();
+            if (!entity) {
+                continue;
+            }
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            if (!success) {
+                continue;
+            }
+            for (size_t i = parentEnd; i < active.size(); i++) {
+                testEntity(queries[active[i]], results[active[i]], entity, entityBox);
+            }
+        }
+
+        levels.push_back({ element.subtreeEnd, parentEnd });
+        index++;
+    }
+}
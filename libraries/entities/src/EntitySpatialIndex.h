@@ -0,0 +1,85 @@
+//
+//  EntitySpatialIndex.h
+//  libraries/entities/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySpatialIndex_h
+#define hifi_EntitySpatialIndex_h
+
+#include <cfloat>
+#include <vector>
+
+#include <QVector>
+
+#include <AABox.h>
+#include <AACube.h>
+
+#include "EntityItem.h"
+
+class EntityTreeElement;
+typedef std::shared_ptr<EntityTreeElement> EntityTreeElementPointer;
+
+/// A sphere, box or ray to be answered as part of a batch by an EntitySpatialIndex
+class EntitySpatialQuery {
+public:
+    enum Type { Sphere, Box, Ray };
+
+    static EntitySpatialQuery sphere(const glm::vec3& center, float radius);
+    static EntitySpatialQuery box(const AABox& box);
+    static EntitySpatialQuery ray(const glm::vec3& origin, const glm::vec3& direction, bool precisionPicking = false);
+
+    Type type { Sphere };
+    glm::vec3 position;             // sphere center, box corner or ray origin
+    glm::vec3 vector;               // box dimensions or ray direction
+    float radius { 0.0f };
+    bool precisionPicking { false };
+};
+
+class EntitySpatialQueryResult {
+public:
+    /// every entity touching a sphere or box, or the closest entity hit by a ray
+    QVector<EntityItemPointer> entities;
+
+    // rays only
+    float distance { FLT_MAX };
+    BoxFace face { UNKNOWN_FACE };
+    glm::vec3 surfaceNormal;
+};
+
+/// A flattened snapshot of an entity tree's elements and the entities in them, laid out depth first in contiguous
+/// arrays so a batch of queries can be answered in a single pass without chasing element pointers.  Entity bounds
+/// are read while querying, once per batch, so entities that move within their element are followed; rebuild it
+/// when entities are added, deleted or move to another element.  Entities are held weakly, so one deleted from the
+/// tree is freed at once and skipped until the rebuild.
+class EntitySpatialIndex {
+public:
+    /// NOTE: assumes caller has handled locking of the tree
+    void build(const EntityTreeElementPointer& root);
+    void clear();
+
+    int getNumElements() const { return (int)_elements.size(); }
+    int getNumEntities() const { return (int)_entities.size(); }
+
+    /// answers all of the queries at once, results are in the order of the queries
+    void findEntities(const QVector<EntitySpatialQuery>& queries, QVector<EntitySpatialQueryResult>& results) const;
+
+private:
+    struct Element {
+        AACube cube;
+        uint32_t firstEntity;
+        uint32_t numEntities;
+        uint32_t subtreeEnd;        // index of the first element that isn't a descendant of this one
+    };
+
+    void addElement(const EntityTreeElementPointer& element);
+
+    std::vector<Element> _elements;
+    std::vector<EntityItemWeakPointer> _entities;
+};
+
+#endif // hifi_EntitySpatialIndex_h
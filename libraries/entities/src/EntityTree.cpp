@@ -28,6 +28,9 @@
 
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
 
+// edits that can change where an entity is and how much room it takes up
+static const uint32_t BOUNDS_DIRTY_FLAGS = Simulation::DIRTY_TRANSFORM | Simulation::DIRTY_SHAPE;
+
 EntityTree::EntityTree(bool shouldReaverage) :
     Octree(shouldReaverage),
     _fbxService(NULL),
@@ -65,6 +68,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
         _entityToElementMap.clear();
     }
     Octree::eraseAllOctreeElements(createNewRoot);
+    _spatialIndexIsDirty = true;
 
     resetClientEditStats();
     clearDeletedEntities();
@@ -191,9 +195,11 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
                         // so we apply the rules for ownership change:
                         // (1) higher priority wins
                         // (2) equal priority wins if ownership filter has expired except...
+                        // (3) the server's own simulation gives way to anyone who wants to simulate the object
                         uint8_t oldPriority = entity->getSimulationPriority();
                         uint8_t newPriority = properties.getSimulationOwner().getPriority();
-                        if (newPriority > oldPriority ||
+                        bool ownedByServer = entity->getSimulatorID() == DependencyManager::get<NodeList>()->getSessionUUID();
+                        if (ownedByServer || newPriority > oldPriority ||
                              (newPriority == oldPriority && properties.getSimulationOwner().hasExpired())) {
                             simulationBlocked = false;
                         }
@@ -277,6 +283,9 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
+            if (newFlags & BOUNDS_DIRTY_FLAGS) {
+                noteChangedBounds(entity->getEntityItemID());
+            }
             if (_simulation) {
                 if (newFlags & DIRTY_SIMULATION_FLAGS) {
                     _simulation->changeEntity(entity);
@@ -682,6 +691,18 @@ void EntityTree::findEntities(const AABox& box, QVector<EntityItemPointer>& foun
     foundEntities.swap(args._foundEntities);
 }
 
+// NOTE: assumes caller has handled locking
+void EntityTree::findEntities(const QVector<EntitySpatialQuery>& queries, QVector<EntitySpatialQueryResult>& results) {
+    if (_spatialIndexIsDirty) {
+        QWriteLocker locker(&_spatialIndexLock);
+        if (_spatialIndexIsDirty.exchange(false)) {
+            _spatialIndex.build(getRoot());
+        }
+    }
+    QReadLocker locker(&_spatialIndexLock);
+    _spatialIndex.findEntities(queries, results);
+}
+
 EntityItemPointer EntityTree::findEntityByID(const QUuid& id) {
     EntityItemID entityID(id);
     return findEntityByEntityItemID(entityID);
@@ -1000,7 +1021,24 @@ void EntityTree::releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncod
     extraEncodeData->clear();
 }
 
+void EntityTree::noteChangedBounds(const EntityItemID& entityID) {
+    if (_collectChangedBounds) {
+        QMutexLocker locker(&_changedBoundsLock);
+        _entitiesWithChangedBounds.insert(entityID);
+    }
+}
+
+QSet<EntityItemID> EntityTree::takeEntitiesWithChangedBounds() {
+    QSet<EntityItemID> entityIDs;
+    QMutexLocker locker(&_changedBoundsLock);
+    entityIDs.swap(_entitiesWithChangedBounds);
+    return entityIDs;
+}
+
 void EntityTree::entityChanged(EntityItemPointer entity) {
+    if (entity->getDirtyFlags() & BOUNDS_DIRTY_FLAGS) {
+        noteChangedBounds(entity->getEntityItemID());
+    }
     if (_simulation) {
         _simulation->changeEntity(entity);
     }
@@ -1238,6 +1276,9 @@ EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& en
 }
 
 void EntityTree::setContainingElement(const EntityItemID& entityItemID, EntityTreeElementPointer element) {
+    // every add, delete and move to another element comes through here
+    _spatialIndexIsDirty = true;
+
     QWriteLocker locker(&_entityToElementLock);
     if (element) {
         _entityToElementMap[entityItemID] = element;
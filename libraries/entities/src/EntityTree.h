@@ -12,6 +12,9 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <atomic>
+
+#include <QMutex>
 #include <QSet>
 #include <QVector>
 
@@ -22,6 +25,7 @@ typedef std::shared_ptr<EntityTree> EntityTreePointer;
 
 
 #include "EntityTreeElement.h"
+#include "EntitySpatialIndex.h"
 #include "DeleteEntityOperator.h"
 
 class Model;
@@ -148,6 +152,13 @@ public:
     /// \remark Side effect: any initial contents in entities will be lost
     void findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities);
 
+    /// answers a batch of sphere, box and ray queries in a single pass over the tree
+    /// \param queries the queries in world-frame (meters)
+    /// \param results[out] one result per query, in the order of the queries
+    /// \remark the index is kept between calls and only rebuilt after entities were added, deleted or moved to
+    /// another element, so a caller that queries often doesn't pay for walking the whole tree each time
+    void findEntities(const QVector<EntitySpatialQuery>& queries, QVector<EntitySpatialQueryResult>& results);
+
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
     void removeNewlyCreatedHook(NewlyCreatedEntityHook* hook);
 
@@ -248,6 +259,11 @@ public:
     void forgetAvatarID(QUuid avatarID) { _avatarIDs -= avatarID; }
     void deleteDescendantsOfAvatar(QUuid avatarID);
 
+    // The entities that edits have moved, rotated or resized since the last take.  Nothing is collected until
+    // it is turned on, so trees that nobody drains don't grow the set.
+    void setCollectChangedBounds(bool collect) { _collectChangedBounds = collect; }
+    QSet<EntityItemID> takeEntitiesWithChangedBounds();
+
 public slots:
     void callLoader(EntityItemID entityID);
 
@@ -271,6 +287,7 @@ protected:
     static bool sendEntitiesOperation(OctreeElementPointer element, void* extraData);
 
     void notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode);
+    void noteChangedBounds(const EntityItemID& entityID);
 
     QReadWriteLock _newlyCreatedHooksLock;
     QVector<NewlyCreatedEntityHook*> _newlyCreatedHooks;
@@ -296,6 +313,16 @@ protected:
     mutable QReadWriteLock _entityToElementLock;
     QHash<EntityItemID, EntityTreeElementPointer> _entityToElementMap;
 
+    // rebuilt on the next batch of queries once an entity changes element; batches can come from several
+    // readers at once, so the index has a lock of its own, held for writing only to rebuild
+    QReadWriteLock _spatialIndexLock;
+    EntitySpatialIndex _spatialIndex;
+    std::atomic<bool> _spatialIndexIsDirty { true };
+
+    std::atomic<bool> _collectChangedBounds { false };
+    QMutex _changedBoundsLock;
+    QSet<EntityItemID> _entitiesWithChangedBounds;
+
     EntitySimulation* _simulation;
 
     bool _wantEditLogging = false;
@@ -599,55 +599,70 @@ bool EntityTreeElement::findDetailedRayIntersection(const glm::vec3& origin, con
             return;
         }
 
-        // extents is the entity relative, scaled, centered extents of the entity
-        glm::mat4 rotation = glm::mat4_cast(entity->getRotation());
-        glm::mat4 translation = glm::translate(entity->getPosition());
-        glm::mat4 entityToWorldMatrix = translation * rotation;
-        glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
-
-        glm::vec3 dimensions = entity->getDimensions();
-        glm::vec3 registrationPoint = entity->getRegistrationPoint();
-        glm::vec3 corner = -(dimensions * registrationPoint);
-
-        AABox entityFrameBox(corner, dimensions);
-
-        glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
-        glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
-
-        // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
-        // and testing intersection there.
-        if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, localDistance,
-                                                localFace, localSurfaceNormal)) {
-            if (localDistance < distance) {
-                // now ask the entity if we actually intersect
-                if (entity->supportsDetailedRayIntersection()) {
-                    if (entity->findDetailedRayIntersection(origin, direction, keepSearching, element, localDistance,
-                        localFace, localSurfaceNormal, intersectedObject, precisionPicking)) {
-
-                        if (localDistance < distance) {
-                            distance = localDistance;
-                            face = localFace;
-                            surfaceNormal = localSurfaceNormal;
-                            *intersectedObject = (void*)entity.get();
-                            somethingIntersected = true;
-                        }
-                    }
-                } else {
-                    // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
-                    // Never intersect with particle effect entities
-                    if (localDistance < distance && EntityTypes::getEntityTypeName(entity->getType()) != "ParticleEffect") {
+        if (findRayIntersectionWithEntity(entity, origin, direction, keepSearching, element, distance, face,
+                                          surfaceNormal, intersectedObject, precisionPicking)) {
+            somethingIntersected = true;
+        }
+        entityNumber++;
+    });
+    return somethingIntersected;
+}
+
+bool EntityTreeElement::findRayIntersectionWithEntity(const EntityItemPointer& entity, const glm::vec3& origin,
+                                    const glm::vec3& direction, bool& keepSearching, OctreeElementPointer& element,
+                                    float& distance, BoxFace& face, glm::vec3& surfaceNormal, void** intersectedObject,
+                                    bool precisionPicking) {
+    float localDistance;
+    BoxFace localFace;
+    glm::vec3 localSurfaceNormal;
+
+    // extents is the entity relative, scaled, centered extents of the entity
+    glm::mat4 rotation = glm::mat4_cast(entity->getRotation());
+    glm::mat4 translation = glm::translate(entity->getPosition());
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+    glm::vec3 dimensions = entity->getDimensions();
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint);
+
+    AABox entityFrameBox(corner, dimensions);
+
+    glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
+    glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
+
+    // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
+    // and testing intersection there.
+    if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, localDistance,
+                                            localFace, localSurfaceNormal)) {
+        if (localDistance < distance) {
+            // now ask the entity if we actually intersect
+            if (entity->supportsDetailedRayIntersection()) {
+                if (entity->findDetailedRayIntersection(origin, direction, keepSearching, element, localDistance,
+                    localFace, localSurfaceNormal, intersectedObject, precisionPicking)) {
+
+                    if (localDistance < distance) {
                         distance = localDistance;
                         face = localFace;
                         surfaceNormal = localSurfaceNormal;
                         *intersectedObject = (void*)entity.get();
-                        somethingIntersected = true;
+                        return true;
                     }
                 }
+            } else {
+                // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
+                // Never intersect with particle effect entities
+                if (localDistance < distance && EntityTypes::getEntityTypeName(entity->getType()) != "ParticleEffect") {
+                    distance = localDistance;
+                    face = localFace;
+                    surfaceNormal = localSurfaceNormal;
+                    *intersectedObject = (void*)entity.get();
+                    return true;
+                }
             }
         }
-        entityNumber++;
-    });
-    return somethingIntersected;
+    }
+    return false;
 }
 
 // TODO: change this to use better bounding shape for entity than sphere
@@ -699,49 +714,49 @@ void EntityTreeElement::getEntities(const glm::vec3& searchPosition, float searc
 
         // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
         glm::vec3 penetration;
-        if (success && entityBox.findSpherePenetration(searchPosition, searchRadius, penetration)) {
-
-            glm::vec3 dimensions = entity->getDimensions();
-
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably dull actuall hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE &&
-                (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
-
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
-
-                bool success;
-                if (findSphereSpherePenetration(searchPosition, searchRadius,
-                        entity->getCenterPosition(success), entityTrueRadius, penetration)) {
-                    if (success) {
-                        foundEntities.push_back(entity);
-                    }
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 rotation = glm::mat4_cast(entity->getRotation());
-                glm::mat4 translation = glm::translate(entity->getPosition());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+        if (success && entityBox.findSpherePenetration(searchPosition, searchRadius, penetration) &&
+                entityShapeTouchesSphere(entity, searchPosition, searchRadius)) {
+            foundEntities.push_back(entity);
+        }
+    });
+}
 
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint);
+bool EntityTreeElement::entityShapeTouchesSphere(const EntityItemPointer& entity, const glm::vec3& searchPosition,
+                                                 float searchRadius) {
+    glm::vec3 penetration;
+    glm::vec3 dimensions = entity->getDimensions();
 
-                AABox entityFrameBox(corner, dimensions);
+    // FIXME - consider allowing the entity to determine penetration so that
+    //         entities could presumably dull actuall hull testing if they wanted to
+    // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
+    //         can we handle the ellipsoid case better? We only currently handle perfect spheres
+    //         with centered registration points
+    if (entity->getShapeType() == SHAPE_TYPE_SPHERE &&
+        (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
 
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(searchPosition, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, searchRadius, penetration)) {
-                    foundEntities.push_back(entity);
-                }
-            }
-        }
-    });
+        // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
+        //       maximum bounding sphere, which is actually larger than our actual radius
+        float entityTrueRadius = dimensions.x / 2.0f;
+
+        bool success;
+        return findSphereSpherePenetration(searchPosition, searchRadius,
+                entity->getCenterPosition(success), entityTrueRadius, penetration) && success;
+    }
+
+    // determine the worldToEntityMatrix that doesn't include scale because
+    // we're going to use the registration aware aa box in the entity frame
+    glm::mat4 rotation = glm::mat4_cast(entity->getRotation());
+    glm::mat4 translation = glm::translate(entity->getPosition());
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint);
+
+    AABox entityFrameBox(corner, dimensions);
+
+    glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(searchPosition, 1.0f));
+    return entityFrameBox.findSpherePenetration(entityFrameSearchPosition, searchRadius, penetration);
 }
 
 void EntityTreeElement::getEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities) {
@@ -155,6 +155,15 @@ public:
     virtual bool findSpherePenetration(const glm::vec3& center, float radius,
                         glm::vec3& penetration, void** penetratedObject) const;
 
+    /// Tests a ray against a single entity whose world frame AABox it is already known to hit.  Updates distance, face,
+    /// surfaceNormal and intersectedObject, and returns true, if the entity is closer than the given distance.
+    static bool findRayIntersectionWithEntity(const EntityItemPointer& entity, const glm::vec3& origin,
+                        const glm::vec3& direction, bool& keepSearching, OctreeElementPointer& element, float& distance,
+                        BoxFace& face, glm::vec3& surfaceNormal, void** intersectedObject, bool precisionPicking);
+
+    /// Tests a sphere against the shape of a single entity whose world frame AABox it is already known to touch.
+    static bool entityShapeTouchesSphere(const EntityItemPointer& entity, const glm::vec3& center, float radius);
+
 
     template <typename F>
     void forEachEntity(F f) const {
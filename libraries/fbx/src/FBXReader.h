@@ -405,6 +405,13 @@ public:
     FBXNode _fbxNode;
     static FBXNode parseFBX(QIODevice* device);
 
+    // binary FBX parsing straight from memory, used by parseFBX whenever the whole file can be mapped or read at once.
+    // data must start with the binary prolog and stay valid for the duration of the call.
+    static FBXNode parseBinaryFBX(const char* data, qint64 size);
+
+    // binary FBX parsing through a QDataStream, the fallback for sequential devices.
+    static FBXNode parseBinaryFBX(QIODevice* device);
+
     FBXGeometry* extractFBXGeometry(const QVariantHash& mapping, const QString& url);
 
     ExtractedMesh extractMesh(const FBXNode& object, unsigned int& meshIndex);
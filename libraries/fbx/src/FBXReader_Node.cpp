@@ -9,15 +9,20 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <string.h>
 #include <QBuffer>
 #include <QDataStream>
+#include <QFile>
 #include <QIODevice>
 #include <QStringList>
 #include <QTextStream>
 #include <QtDebug>
 #include <QtEndian>
 #include <QFileInfo>
+#include <zlib.h>
 #include "FBXReader.h"
 
 template<class T> int streamSize() {
@@ -172,6 +177,248 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position) {
     return node;
 }
 
+// see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
+// of the FBX binary format
+const QByteArray BINARY_PROLOG = "Kaydara FBX Binary  ";
+const int BINARY_HEADER_SIZE = 27;
+const int BINARY_VERSION_OFFSET = 23;
+const quint32 DEFLATE_ENCODING = 1;
+
+// starting with version 7.5, node record offsets and counts are 64 bits wide
+const quint32 FIRST_64_BIT_VERSION = 7500;
+
+// zlib can't do better than about 1032:1, anything claiming more is corrupt.
+const quint64 MAX_DEFLATE_RATIO = 1032;
+
+// Reads binary FBX straight out of a block of memory.  Arrays are decoded (or inflated) directly into the
+// storage of the QVector they're returned in, rather than an element at a time through a QDataStream.
+class BinaryFBXParser {
+public:
+    BinaryFBXParser(const char* data, qint64 size) : _data(data), _size(size) { }
+    ~BinaryFBXParser();
+
+    FBXNode parse();
+
+private:
+    void require(quint64 length) const;
+    template<class T> T read();
+    quint32 readArrayLength(size_t elementSize);
+    void readArrayData(void* destination, quint64 length);
+    template<class T> QVariant readArray();
+    QByteArray readBytes(quint64 length);
+    QVariant readProperty();
+    FBXNode readNode();
+
+    const char* _data;
+    qint64 _size;
+    qint64 _position { 0 };
+    bool _wideRecords { false };
+
+    // reused by every compressed array
+    z_stream _stream;
+    bool _streamInitialized { false };
+    QByteArray _scratch;
+};
+
+BinaryFBXParser::~BinaryFBXParser() {
+    if (_streamInitialized) {
+        inflateEnd(&_stream);
+    }
+}
+
+void BinaryFBXParser::require(quint64 length) const {
+    if (length > (quint64)(_size - _position)) {
+        throw QString("Unexpected end of binary FBX data at ") + QString::number(_position);
+    }
+}
+
+template<class T> static void fromLittleEndian(T* values, quint64 count) {
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    for (quint64 i = 0; i < count; i++) {
+        char* bytes = reinterpret_cast<char*>(values + i);
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+#endif
+}
+
+template<class T> T BinaryFBXParser::read() {
+    require(sizeof(T));
+    T value;
+    memcpy(&value, _data + _position, sizeof(T));
+    fromLittleEndian(&value, 1);
+    _position += sizeof(T);
+    return value;
+}
+
+QByteArray BinaryFBXParser::readBytes(quint64 length) {
+    require(length);
+    QByteArray bytes(_data + _position, (int)length);
+    _position += length;
+    return bytes;
+}
+
+void BinaryFBXParser::readArrayData(void* destination, quint64 length) {
+    quint32 encoding = read<quint32>();
+    quint32 compressedLength = read<quint32>();
+    if (encoding != DEFLATE_ENCODING) {
+        require(length);
+        memcpy(destination, _data + _position, length);
+        _position += length;
+        return;
+    }
+    require(compressedLength);
+    if (!_streamInitialized) {
+        memset(&_stream, 0, sizeof(_stream));
+        if (inflateInit(&_stream) != Z_OK) {
+            throw QString("Failed to initialize zlib");
+        }
+        _streamInitialized = true;
+    } else {
+        inflateReset(&_stream);
+    }
+    _stream.next_in = (Bytef*)(_data + _position);
+    _stream.avail_in = compressedLength;
+    _stream.next_out = (Bytef*)destination;
+    _stream.avail_out = (uInt)length;
+    if (inflate(&_stream, Z_FINISH) != Z_STREAM_END || _stream.avail_out != 0) {
+        throw QString("Failed to inflate binary FBX array at ") + QString::number(_position);
+    }
+    _position += compressedLength;
+}
+
+quint32 BinaryFBXParser::readArrayLength(size_t elementSize) {
+    quint32 arrayLength = read<quint32>();
+
+    // check the claimed length against the data that's left before allocating anything
+    require(2 * sizeof(quint32));
+    quint32 header[2];
+    memcpy(header, _data + _position, sizeof(header));
+    fromLittleEndian(header, 2);
+    quint64 length = (quint64)arrayLength * elementSize;
+    quint64 available = (header[0] == DEFLATE_ENCODING) ? (quint64)header[1] * MAX_DEFLATE_RATIO :
+        (quint64)(_size - _position);
+    if (length > available || arrayLength > (quint32)std::numeric_limits<int>::max()) {
+        throw QString("Invalid binary FBX array length at ") + QString::number(_position);
+    }
+    return arrayLength;
+}
+
+template<class T> QVariant BinaryFBXParser::readArray() {
+    quint32 arrayLength = readArrayLength(sizeof(T));
+    QVector<T> values((int)arrayLength);
+    readArrayData(values.data(), (quint64)arrayLength * sizeof(T));
+    fromLittleEndian(values.data(), arrayLength);
+    return QVariant::fromValue(values);
+}
+
+// booleans are stored as bytes, which may not hold 0 or 1
+template<> QVariant BinaryFBXParser::readArray<bool>() {
+    int arrayLength = (int)readArrayLength(sizeof(char));
+    _scratch.resize(arrayLength);
+    readArrayData(_scratch.data(), arrayLength);
+
+    QVector<bool> values(arrayLength);
+    for (int i = 0; i < arrayLength; i++) {
+        values[i] = _scratch.at(i) != 0;
+    }
+    return QVariant::fromValue(values);
+}
+
+QVariant BinaryFBXParser::readProperty() {
+    char ch = read<char>();
+    switch (ch) {
+        case 'Y':
+            return QVariant::fromValue(read<qint16>());
+        case 'C':
+            return QVariant::fromValue(read<quint8>() != 0);
+        case 'I':
+            return QVariant::fromValue(read<qint32>());
+        case 'F':
+            return QVariant::fromValue(read<float>());
+        case 'D':
+            return QVariant::fromValue(read<double>());
+        case 'L':
+            return QVariant::fromValue(read<qint64>());
+        case 'f':
+            return readArray<float>();
+        case 'd':
+            return readArray<double>();
+        case 'l':
+            return readArray<qint64>();
+        case 'i':
+            return readArray<qint32>();
+        case 'b':
+            return readArray<bool>();
+        case 'S':
+        case 'R':
+            return QVariant::fromValue(readBytes(read<quint32>()));
+        default:
+            throw QString("Unknown property type: ") + ch;
+    }
+}
+
+FBXNode BinaryFBXParser::readNode() {
+    quint64 endOffset;
+    quint64 propertyCount;
+    if (_wideRecords) {
+        endOffset = read<quint64>();
+        propertyCount = read<quint64>();
+        read<quint64>(); // property list length
+    } else {
+        endOffset = read<quint32>();
+        propertyCount = read<quint32>();
+        read<quint32>(); // property list length
+    }
+    quint8 nameLength = read<quint8>();
+
+    FBXNode node;
+    const quint64 MIN_VALID_OFFSET = 40;
+    if (endOffset < MIN_VALID_OFFSET || nameLength == 0) {
+        // use a null name to indicate a null node
+        return node;
+    }
+    node.name = readBytes(nameLength);
+
+    for (quint64 i = 0; i < propertyCount; i++) {
+        node.properties.append(readProperty());
+    }
+
+    while ((quint64)_position < endOffset) {
+        FBXNode child = readNode();
+        if (child.name.isNull()) {
+            return node;
+
+        } else {
+            node.children.append(child);
+        }
+    }
+
+    return node;
+}
+
+FBXNode BinaryFBXParser::parse() {
+    require(BINARY_HEADER_SIZE);
+    quint32 version;
+    memcpy(&version, _data + BINARY_VERSION_OFFSET, sizeof(quint32));
+    fromLittleEndian(&version, 1);
+    _wideRecords = (version >= FIRST_64_BIT_VERSION);
+    _position = BINARY_HEADER_SIZE;
+
+    // parse the top-level node
+    FBXNode top;
+    while (_position < _size) {
+        FBXNode next = readNode();
+        if (next.name.isNull()) {
+            return top;
+
+        } else {
+            top.children.append(next);
+        }
+    }
+
+    return top;
+}
+
 class Tokenizer {
 public:
 
@@ -297,7 +544,6 @@ FBXNode parseTextFBXNode(Tokenizer& tokenizer) {
 
 FBXNode FBXReader::parseFBX(QIODevice* device) {
     // verify the prolog
-    const QByteArray BINARY_PROLOG = "Kaydara FBX Binary  ";
     if (device->peek(BINARY_PROLOG.size()) != BINARY_PROLOG) {
         // parse as a text file
         FBXNode top;
@@ -313,17 +559,47 @@ FBXNode FBXReader::parseFBX(QIODevice* device) {
         }
         return top;
     }
+
+    // parse in place whenever the data is already in memory or can be mapped
+    if (QBuffer* buffer = qobject_cast<QBuffer*>(device)) {
+        const QByteArray& data = buffer->data();
+        return parseBinaryFBX(data.constData() + buffer->pos(), data.size() - buffer->pos());
+    }
+    if (QFile* file = qobject_cast<QFile*>(device)) {
+        qint64 size = file->size() - file->pos();
+        uchar* mapped = file->map(file->pos(), size);
+        if (mapped) {
+            FBXNode top;
+            try {
+                top = parseBinaryFBX((const char*)mapped, size);
+            } catch (...) {
+                file->unmap(mapped);
+                throw;
+            }
+            file->unmap(mapped);
+            return top;
+        }
+    }
+    if (!device->isSequential()) {
+        QByteArray data = device->readAll();
+        return parseBinaryFBX(data.constData(), data.size());
+    }
+    return parseBinaryFBX(device);
+}
+
+FBXNode FBXReader::parseBinaryFBX(const char* data, qint64 size) {
+    BinaryFBXParser parser(data, size);
+    return parser.parse();
+}
+
+FBXNode FBXReader::parseBinaryFBX(QIODevice* device) {
     QDataStream in(device);
     in.setByteOrder(QDataStream::LittleEndian);
     in.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
 
-    // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
-    // of the FBX binary format
-
     // skip the rest of the header
-    const int HEADER_SIZE = 27;
-    in.skipRawData(HEADER_SIZE);
-    int position = HEADER_SIZE;
+    in.skipRawData(BINARY_HEADER_SIZE);
+    int position = BINARY_HEADER_SIZE;
 
     // parse the top-level node
     FBXNode top;
@@ -0,0 +1,44 @@
+//
+//  PackedBlendshapes.cpp
+//  libraries/fbx/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PackedBlendshapes.h"
+
+PackedBlendshapes::PackedBlendshapes(const QVector<FBXMesh>& meshes) {
+    for (const FBXMesh& mesh : meshes) {
+        if (mesh.blendshapes.isEmpty()) {
+            continue;
+        }
+        int offset = numVertices;
+        baseVertices += mesh.vertices;
+        baseNormals += mesh.normals;
+        numVertices += mesh.vertices.size();
+
+        for (int i = 0; i < mesh.blendshapes.size(); i++) {
+            const FBXBlendshape& blendshape = mesh.blendshapes.at(i);
+            if (blendshape.indices.isEmpty()) {
+                continue;
+            }
+            blendshapes.push_back({ i, (int)indices.size(), blendshape.indices.size() });
+            for (int j = 0; j < blendshape.indices.size(); j++) {
+                indices.push_back(offset + blendshape.indices.at(j));
+                vertexDeltas.push_back(glm::vec4(blendshape.vertices.at(j), 0.0f));
+                normalDeltas.push_back(glm::vec4(blendshape.normals.at(j), 0.0f));
+            }
+        }
+    }
+    // keep the normals in step with the vertices even if a mesh is missing some
+    baseNormals.resize(numVertices);
+}
+
+size_t PackedBlendshapes::getMemoryUsage() const {
+    return (baseVertices.capacity() + baseNormals.capacity()) * sizeof(glm::vec3) +
+        blendshapes.capacity() * sizeof(Blendshape) + indices.capacity() * sizeof(int) +
+        (vertexDeltas.capacity() + normalDeltas.capacity()) * sizeof(glm::vec4);
+}
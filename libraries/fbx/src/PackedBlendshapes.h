@@ -0,0 +1,50 @@
+//
+//  PackedBlendshapes.h
+//  libraries/fbx/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PackedBlendshapes_h
+#define hifi_PackedBlendshapes_h
+
+#include <vector>
+
+#include <QVector>
+
+#include <glm/glm.hpp>
+
+#include "FBXReader.h"
+
+// The blendshapes of every blended mesh of a model, packed into flat arrays of vertex indices and deltas with the
+// vertex offset of their mesh folded into the indices. It never changes once built, so one is shared by every
+// model of the same geometry.
+//
+// The deltas are kept as padded vec4s rather than split into x, y and z arrays: they are added to vertices picked
+// by index, so each one is a single 16 byte load next to the 12 byte vertex it updates.
+class PackedBlendshapes {
+public:
+    struct Blendshape {
+        int coefficientIndex;
+        int firstDelta;
+        int numDeltas;
+    };
+
+    explicit PackedBlendshapes(const QVector<FBXMesh>& meshes);
+
+    size_t getMemoryUsage() const;
+
+    int numVertices { 0 };
+    QVector<glm::vec3> baseVertices;
+    QVector<glm::vec3> baseNormals;
+
+    std::vector<Blendshape> blendshapes;
+    std::vector<int> indices;
+    std::vector<glm::vec4> vertexDeltas; // w is always 0
+    std::vector<glm::vec4> normalDeltas;
+};
+
+#endif // hifi_PackedBlendshapes_h
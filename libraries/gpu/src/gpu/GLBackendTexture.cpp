@@ -398,6 +398,27 @@ public:
 };
 
 
+// Transfer the mips below level 0 which were provided through assignStoredMip instead of being generated by GL
+static void transferStoredSubMips2D(const Texture& texture) {
+    if (texture.isAutogenerateMips() || texture.maxMip() == 0) {
+        return;
+    }
+    uint16 maxMip = texture.maxMip();
+    for (uint16 level = 1; level <= maxMip; level++) {
+        if (texture.isStoredMipFaceAvailable(level)) {
+            Texture::PixelsPointer mip = texture.accessStoredMipFace(level);
+            GLTexelFormat texelFormat = GLTexelFormat::evalGLTexelFormat(texture.getTexelFormat(), mip->getFormat());
+
+            glTexImage2D(GL_TEXTURE_2D, level,
+                texelFormat.internalFormat, texture.evalMipWidth(level), texture.evalMipHeight(level), 0,
+                texelFormat.format, texelFormat.type, mip->readData());
+
+            texture.notifyMipFaceGPULoaded(level, 0);
+        }
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, maxMip);
+}
+
 GLBackend::GLTexture* GLBackend::syncGPUObject(const Texture& texture) {
     GLTexture* object = Backend::getGPUObject<GLBackend::GLTexture>(texture);
 
@@ -449,6 +470,8 @@ GLBackend::GLTexture* GLBackend::syncGPUObject(const Texture& texture) {
                     if (texture.isAutogenerateMips()) {
                         glGenerateMipmap(GL_TEXTURE_2D);
                         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+                    } else {
+                        transferStoredSubMips2D(texture);
                     }
 
                 object->_target = GL_TEXTURE_2D;
@@ -482,6 +505,8 @@ GLBackend::GLTexture* GLBackend::syncGPUObject(const Texture& texture) {
                 if (bytes && texture.isAutogenerateMips()) {
                     glGenerateMipmap(GL_TEXTURE_2D);
                     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+                } else if (bytes) {
+                    transferStoredSubMips2D(texture);
                 }
                 object->_target = GL_TEXTURE_2D;
 
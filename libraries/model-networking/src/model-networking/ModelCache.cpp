@@ -17,8 +17,12 @@
 #include <gpu/Batch.h>
 #include <gpu/Stream.h>
 
+#include <QMutex>
+#include <QMutexLocker>
 #include <QThreadPool>
 
+#include <shared/NsightHelpers.h>
+
 #include "ModelNetworkingLogging.h"
 
 class GeometryReader;
@@ -36,6 +40,8 @@ public:
 
     virtual void downloadFinished(const QByteArray& data) override;
 
+    virtual void setLoadPriority(const QPointer<QObject>& owner, float priority) override;
+
 private slots:
     void onGeometryMappingLoaded(bool success);
 
@@ -79,11 +85,21 @@ void GeometryMappingResource::downloadFinished(const QByteArray& data) {
     }
 }
 
+void GeometryMappingResource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
+    GeometryResource::setLoadPriority(owner, priority);
+    // the mapped model is requested once the mapping arrives, and keeps its place in the queue
+    if (_geometryResource) {
+        _geometryResource->setLoadPriority(owner, priority);
+    }
+}
+
 void GeometryMappingResource::onGeometryMappingLoaded(bool success) {
     if (success) {
         _geometry = _geometryResource->_geometry;
         _shapes = _geometryResource->_shapes;
         _meshes = _geometryResource->_meshes;
+        _triangleBVHs = _geometryResource->_triangleBVHs;
+        _packedBlendshapes = _geometryResource->_packedBlendshapes;
         _materials = _geometryResource->_materials;
     }
     finishedLoading(success);
@@ -153,6 +169,68 @@ void GeometryReader::run() {
     QThread::currentThread()->setPriority(originalPriority);
 }
 
+class TriangleBVHCache {
+public:
+    QMutex mutex;
+    std::shared_ptr<const Geometry::TriangleBVHs> bvhs;
+    bool building { false };
+};
+
+class PackedBlendshapesCache {
+public:
+    QMutex mutex;
+    std::shared_ptr<const PackedBlendshapes> blendshapes;
+};
+
+class TriangleBVHBuilder : public QRunnable {
+public:
+    TriangleBVHBuilder(const std::shared_ptr<const FBXGeometry>& geometry, const std::shared_ptr<TriangleBVHCache>& cache) :
+        _geometry(geometry), _cache(cache) {}
+
+    virtual void run() override;
+
+private:
+    std::shared_ptr<const FBXGeometry> _geometry;
+    std::weak_ptr<TriangleBVHCache> _cache;
+};
+
+void TriangleBVHBuilder::run() {
+    PROFILE_RANGE(__FUNCTION__);
+    auto bvhs = std::make_shared<Geometry::TriangleBVHs>();
+    bvhs->reserve(_geometry->meshes.size());
+    for (const FBXMesh& mesh : _geometry->meshes) {
+        std::vector<Triangle> triangles;
+        auto getVertex = [&](int index) {
+            return glm::vec3(mesh.modelTransform * glm::vec4(mesh.vertices[index], 1.0f));
+        };
+        for (const FBXMeshPart& part : mesh.parts) {
+            const int INDICES_PER_QUAD = 4;
+            for (int i = 0; i + INDICES_PER_QUAD <= part.quadIndices.size(); i += INDICES_PER_QUAD) {
+                glm::vec3 v0 = getVertex(part.quadIndices[i]);
+                glm::vec3 v1 = getVertex(part.quadIndices[i + 1]);
+                glm::vec3 v2 = getVertex(part.quadIndices[i + 2]);
+                glm::vec3 v3 = getVertex(part.quadIndices[i + 3]);
+
+                // same slices as Model::recalculateMeshBoxes
+                triangles.push_back({ v0, v1, v3 });
+                triangles.push_back({ v1, v2, v3 });
+            }
+            const int INDICES_PER_TRIANGLE = 3;
+            for (int i = 0; i + INDICES_PER_TRIANGLE <= part.triangleIndices.size(); i += INDICES_PER_TRIANGLE) {
+                triangles.push_back({ getVertex(part.triangleIndices[i]), getVertex(part.triangleIndices[i + 1]),
+                    getVertex(part.triangleIndices[i + 2]) });
+            }
+        }
+        bvhs->emplace_back(triangles);
+    }
+
+    auto cache = _cache.lock();
+    if (cache) {
+        QMutexLocker locker(&cache->mutex);
+        cache->bvhs = bvhs;
+    }
+}
+
 class GeometryDefinitionResource : public GeometryResource {
     Q_OBJECT
 public:
@@ -200,6 +278,8 @@ void GeometryDefinitionResource::setGeometryDefinition(void* fbxGeometry) {
     }
     _meshes = meshes;
     _shapes = shapes;
+    _triangleBVHs = std::make_shared<TriangleBVHCache>();
+    _packedBlendshapes = std::make_shared<PackedBlendshapesCache>();
 
     finishedLoading(true);
 }
@@ -247,6 +327,8 @@ Geometry::Geometry(const Geometry& geometry) {
     _geometry = geometry._geometry;
     _meshes = geometry._meshes;
     _shapes = geometry._shapes;
+    _triangleBVHs = geometry._triangleBVHs;
+    _packedBlendshapes = geometry._packedBlendshapes;
 
     _materials.reserve(geometry._materials.size());
     for (const auto& material : geometry._materials) {
@@ -254,6 +336,29 @@ Geometry::Geometry(const Geometry& geometry) {
     }
 }
 
+std::shared_ptr<const Geometry::TriangleBVHs> Geometry::getTriangleBVHs() const {
+    if (!_triangleBVHs) {
+        return nullptr;
+    }
+    QMutexLocker locker(&_triangleBVHs->mutex);
+    if (!_triangleBVHs->bvhs && !_triangleBVHs->building) {
+        _triangleBVHs->building = true;
+        QThreadPool::globalInstance()->start(new TriangleBVHBuilder(_geometry, _triangleBVHs));
+    }
+    return _triangleBVHs->bvhs;
+}
+
+std::shared_ptr<const PackedBlendshapes> Geometry::getPackedBlendshapes() const {
+    if (!_packedBlendshapes) {
+        return std::make_shared<PackedBlendshapes>(_geometry->meshes);
+    }
+    QMutexLocker locker(&_packedBlendshapes->mutex);
+    if (!_packedBlendshapes->blendshapes) {
+        _packedBlendshapes->blendshapes = std::make_shared<PackedBlendshapes>(_geometry->meshes);
+    }
+    return _packedBlendshapes->blendshapes;
+}
+
 void Geometry::setTextures(const QVariantMap& textureMap) {
     if (_meshes->size() > 0) {
         for (auto& material : _materials) {
@@ -277,6 +382,16 @@ void Geometry::setTextures(const QVariantMap& textureMap) {
     }
 }
 
+void Geometry::setTextureLoadPriority(const QPointer<QObject>& owner, float priority) {
+    for (auto& material : _materials) {
+        for (auto& texture : material->_textures) {
+            if (texture.texture) {
+                texture.texture->setLoadPriority(owner, priority);
+            }
+        }
+    }
+}
+
 bool Geometry::areTexturesLoaded() const {
     if (!_areTexturesLoaded) {
         _hasTransparentTextures = false;
@@ -321,6 +436,13 @@ NetworkGeometry::NetworkGeometry(const GeometryResource::Pointer& networkGeometr
     }
 }
 
+void NetworkGeometry::setLoadPriority(const QPointer<QObject>& owner, float priority) {
+    _resource->setLoadPriority(owner, priority);
+    if (_instance) {
+        _instance->setTextureLoadPriority(owner, priority);
+    }
+}
+
 void NetworkGeometry::resourceFinished(bool success) {
     // FIXME: Model is not set up to handle a refresh
     if (_instance) {
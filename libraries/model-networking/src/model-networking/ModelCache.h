@@ -14,11 +14,13 @@
 
 #include <DependencyManager.h>
 #include <ResourceCache.h>
+#include <TriangleBVH.h>
 
 #include <model/Material.h>
 #include <model/Asset.h>
 
 #include "FBXReader.h"
+#include "PackedBlendshapes.h"
 #include "TextureCache.h"
 
 // Alias instead of derive to avoid copying
@@ -28,6 +30,8 @@ class NetworkTexture;
 class NetworkMaterial;
 class NetworkShape;
 class NetworkGeometry;
+class TriangleBVHCache;
+class PackedBlendshapesCache;
 
 class GeometryMappingResource;
 
@@ -66,14 +70,28 @@ public:
     // Mutable, but must retain structure of vector
     using NetworkMaterials = std::vector<std::shared_ptr<NetworkMaterial>>;
 
+    // One per FBXMesh, over the mesh's triangles with its modelTransform applied
+    using TriangleBVHs = std::vector<TriangleBVH>;
+
     const FBXGeometry& getGeometry() const { return *_geometry; }
     const NetworkMeshes& getMeshes() const { return *_meshes; }
     const std::shared_ptr<const NetworkMaterial> getShapeMaterial(int shapeID) const;
 
+    // Shared by every copy of this geometry.  The first call starts building them on a worker thread,
+    // until they are ready this returns null.
+    std::shared_ptr<const TriangleBVHs> getTriangleBVHs() const;
+
+    // Shared by every copy of this geometry, packed by the first caller.
+    std::shared_ptr<const PackedBlendshapes> getPackedBlendshapes() const;
+
     const QVariantMap getTextures() const;
     void setTextures(const QVariantMap& textureMap);
 
     virtual bool areTexturesLoaded() const;
+
+    /// Sets the load priority of the textures for one owner.
+    void setTextureLoadPriority(const QPointer<QObject>& owner, float priority);
+
     // Returns true if any albedo texture has a non-masking alpha channel.
     // This can only be known after areTexturesLoaded().
     bool hasTransparentTextures() const { return _hasTransparentTextures; }
@@ -86,6 +104,9 @@ protected:
     std::shared_ptr<const NetworkMeshes> _meshes;
     std::shared_ptr<const NetworkShapes> _shapes;
 
+    std::shared_ptr<TriangleBVHCache> _triangleBVHs;
+    std::shared_ptr<PackedBlendshapesCache> _packedBlendshapes;
+
     // Copied to each geometry, mutable throughout lifetime via setTextures
     NetworkMaterials _materials;
 
@@ -124,6 +145,9 @@ public:
     /// Returns the geometry, if it is loaded (must be checked!)
     const Geometry::Pointer& getGeometry() { return _instance; }
 
+    /// Sets the load priority of the geometry and its textures for one owner.
+    void setLoadPriority(const QPointer<QObject>& owner, float priority);
+
 signals:
     /// Emitted when the NetworkGeometry loads (or fails to)
     void finished(bool success);
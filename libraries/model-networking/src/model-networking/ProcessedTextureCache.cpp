@@ -0,0 +1,182 @@
+//
+//  ProcessedTextureCache.cpp
+//  libraries/model-networking/src/model-networking
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ProcessedTextureCache.h"
+
+#include <cstring>
+
+#include <QCryptographicHash>
+
+#include <ResourceCache.h>
+
+const qint64 ProcessedTextureCache::DEFAULT_MAXIMUM_SIZE = 2 * BYTES_PER_GIGABYTES;
+const QString ProcessedTextureCache::FILE_EXTENSION = ".hftex";
+
+// bump whenever the layout or the TextureUsage processing changes, older entries are then never hit again
+static const quint32 CACHE_VERSION = 1;
+static const char CACHE_MAGIC[4] = { 'H', 'F', 'T', 'X' };
+static const int MIP_ALIGNMENT = 16;
+
+namespace {
+
+struct Header {
+    char magic[4];
+    quint32 version;
+    quint8 texelSemantic;
+    quint8 texelDimension;
+    quint8 texelType;
+    quint8 mipSemantic;
+    quint8 mipDimension;
+    quint8 mipType;
+    quint16 usage;
+    quint16 width;
+    quint16 height;
+    quint16 numMips;
+    quint16 padding;
+    qint32 originalWidth;
+    qint32 originalHeight;
+};
+
+struct MipEntry {
+    quint32 offset;
+    quint32 size;
+};
+
+}
+
+static qint64 alignMipOffset(qint64 offset) {
+    return (offset + MIP_ALIGNMENT - 1) & ~(qint64)(MIP_ALIGNMENT - 1);
+}
+
+ProcessedTextureCache::ProcessedTextureCache(const QString& directory, qint64 maximumSize) :
+    _files(directory, FILE_EXTENSION, maximumSize)
+{
+}
+
+QByteArray ProcessedTextureCache::computeKey(const QByteArray& content, int textureType) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(content);
+    hash.addData(reinterpret_cast<const char*>(&textureType), sizeof(textureType));
+    hash.addData(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+    return hash.result().toHex();
+}
+
+bool ProcessedTextureCache::isCacheable(const gpu::Texture& texture) {
+    if (texture.getType() != gpu::Texture::TEX_2D || texture.getNumSlices() != 1 || texture.isAutogenerateMips()) {
+        return false;
+    }
+    // only complete mip chains, so a hit gives the same texture as processing the image again
+    if (texture.maxMip() != texture.evalNumMips() - 1) {
+        return false;
+    }
+    for (uint16_t level = 0; level <= texture.maxMip(); level++) {
+        if (!texture.isStoredMipFaceAvailable(level)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QByteArray ProcessedTextureCache::serialize(const gpu::Texture& texture, int originalWidth, int originalHeight) {
+    if (!isCacheable(texture)) {
+        return QByteArray();
+    }
+
+    uint16_t numMips = texture.maxMip() + 1;
+    const gpu::Element& texelFormat = texture.getTexelFormat();
+    const gpu::Element& mipFormat = texture.accessStoredMipFace(0)->getFormat();
+
+    Header header;
+    memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.version = CACHE_VERSION;
+    header.texelSemantic = texelFormat.getSemantic();
+    header.texelDimension = texelFormat.getDimension();
+    header.texelType = texelFormat.getType();
+    header.mipSemantic = mipFormat.getSemantic();
+    header.mipDimension = mipFormat.getDimension();
+    header.mipType = mipFormat.getType();
+    header.usage = (quint16)texture.getUsage()._flags.to_ulong();
+    header.width = texture.getWidth();
+    header.height = texture.getHeight();
+    header.numMips = numMips;
+    header.padding = 0;
+    header.originalWidth = originalWidth;
+    header.originalHeight = originalHeight;
+
+    std::vector<MipEntry> mipEntries(numMips);
+    qint64 offset = sizeof(Header) + numMips * sizeof(MipEntry);
+    for (uint16_t level = 0; level < numMips; level++) {
+        offset = alignMipOffset(offset);
+        mipEntries[level].offset = (quint32)offset;
+        mipEntries[level].size = (quint32)texture.accessStoredMipFace(level)->getSize();
+        offset += mipEntries[level].size;
+    }
+
+    QByteArray data(offset, 0);
+    char* bytes = data.data();
+    memcpy(bytes, &header, sizeof(Header));
+    memcpy(bytes + sizeof(Header), mipEntries.data(), numMips * sizeof(MipEntry));
+    for (uint16_t level = 0; level < numMips; level++) {
+        memcpy(bytes + mipEntries[level].offset, texture.accessStoredMipFace(level)->readData(), mipEntries[level].size);
+    }
+    return data;
+}
+
+gpu::Texture* ProcessedTextureCache::deserialize(const char* data, qint64 size, int& originalWidth, int& originalHeight) {
+    Header header;
+    if (size < (qint64)sizeof(Header)) {
+        return nullptr;
+    }
+    memcpy(&header, data, sizeof(Header));
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(header.magic)) != 0 || header.version != CACHE_VERSION) {
+        return nullptr;
+    }
+    if (header.width == 0 || header.height == 0 || header.numMips == 0 ||
+        size < (qint64)(sizeof(Header) + header.numMips * sizeof(MipEntry))) {
+        return nullptr;
+    }
+    if (header.texelSemantic >= gpu::NUM_SEMANTICS || header.texelDimension >= gpu::NUM_DIMENSIONS ||
+        header.texelType >= gpu::NUM_TYPES || header.mipSemantic >= gpu::NUM_SEMANTICS ||
+        header.mipDimension >= gpu::NUM_DIMENSIONS || header.mipType >= gpu::NUM_TYPES) {
+        return nullptr;
+    }
+
+    gpu::Element texelFormat((gpu::Dimension)header.texelDimension, (gpu::Type)header.texelType,
+                             (gpu::Semantic)header.texelSemantic);
+    gpu::Element mipFormat((gpu::Dimension)header.mipDimension, (gpu::Type)header.mipType, (gpu::Semantic)header.mipSemantic);
+
+    auto texture = gpu::Texture::create2D(texelFormat, header.width, header.height,
+                                          gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR));
+    texture->setUsage(gpu::Texture::Usage(gpu::Texture::Usage::Flags(header.usage)));
+
+    const char* mipEntries = data + sizeof(Header);
+    for (uint16_t level = 0; level < header.numMips; level++) {
+        MipEntry entry;
+        memcpy(&entry, mipEntries + level * sizeof(MipEntry), sizeof(MipEntry));
+        if ((qint64)entry.offset + entry.size > size ||
+            !texture->assignStoredMip(level, mipFormat, entry.size, reinterpret_cast<const gpu::Byte*>(data + entry.offset))) {
+            delete texture;
+            return nullptr;
+        }
+    }
+
+    originalWidth = header.originalWidth;
+    originalHeight = header.originalHeight;
+    return texture;
+}
+
+gpu::Texture* ProcessedTextureCache::load(const QByteArray& key, int& originalWidth, int& originalHeight) {
+    gpu::Texture* texture = nullptr;
+    _files.read(key, [&](const char* data, qint64 size) {
+        texture = deserialize(data, size, originalWidth, originalHeight);
+        return texture != nullptr;
+    });
+    return texture;
+}
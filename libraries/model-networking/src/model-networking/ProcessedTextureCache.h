@@ -0,0 +1,68 @@
+//
+//  ProcessedTextureCache.h
+//  libraries/model-networking/src/model-networking
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ProcessedTextureCache_h
+#define hifi_ProcessedTextureCache_h
+
+#include <QByteArray>
+#include <QString>
+
+#include <FileCache.h>
+#include <gpu/Texture.h>
+
+/// A disk cache of textures which went through TextureUsage processing, mips included, so that loading
+/// the same image content again skips decoding and processing entirely.
+///
+/// Entries are keyed by a hash of the source image bytes and the texture type. Each one is a single file
+/// laid out so it can be mapped and handed to the texture without parsing:
+///
+///    Header | MipEntry[numMips] | mip data, each level aligned to 16 bytes
+///
+/// The least recently used entries are evicted once the total size goes over the maximum.
+class ProcessedTextureCache {
+public:
+    static const qint64 DEFAULT_MAXIMUM_SIZE;
+    static const QString FILE_EXTENSION;
+
+    ProcessedTextureCache(const QString& directory, qint64 maximumSize = DEFAULT_MAXIMUM_SIZE);
+
+    static QByteArray computeKey(const QByteArray& content, int textureType);
+
+    /// Only 2D textures with all their mips stored in sysmem can be cached.
+    static bool isCacheable(const gpu::Texture& texture);
+
+    /// Must be called before the texture is handed to the gpu, since that releases the sysmem mips.
+    static QByteArray serialize(const gpu::Texture& texture, int originalWidth, int originalHeight);
+    static gpu::Texture* deserialize(const char* data, qint64 size, int& originalWidth, int& originalHeight);
+
+    /// Returns a new texture on a hit, nullptr otherwise.  Thread safe.
+    gpu::Texture* load(const QByteArray& key, int& originalWidth, int& originalHeight);
+
+    /// Writes a serialized texture, evicting old entries if needed.  Thread safe.
+    bool store(const QByteArray& key, const QByteArray& data) { return _files.write(key, data); }
+
+    void clear() { _files.clear(); }
+
+    const QString& getDirectory() const { return _files.getDirectory(); }
+    void setMaximumSize(qint64 maximumSize) { _files.setMaximumSize(maximumSize); }
+    qint64 getMaximumSize() const { return _files.getMaximumSize(); }
+    qint64 getSize() const { return _files.getSize(); }
+    int getNumEntries() const { return _files.getNumEntries(); }
+
+    int getNumHits() const { return _files.getNumHits(); }
+    int getNumMisses() const { return _files.getNumMisses(); }
+    int getNumEvictions() const { return _files.getNumEvictions(); }
+    float getHitRate() const { return _files.getHitRate(); }
+
+private:
+    FileCache _files;
+};
+
+#endif // hifi_ProcessedTextureCache_h
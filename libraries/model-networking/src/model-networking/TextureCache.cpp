@@ -19,6 +19,7 @@
 #include <QNetworkReply>
 #include <QPainter>
 #include <QRunnable>
+#include <QStandardPaths>
 #include <QThreadPool>
 #include <qimagereader.h>
 #include <PathUtils.h>
@@ -30,6 +31,10 @@
 TextureCache::TextureCache() {
     const qint64 TEXTURE_DEFAULT_UNUSED_MAX_SIZE = DEFAULT_UNUSED_MAX_SIZE;
     setUnusedResourceCacheSize(TEXTURE_DEFAULT_UNUSED_MAX_SIZE);
+
+    QString cachePath = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+    cachePath = !cachePath.isEmpty() ? cachePath : "interfaceCache";
+    _processedTextureCache = std::make_shared<ProcessedTextureCache>(cachePath + "/processedTextures");
 }
 
 TextureCache::~TextureCache() {
@@ -241,7 +246,8 @@ NetworkTexture::TextureLoaderFunc NetworkTexture::getTextureLoader() const {
 class ImageReader : public QRunnable {
 public:
 
-    ImageReader(const QWeakPointer<Resource>& texture, const QByteArray& data, const QUrl& url = QUrl());
+    ImageReader(const QWeakPointer<Resource>& texture, const QByteArray& data, const QUrl& url = QUrl(),
+                std::shared_ptr<ProcessedTextureCache> processedTextureCache = nullptr, TextureType type = DEFAULT_TEXTURE);
 
     virtual void run();
 
@@ -251,22 +257,37 @@ private:
     QWeakPointer<Resource> _texture;
     QUrl _url;
     QByteArray _content;
+    std::shared_ptr<ProcessedTextureCache> _processedTextureCache;
+    TextureType _type;
 };
 
 void NetworkTexture::downloadFinished(const QByteArray& data) {
-    // send the reader off to the thread pool
-    QThreadPool::globalInstance()->start(new ImageReader(_self, data, _url));
+    startImageReader(data);
 }
 
 void NetworkTexture::loadContent(const QByteArray& content) {
-    QThreadPool::globalInstance()->start(new ImageReader(_self, content, _url));
+    startImageReader(content);
+}
+
+void NetworkTexture::startImageReader(const QByteArray& content) {
+    // cube maps also carry their irradiance, and custom loaders are unknown to the cache key
+    std::shared_ptr<ProcessedTextureCache> processedTextureCache;
+    auto textureCache = DependencyManager::get<TextureCache>();
+    if (textureCache && _type != CUBE_TEXTURE && _type != CUSTOM_TEXTURE) {
+        processedTextureCache = textureCache->getProcessedTextureCache();
+    }
+
+    // send the reader off to the thread pool
+    QThreadPool::globalInstance()->start(new ImageReader(_self, content, _url, processedTextureCache, _type));
 }
 
 ImageReader::ImageReader(const QWeakPointer<Resource>& texture, const QByteArray& data,
-        const QUrl& url) :
+        const QUrl& url, std::shared_ptr<ProcessedTextureCache> processedTextureCache, TextureType type) :
     _texture(texture),
     _url(url),
-    _content(data)
+    _content(data),
+    _processedTextureCache(processedTextureCache),
+    _type(type)
 {
 }
 
@@ -291,6 +312,22 @@ void ImageReader::run() {
         return;
     }
 
+    // a texture processed in an earlier session skips decoding altogether
+    QByteArray processedTextureKey;
+    if (_processedTextureCache) {
+        processedTextureKey = ProcessedTextureCache::computeKey(_content, _type);
+        int originalWidth = 0;
+        int originalHeight = 0;
+        gpu::Texture* theTexture = _processedTextureCache->load(processedTextureKey, originalWidth, originalHeight);
+        if (theTexture) {
+            QMetaObject::invokeMethod(texture.data(), "setImage",
+                Q_ARG(void*, theTexture),
+                Q_ARG(int, originalWidth), Q_ARG(int, originalHeight));
+            QThread::currentThread()->setPriority(originalPriority);
+            return;
+        }
+    }
+
     listSupportedImageFormats();
 
     // try to help the QImage loader by extracting the image file format from the url filename ext
@@ -319,9 +356,19 @@ void ImageReader::run() {
         theTexture = ntex->getTextureLoader()(image, _url.toString().toStdString());
     }
 
+    // serialize before handing the texture over, its sysmem mips are released once it reaches the gpu
+    QByteArray processedTexture;
+    if (_processedTextureCache && theTexture) {
+        processedTexture = ProcessedTextureCache::serialize(*theTexture, originalWidth, originalHeight);
+    }
+
     QMetaObject::invokeMethod(texture.data(), "setImage", 
         Q_ARG(void*, theTexture),
         Q_ARG(int, originalWidth), Q_ARG(int, originalHeight));
+
+    if (!processedTexture.isEmpty()) {
+        _processedTextureCache->store(processedTextureKey, processedTexture);
+    }
     QThread::currentThread()->setPriority(originalPriority);
 }
 
@@ -22,6 +22,8 @@
 #include <ResourceCache.h>
 #include <model/TextureMap.h>
 
+#include "ProcessedTextureCache.h"
+
 namespace gpu {
 class Batch;
 }
@@ -80,6 +82,10 @@ public:
     typedef gpu::Texture* TextureLoader(const QImage& image, const std::string& srcImageName);
     
     typedef std::function<TextureLoader> TextureLoaderFunc;
+
+    /// The disk cache of processed textures, shared with the image readers.
+    std::shared_ptr<ProcessedTextureCache> getProcessedTextureCache() const { return _processedTextureCache; }
+
 protected:
 
     virtual QSharedPointer<Resource> createResource(const QUrl& url,
@@ -96,6 +102,8 @@ private:
     gpu::TexturePointer _blueTexture;
     gpu::TexturePointer _blackTexture;
     gpu::TexturePointer _normalFittingTexture;
+
+    std::shared_ptr<ProcessedTextureCache> _processedTextureCache;
 };
 
 /// A simple object wrapper for an OpenGL texture.
@@ -122,6 +130,7 @@ public:
     int getWidth() const { return _width; }
     int getHeight() const { return _height; }
     
+    TextureType getTextureType() const { return _type; }
     TextureLoaderFunc getTextureLoader() const;
 
 signals:
@@ -138,6 +147,7 @@ protected:
     // FIXME: This void* should be a gpu::Texture* but i cannot get it to work for now, moving on...
     Q_INVOKABLE void setImage(void* texture, int originalWidth, int originalHeight);
 
+    void startImageReader(const QByteArray& content);
 
 private:
     TextureType _type;
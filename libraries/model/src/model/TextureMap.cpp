@@ -15,6 +15,7 @@
 #include <QDebug>
 
 #include "ModelLogging.h"
+#include "TextureProcessing.h"
 
 using namespace model;
 using namespace gpu;
@@ -50,43 +51,68 @@ void TextureMap::setLightmapOffsetScale(float offset, float scale) {
 }
 
 
+// The scanline processing works on 32 bit images, which is what most image loaders give us anyway
+static QImage convertTo32Bit(const QImage& image) {
+    if (image.format() == QImage::Format_ARGB32 || image.format() == QImage::Format_RGB32) {
+        return image;
+    }
+    return image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32 : QImage::Format_RGB32);
+}
+
+static QImage convertToRGB888(const QImage& image) {
+    if (image.format() == QImage::Format_RGB888) {
+        return image;
+    }
+    return TextureProcessing::convertToRGB888(convertTo32Bit(image));
+}
+
+// Opaque images are converted to RGB888, the others to ARGB32
+static QImage convertToRGB888OrARGB32(const QImage& image) {
+    if (!image.hasAlphaChannel()) {
+        return convertToRGB888(image);
+    }
+    if (image.format() != QImage::Format_ARGB32) {
+        return image.convertToFormat(QImage::Format_ARGB32);
+    }
+    return image;
+}
+
+// Converts opaque images to RGB888, including those with an alpha channel which is fully opaque, and the others to ARGB32.
+// Returns the stats of the image colors.
+static TextureProcessing::ImageStats convertToRGB888OrAnalyzedARGB32(QImage& image, const std::string& srcImageName) {
+    bool hasAlphaChannel = image.hasAlphaChannel();
+    image = convertTo32Bit(image);
+    auto stats = TextureProcessing::analyzeImage(image);
+    if (hasAlphaChannel && !stats.hasValidAlpha()) {
+        qCDebug(modelLog) << "Image with alpha channel is completely opaque:" << QString(srcImageName.c_str());
+    }
+    if (!stats.hasValidAlpha()) {
+        image = TextureProcessing::convertToRGB888(image);
+    }
+    return stats;
+}
+
 // FIXME why is this in the model library?  Move to GPU or GPU_GL
 gpu::Texture* TextureUsage::create2DTextureFromImage(const QImage& srcImage, const std::string& srcImageName) {
     QImage image = srcImage;
     bool validAlpha = false;
     bool alphaAsMask = true;
-    const uint8 OPAQUE_ALPHA = 255;
-    const uint8 TRANSPARENT_ALPHA = 0;
     if (image.hasAlphaChannel()) {
-        std::map<uint8, uint32> alphaHistogram;
-
         if (image.format() != QImage::Format_ARGB32) {
             image = image.convertToFormat(QImage::Format_ARGB32);
         }
-        
-        // Actual alpha channel? create the histogram
-        for (int y = 0; y < image.height(); ++y) {
-            const QRgb* data = reinterpret_cast<const QRgb*>(image.constScanLine(y));
-            for (int x = 0; x < image.width(); ++x) {
-                auto alpha = qAlpha(data[x]);
-                alphaHistogram[alpha] ++;
-                validAlpha = validAlpha || (alpha != OPAQUE_ALPHA);
-            }
-        }
 
-        // If alpha was meaningfull refine
-        if (validAlpha && (alphaHistogram.size() > 1)) {
-            auto totalNumPixels = image.height() * image.width();
-            auto numOpaques = alphaHistogram[OPAQUE_ALPHA];
-            auto numTransparents = alphaHistogram[TRANSPARENT_ALPHA];
-            auto numTranslucents = totalNumPixels - numOpaques - numTransparents;
+        auto stats = TextureProcessing::analyzeImage(image);
+        validAlpha = stats.hasValidAlpha();
 
-            alphaAsMask = ((numTranslucents / (double)totalNumPixels) < 0.05);
+        // If alpha was meaningfull refine
+        if (validAlpha && !stats.isAlphaUniform()) {
+            alphaAsMask = ((stats.getNumTranslucent() / (double)stats.numPixels) < 0.05);
         }
     } 
     
-    if (!validAlpha && image.format() != QImage::Format_RGB888) {
-        image = image.convertToFormat(QImage::Format_RGB888);
+    if (!validAlpha) {
+        image = convertToRGB888(image);
     }
     
     gpu::Texture* theTexture = nullptr;
@@ -113,7 +139,7 @@ gpu::Texture* TextureUsage::create2DTextureFromImage(const QImage& srcImage, con
         theTexture->setUsage(usage.build());
 
         theTexture->assignStoredMip(0, formatMip, image.byteCount(), image.constBits());
-        theTexture->autoGenerateMips(-1);
+        TextureProcessing::assignMips(theTexture, formatMip, image);
         
         // FIXME queue for transfer to GPU and block on completion
 
@@ -124,17 +150,7 @@ gpu::Texture* TextureUsage::create2DTextureFromImage(const QImage& srcImage, con
 
 
 gpu::Texture* TextureUsage::createNormalTextureFromNormalImage(const QImage& srcImage, const std::string& srcImageName) {
-    QImage image = srcImage;
-
-    if (!image.hasAlphaChannel()) {
-        if (image.format() != QImage::Format_RGB888) {
-            image = image.convertToFormat(QImage::Format_RGB888);
-        }
-    } else {
-        if (image.format() != QImage::Format_ARGB32) {
-            image = image.convertToFormat(QImage::Format_ARGB32);
-        }
-    }
+    QImage image = convertToRGB888OrARGB32(srcImage);
 
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
@@ -150,7 +166,7 @@ gpu::Texture* TextureUsage::createNormalTextureFromNormalImage(const QImage& src
 
         theTexture = (gpu::Texture::create2D(formatGPU, image.width(), image.height(), gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
         theTexture->assignStoredMip(0, formatMip, image.byteCount(), image.constBits());
-        theTexture->autoGenerateMips(-1);
+        TextureProcessing::assignMips(theTexture, formatMip, image);
     }
 
     return theTexture;
@@ -169,7 +185,7 @@ double mapComponent(double sobelValue) {
 }
 
 gpu::Texture* TextureUsage::createNormalTextureFromBumpImage(const QImage& srcImage, const std::string& srcImageName) {
-    QImage image = srcImage;
+    QImage image = convertToRGB888OrARGB32(srcImage);
     
 
     #if 0
@@ -241,25 +257,14 @@ gpu::Texture* TextureUsage::createNormalTextureFromBumpImage(const QImage& srcIm
         
         theTexture = (gpu::Texture::create2D(formatGPU, image.width(), image.height(), gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
         theTexture->assignStoredMip(0, formatMip, image.byteCount(), image.constBits());
-        theTexture->autoGenerateMips(-1);
+        TextureProcessing::assignMips(theTexture, formatMip, image);
     }
     
     return theTexture;
 }
 
 gpu::Texture* TextureUsage::createRoughnessTextureFromImage(const QImage& srcImage, const std::string& srcImageName) {
-    QImage image = srcImage;
-    if (!image.hasAlphaChannel()) {
-        if (image.format() != QImage::Format_RGB888) {
-            image = image.convertToFormat(QImage::Format_RGB888);
-        }
-    } else {
-        if (image.format() != QImage::Format_ARGB32) {
-            image = image.convertToFormat(QImage::Format_ARGB32);
-        }
-    }
-
-    image = image.convertToFormat(QImage::Format_Grayscale8);
+    QImage image = TextureProcessing::convertToGrayscale8(convertTo32Bit(srcImage));
 
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
@@ -269,7 +274,7 @@ gpu::Texture* TextureUsage::createRoughnessTextureFromImage(const QImage& srcIma
 
         theTexture = (gpu::Texture::create2D(formatGPU, image.width(), image.height(), gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
         theTexture->assignStoredMip(0, formatMip, image.byteCount(), image.constBits());
-        theTexture->autoGenerateMips(-1);
+        TextureProcessing::assignMips(theTexture, formatMip, image);
 
         // FIXME queue for transfer to GPU and block on completion
     }
@@ -278,21 +283,8 @@ gpu::Texture* TextureUsage::createRoughnessTextureFromImage(const QImage& srcIma
 }
 
 gpu::Texture* TextureUsage::createRoughnessTextureFromGlossImage(const QImage& srcImage, const std::string& srcImageName) {
-    QImage image = srcImage;
-    if (!image.hasAlphaChannel()) {
-        if (image.format() != QImage::Format_RGB888) {
-            image = image.convertToFormat(QImage::Format_RGB888);
-        }
-    } else {
-        if (image.format() != QImage::Format_ARGB32) {
-            image = image.convertToFormat(QImage::Format_ARGB32);
-        }
-    }
-
     // Gloss turned into Rough
-    image.invertPixels(QImage::InvertRgba);
-    
-    image = image.convertToFormat(QImage::Format_Grayscale8);
+    QImage image = TextureProcessing::convertToGrayscale8(convertTo32Bit(srcImage), true);
     
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
@@ -302,7 +294,7 @@ gpu::Texture* TextureUsage::createRoughnessTextureFromGlossImage(const QImage& s
         
         theTexture = (gpu::Texture::create2D(formatGPU, image.width(), image.height(), gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
         theTexture->assignStoredMip(0, formatMip, image.byteCount(), image.constBits());
-        theTexture->autoGenerateMips(-1);
+        TextureProcessing::assignMips(theTexture, formatMip, image);
         
         // FIXME queue for transfer to GPU and block on completion
     }
@@ -311,18 +303,7 @@ gpu::Texture* TextureUsage::createRoughnessTextureFromGlossImage(const QImage& s
 }
 
 gpu::Texture* TextureUsage::createMetallicTextureFromImage(const QImage& srcImage, const std::string& srcImageName) {
-    QImage image = srcImage;
-    if (!image.hasAlphaChannel()) {
-        if (image.format() != QImage::Format_RGB888) {
-            image = image.convertToFormat(QImage::Format_RGB888);
-        }
-    } else {
-        if (image.format() != QImage::Format_ARGB32) {
-            image = image.convertToFormat(QImage::Format_ARGB32);
-        }
-    }
-
-    image = image.convertToFormat(QImage::Format_Grayscale8);
+    QImage image = TextureProcessing::convertToGrayscale8(convertTo32Bit(srcImage));
 
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
@@ -332,7 +313,7 @@ gpu::Texture* TextureUsage::createMetallicTextureFromImage(const QImage& srcImag
 
         theTexture = (gpu::Texture::create2D(formatGPU, image.width(), image.height(), gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
         theTexture->assignStoredMip(0, formatMip, image.byteCount(), image.constBits());
-        theTexture->autoGenerateMips(-1);
+        TextureProcessing::assignMips(theTexture, formatMip, image);
 
         // FIXME queue for transfer to GPU and block on completion
     }
@@ -377,68 +358,9 @@ public:
 gpu::Texture* TextureUsage::createCubeTextureFromImage(const QImage& srcImage, const std::string& srcImageName) {
     QImage image = srcImage;
     
-    int imageArea = image.width() * image.height();
-    
-    
     qCDebug(modelLog) << "Cube map size:" << QString(srcImageName.c_str()) << image.width() << image.height();
-    
-    int opaquePixels = 0;
-    int translucentPixels = 0;
-    //bool isTransparent = false;
-    int redTotal = 0, greenTotal = 0, blueTotal = 0, alphaTotal = 0;
-    const int EIGHT_BIT_MAXIMUM = 255;
-    QColor averageColor(EIGHT_BIT_MAXIMUM, EIGHT_BIT_MAXIMUM, EIGHT_BIT_MAXIMUM);
-    
-    if (!image.hasAlphaChannel()) {
-        if (image.format() != QImage::Format_RGB888) {
-            image = image.convertToFormat(QImage::Format_RGB888);
-        }
-        // int redTotal = 0, greenTotal = 0, blueTotal = 0;
-        for (int y = 0; y < image.height(); y++) {
-            for (int x = 0; x < image.width(); x++) {
-                QRgb rgb = image.pixel(x, y);
-                redTotal += qRed(rgb);
-                greenTotal += qGreen(rgb);
-                blueTotal += qBlue(rgb);
-            }
-        }
-        if (imageArea > 0) {
-            averageColor.setRgb(redTotal / imageArea, greenTotal / imageArea, blueTotal / imageArea);
-        }
-    } else {
-        if (image.format() != QImage::Format_ARGB32) {
-            image = image.convertToFormat(QImage::Format_ARGB32);
-        }
-        
-        // check for translucency/false transparency
-        // int opaquePixels = 0;
-        // int translucentPixels = 0;
-        // int redTotal = 0, greenTotal = 0, blueTotal = 0, alphaTotal = 0;
-        for (int y = 0; y < image.height(); y++) {
-            for (int x = 0; x < image.width(); x++) {
-                QRgb rgb = image.pixel(x, y);
-                redTotal += qRed(rgb);
-                greenTotal += qGreen(rgb);
-                blueTotal += qBlue(rgb);
-                int alpha = qAlpha(rgb);
-                alphaTotal += alpha;
-                if (alpha == EIGHT_BIT_MAXIMUM) {
-                    opaquePixels++;
-                } else if (alpha != 0) {
-                    translucentPixels++;
-                }
-            }
-        }
-        if (opaquePixels == imageArea) {
-            qCDebug(modelLog) << "Image with alpha channel is completely opaque:" << QString(srcImageName.c_str());
-            image = image.convertToFormat(QImage::Format_RGB888);
-        }
-        
-        averageColor = QColor(redTotal / imageArea,
-                              greenTotal / imageArea, blueTotal / imageArea, alphaTotal / imageArea);
-        
-        //isTransparent = (translucentPixels >= imageArea / 2);
-    }
+
+    QColor averageColor = convertToRGB888OrAnalyzedARGB32(image, srcImageName).getAverageColor();
     
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
@@ -603,65 +525,7 @@ gpu::Texture* TextureUsage::createCubeTextureFromImage(const QImage& srcImage, c
 gpu::Texture* TextureUsage::createLightmapTextureFromImage(const QImage& srcImage, const std::string& srcImageName) {
     QImage image = srcImage;
 
-    int imageArea = image.width() * image.height();
-
-    int opaquePixels = 0;
-    int translucentPixels = 0;
-    //bool isTransparent = false;
-    int redTotal = 0, greenTotal = 0, blueTotal = 0, alphaTotal = 0;
-    const int EIGHT_BIT_MAXIMUM = 255;
-    QColor averageColor(EIGHT_BIT_MAXIMUM, EIGHT_BIT_MAXIMUM, EIGHT_BIT_MAXIMUM);
-
-    if (!image.hasAlphaChannel()) {
-        if (image.format() != QImage::Format_RGB888) {
-            image = image.convertToFormat(QImage::Format_RGB888);
-        }
-        // int redTotal = 0, greenTotal = 0, blueTotal = 0;
-        for (int y = 0; y < image.height(); y++) {
-            for (int x = 0; x < image.width(); x++) {
-                QRgb rgb = image.pixel(x, y);
-                redTotal += qRed(rgb);
-                greenTotal += qGreen(rgb);
-                blueTotal += qBlue(rgb);
-            }
-        }
-        if (imageArea > 0) {
-            averageColor.setRgb(redTotal / imageArea, greenTotal / imageArea, blueTotal / imageArea);
-        }
-    } else {
-        if (image.format() != QImage::Format_ARGB32) {
-            image = image.convertToFormat(QImage::Format_ARGB32);
-        }
-
-        // check for translucency/false transparency
-        // int opaquePixels = 0;
-        // int translucentPixels = 0;
-        // int redTotal = 0, greenTotal = 0, blueTotal = 0, alphaTotal = 0;
-        for (int y = 0; y < image.height(); y++) {
-            for (int x = 0; x < image.width(); x++) {
-                QRgb rgb = image.pixel(x, y);
-                redTotal += qRed(rgb);
-                greenTotal += qGreen(rgb);
-                blueTotal += qBlue(rgb);
-                int alpha = qAlpha(rgb);
-                alphaTotal += alpha;
-                if (alpha == EIGHT_BIT_MAXIMUM) {
-                    opaquePixels++;
-                } else if (alpha != 0) {
-                    translucentPixels++;
-                }
-            }
-        }
-        if (opaquePixels == imageArea) {
-            qCDebug(modelLog) << "Image with alpha channel is completely opaque:" << QString(srcImageName.c_str());
-            image = image.convertToFormat(QImage::Format_RGB888);
-        }
-
-        averageColor = QColor(redTotal / imageArea,
-            greenTotal / imageArea, blueTotal / imageArea, alphaTotal / imageArea);
-
-        //isTransparent = (translucentPixels >= imageArea / 2);
-    }
+    QColor averageColor = convertToRGB888OrAnalyzedARGB32(image, srcImageName).getAverageColor();
 
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
@@ -679,7 +543,7 @@ gpu::Texture* TextureUsage::createLightmapTextureFromImage(const QImage& srcImag
 
         theTexture = (gpu::Texture::create2D(formatGPU, image.width(), image.height(), gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
         theTexture->assignStoredMip(0, formatMip, image.byteCount(), image.constBits());
-        theTexture->autoGenerateMips(-1);
+        TextureProcessing::assignMips(theTexture, formatMip, image);
     }
 
     return theTexture;
@@ -0,0 +1,456 @@
+//
+//  TextureProcessing.cpp
+//  libraries/model/src/model
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "TextureProcessing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+using namespace model;
+
+// blocks smaller than this aren't worth handing to another thread
+static const int MIN_BLOCK_SIZE = 256 * 1024;
+
+namespace {
+
+// shared between the caller and its helpers, so that a helper which starts late never touches a finished job.
+struct RowJob {
+    const std::function<void(int, int)>* function;
+    int numRows;
+    int rowsPerBlock;
+    int numBlocks;
+    std::atomic<int> nextBlock { 0 };
+    std::atomic<int> remainingBlocks { 0 };
+    QMutex mutex;
+    QWaitCondition finished;
+
+    // process blocks until there are none left to claim.
+    void run() {
+        int block = nextBlock++;
+        while (block < numBlocks) {
+            int firstRow = block * rowsPerBlock;
+            (*function)(firstRow, std::min(firstRow + rowsPerBlock, numRows));
+            if (--remainingBlocks == 0) {
+                QMutexLocker locker(&mutex);
+                finished.wakeAll();
+            }
+            block = nextBlock++;
+        }
+    }
+};
+
+class RowJobHelper : public QRunnable {
+public:
+    RowJobHelper(std::shared_ptr<RowJob> job) : _job(job) {}
+    virtual void run() override { _job->run(); }
+private:
+    std::shared_ptr<RowJob> _job;
+};
+
+}
+
+void TextureProcessing::forEachRowBlock(int numRows, int rowSize, const std::function<void(int, int)>& function) {
+    if (numRows <= 0) {
+        return;
+    }
+    int rowsPerBlock = std::max(1, MIN_BLOCK_SIZE / std::max(rowSize, 1));
+    int numBlocks = (numRows + rowsPerBlock - 1) / rowsPerBlock;
+    if (numBlocks == 1) {
+        function(0, numRows);
+        return;
+    }
+
+    auto job = std::make_shared<RowJob>();
+    job->function = &function;
+    job->numRows = numRows;
+    job->rowsPerBlock = rowsPerBlock;
+    job->numBlocks = numBlocks;
+    job->remainingBlocks = numBlocks;
+
+    // the calling thread works too, so we only need helpers for the other blocks
+    auto threadPool = QThreadPool::globalInstance();
+    int numHelpers = std::min(threadPool->maxThreadCount(), numBlocks - 1);
+    for (int i = 0; i < numHelpers; i++) {
+        threadPool->start(new RowJobHelper(job));
+    }
+
+    job->run();
+    QMutexLocker locker(&job->mutex);
+    while (job->remainingBlocks > 0) {
+        job->finished.wait(&job->mutex);
+    }
+}
+
+QColor TextureProcessing::ImageStats::getAverageColor() const {
+    if (numPixels == 0) {
+        return QColor(255, 255, 255);
+    }
+    return QColor((int)(redTotal / numPixels), (int)(greenTotal / numPixels),
+                  (int)(blueTotal / numPixels), (int)(alphaTotal / numPixels));
+}
+
+void TextureProcessing::ImageStats::merge(const ImageStats& other) {
+    redTotal += other.redTotal;
+    greenTotal += other.greenTotal;
+    blueTotal += other.blueTotal;
+    alphaTotal += other.alphaTotal;
+    numPixels += other.numPixels;
+    numOpaque += other.numOpaque;
+    numTransparent += other.numTransparent;
+    minAlpha = std::min(minAlpha, other.minAlpha);
+    maxAlpha = std::max(maxAlpha, other.maxAlpha);
+}
+
+static inline uint8_t averageBytes(uint8_t a, uint8_t b) {
+    return (uint8_t)((a + b + 1) >> 1);
+}
+
+// on x86 architecture, assume that SSE2 is present
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static const int BIT_COUNT[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+// accumulates the stats of the first pixels of the row, 4 at a time, and returns how many were done.
+static int analyzeRowSIMD(const QRgb* row, int width, TextureProcessing::ImageStats& stats) {
+    const __m128i ALPHA_MASK = _mm_set1_epi32(0xff000000);
+    const __m128i BYTE_MASK = _mm_set1_epi32(0xff);
+    const __m128i ZERO = _mm_setzero_si128();
+
+    __m128i redSum = ZERO, greenSum = ZERO, blueSum = ZERO, alphaSum = ZERO;
+    __m128i minAlpha = ALPHA_MASK, maxAlpha = ZERO;
+    int numOpaque = 0;
+    int numTransparent = 0;
+
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        __m128i pixels = _mm_loadu_si128((const __m128i*)(row + x));
+        __m128i alpha = _mm_and_si128(pixels, ALPHA_MASK);
+
+        minAlpha = _mm_min_epu8(minAlpha, alpha);
+        maxAlpha = _mm_max_epu8(maxAlpha, alpha);
+        numOpaque += BIT_COUNT[_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(alpha, ALPHA_MASK)))];
+        numTransparent += BIT_COUNT[_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(alpha, ZERO)))];
+
+        // each channel is isolated in the low byte of its lane, then summed horizontally into 64 bit halves
+        blueSum = _mm_add_epi64(blueSum, _mm_sad_epu8(_mm_and_si128(pixels, BYTE_MASK), ZERO));
+        greenSum = _mm_add_epi64(greenSum, _mm_sad_epu8(_mm_and_si128(_mm_srli_epi32(pixels, 8), BYTE_MASK), ZERO));
+        redSum = _mm_add_epi64(redSum, _mm_sad_epu8(_mm_and_si128(_mm_srli_epi32(pixels, 16), BYTE_MASK), ZERO));
+        alphaSum = _mm_add_epi64(alphaSum, _mm_sad_epu8(_mm_srli_epi32(pixels, 24), ZERO));
+    }
+
+    quint64 sums[2];
+    _mm_storeu_si128((__m128i*)sums, redSum);
+    stats.redTotal += sums[0] + sums[1];
+    _mm_storeu_si128((__m128i*)sums, greenSum);
+    stats.greenTotal += sums[0] + sums[1];
+    _mm_storeu_si128((__m128i*)sums, blueSum);
+    stats.blueTotal += sums[0] + sums[1];
+    _mm_storeu_si128((__m128i*)sums, alphaSum);
+    stats.alphaTotal += sums[0] + sums[1];
+
+    uint32_t minAlphas[4];
+    uint32_t maxAlphas[4];
+    _mm_storeu_si128((__m128i*)minAlphas, minAlpha);
+    _mm_storeu_si128((__m128i*)maxAlphas, maxAlpha);
+    if (x > 0) {
+        for (int i = 0; i < 4; i++) {
+            stats.minAlpha = std::min(stats.minAlpha, (uint8_t)(minAlphas[i] >> 24));
+            stats.maxAlpha = std::max(stats.maxAlpha, (uint8_t)(maxAlphas[i] >> 24));
+        }
+    }
+
+    stats.numOpaque += numOpaque;
+    stats.numTransparent += numTransparent;
+    stats.numPixels += x;
+    return x;
+}
+
+// converts the first pixels of the row to gray, 4 at a time, and returns how many were done.
+static int grayscaleRowSIMD(const QRgb* row, int width, uint8_t* dest, bool invert) {
+    const __m128i BYTE_MASK = _mm_set1_epi32(0xff);
+    const __m128i INVERT_MASK = _mm_set1_epi32(invert ? -1 : 0);
+    const __m128i RED_WEIGHT = _mm_set1_epi32(11);
+    const __m128i GREEN_WEIGHT = _mm_set1_epi32(16);
+    const __m128i BLUE_WEIGHT = _mm_set1_epi32(5);
+
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        __m128i pixels = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(row + x)), INVERT_MASK);
+        __m128i red = _mm_and_si128(_mm_srli_epi32(pixels, 16), BYTE_MASK);
+        __m128i green = _mm_and_si128(_mm_srli_epi32(pixels, 8), BYTE_MASK);
+        __m128i blue = _mm_and_si128(pixels, BYTE_MASK);
+
+        // qGray(), the products fit in the low 16 bits of each lane
+        __m128i gray = _mm_add_epi32(_mm_mullo_epi16(red, RED_WEIGHT), _mm_mullo_epi16(green, GREEN_WEIGHT));
+        gray = _mm_srli_epi32(_mm_add_epi32(gray, _mm_mullo_epi16(blue, BLUE_WEIGHT)), 5);
+        gray = _mm_packs_epi32(gray, gray);
+        gray = _mm_packus_epi16(gray, gray);
+
+        uint32_t grays = (uint32_t)_mm_cvtsi128_si32(gray);
+        memcpy(dest + x, &grays, sizeof(grays));
+    }
+    return x;
+}
+
+// box filters 4 pixels wide output runs from a pair of 32 bit rows, and returns how many pixels were done.
+static int downsampleRow32SIMD(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dest, int destWidth) {
+    int x = 0;
+    for (; x + 4 <= destWidth && 2 * x + 8 <= srcWidth; x += 4) {
+        __m128i top0 = _mm_loadu_si128((const __m128i*)(row0 + 8 * x));
+        __m128i top1 = _mm_loadu_si128((const __m128i*)(row0 + 8 * x + 16));
+        __m128i bottom0 = _mm_loadu_si128((const __m128i*)(row1 + 8 * x));
+        __m128i bottom1 = _mm_loadu_si128((const __m128i*)(row1 + 8 * x + 16));
+        __m128 vertical0 = _mm_castsi128_ps(_mm_avg_epu8(top0, bottom0));
+        __m128 vertical1 = _mm_castsi128_ps(_mm_avg_epu8(top1, bottom1));
+        __m128i even = _mm_castps_si128(_mm_shuffle_ps(vertical0, vertical1, _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128i odd = _mm_castps_si128(_mm_shuffle_ps(vertical0, vertical1, _MM_SHUFFLE(3, 1, 3, 1)));
+        _mm_storeu_si128((__m128i*)(dest + 4 * x), _mm_avg_epu8(even, odd));
+    }
+    return x;
+}
+
+// box filters 8 pixels wide output runs from a pair of 8 bit rows, and returns how many pixels were done.
+static int downsampleRow8SIMD(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dest, int destWidth) {
+    const __m128i LOW_BYTE_MASK = _mm_set1_epi16(0xff);
+    int x = 0;
+    for (; x + 8 <= destWidth && 2 * x + 16 <= srcWidth; x += 8) {
+        __m128i vertical = _mm_avg_epu8(_mm_loadu_si128((const __m128i*)(row0 + 2 * x)),
+                                        _mm_loadu_si128((const __m128i*)(row1 + 2 * x)));
+        __m128i even = _mm_and_si128(vertical, LOW_BYTE_MASK);
+        __m128i odd = _mm_srli_epi16(vertical, 8);
+        __m128i result = _mm_avg_epu16(even, odd);
+        _mm_storel_epi64((__m128i*)(dest + x), _mm_packus_epi16(result, result));
+    }
+    return x;
+}
+
+#else
+
+static int analyzeRowSIMD(const QRgb* row, int width, TextureProcessing::ImageStats& stats) {
+    return 0;
+}
+
+static int grayscaleRowSIMD(const QRgb* row, int width, uint8_t* dest, bool invert) {
+    return 0;
+}
+
+static int downsampleRow32SIMD(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dest, int destWidth) {
+    return 0;
+}
+
+static int downsampleRow8SIMD(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dest, int destWidth) {
+    return 0;
+}
+
+#endif
+
+TextureProcessing::ImageStats TextureProcessing::analyzeImage(const QImage& image) {
+    Q_ASSERT(image.isNull() || image.format() == QImage::Format_ARGB32 || image.format() == QImage::Format_RGB32);
+
+    ImageStats stats;
+    QMutex statsMutex;
+    int width = image.width();
+    bool hasAlpha = image.format() == QImage::Format_ARGB32;
+
+    forEachRowBlock(image.height(), image.bytesPerLine(), [&](int firstRow, int endRow) {
+        ImageStats blockStats;
+        for (int y = firstRow; y < endRow; ++y) {
+            const QRgb* row = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+            int x = analyzeRowSIMD(row, width, blockStats);
+            for (; x < width; ++x) {
+                QRgb pixel = row[x];
+                uint8_t alpha = qAlpha(pixel);
+                blockStats.redTotal += qRed(pixel);
+                blockStats.greenTotal += qGreen(pixel);
+                blockStats.blueTotal += qBlue(pixel);
+                blockStats.alphaTotal += alpha;
+                blockStats.numOpaque += (alpha == 255);
+                blockStats.numTransparent += (alpha == 0);
+                blockStats.minAlpha = std::min(blockStats.minAlpha, alpha);
+                blockStats.maxAlpha = std::max(blockStats.maxAlpha, alpha);
+                blockStats.numPixels++;
+            }
+        }
+        QMutexLocker locker(&statsMutex);
+        stats.merge(blockStats);
+    });
+
+    // the unused alpha byte of RGB32 isn't guaranteed to be 0xff
+    if (!hasAlpha) {
+        stats.alphaTotal = (quint64)stats.numPixels * 255;
+        stats.numOpaque = stats.numPixels;
+        stats.numTransparent = 0;
+        stats.minAlpha = 255;
+        stats.maxAlpha = 255;
+    }
+    return stats;
+}
+
+QImage TextureProcessing::convertToRGB888(const QImage& image) {
+    Q_ASSERT(image.isNull() || image.format() == QImage::Format_ARGB32 || image.format() == QImage::Format_RGB32);
+
+    int width = image.width();
+    QImage result(width, image.height(), QImage::Format_RGB888);
+    forEachRowBlock(image.height(), image.bytesPerLine(), [&](int firstRow, int endRow) {
+        for (int y = firstRow; y < endRow; ++y) {
+            const QRgb* row = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+            uint8_t* dest = result.scanLine(y);
+            for (int x = 0; x < width; ++x) {
+                QRgb pixel = row[x];
+                dest[0] = (uint8_t)qRed(pixel);
+                dest[1] = (uint8_t)qGreen(pixel);
+                dest[2] = (uint8_t)qBlue(pixel);
+                dest += 3;
+            }
+        }
+    });
+    return result;
+}
+
+QImage TextureProcessing::convertToGrayscale8(const QImage& image, bool invert) {
+    Q_ASSERT(image.isNull() || image.format() == QImage::Format_ARGB32 || image.format() == QImage::Format_RGB32);
+
+    int width = image.width();
+    QImage result(width, image.height(), QImage::Format_Grayscale8);
+    forEachRowBlock(image.height(), image.bytesPerLine(), [&](int firstRow, int endRow) {
+        for (int y = firstRow; y < endRow; ++y) {
+            const QRgb* row = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+            uint8_t* dest = result.scanLine(y);
+            int x = grayscaleRowSIMD(row, width, dest, invert);
+            for (; x < width; ++x) {
+                QRgb pixel = invert ? ~row[x] : row[x];
+                dest[x] = (uint8_t)qGray(pixel);
+            }
+        }
+    });
+    return result;
+}
+
+namespace {
+
+// 16 bit linear values for each sRGB byte, and sRGB bytes for 12 bit linear values
+struct SRGBTables {
+    static const int LINEAR_BITS = 12;
+    uint16_t toLinear[256];
+    uint8_t fromLinear[1 << LINEAR_BITS];
+
+    SRGBTables() {
+        for (int i = 0; i < 256; i++) {
+            float value = (float)i / 255.0f;
+            float linear = (value <= 0.04045f) ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+            toLinear[i] = (uint16_t)(linear * 65535.0f + 0.5f);
+        }
+        const int NUM_LINEAR_VALUES = 1 << LINEAR_BITS;
+        for (int i = 0; i < NUM_LINEAR_VALUES; i++) {
+            float linear = ((float)i + 0.5f) / (float)NUM_LINEAR_VALUES;
+            float value = (linear <= 0.0031308f) ? linear * 12.92f : 1.055f * powf(linear, 1.0f / 2.4f) - 0.055f;
+            fromLinear[i] = (uint8_t)std::min(255.0f, value * 255.0f + 0.5f);
+        }
+    }
+
+    uint8_t average(uint8_t a, uint8_t b, uint8_t c, uint8_t d) const {
+        uint32_t linear = ((uint32_t)toLinear[a] + toLinear[b] + toLinear[c] + toLinear[d] + 2) >> 2;
+        return fromLinear[linear >> (16 - LINEAR_BITS)];
+    }
+};
+
+const SRGBTables& getSRGBTables() {
+    static const SRGBTables tables;
+    return tables;
+}
+
+}
+
+static QImage downsample(const QImage& image, bool isSRGB) {
+    int srcWidth = image.width();
+    int srcHeight = image.height();
+    int width = std::max(srcWidth >> 1, 1);
+    int height = std::max(srcHeight >> 1, 1);
+    QImage result(width, height, image.format());
+
+    int pixelSize = image.depth() / 8;
+    // the alpha byte in memory, it isn't sRGB encoded
+    int alphaByte = (image.format() != QImage::Format_ARGB32) ? -1 : ((Q_BYTE_ORDER == Q_LITTLE_ENDIAN) ? 3 : 0);
+    const SRGBTables* srgb = isSRGB && pixelSize > 1 ? &getSRGBTables() : nullptr;
+
+    TextureProcessing::forEachRowBlock(height, result.bytesPerLine() * 4, [&](int firstRow, int endRow) {
+        for (int y = firstRow; y < endRow; ++y) {
+            const uint8_t* row0 = image.constScanLine(2 * y);
+            const uint8_t* row1 = image.constScanLine(std::min(2 * y + 1, srcHeight - 1));
+            uint8_t* dest = result.scanLine(y);
+
+            int x = 0;
+            if (!srgb) {
+                if (pixelSize == 4) {
+                    x = downsampleRow32SIMD(row0, row1, srcWidth, dest, width);
+                } else if (pixelSize == 1) {
+                    x = downsampleRow8SIMD(row0, row1, srcWidth, dest, width);
+                }
+            }
+
+            for (; x < width; ++x) {
+                int left = 2 * x * pixelSize;
+                int right = std::min(2 * x + 1, srcWidth - 1) * pixelSize;
+                for (int c = 0; c < pixelSize; ++c) {
+                    if (srgb && c != alphaByte) {
+                        dest[x * pixelSize + c] = srgb->average(row0[left + c], row0[right + c],
+                                                                row1[left + c], row1[right + c]);
+                    } else {
+                        // the same rounding as the SIMD version, so both give identical results
+                        dest[x * pixelSize + c] = averageBytes(averageBytes(row0[left + c], row1[left + c]),
+                                                               averageBytes(row0[right + c], row1[right + c]));
+                    }
+                }
+            }
+        }
+    });
+    return result;
+}
+
+std::vector<QImage> TextureProcessing::generateMips(const QImage& image, bool isSRGB) {
+    std::vector<QImage> mips;
+    if (image.isNull()) {
+        return mips;
+    }
+    Q_ASSERT(image.format() == QImage::Format_ARGB32 || image.format() == QImage::Format_RGB32 ||
+             image.format() == QImage::Format_RGB888 || image.format() == QImage::Format_Grayscale8);
+
+    QImage source = image;
+    while (source.width() > 1 || source.height() > 1) {
+        source = downsample(source, isSRGB);
+        mips.push_back(source);
+    }
+    return mips;
+}
+
+int TextureProcessing::assignMips(gpu::Texture* texture, const gpu::Element& formatMip, const QImage& image) {
+    auto semantic = formatMip.getSemantic();
+    bool isSRGB = (semantic == gpu::SRGB || semantic == gpu::SRGBA || semantic == gpu::SBGRA);
+
+    auto mips = generateMips(image, isSRGB);
+    uint16_t level = 1;
+    for (const auto& mip : mips) {
+        if (!texture->assignStoredMip(level, formatMip, mip.byteCount(), mip.constBits())) {
+            break;
+        }
+        level++;
+    }
+    return level - 1;
+}
@@ -0,0 +1,80 @@
+//
+//  TextureProcessing.h
+//  libraries/model/src/model
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_model_TextureProcessing_h
+#define hifi_model_TextureProcessing_h
+
+#include <functional>
+#include <vector>
+
+#include <QColor>
+#include <QImage>
+
+#include "gpu/Texture.h"
+
+namespace model {
+
+// CPU side preparation of texture images, working a scanline at a time instead of through QImage::pixel().
+// Large images are split in blocks of rows which are processed on the global thread pool. The calling thread
+// takes blocks as well, so these are safe to call from a thread pool job such as the ImageReader.
+namespace TextureProcessing {
+
+class ImageStats {
+public:
+    quint64 redTotal { 0 };
+    quint64 greenTotal { 0 };
+    quint64 blueTotal { 0 };
+    quint64 alphaTotal { 0 };
+    int numPixels { 0 };
+    int numOpaque { 0 };
+    int numTransparent { 0 };
+    uint8_t minAlpha { 255 };
+    uint8_t maxAlpha { 0 };
+
+    int getNumTranslucent() const { return numPixels - numOpaque - numTransparent; }
+
+    // true if at least one pixel is not fully opaque
+    bool hasValidAlpha() const { return numOpaque != numPixels; }
+
+    // true if every pixel has the same alpha value
+    bool isAlphaUniform() const { return minAlpha >= maxAlpha; }
+
+    QColor getAverageColor() const;
+
+    void merge(const ImageStats& other);
+};
+
+// image must be in Format_ARGB32 or Format_RGB32
+ImageStats analyzeImage(const QImage& image);
+
+// image must be in Format_ARGB32 or Format_RGB32, the alpha channel is dropped
+QImage convertToRGB888(const QImage& image);
+
+// image must be in Format_ARGB32 or Format_RGB32, gives the same gray levels as QImage::convertToFormat.
+// If invert is true the colors are inverted first, which turns a gloss map into a roughness map.
+QImage convertToGrayscale8(const QImage& image, bool invert = false);
+
+// Box filters the mip chain below the image, the first image is level 1 and the last one is 1x1.
+// The color channels of sRGB images are averaged in linear space.
+// Supports Format_ARGB32, Format_RGB32, Format_RGB888 and Format_Grayscale8.
+std::vector<QImage> generateMips(const QImage& image, bool isSRGB);
+
+// Generates the mips of a 2D texture from its level 0 image and stores them in the texture, in place of
+// autoGenerateMips. Returns the number of levels assigned.
+int assignMips(gpu::Texture* texture, const gpu::Element& formatMip, const QImage& image);
+
+// Calls function(firstRow, endRow) for consecutive blocks of rows covering [0, numRows), in parallel when
+// there is enough work to share. Returns once every block has been processed.
+void forEachRowBlock(int numRows, int rowSize, const std::function<void(int, int)>& function);
+
+};
+
+};
+
+#endif // hifi_model_TextureProcessing_h
@@ -31,6 +31,9 @@
 
 MessageID AssetClient::_currentID = 0;
 
+static const qint64 MAXIMUM_ASSET_CACHE_SIZE = 4 * BYTES_PER_GIGABYTES;
+static const QString ASSET_CACHE_EXTENSION = ".asset";
+
 AssetClient::AssetClient() {
     
     setCustomDeleter([](Dependency* dependency){
@@ -64,6 +67,32 @@ void AssetClient::init() {
         qDebug() << "ResourceManager disk cache setup at" << cachePath
                  << "(size:" << MAXIMUM_CACHE_SIZE / BYTES_PER_GIGABYTES << "GB)";
     }
+
+    if (!_assetCache) {
+        QString cachePath = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+        cachePath = !cachePath.isEmpty() ? cachePath : "interfaceCache";
+        _assetCache.reset(new FileCache(cachePath + "/assets", ASSET_CACHE_EXTENSION, MAXIMUM_ASSET_CACHE_SIZE));
+        qDebug() << "AssetClient disk cache setup at" << _assetCache->getDirectory() << "with"
+                 << _assetCache->getNumEntries() << "assets";
+    }
+}
+
+bool AssetClient::loadFromCache(const AssetHash& hash, QByteArray& data) {
+    if (!_assetCache) {
+        return false;
+    }
+    return _assetCache->read(hash.toLatin1(), [&](const char* bytes, qint64 size) {
+        // a damaged file doesn't match its name anymore, it is then removed and fetched again
+        if (hashData(QByteArray::fromRawData(bytes, size)).toHex() != hash) {
+            return false;
+        }
+        data = QByteArray(bytes, size);
+        return true;
+    });
+}
+
+bool AssetClient::saveToCache(const AssetHash& hash, const QByteArray& data) {
+    return _assetCache && _assetCache->write(hash.toLatin1(), data);
 }
 
 
@@ -76,10 +105,13 @@ void AssetClient::cacheInfoRequest(QObject* reciever, QString slot) {
 
 
     if (auto* cache = qobject_cast<QNetworkDiskCache*>(NetworkAccessManager::getInstance().cache())) {
+        // the assets are counted in with the http cache
+        qint64 assetCacheSize = _assetCache ? _assetCache->getSize() : 0;
+        qint64 assetCacheMaximumSize = _assetCache ? _assetCache->getMaximumSize() : 0;
         QMetaObject::invokeMethod(reciever, slot.toStdString().data(), Qt::QueuedConnection,
                                   Q_ARG(QString, cache->cacheDirectory()),
-                                  Q_ARG(qint64, cache->cacheSize()),
-                                  Q_ARG(qint64, cache->maximumCacheSize()));
+                                  Q_ARG(qint64, cache->cacheSize() + assetCacheSize),
+                                  Q_ARG(qint64, cache->maximumCacheSize() + assetCacheMaximumSize));
     } else {
         qCWarning(asset_client) << "No disk cache to get info from.";
     }
@@ -97,6 +129,10 @@ void AssetClient::clearCache() {
     } else {
         qCWarning(asset_client) << "No disk cache to clear.";
     }
+
+    if (_assetCache) {
+        _assetCache->clear();
+    }
 }
 
 void AssetClient::handleAssetMappingOperationReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
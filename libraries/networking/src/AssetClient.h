@@ -17,10 +17,12 @@
 #include <QString>
 
 #include <map>
+#include <memory>
 
 #include <DependencyManager.h>
 
 #include "AssetUtils.h"
+#include "FileCache.h"
 #include "LimitedNodeList.h"
 #include "NLPacket.h"
 #include "Node.h"
@@ -60,6 +62,12 @@ public:
     Q_INVOKABLE AssetUpload* createUpload(const QString& filename);
     Q_INVOKABLE AssetUpload* createUpload(const QByteArray& data);
 
+    /// Loads an asset from the local cache, checking that its contents still match the hash.  Thread safe.
+    bool loadFromCache(const AssetHash& hash, QByteArray& data);
+
+    /// Thread safe.
+    bool saveToCache(const AssetHash& hash, const QByteArray& data);
+
 public slots:
     void init();
 
@@ -93,6 +101,10 @@ private:
     };
 
     static MessageID _currentID;
+
+    // assets never change for a given hash, so they are cached forever unless evicted for space
+    std::unique_ptr<FileCache> _assetCache;
+
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, MappingOperationCallback>> _pendingMappingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetAssetRequestData>> _pendingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetInfoCallback>> _pendingInfoRequests;
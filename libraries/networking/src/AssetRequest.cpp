@@ -46,8 +46,9 @@ void AssetRequest::start() {
     }
     
     // Try to load from cache
-    _data = loadFromCache(getUrl());
-    if (!_data.isNull()) {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    if (assetClient->loadFromCache(_hash, _data)) {
+        qCDebug(asset_client) << getUrl().toDisplayString() << "loaded from disk cache.";
         _info.hash = _hash;
         _info.size = _data.size();
         _error = NoError;
@@ -59,7 +60,6 @@ void AssetRequest::start() {
     
     _state = WaitingForInfo;
     
-    auto assetClient = DependencyManager::get<AssetClient>();
     assetClient->getAssetInfo(_hash, [this](bool responseReceived, AssetServerError serverError, AssetInfo info) {
         _info = info;
 
@@ -117,7 +117,7 @@ void AssetRequest::start() {
                     _totalReceived += data.size();
                     emit progress(_totalReceived, _info.size);
                     
-                    saveToCache(getUrl(), data);
+                    DependencyManager::get<AssetClient>()->saveToCache(_hash, data);
                 } else {
                     // hash doesn't match - we have an error
                     _error = HashVerificationFailed;
@@ -105,7 +105,7 @@ void AssetUpload::start() {
         }
         
         if (_error == NoError && hash == hashData(_data).toHex()) {
-            saveToCache(getATPUrl(hash), _data);
+            DependencyManager::get<AssetClient>()->saveToCache(hash, _data);
         }
         
         emit finished(this, hash);
@@ -56,9 +56,6 @@ QUrl getATPUrl(const QString& hash);
 
 QByteArray hashData(const QByteArray& data);
 
-QByteArray loadFromCache(const QUrl& url);
-bool saveToCache(const QUrl& url, const QByteArray& file);
-
 bool isValidPath(const AssetPath& path);
 bool isValidHash(const QString& hashString);
 
@@ -0,0 +1,168 @@
+//
+//  FileCache.cpp
+//  libraries/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FileCache.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#include "NetworkLogging.h"
+
+FileCache::FileCache(const QString& directory, const QString& extension, qint64 maximumSize) :
+    _directory(directory),
+    _extension(extension),
+    _maximumSize(maximumSize)
+{
+    scanDirectory();
+}
+
+QString FileCache::getFilePath(const QByteArray& key) const {
+    return _directory + "/" + QString::fromLatin1(key) + _extension;
+}
+
+void FileCache::scanDirectory() {
+    QDir directory(_directory);
+    if (!directory.exists() && !directory.mkpath(".")) {
+        qCWarning(networking) << "Could not create cache directory" << _directory;
+        return;
+    }
+
+    auto files = directory.entryInfoList(QStringList("*" + _extension), QDir::Files);
+    auto lastUsed = [](const QFileInfo& info) {
+        return std::max(info.lastRead(), info.lastModified());
+    };
+    std::sort(files.begin(), files.end(), [&](const QFileInfo& a, const QFileInfo& b) {
+        return lastUsed(a) > lastUsed(b);
+    });
+
+    QMutexLocker locker(&_mutex);
+    for (const auto& file : files) {
+        QByteArray key = file.completeBaseName().toLatin1();
+        _entries.push_back({ key, file.size() });
+        _entryIndex[key] = std::prev(_entries.end());
+        _size += file.size();
+    }
+    evict();
+}
+
+bool FileCache::read(const QByteArray& key, const Reader& reader) {
+    {
+        QMutexLocker locker(&_mutex);
+        auto entry = _entryIndex.find(key);
+        if (entry == _entryIndex.end()) {
+            _numMisses++;
+            return false;
+        }
+        _entries.splice(_entries.begin(), _entries, entry.value());
+    }
+
+    bool accepted = false;
+    QFile file(getFilePath(key));
+    if (file.open(QIODevice::ReadOnly)) {
+        uchar* mapped = file.map(0, file.size());
+        if (mapped) {
+            accepted = reader(reinterpret_cast<const char*>(mapped), file.size());
+            file.unmap(mapped);
+        } else {
+            QByteArray data = file.readAll();
+            accepted = reader(data.constData(), data.size());
+        }
+        file.close();
+    }
+
+    if (!accepted) {
+        qCWarning(networking) << "Discarding unreadable cache file" << file.fileName();
+        QMutexLocker locker(&_mutex);
+        auto entry = _entryIndex.find(key);
+        if (entry != _entryIndex.end()) {
+            remove(entry.value());
+        }
+        _numMisses++;
+        return false;
+    }
+
+    _numHits++;
+    return true;
+}
+
+bool FileCache::write(const QByteArray& key, const QByteArray& data) {
+    if (data.isEmpty() || data.size() > _maximumSize) {
+        return false;
+    }
+
+    // written to a temporary file first, so a reader never sees a partial entry
+    QSaveFile file(getFilePath(key));
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(networking) << "Could not write cache file" << file.fileName();
+        return false;
+    }
+
+    QMutexLocker locker(&_mutex);
+    auto previous = _entryIndex.find(key);
+    if (previous != _entryIndex.end()) {
+        _size -= previous.value()->size;
+        _entries.erase(previous.value());
+        _entryIndex.erase(previous);
+    }
+    _entries.push_front({ key, data.size() });
+    _entryIndex[key] = _entries.begin();
+    _size += data.size();
+    evict();
+    return true;
+}
+
+bool FileCache::contains(const QByteArray& key) const {
+    QMutexLocker locker(&_mutex);
+    return _entryIndex.contains(key);
+}
+
+void FileCache::remove(Entries::iterator entry) {
+    QFile::remove(getFilePath(entry->key));
+    _size -= entry->size;
+    _entryIndex.remove(entry->key);
+    _entries.erase(entry);
+}
+
+void FileCache::evict() {
+    while (_size > _maximumSize && !_entries.empty()) {
+        remove(std::prev(_entries.end()));
+        _numEvictions++;
+    }
+}
+
+void FileCache::clear() {
+    QMutexLocker locker(&_mutex);
+    while (!_entries.empty()) {
+        remove(_entries.begin());
+    }
+}
+
+void FileCache::setMaximumSize(qint64 maximumSize) {
+    QMutexLocker locker(&_mutex);
+    _maximumSize = maximumSize;
+    evict();
+}
+
+int FileCache::getNumEntries() const {
+    QMutexLocker locker(&_mutex);
+    return (int)_entries.size();
+}
+
+float FileCache::getHitRate() const {
+    int numRequests = _numHits + _numMisses;
+    return (numRequests > 0) ? (float)_numHits / (float)numRequests : 0.0f;
+}
@@ -0,0 +1,81 @@
+//
+//  FileCache.h
+//  libraries/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FileCache_h
+#define hifi_FileCache_h
+
+#include <atomic>
+#include <functional>
+#include <list>
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+/// A directory holding one file per key, which stays under a maximum total size by removing the least
+/// recently used files.  The entries already in the directory are picked up on construction, ordered by
+/// their last access, so the cache carries over between sessions.  Thread safe.
+class FileCache {
+public:
+    /// Given the contents of an entry, returns false if they are unusable.
+    using Reader = std::function<bool(const char* data, qint64 size)>;
+
+    FileCache(const QString& directory, const QString& extension, qint64 maximumSize);
+
+    /// Maps the file for the key and hands its contents to the reader.  Entries the reader rejects are removed.
+    /// Returns true if the entry was found and accepted.
+    bool read(const QByteArray& key, const Reader& reader);
+
+    /// Writes the entry, evicting old ones if needed.  Readers never see a partially written file.
+    bool write(const QByteArray& key, const QByteArray& data);
+
+    bool contains(const QByteArray& key) const;
+    void clear();
+
+    QString getFilePath(const QByteArray& key) const;
+    const QString& getDirectory() const { return _directory; }
+    void setMaximumSize(qint64 maximumSize);
+    qint64 getMaximumSize() const { return _maximumSize; }
+    qint64 getSize() const { return _size; }
+    int getNumEntries() const;
+
+    int getNumHits() const { return _numHits; }
+    int getNumMisses() const { return _numMisses; }
+    int getNumEvictions() const { return _numEvictions; }
+    float getHitRate() const;
+
+private:
+    struct Entry {
+        QByteArray key;
+        qint64 size;
+    };
+    using Entries = std::list<Entry>;
+
+    void scanDirectory();
+    void remove(Entries::iterator entry);
+    void evict();
+
+    QString _directory;
+    QString _extension;
+    std::atomic<qint64> _maximumSize;
+    std::atomic<qint64> _size { 0 };
+
+    // most recently used first
+    mutable QMutex _mutex;
+    Entries _entries;
+    QHash<QByteArray, Entries::iterator> _entryIndex;
+
+    std::atomic<int> _numHits { 0 };
+    std::atomic<int> _numMisses { 0 };
+    std::atomic<int> _numEvictions { 0 };
+};
+
+#endif // hifi_FileCache_h
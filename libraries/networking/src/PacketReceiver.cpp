@@ -19,6 +19,53 @@
 #include "NodeList.h"
 #include "SharedUtil.h"
 
+// the handler being called on this thread, which can unregister itself without waiting on its own call
+static thread_local void* currentHandler { nullptr };
+
+// Holds on to a handler from acquireHandlerForType for the length of a call, so it can't be unregistered under it.
+// The caller keeps the HandlerPointer alive for longer than the HandlerCall.
+class PacketReceiver::HandlerCall {
+public:
+    HandlerCall(Handler* handler) : _handler(handler), _previousHandler(currentHandler) {
+        if (_handler) {
+            currentHandler = _handler;
+        }
+    }
+    ~HandlerCall() {
+        if (_handler) {
+            currentHandler = _previousHandler;
+            _handler->endCall();
+        }
+    }
+
+    HandlerCall(const HandlerCall&) = delete;
+    HandlerCall& operator=(const HandlerCall&) = delete;
+
+private:
+    Handler* _handler;
+    void* _previousHandler;
+};
+
+void PacketReceiver::Handler::endCall() {
+    --numCalls;
+
+    // checked after the call is no longer counted, and unregisterListener sets it before it counts the calls,
+    // so either it sees this call gone or it is woken up here
+    if (isRemoved) {
+        std::lock_guard<std::mutex> locker(callsMutex);
+        callsDone.notify_all();
+    }
+}
+
+// a handler always takes the node, and a listener slot that does isn't invoked without one
+static bool isFromKnownSource(const ReceivedMessage& message, const SharedNodePointer& matchingNode) {
+    if (matchingNode || NON_SOURCED_PACKETS.contains(message.getType())) {
+        return true;
+    }
+    qCDebug(networking) << "Dropping packet" << message.getType() << "from unknown node" << message.getSourceID();
+    return false;
+}
+
 PacketReceiver::PacketReceiver(QObject* parent) : QObject(parent) {
     qRegisterMetaType<QSharedPointer<NLPacket>>();
     qRegisterMetaType<QSharedPointer<NLPacketList>>();
@@ -178,11 +225,96 @@ void PacketReceiver::registerVerifiedListener(PacketType type, QObject* object,
     _messageListenerMap[type] = { QPointer<QObject>(object), slot, deliverPending };
 }
 
+void PacketReceiver::registerMessageHandler(PacketTypeList types, MessageHandler handler, bool deliverPending) {
+    Q_ASSERT_X(handler, "PacketReceiver::registerMessageHandler", "No handler to register");
+    registerHandler(std::move(types), nullptr, handler, PacketHandler(), deliverPending);
+}
+
+void PacketReceiver::registerPacketHandler(PacketTypeList types, PacketHandler handler) {
+    Q_ASSERT_X(handler, "PacketReceiver::registerPacketHandler", "No handler to register");
+    registerHandler(std::move(types), nullptr, MessageHandler(), handler, false);
+}
+
+void PacketReceiver::registerHandler(PacketTypeList types, QObject* listener, MessageHandler messageHandler,
+                                     PacketHandler packetHandler, bool deliverPending) {
+    Q_ASSERT_X(!types.empty(), "PacketReceiver::registerHandler", "No types to register");
+
+    QMutexLocker locker(&_packetListenerLock);
+
+    auto handler = std::make_shared<Handler>(listener, messageHandler, packetHandler, deliverPending);
+
+    for (PacketType type : types) {
+        if (std::atomic_load(&_handlers[(int)type]) || _messageListenerMap.contains(type)) {
+            qCWarning(networking) << "Registering a packet handler for packet type" << type
+                << "that will replace a previously registered listener";
+        }
+        qCDebug(networking) << "Registering a packet handler for packet type" << type;
+        std::atomic_store(&_handlers[(int)type], handler);
+    }
+}
+
+PacketReceiver::HandlerPointer PacketReceiver::acquireHandlerForType(PacketType type) {
+    while (true) {
+        HandlerPointer handler = std::atomic_load(&_handlers[(int)type]);
+        if (!handler) {
+            return nullptr;
+        }
+
+        // counted before checking it is still registered, so unregisterListener either sees this call or
+        // removed the handler before we got to it
+        ++handler->numCalls;
+        if (std::atomic_load(&_handlers[(int)type]) != handler) {
+            handler->endCall();
+            continue;
+        }
+
+        if (handler->hasObject && !handler->object) {
+            handler->endCall();
+            qCDebug(networking).nospace() << "Handler for packet " << type
+                << " has been destroyed. Removing from handlers.";
+            removeHandler(type, handler);
+            return nullptr;
+        }
+        return handler;
+    }
+}
+
+void PacketReceiver::removeHandler(PacketType type, HandlerPointer handler) {
+    // only removed if it wasn't replaced in the meantime
+    std::atomic_compare_exchange_strong(&_handlers[(int)type], &handler, HandlerPointer());
+}
+
+SharedNodePointer PacketReceiver::recordReceivedMessage(const ReceivedMessage& message) {
+    SharedNodePointer matchingNode;
+    if (!message.getSourceID().isNull()) {
+        matchingNode = DependencyManager::get<LimitedNodeList>()->nodeWithUUID(message.getSourceID());
+    }
+
+    if (matchingNode) {
+        emit dataReceived(matchingNode->getType(), message.getSize());
+        matchingNode->recordBytesReceived(message.getSize());
+    } else {
+        emit dataReceived(NodeType::Unassigned, message.getSize());
+    }
+    return matchingNode;
+}
+
 void PacketReceiver::unregisterListener(QObject* listener) {
     Q_ASSERT_X(listener, "PacketReceiver::unregisterListener", "No listener to unregister");
     
+    std::vector<HandlerPointer> removedHandlers;
     {
         QMutexLocker packetListenerLocker(&_packetListenerLock);
+
+        for (int type = 0; type < NUM_PACKET_TYPES; type++) {
+            HandlerPointer handler = std::atomic_load(&_handlers[type]);
+            if (handler && handler->hasObject && handler->object == listener) {
+                removeHandler((PacketType)type, handler);
+                if (std::find(removedHandlers.begin(), removedHandlers.end(), handler) == removedHandlers.end()) {
+                    removedHandlers.push_back(handler);
+                }
+            }
+        }
         
         // clear any registrations for this listener in _messageListenerMap
         auto it = _messageListenerMap.begin();
@@ -196,8 +328,20 @@ void PacketReceiver::unregisterListener(QObject* listener) {
         }
     }
     
-    QMutexLocker directConnectSetLocker(&_directConnectSetMutex);
-    _directlyConnectedObjects.remove(listener);
+    {
+        QMutexLocker directConnectSetLocker(&_directConnectSetMutex);
+        _directlyConnectedObjects.remove(listener);
+    }
+
+    // wait, without the lock so the handlers can still register and unregister, for calls under way on other
+    // threads - a handler unregistering from inside its own call only waits for the others
+    for (auto& handler : removedHandlers) {
+        int ownCalls = (handler.get() == currentHandler) ? 1 : 0;
+        handler->isRemoved = true;
+
+        std::unique_lock<std::mutex> locker(handler->callsMutex);
+        handler->callsDone.wait(locker, [&] { return handler->numCalls <= ownCalls; });
+    }
 }
 
 void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
@@ -210,11 +354,25 @@ void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
     
     // setup an NLPacket from the packet we were passed
     auto nlPacket = NLPacket::fromBase(std::move(packet));
-    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(*nlPacket);
 
     _inPacketCount += 1;
     _inByteCount += nlPacket->size();
 
+    // a packet handler gets the single packet message without it being shared
+    {
+        HandlerPointer handler = acquireHandlerForType(nlPacket->getType());
+        HandlerCall handlerCall(handler.get());
+        if (handler && handler->packetHandler) {
+            ReceivedMessage receivedMessage(std::move(nlPacket));
+            SharedNodePointer matchingNode = recordReceivedMessage(receivedMessage);
+            if (isFromKnownSource(receivedMessage, matchingNode)) {
+                handler->packetHandler(receivedMessage, matchingNode);
+            }
+            return;
+        }
+    }
+
+    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
     handleVerifiedMessage(receivedMessage, true);
 }
 
@@ -230,14 +388,14 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
 
     if (it == _pendingMessages.end()) {
         // Create message
-        message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+        message = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
         if (!message->isComplete()) {
             _pendingMessages[key] = message;
         }
         handleVerifiedMessage(message, true);
     } else {
         message = it->second;
-        message->appendPacket(*nlPacket);
+        message->appendPacket(std::move(nlPacket));
 
         if (message->isComplete()) {
             _pendingMessages.erase(it);
@@ -257,6 +415,26 @@ void PacketReceiver::handleMessageFailure(HifiSockAddr from, udt::Packet::Messag
 }
 
 void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> receivedMessage, bool justReceived) {
+    HandlerPointer handler = acquireHandlerForType(receivedMessage->getType());
+    HandlerCall handlerCall(handler.get());
+    if (handler) {
+        bool deliverPending = handler->deliverPending && !handler->packetHandler;
+        if ((deliverPending && !justReceived) || (!deliverPending && !receivedMessage->isComplete())) {
+            return;
+        }
+
+        SharedNodePointer matchingNode = recordReceivedMessage(*receivedMessage);
+        if (!isFromKnownSource(*receivedMessage, matchingNode)) {
+            return;
+        }
+        if (handler->packetHandler) {
+            handler->packetHandler(*receivedMessage, matchingNode);
+        } else {
+            handler->messageHandler(receivedMessage, matchingNode);
+        }
+        return;
+    }
+
     auto nodeList = DependencyManager::get<LimitedNodeList>();
     
     SharedNodePointer matchingNode;
@@ -13,6 +13,12 @@
 #ifndef hifi_PacketReceiver_h
 #define hifi_PacketReceiver_h
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 
@@ -25,6 +31,7 @@
 
 #include "NLPacket.h"
 #include "NLPacketList.h"
+#include "Node.h"
 #include "ReceivedMessage.h"
 #include "udt/PacketHeaders.h"
 
@@ -44,6 +51,8 @@ class PacketReceiver : public QObject {
     Q_OBJECT
 public:
     using PacketTypeList = std::vector<PacketType>;
+    using MessageHandler = std::function<void(QSharedPointer<ReceivedMessage>, SharedNodePointer)>;
+    using PacketHandler = std::function<void(ReceivedMessage&, SharedNodePointer)>;
     
     PacketReceiver(QObject* parent = 0);
     PacketReceiver(const PacketReceiver&) = delete;
@@ -63,6 +72,40 @@ public:
     bool registerListener(PacketType type, QObject* listener, const char* slot, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
     void unregisterListener(QObject* listener);
+
+    // Handlers are called directly on the thread that receives the packets, without going through the meta-object
+    // system, so they have to be thread safe. They take precedence over a listener registered for the same type.
+    // A MessageHandler gets the shared ReceivedMessage, and deliverPending works as it does for listeners.
+    // A PacketHandler only gets complete messages, and those that arrived as a single packet are handed over as a
+    // ReceivedMessage that only lives for the call, so it must not be kept.
+    // As with a listener slot that takes the node, a handler isn't called for a sourced packet from an unknown node.
+    void registerMessageHandler(PacketTypeList types, MessageHandler handler, bool deliverPending = false);
+    void registerPacketHandler(PacketTypeList types, PacketHandler handler);
+
+    // Handlers for member functions of a QObject are dropped by unregisterListener, which waits for calls to them
+    // that are under way on other threads to return. An object that can be destroyed while packets are being
+    // received on another thread must unregister in its destructor; otherwise it is only dropped the next time a
+    // packet for it arrives and its QPointer is found to be null.
+    // Because of that wait, a handler must not block on the thread that unregisters its object: no
+    // BlockingQueuedConnection to it, and no lock that thread can hold while it calls unregisterListener.
+    template <typename T>
+    void registerMessageHandler(PacketTypeList types, T* listener,
+                                void (T::*method)(QSharedPointer<ReceivedMessage>, SharedNodePointer),
+                                bool deliverPending = false) {
+        registerHandler(std::move(types), listener, [listener, method](QSharedPointer<ReceivedMessage> message,
+                                                                       SharedNodePointer sendingNode) {
+            (listener->*method)(message, sendingNode);
+        }, PacketHandler(), deliverPending);
+    }
+
+    template <typename T>
+    void registerPacketHandler(PacketTypeList types, T* listener,
+                               void (T::*method)(ReceivedMessage&, SharedNodePointer)) {
+        registerHandler(std::move(types), listener, MessageHandler(), [listener, method](ReceivedMessage& message,
+                                                                                         SharedNodePointer sendingNode) {
+            (listener->*method)(message, sendingNode);
+        }, false);
+    }
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
     void handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> message);
@@ -78,6 +121,33 @@ private:
         bool deliverPending;
     };
 
+    struct Handler {
+        Handler(QObject* object, MessageHandler messageHandler, PacketHandler packetHandler, bool deliverPending) :
+            object(object), hasObject(object != nullptr), messageHandler(messageHandler),
+            packetHandler(packetHandler), deliverPending(deliverPending) {}
+
+        void endCall(); // wakes unregisterListener if it is waiting for this call
+
+        QPointer<QObject> object;
+        bool hasObject;
+        MessageHandler messageHandler;
+        PacketHandler packetHandler;
+        bool deliverPending;
+
+        std::atomic<int> numCalls { 0 }; // calls under way, unregisterListener waits for these to return
+        std::atomic<bool> isRemoved { false }; // unregisterListener may be waiting on callsDone
+        std::mutex callsMutex;
+        std::condition_variable callsDone;
+    };
+    using HandlerPointer = std::shared_ptr<Handler>;
+    class HandlerCall;
+
+    void registerHandler(PacketTypeList types, QObject* listener, MessageHandler messageHandler,
+                         PacketHandler packetHandler, bool deliverPending);
+    HandlerPointer acquireHandlerForType(PacketType type); // the handler must be released by a HandlerCall
+    void removeHandler(PacketType type, HandlerPointer handler);
+    SharedNodePointer recordReceivedMessage(const ReceivedMessage& message);
+
     void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
 
     // these are brutal hacks for now - ideally GenericThread / ReceivedPacketProcessor
@@ -90,6 +160,12 @@ private:
 
     QMutex _packetListenerLock;
     QHash<PacketType, Listener> _messageListenerMap;
+
+    // indexed by packet type and only ever accessed through std::atomic_load and friends, so it is read without
+    // _packetListenerLock; a handler that was replaced or removed is freed once the calls holding it return
+    static const int NUM_PACKET_TYPES = 1 << (sizeof(PacketType) * 8);
+    std::array<HandlerPointer, NUM_PACKET_TYPES> _handlers;
+
     int _inPacketCount = 0;
     int _inByteCount = 0;
     bool _shouldDropPackets = false;
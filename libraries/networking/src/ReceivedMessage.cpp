@@ -12,6 +12,10 @@
 
 #include "ReceivedMessage.h"
 
+#include <algorithm>
+#include <iterator>
+
+#include <QMutexLocker>
 #include "QSharedPointer"
 
 static int receivedMessageMetaTypeId = qRegisterMetaType<ReceivedMessage*>("ReceivedMessage*");
@@ -29,18 +33,38 @@ ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
       _senderSockAddr(packetList.getSenderSockAddr()),
       _isComplete(true)
 {
+    appendChunk(_data.constData(), _data.size());
 }
 
-ReceivedMessage::ReceivedMessage(NLPacket& packet)
-    : _data(packet.readAll()),
-      _headData(_data.mid(0, HEAD_DATA_SIZE)),
+ReceivedMessage::ReceivedMessage(std::unique_ptr<NLPacket> packet)
+    : _headData(packet->getPayload(), (int)std::min(packet->getPayloadSize(), (qint64)HEAD_DATA_SIZE)),
       _numPackets(1),
-      _sourceID(packet.getSourceID()),
-      _packetType(packet.getType()),
-      _packetVersion(packet.getVersion()),
-      _senderSockAddr(packet.getSenderSockAddr()),
-      _isComplete(packet.getPacketPosition() == NLPacket::ONLY)
+      _sourceID(packet->getSourceID()),
+      _packetType(packet->getType()),
+      _packetVersion(packet->getVersion()),
+      _senderSockAddr(packet->getSenderSockAddr()),
+      _isComplete(packet->getPacketPosition() == NLPacket::ONLY)
 {
+    appendChunk(packet->getPayload(), packet->getPayloadSize());
+    _packets.push_back(std::move(packet));
+}
+
+QByteArray ReceivedMessage::getMessage() const {
+    QMutexLocker locker(&_appendLock);
+    if (_chunks.size() == 1 && _chunks.front().data == _data.constData()) {
+        return _data;
+    }
+    flatten();
+    return _data;
+}
+
+const char* ReceivedMessage::getRawMessage() const {
+    QMutexLocker locker(&_appendLock);
+    if (_chunks.size() > 1) {
+        flatten();
+    }
+    _hasRawViews = true;
+    return _chunks.empty() ? _data.constData() : _chunks.front().data;
 }
 
 void ReceivedMessage::setFailed() {
@@ -49,7 +73,7 @@ void ReceivedMessage::setFailed() {
     emit completed();
 }
 
-void ReceivedMessage::appendPacket(NLPacket& packet) {
+void ReceivedMessage::appendPacket(std::unique_ptr<NLPacket> packet) {
     Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
                "We should not be appending to a complete message");
 
@@ -58,27 +82,103 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
 
     ++_numPackets;
 
-    _data.append(packet.getPayload(), packet.getPayloadSize());
+    bool isLast = packet->getPacketPosition() == NLPacket::PacketPosition::LAST;
+
+    {
+        // the packet is kept as it is, its payload becomes the next chunk of the message
+        QMutexLocker locker(&_appendLock);
+        appendChunk(packet->getPayload(), packet->getPayloadSize());
+        _packets.push_back(std::move(packet));
+    }
 
     if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
         emit progress();
     }
 
-    if (packet.getPacketPosition() == NLPacket::PacketPosition::LAST) {
+    if (isLast) {
         _isComplete = true;
         emit completed();
     }
 }
 
+void ReceivedMessage::appendChunk(const char* data, qint64 size) const {
+    if (size > 0) {
+        _chunks.push_back({ data, size, _size });
+        _size += size;
+    }
+}
+
+std::vector<ReceivedMessage::Chunk>::const_iterator ReceivedMessage::findChunk(qint64 position) const {
+    if (_chunks.size() == 1) {
+        return (position < _chunks.front().size) ? _chunks.begin() : _chunks.end();
+    }
+    auto it = std::upper_bound(_chunks.begin(), _chunks.end(), position, [](qint64 position, const Chunk& chunk) {
+        return position < chunk.offset;
+    });
+    if (it == _chunks.begin()) {
+        return _chunks.end();
+    }
+    --it;
+    return (position < it->offset + it->size) ? it : _chunks.end();
+}
+
+const char* ReceivedMessage::contiguousData(qint64 position, qint64 size) const {
+    auto it = findChunk(position);
+    if (it == _chunks.end() || position + size > it->offset + it->size) {
+        return nullptr;
+    }
+    return it->data + (position - it->offset);
+}
+
+qint64 ReceivedMessage::gather(char* data, qint64 position, qint64 size) const {
+    qint64 copied = 0;
+    for (auto it = findChunk(position); it != _chunks.end() && copied < size; ++it) {
+        qint64 offsetInChunk = position + copied - it->offset;
+        qint64 toCopy = std::min(it->size - offsetInChunk, size - copied);
+        memcpy(data + copied, it->data + offsetInChunk, toCopy);
+        copied += toCopy;
+    }
+    return copied;
+}
+
+void ReceivedMessage::flatten() const {
+    // the size is known, so this is the only allocation the copy needs
+    QByteArray data;
+    data.reserve((int)_size);
+    for (auto& chunk : _chunks) {
+        data.append(chunk.data, (int)chunk.size);
+    }
+
+    // a pointer handed out by readWithoutCopy() or getRawMessage() since the last flatten() may point into the
+    // packets or into _data, which then have to live as long as the message does; otherwise they are freed here,
+    // and a copy of _data returned by getMessage() holds on to its buffer by itself
+    if (_hasRawViews) {
+        std::move(_packets.begin(), _packets.end(), std::back_inserter(_viewedPackets));
+        if (!_data.isEmpty()) {
+            _viewedData.push_back(_data);
+        }
+        _hasRawViews = false;
+    }
+    _packets.clear();
+    _data = data;
+
+    // the size stays as it was, readers check it without the lock
+    _chunks.clear();
+    if (!_data.isEmpty()) {
+        _chunks.push_back({ _data.constData(), _data.size(), 0 });
+    }
+}
+
 qint64 ReceivedMessage::peek(char* data, qint64 size) {
-    memcpy(data, _data.constData() + _position, size);
-    return size;
+    QMutexLocker locker(&_appendLock);
+    return gather(data, _position, size);
 }
 
 qint64 ReceivedMessage::read(char* data, qint64 size) {
-    memcpy(data, _data.constData() + _position, size);
-    _position += size;
-    return size;
+    QMutexLocker locker(&_appendLock);
+    qint64 bytesRead = gather(data, _position, size);
+    _position += bytesRead;
+    return bytesRead;
 }
 
 qint64 ReceivedMessage::readHead(char* data, qint64 size) {
@@ -88,12 +188,20 @@ qint64 ReceivedMessage::readHead(char* data, qint64 size) {
 }
 
 QByteArray ReceivedMessage::peek(qint64 size) {
-    return _data.mid(_position, size);
+    QMutexLocker locker(&_appendLock);
+    size = std::max(std::min(size, getBytesLeftToRead()), (qint64)0);
+    const char* contiguous = contiguousData(_position, size);
+    if (contiguous) {
+        return QByteArray(contiguous, (int)size);
+    }
+    QByteArray data((int)size, Qt::Uninitialized);
+    gather(data.data(), _position, size);
+    return data;
 }
 
 QByteArray ReceivedMessage::read(qint64 size) {
-    auto data = _data.mid(_position, size);
-    _position += size;
+    auto data = peek(size);
+    _position += data.size();
     return data;
 }
 
@@ -107,19 +215,39 @@ QByteArray ReceivedMessage::readAll() {
     return read(getBytesLeftToRead());
 }
 
+QByteArray ReceivedMessage::readAvailable() {
+    // what is there now, the chunks are only ever added to
+    return read(_size - _position);
+}
+
 QString ReceivedMessage::readString() {
     uint32_t size;
     readPrimitive(&size);
     //Q_ASSERT(size <= _size - _position);
-    auto string = QString::fromUtf8(_data.constData() + _position, size);
-    _position += size;
-    return string;
+    {
+        QMutexLocker locker(&_appendLock);
+        const char* contiguous = contiguousData(_position, size);
+        if (contiguous) {
+            _position += size;
+            return QString::fromUtf8(contiguous, size);
+        }
+    }
+    return QString::fromUtf8(read(size));
 }
 
 QByteArray ReceivedMessage::readWithoutCopy(qint64 size) {
-    QByteArray data { QByteArray::fromRawData(_data.constData() + _position, size) };
-    _position += size;
-    return data;
+    {
+        QMutexLocker locker(&_appendLock);
+        const char* contiguous = contiguousData(_position, size);
+        if (contiguous) {
+            _hasRawViews = true;
+            _position += size;
+            return QByteArray::fromRawData(contiguous, size);
+        }
+    }
+
+    // spread over several packets, these bytes are copied and the copy owns them
+    return read(size);
 }
 
 void ReceivedMessage::onComplete() {
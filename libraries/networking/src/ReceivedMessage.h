@@ -13,9 +13,12 @@
 #define hifi_ReceivedMessage_h
 
 #include <QByteArray>
+#include <QMutex>
 #include <QObject>
 
 #include <atomic>
+#include <memory>
+#include <vector>
 
 #include "NLPacketList.h"
 
@@ -23,17 +26,21 @@ class ReceivedMessage : public QObject {
     Q_OBJECT
 public:
     ReceivedMessage(const NLPacketList& packetList);
-    ReceivedMessage(NLPacket& packet);
+    ReceivedMessage(std::unique_ptr<NLPacket> packet);
 
-    QByteArray getMessage() const { return _data; }
-    const char* getRawMessage() const { return _data.constData(); }
+    // The message is kept in the payloads of the packets it arrived in, and only copied into one piece the first
+    // time it is asked for that way.  Prefer the read methods, which copy straight out of the packets.
+    // Data returned by getRawMessage() stays valid for the lifetime of the message, even once more packets arrive,
+    // at the cost of keeping what it points into around until then.
+    QByteArray getMessage() const;
+    const char* getRawMessage() const;
 
     PacketType getType() const { return _packetType; }
     PacketVersion getVersion() const { return _packetVersion; }
 
     void setFailed();
 
-    void appendPacket(NLPacket& packet);
+    void appendPacket(std::unique_ptr<NLPacket> packet);
 
     bool failed() const { return _failed; }
     bool isComplete() const { return _isComplete; }
@@ -46,9 +53,9 @@ public:
     // Get the number of packets that were used to send this message
     qint64 getNumPackets() const { return _numPackets; }
 
-    qint64 getSize() const { return _data.size(); }
+    qint64 getSize() const { return _size; }
 
-    qint64 getBytesLeftToRead() const { return _data.size() -  _position; }
+    qint64 getBytesLeftToRead() const { return _size - _position; }
 
     void seek(qint64 position) { _position = position; }
 
@@ -63,13 +70,18 @@ public:
     QByteArray read(qint64 size);
     QByteArray readAll();
 
+    // Reads everything received past the current position.  Like the other read methods, it can be called while
+    // packets are still being appended to the message.
+    QByteArray readAvailable();
+
     QString readString();
 
     QByteArray readHead(qint64 size);
 
     // This will return a QByteArray referencing the underlying data _without_ refcounting that data.
     // Be careful when using this method, only use it when the lifetime of the returned QByteArray will not
-    // exceed that of the ReceivedMessage.
+    // exceed that of the ReceivedMessage.  Bytes spread over several packets are copied instead, and that copy
+    // is an ordinary QByteArray.
     QByteArray readWithoutCopy(qint64 size);
 
     template<typename T> qint64 peekPrimitive(T* data);
@@ -85,9 +97,43 @@ private slots:
     void onComplete();
 
 private:
-    QByteArray _data;
+    // a piece of the message, starting at offset
+    struct Chunk {
+        const char* data;
+        qint64 size;
+        qint64 offset;
+    };
+
+    void appendChunk(const char* data, qint64 size) const;
+
+    // the chunk the position is in, or the end of _chunks
+    std::vector<Chunk>::const_iterator findChunk(qint64 position) const;
+
+    // the data at position if size bytes from there are all in one chunk, otherwise nullptr
+    const char* contiguousData(qint64 position, qint64 size) const;
+
+    // copies up to size bytes from position, across as many chunks as they are spread over
+    qint64 gather(char* data, qint64 position, qint64 size) const;
+
+    // copies what has been received into _data, which becomes the only chunk
+    void flatten() const;
+
+    // the chunks, and what they point into, are only accessed with _appendLock held
+    mutable std::vector<std::unique_ptr<NLPacket>> _packets;
+    mutable std::vector<Chunk> _chunks;
+    mutable QByteArray _data;
+    mutable QMutex _appendLock;
+
+    // a raw pointer into the packets or _data was handed out since the last flatten(), which then keeps them in
+    // _viewedPackets and _viewedData until the message is destroyed
+    mutable bool _hasRawViews { false };
+    mutable std::vector<std::unique_ptr<NLPacket>> _viewedPackets;
+    mutable std::vector<QByteArray> _viewedData;
+
     QByteArray _headData;
 
+    mutable std::atomic<qint64> _size { 0 };
+
     std::atomic<qint64> _position { 0 };
     std::atomic<qint64> _numPackets { 0 };
 
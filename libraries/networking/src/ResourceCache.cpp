@@ -9,12 +9,14 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 
 #include <QThread>
 #include <QTimer>
 
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 #include <assert.h>
 
@@ -57,7 +59,18 @@ void ResourceCache::refresh(const QUrl& url) {
 }
 
 void ResourceCache::setRequestLimit(int limit) {
-    _requestLimit = limit;
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    sharedItems->setRequestLimit(ResourceProtocol::Http, limit);
+    sharedItems->setRequestLimit(ResourceProtocol::Atp, limit);
+
+    // Now go fill any new request spots
+    while (attemptHighestPriorityRequest()) {
+        // just keep looping until we reach the new limit or no more pending requests
+    }
+}
+
+void ResourceCache::setRequestLimit(ResourceProtocol protocol, int limit) {
+    DependencyManager::get<ResourceCacheSharedItems>()->setRequestLimit(protocol, limit);
 
     // Now go fill any new request spots
     while (attemptHighestPriorityRequest()) {
@@ -159,24 +172,51 @@ void ResourceCache::clearUnusedResource() {
     }
 }
 
+// heap order: the lowest priority compares less, and among equal priorities the most recent arrival
+bool ResourceCacheSharedItems::isLowerPriority(const PendingRequest& a, const PendingRequest& b) {
+    return (a.priority < b.priority) || (a.priority == b.priority && a.sequenceNumber > b.sequenceNumber);
+}
+
+ResourceCacheSharedItems::ResourceCacheSharedItems() {
+    getState(ResourceProtocol::File).requestLimit = DEFAULT_FILE_REQUEST_LIMIT;
+}
+
 void ResourceCacheSharedItems::appendActiveRequest(Resource* resource) {
     Lock lock(_mutex);
     _loadingRequests.append(resource);
+    getState(resource->getProtocol()).loadingRequestsCount++;
 }
 
 void ResourceCacheSharedItems::appendPendingRequest(Resource* resource) {
     Lock lock(_mutex);
-    _pendingRequests.append(resource);
+    auto& pendingRequests = getState(resource->getProtocol()).pendingRequests;
+    pendingRequests.push_back({ resource, resource->getLoadPriority(), _nextSequenceNumber++ });
+    std::push_heap(pendingRequests.begin(), pendingRequests.end(), isLowerPriority);
 }
 
 QList<QPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() const {
     Lock lock(_mutex);
-    return _pendingRequests;
+    QList<QPointer<Resource>> result;
+    for (const auto& state : _protocols) {
+        for (const auto& request : state.pendingRequests) {
+            result.append(request.resource);
+        }
+    }
+    return result;
 }
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    uint32_t count = 0;
+    for (const auto& state : _protocols) {
+        count += (uint32_t)state.pendingRequests.size();
+    }
+    return count;
+}
+
+uint32_t ResourceCacheSharedItems::getPendingRequestsCount(ResourceProtocol protocol) const {
+    Lock lock(_mutex);
+    return (uint32_t)getState(protocol).pendingRequests.size();
 }
 
 QList<Resource*> ResourceCacheSharedItems::getLoadingRequests() const {
@@ -184,39 +224,92 @@ QList<Resource*> ResourceCacheSharedItems::getLoadingRequests() const {
     return _loadingRequests;
 }
 
+int ResourceCacheSharedItems::getLoadingRequestsCount(ResourceProtocol protocol) const {
+    Lock lock(_mutex);
+    return getState(protocol).loadingRequestsCount;
+}
+
 void ResourceCacheSharedItems::removeRequest(Resource* resource) {
     Lock lock(_mutex);
-    _loadingRequests.removeOne(resource);
+    if (_loadingRequests.removeOne(resource)) {
+        getState(resource->getProtocol()).loadingRequestsCount--;
+    }
+}
+
+void ResourceCacheSharedItems::refreshPendingPriorities() {
+    for (auto& state : _protocols) {
+        auto& pendingRequests = state.pendingRequests;
+        pendingRequests.erase(std::remove_if(pendingRequests.begin(), pendingRequests.end(),
+            [](const PendingRequest& request) { return request.resource.isNull(); }), pendingRequests.end());
+        for (auto& request : pendingRequests) {
+            request.priority = request.resource->getLoadPriority();
+        }
+        std::make_heap(pendingRequests.begin(), pendingRequests.end(), isLowerPriority);
+    }
 }
 
 Resource* ResourceCacheSharedItems::getHighestPendingRequest() {
     Lock lock(_mutex);
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    for (int i = 0; i < _pendingRequests.size();) {
-        Resource* resource = _pendingRequests.at(i).data();
-        if (!resource) {
-            _pendingRequests.removeAt(i);
+    if (_pendingPrioritiesChanged.exchange(false)) {
+        refreshPendingPriorities();
+    }
+
+    ProtocolState* highest = nullptr;
+    for (auto& state : _protocols) {
+        if (state.loadingRequestsCount >= state.requestLimit) {
             continue;
         }
-        float priority = resource->getLoadPriority();
-        if (priority >= highestPriority) {
-            highestPriority = priority;
-            highestIndex = i;
+        auto& pendingRequests = state.pendingRequests;
+        while (!pendingRequests.empty() && pendingRequests.front().resource.isNull()) {
+            std::pop_heap(pendingRequests.begin(), pendingRequests.end(), isLowerPriority);
+            pendingRequests.pop_back();
+        }
+        if (!pendingRequests.empty() &&
+                (!highest || isLowerPriority(highest->pendingRequests.front(), pendingRequests.front()))) {
+            highest = &state;
         }
-        i++;
     }
-    if (highestIndex >= 0) {
-        return _pendingRequests.takeAt(highestIndex);
+    if (!highest) {
+        return nullptr;
     }
-    return nullptr;
+    auto& pendingRequests = highest->pendingRequests;
+    std::pop_heap(pendingRequests.begin(), pendingRequests.end(), isLowerPriority);
+    Resource* resource = pendingRequests.back().resource.data();
+    pendingRequests.pop_back();
+    return resource;
+}
+
+void ResourceCacheSharedItems::setRequestLimit(ResourceProtocol protocol, int limit) {
+    Lock lock(_mutex);
+    getState(protocol).requestLimit = limit;
+}
+
+int ResourceCacheSharedItems::getRequestLimit(ResourceProtocol protocol) const {
+    Lock lock(_mutex);
+    return getState(protocol).requestLimit;
+}
+
+bool ResourceCacheSharedItems::isBelowRequestLimit(ResourceProtocol protocol) const {
+    Lock lock(_mutex);
+    const auto& state = getState(protocol);
+    return state.loadingRequestsCount < state.requestLimit;
+}
+
+void ResourceCacheSharedItems::recordTimeToFirstByte(ResourceProtocol protocol, quint64 usecs) {
+    Lock lock(_mutex);
+    getState(protocol).timeToFirstByte.addSample((float)usecs / (float)USECS_PER_MSEC);
+}
+
+float ResourceCacheSharedItems::getAverageTimeToFirstByte(ResourceProtocol protocol) const {
+    Lock lock(_mutex);
+    const auto& timeToFirstByte = getState(protocol).timeToFirstByte;
+    return timeToFirstByte.isAverageValid() ? timeToFirstByte.average : 0.0f;
 }
 
 bool ResourceCache::attemptRequest(Resource* resource) {
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
 
-    if (_requestsActive >= _requestLimit) {
+    if (!sharedItems->isBelowRequestLimit(resource->getProtocol())) {
         // wait until a slot becomes available
         sharedItems->appendPendingRequest(resource);
         return false;
@@ -242,14 +335,13 @@ bool ResourceCache::attemptHighestPriorityRequest() {
     return (resource && attemptRequest(resource));
 }
 
-const int DEFAULT_REQUEST_LIMIT = 10;
-int ResourceCache::_requestLimit = DEFAULT_REQUEST_LIMIT;
 int ResourceCache::_requestsActive = 0;
 
 Resource::Resource(const QUrl& url, bool delayLoad) :
     _url(url),
     _activeUrl(url),
-    _request(nullptr) {
+    _request(nullptr),
+    _protocol(ResourceManager::getProtocol(url)) {
     
     init();
     
@@ -277,6 +369,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!(_failedToLoad || _loaded)) {
         _loadPriorities.insert(owner, priority);
+        pendingPriorityChanged();
     }
 }
 
@@ -288,11 +381,20 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    pendingPriorityChanged();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     if (!(_failedToLoad || _loaded)) {
         _loadPriorities.remove(owner);
+        pendingPriorityChanged();
+    }
+}
+
+void Resource::pendingPriorityChanged() {
+    // only a request waiting for a slot needs to move in the queue
+    if (_startedLoading && !_request) {
+        DependencyManager::get<ResourceCacheSharedItems>()->pendingPrioritiesChanged();
     }
 }
 
@@ -400,6 +502,8 @@ void Resource::makeRequest() {
     connect(_request, &ResourceRequest::finished, this, &Resource::handleReplyFinished);
 
     _bytesReceived = _bytesTotal = 0;
+    _requestStartTime = usecTimestampNow();
+    _hasReceivedFirstByte = false;
 
     _request->send();
 }
@@ -407,6 +511,17 @@ void Resource::makeRequest() {
 void Resource::handleDownloadProgress(uint64_t bytesReceived, uint64_t bytesTotal) {
     _bytesReceived = bytesReceived;
     _bytesTotal = bytesTotal;
+    if (bytesReceived > 0) {
+        recordTimeToFirstByte();
+    }
+}
+
+void Resource::recordTimeToFirstByte() {
+    if (!_hasReceivedFirstByte) {
+        _hasReceivedFirstByte = true;
+        DependencyManager::get<ResourceCacheSharedItems>()->recordTimeToFirstByte(_protocol,
+            usecTimestampNow() - _requestStartTime);
+    }
 }
 
 void Resource::handleReplyFinished() {
@@ -423,6 +538,9 @@ void Resource::handleReplyFinished() {
     
     auto result = _request->getResult();
     if (result == ResourceRequest::Success) {
+        // small replies can finish without reporting any progress
+        recordTimeToFirstByte();
+
         auto extraInfo = _url == _activeUrl ? "" : QString(", %1").arg(_activeUrl.toDisplayString());
         qCDebug(networking).noquote() << QString("Request finished for %1%2").arg(_url.toDisplayString(), extraInfo);
         
@@ -12,7 +12,10 @@
 #ifndef hifi_ResourceCache_h
 #define hifi_ResourceCache_h
 
+#include <atomic>
 #include <mutex>
+#include <vector>
+
 #include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QObject>
@@ -26,6 +29,7 @@
 #include <QtNetwork/QNetworkRequest>
 
 #include <DependencyManager.h>
+#include <SimpleMovingAverage.h>
 
 #include "ResourceManager.h"
 
@@ -48,10 +52,16 @@ static const qint64 DEFAULT_UNUSED_MAX_SIZE = 1024 * BYTES_PER_MEGABYTES;
 static const qint64 MIN_UNUSED_MAX_SIZE = 0;
 static const qint64 MAX_UNUSED_MAX_SIZE = 10 * BYTES_PER_GIGABYTES;
 
+static const int DEFAULT_REQUEST_LIMIT = 10;
+static const int DEFAULT_FILE_REQUEST_LIMIT = 4;
+
 // We need to make sure that these items are available for all instances of
 // ResourceCache derived classes. Since we can't count on the ordering of
 // static members destruction, we need to use this Dependency manager implemented
 // object instead
+//
+// Pending requests are kept in one heap per protocol, ordered by load priority and then by arrival. The
+// priorities are only re-read from the resources when one of them changed since the last request was picked.
 class ResourceCacheSharedItems : public Dependency  {
     SINGLETON_DEPENDENCY
 
@@ -63,15 +73,55 @@ public:
     void removeRequest(Resource* doneRequest);
     QList<QPointer<Resource>> getPendingRequests() const;
     uint32_t getPendingRequestsCount() const;
+    uint32_t getPendingRequestsCount(ResourceProtocol protocol) const;
     QList<Resource*> getLoadingRequests() const;
+    int getLoadingRequestsCount(ResourceProtocol protocol) const;
+
+    /// Takes the highest priority pending request among the protocols below their request limit.
     Resource* getHighestPendingRequest();
 
+    /// Notes that the load priority of a pending request changed.
+    void pendingPrioritiesChanged() { _pendingPrioritiesChanged = true; }
+
+    void setRequestLimit(ResourceProtocol protocol, int limit);
+    int getRequestLimit(ResourceProtocol protocol) const;
+    bool isBelowRequestLimit(ResourceProtocol protocol) const;
+
+    void recordTimeToFirstByte(ResourceProtocol protocol, quint64 usecs);
+
+    /// Returns the moving average of the time between sending a request and receiving data, in milliseconds.
+    float getAverageTimeToFirstByte(ResourceProtocol protocol) const;
+
 private:
-    ResourceCacheSharedItems() { }
+    ResourceCacheSharedItems();
     virtual ~ResourceCacheSharedItems() { }
 
+    struct PendingRequest {
+        QPointer<Resource> resource;
+        float priority;
+        quint64 sequenceNumber;
+    };
+    using PendingRequests = std::vector<PendingRequest>;
+
+    static bool isLowerPriority(const PendingRequest& a, const PendingRequest& b);
+
+    struct ProtocolState {
+        PendingRequests pendingRequests;  // a heap
+        int loadingRequestsCount { 0 };
+        int requestLimit { DEFAULT_REQUEST_LIMIT };
+        MovingAverage<float, 50> timeToFirstByte;
+    };
+
+    static const int NUM_PROTOCOLS = (int)ResourceProtocol::NumProtocols;
+
+    ProtocolState& getState(ResourceProtocol protocol) { return _protocols[(int)protocol]; }
+    const ProtocolState& getState(ResourceProtocol protocol) const { return _protocols[(int)protocol]; }
+    void refreshPendingPriorities();
+
     mutable Mutex _mutex;
-    QList<QPointer<Resource>> _pendingRequests;
+    ProtocolState _protocols[NUM_PROTOCOLS];
+    quint64 _nextSequenceNumber { 0 };
+    std::atomic<bool> _pendingPrioritiesChanged { false };
     QList<Resource*> _loadingRequests;
 };
 
@@ -81,8 +131,14 @@ class ResourceCache : public QObject {
     Q_OBJECT
     
 public:
+    /// Sets the number of concurrent requests allowed for each network protocol.  File requests don't use
+    /// any bandwidth and have their own limit.
     static void setRequestLimit(int limit);
-    static int getRequestLimit() { return _requestLimit; }
+    static int getRequestLimit() { return getRequestLimit(ResourceProtocol::Http); }
+
+    static void setRequestLimit(ResourceProtocol protocol, int limit);
+    static int getRequestLimit(ResourceProtocol protocol)
+        { return DependencyManager::get<ResourceCacheSharedItems>()->getRequestLimit(protocol); }
 
     static int getRequestsActive() { return _requestsActive; }
     
@@ -95,6 +151,13 @@ public:
     static int getPendingRequestCount() 
         { return DependencyManager::get<ResourceCacheSharedItems>()->getPendingRequestsCount(); }
 
+    static int getPendingRequestCount(ResourceProtocol protocol)
+        { return DependencyManager::get<ResourceCacheSharedItems>()->getPendingRequestsCount(protocol); }
+
+    /// In milliseconds
+    static float getAverageTimeToFirstByte(ResourceProtocol protocol)
+        { return DependencyManager::get<ResourceCacheSharedItems>()->getAverageTimeToFirstByte(protocol); }
+
     ResourceCache(QObject* parent = NULL);
     virtual ~ResourceCache();
     
@@ -133,7 +196,6 @@ private:
     QHash<QUrl, QWeakPointer<Resource>> _resources;
     int _lastLRUKey = 0;
     
-    static int _requestLimit;
     static int _requestsActive;
 
     void getResourceAsynchronously(const QUrl& url);
@@ -172,6 +234,9 @@ public:
     /// Returns the highest load priority across all owners.
     float getLoadPriority();
 
+    /// Returns the kind of request used to load the resource, which decides the queue it waits in.
+    ResourceProtocol getProtocol() const { return _protocol; }
+
     /// Checks whether the resource has loaded.
     virtual bool isLoaded() const { return _loaded; }
 
@@ -245,6 +310,8 @@ private:
     void makeRequest();
     void retry();
     void reinsert();
+    void pendingPriorityChanged();
+    void recordTimeToFirstByte();
     
     friend class ResourceCache;
     
@@ -254,6 +321,9 @@ private:
     qint64 _bytesReceived = 0;
     qint64 _bytesTotal = 0;
     int _attempts = 0;
+    ResourceProtocol _protocol;
+    quint64 _requestStartTime = 0;
+    bool _hasReceivedFirstByte = false;
 };
 
 uint qHash(const QPointer<QObject>& value, uint seed = 0);
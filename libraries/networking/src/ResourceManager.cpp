@@ -113,3 +113,13 @@ ResourceRequest* ResourceManager::createResourceRequest(QObject* parent, const Q
     request->moveToThread(&_thread);
     return request;
 }
+
+ResourceProtocol ResourceManager::getProtocol(const QUrl& url) {
+    auto scheme = normalizeURL(url).scheme();
+    if (scheme == URL_SCHEME_FILE) {
+        return ResourceProtocol::File;
+    } else if (scheme == URL_SCHEME_ATP) {
+        return ResourceProtocol::Atp;
+    }
+    return ResourceProtocol::Http;
+}
@@ -24,6 +24,14 @@ const QString URL_SCHEME_HTTPS = "https";
 const QString URL_SCHEME_FTP = "ftp";
 const QString URL_SCHEME_ATP = "atp";
 
+// the kinds of ResourceRequest, which are scheduled and rate limited separately
+enum class ResourceProtocol : uint8_t {
+    File = 0,
+    Http,
+    Atp,
+    NumProtocols
+};
+
 class ResourceManager {
 public:
     static void setUrlPrefixOverride(const QString& prefix, const QString& replacement);
@@ -32,6 +40,9 @@ public:
 
     static ResourceRequest* createResourceRequest(QObject* parent, const QUrl& url);
 
+    /// Returns the kind of request createResourceRequest makes for the url, unknown schemes count as Http.
+    static ResourceProtocol getProtocol(const QUrl& url);
+
     static void init();
     static void cleanup();
 
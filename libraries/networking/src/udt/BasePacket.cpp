@@ -11,6 +11,8 @@
 
 #include "BasePacket.h"
 
+#include "PacketBufferPool.h"
+
 using namespace udt;
 
 const qint64 BasePacket::PACKET_WRITE_ERROR = -1;
@@ -58,7 +60,11 @@ BasePacket::BasePacket(qint64 size) {
     Q_ASSERT(size >= 0 || size < maxPayload);
     
     _packetSize = size;
-    _packet.reset(new char[_packetSize]());
+    if (_packetSize == PacketBufferPool::BUFFER_SIZE) {
+        _packet = PacketBufferPool::getInstance().allocate();
+    } else {
+        _packet.reset(new char[_packetSize]());
+    }
     _payloadCapacity = _packetSize;
     _payloadSize = 0;
     _payloadStart = _packet.get();
@@ -75,6 +81,12 @@ BasePacket::BasePacket(std::unique_ptr<char[]> data, qint64 size, const HifiSock
     
 }
 
+BasePacket::~BasePacket() {
+    if (_packet && _packetSize == PacketBufferPool::BUFFER_SIZE) {
+        PacketBufferPool::getInstance().release(std::move(_packet));
+    }
+}
+
 BasePacket::BasePacket(const BasePacket& other) :
     QIODevice()
 {
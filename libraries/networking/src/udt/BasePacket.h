@@ -38,6 +38,8 @@ public:
     static int totalHeaderSize();
     // The maximum payload size this packet can use to fit in MTU
     static int maxPayloadSize();
+
+    virtual ~BasePacket();
     
     // Payload direct access to the payload, use responsibly!
     char* getPayload() { return _payloadStart; }
@@ -100,7 +102,7 @@ protected:
     void adjustPayloadStartAndCapacity(qint64 headerSize, bool shouldDecreasePayloadSize = false);
     
     qint64 _packetSize = 0;        // Total size of the allocated memory
-    std::unique_ptr<char[]> _packet; // Allocated memory
+    std::unique_ptr<char[]> _packet; // Allocated memory, from the PacketBufferPool when it is MAX_PACKET_SIZE
     
     char* _payloadStart = nullptr; // Start of the payload
     qint64 _payloadCapacity = 0;          // Total capacity of the payload
@@ -11,8 +11,6 @@
 
 #include "Connection.h"
 
-#include <QtCore/QThread>
-
 #include <NumericalConstants.h>
 
 #include "../HifiSockAddr.h"
@@ -57,21 +55,13 @@ Connection::~Connection() {
 }
 
 void Connection::stopSendQueue() {
-    if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
-        
-        // tell the send queue to stop and be deleted
-        
+    if (auto sendQueue = std::move(_sendQueue)) {
+        // tell the send queue to stop - once it returns the socket's send scheduler is done with it
+        // and it can be deleted
         sendQueue->stop();
-        sendQueue->deleteLater();
         
         // since we're stopping the send queue we should consider our handshake ACK not receieved
         _hasReceivedHandshakeACK = false;
-        
-        // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
     }
 }
 
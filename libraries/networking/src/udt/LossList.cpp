@@ -11,6 +11,8 @@
 
 #include "LossList.h"
 
+#include <algorithm>
+
 #include "ControlPacket.h"
 
 using namespace udt;
@@ -43,16 +45,21 @@ void LossList::append(SequenceNumber start, SequenceNumber end) {
     _length += seqlen(start, end);
 }
 
+LossList::Ranges::iterator LossList::findRange(SequenceNumber seq) {
+    return lower_bound(_lossList.begin(), _lossList.end(), seq, [](const Range& range, SequenceNumber seq) {
+        return range.second < seq;
+    });
+}
+
 void LossList::insert(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::insert(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     
-    auto it = find_if_not(_lossList.begin(), _lossList.end(), [&start](pair<SequenceNumber, SequenceNumber> pair){
-        return pair.second < start;
-    });
+    // a range ending right before start is joined rather than left touching the new one
+    auto it = findRange(start - 1);
     
-    if (it == _lossList.end() || end < it->first) {
-        // No overlap, simply insert
+    if (it == _lossList.end() || end + 1 < it->first) {
+        // Neither overlapping nor touching, simply insert
         _length += seqlen(start, end);
         _lossList.insert(it, make_pair(start, end));
     } else {
@@ -78,19 +85,18 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
                 it->second = it2->second;
             }
             
-            // Remove overlapping range
+            // Overlapping range will be removed
             _length -= seqlen(it2->first, it2->second);
-            it2 = _lossList.erase(it2);
+            ++it2;
         }
+        _lossList.erase(it + 1, it2);
     }
 }
 
 bool LossList::remove(SequenceNumber seq) {
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&seq](pair<SequenceNumber, SequenceNumber> pair) {
-        return pair.first <= seq && seq <= pair.second;
-    });
+    auto it = findRange(seq);
     
-    if (it != end(_lossList)) {
+    if (it != _lossList.end() && it->first <= seq) {
         if (it->first == it->second) {
             _lossList.erase(it);
         } else if (seq == it->first) {
@@ -116,12 +122,10 @@ void LossList::remove(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::remove(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     // Find the first segment sharing sequence numbers
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&start, &end](pair<SequenceNumber, SequenceNumber> pair) {
-        return (pair.first <= start && start <= pair.second) || (start <= pair.first && pair.first <= end);
-    });
+    auto it = findRange(start);
     
     // If we found one
-    if (it != _lossList.end()) {
+    if (it != _lossList.end() && it->first <= end) {
         
         // While the end of the current segment is contained, either shorten it (first one only - sometimes)
         // or remove it altogether since it is fully contained it the range
@@ -163,7 +167,12 @@ SequenceNumber LossList::getFirstSequenceNumber() const {
 
 SequenceNumber LossList::popFirstSequenceNumber() {
     auto front = getFirstSequenceNumber();
-    remove(front);
+    if (_lossList.front().first == _lossList.front().second) {
+        _lossList.pop_front();
+    } else {
+        ++_lossList.front().first;
+    }
+    _length -= 1;
     return front;
 }
 
@@ -12,7 +12,7 @@
 #ifndef hifi_LossList_h
 #define hifi_LossList_h
 
-#include <list>
+#include <deque>
 
 #include "SequenceNumber.h"
 
@@ -30,7 +30,7 @@ public:
     void append(SequenceNumber seq);
     void append(SequenceNumber start, SequenceNumber end);
     
-    // inserts anywhere - MUCH slower
+    // inserts anywhere - slower
     void insert(SequenceNumber start, SequenceNumber end);
     
     bool remove(SequenceNumber seq);
@@ -44,7 +44,14 @@ public:
     void write(ControlPacket& packet, int maxPairs = -1);
     
 private:
-    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
+    using Range = std::pair<SequenceNumber, SequenceNumber>;
+    using Ranges = std::deque<Range>;
+
+    // the first range that ends at or after seq
+    Ranges::iterator findRange(SequenceNumber seq);
+
+    // sorted ranges that don't touch, so they can be binary searched
+    Ranges _lossList;
     int _length { 0 };
 };
     
@@ -0,0 +1,57 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+#include <cstring>
+
+#include <QtCore/QMutexLocker>
+
+using namespace udt;
+
+PacketBufferPool& PacketBufferPool::getInstance() {
+    // never destroyed, packets freed by other static destructors at exit still give their buffers back to it
+    static PacketBufferPool* instance = new PacketBufferPool();
+    return *instance;
+}
+
+std::unique_ptr<char[]> PacketBufferPool::allocate() {
+    std::unique_ptr<char[]> buffer;
+    {
+        QMutexLocker locker(&_mutex);
+        if (!_buffers.empty()) {
+            buffer = std::move(_buffers.back());
+            _buffers.pop_back();
+        }
+    }
+
+    if (!buffer) {
+        return std::unique_ptr<char[]>(new char[BUFFER_SIZE]());
+    }
+
+    memset(buffer.get(), 0, BUFFER_SIZE);
+    return buffer;
+}
+
+void PacketBufferPool::release(std::unique_ptr<char[]> buffer) {
+    if (!buffer) {
+        return;
+    }
+
+    QMutexLocker locker(&_mutex);
+    if (_buffers.size() < MAX_POOLED_BUFFERS) {
+        _buffers.push_back(std::move(buffer));
+    }
+}
+
+size_t PacketBufferPool::getNumPooledBuffers() const {
+    QMutexLocker locker(&_mutex);
+    return _buffers.size();
+}
@@ -0,0 +1,52 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QMutex>
+
+#include "Constants.h"
+
+namespace udt {
+
+// Keeps the buffers of full size packets for reuse, so that writing a large packet list doesn't allocate (and the
+// send thread doesn't free) a buffer per packet.  Any buffer of MAX_PACKET_SIZE bytes allocated with new[] can be
+// given back, wherever it came from.
+class PacketBufferPool {
+public:
+    static const int BUFFER_SIZE = MAX_PACKET_SIZE;
+
+    // buffers given back past this many are freed
+    static const size_t MAX_POOLED_BUFFERS = 1024;
+
+    static PacketBufferPool& getInstance();
+
+    // the contents of the returned buffer are zeroed, like those of a new packet
+    std::unique_ptr<char[]> allocate();
+    void release(std::unique_ptr<char[]> buffer);
+
+    size_t getNumPooledBuffers() const;
+
+private:
+    PacketBufferPool() {}
+
+    mutable QMutex _mutex;
+    std::vector<std::unique_ptr<char[]>> _buffers;
+};
+
+}
+
+#endif // hifi_PacketBufferPool_h
@@ -13,12 +13,9 @@
 
 #include <algorithm>
 #include <random>
-#include <thread>
 
-#include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 #include <QtCore/QJsonObject>
-#include <QtCore/QThread>
 
 #include <LogHandler.h>
 #include <NumericalConstants.h>
@@ -29,59 +26,27 @@
 #include "Packet.h"
 #include "PacketList.h"
 #include "../UserActivityLogger.h"
+#include "SendScheduler.h"
 #include "Socket.h"
 
 using namespace udt;
 using namespace std::chrono;
 
-template <typename Mutex1, typename Mutex2>
-class DoubleLock {
-public:
-    using Lock = std::unique_lock<DoubleLock<Mutex1, Mutex2>>;
-    
-    DoubleLock(Mutex1& mutex1, Mutex2& mutex2) : _mutex1(mutex1), _mutex2(mutex2) { }
-    
-    DoubleLock(const DoubleLock&) = delete;
-    DoubleLock& operator=(const DoubleLock&) = delete;
-    
-    // Either locks all the mutexes or none of them
-    bool try_lock() { return (std::try_lock(_mutex1, _mutex2) == -1); }
-    
-    // Locks all the mutexes
-    void lock() { std::lock(_mutex1, _mutex2); }
-    
-     // Undefined behavior if not locked
-    void unlock() { _mutex1.unlock(); _mutex2.unlock(); }
-    
-private:
-    Mutex1& _mutex1;
-    Mutex2& _mutex2;
-};
-
 std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destination) {
     Q_ASSERT_X(socket, "SendQueue::create", "Must be called with a valid Socket*");
     
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination));
 
-    // Setup queue private thread
-    QThread* thread = new QThread;
-    thread->setObjectName("Networking: SendQueue " + destination.objectName()); // Name thread for easier debug
-    
-    connect(thread, &QThread::started, queue.get(), &SendQueue::run);
-    
-    connect(queue.get(), &QObject::destroyed, thread, &QThread::quit); // Thread auto cleanup
-    connect(thread, &QThread::finished, thread, &QThread::deleteLater); // Thread auto cleanup
-    
-    // Move queue to private thread and start it
-    queue->moveToThread(thread);
-    
-    thread->start();
+    // have the queue serviced right away so that it starts on its handshake
+    queue->_scheduler->add(queue.get());
+    queue->_scheduler->wake(queue.get());
     
     return queue;
 }
     
 SendQueue::SendQueue(Socket* socket, HifiSockAddr dest) :
     _socket(socket),
+    _scheduler(&socket->getSendScheduler()),
     _destination(dest)
 {
 
@@ -99,35 +64,40 @@ SendQueue::SendQueue(Socket* socket, HifiSockAddr dest) :
     _lastACKSequenceNumber = uint32_t(_currentSequenceNumber) - 1;
 }
 
+SendQueue::~SendQueue() {
+    // make sure no worker is still servicing us
+    _scheduler->remove(this);
+}
+
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!this->thread()->isRunning() && _state == State::NotStarted) {
-        this->thread()->start();
-    }
+    // have the queue serviced in case it is waiting for packets
+    notify();
 }
 
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!this->thread()->isRunning() && _state == State::NotStarted) {
-        this->thread()->start();
-    }
+    // have the queue serviced in case it is waiting for packets
+    notify();
 }
 
 void SendQueue::stop() {
     
     _state = State::Stopped;
     
-    // Notify all conditions in case we're waiting somewhere
-    _handshakeACKCondition.notify_one();
-    _emptyCondition.notify_one();
+    // once this returns no worker is servicing the queue, and none will again
+    _scheduler->remove(this);
+}
+
+void SendQueue::notify() {
+    _notified = true;
+    
+    // only saves taking the scheduler's lock, a wake that races stop() is dropped by the scheduler once removed
+    if (_state != State::Stopped) {
+        _scheduler->wake(this);
+    }
 }
     
 int SendQueue::sendPacket(const Packet& packet) {
@@ -143,11 +113,9 @@ void SendQueue::ack(SequenceNumber ack) {
     }
     
     {
-        // remove any ACKed packets from the map of sent packets
-        QWriteLocker locker(&_sentLock);
-        for (auto seq = SequenceNumber { (uint32_t) _lastACKSequenceNumber }; seq <= ack; ++seq) {
-            _sentPackets.erase(seq);
-        }
+        // remove any ACKed packets from the sent packets
+        std::lock_guard<std::mutex> locker(_sentLock);
+        _sentPackets.removeUpTo(ack);
     }
     
     {   // remove any sequence numbers equal to or lower than this ACK in the loss list
@@ -160,8 +128,8 @@ void SendQueue::ack(SequenceNumber ack) {
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // have the queue serviced in case it is waiting with a full congestion window
+    notify();
 }
 
 void SendQueue::nak(SequenceNumber start, SequenceNumber end) {
@@ -173,8 +141,8 @@ void SendQueue::nak(SequenceNumber start, SequenceNumber end) {
         _naks.insert(start, end);
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // have the queue serviced in case it is waiting for losses to re-send
+    notify();
 }
 
 void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
@@ -198,34 +166,26 @@ void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
         }
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // have the queue serviced in case it is waiting for losses to re-send
+    notify();
 }
 
 void SendQueue::sendHandshake() {
-    std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
     if (!_hasReceivedHandshakeACK) {
         // we haven't received a handshake ACK from the client, send another now
         auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
 
         handshakePacket->writePrimitive(_initialSequenceNumber);
         _socket->writeBasePacket(*handshakePacket, _destination);
-        
-        // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
-        _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
     }
 }
 
 void SendQueue::handshakeACK(SequenceNumber initialSequenceNumber) {
     if (initialSequenceNumber == _initialSequenceNumber) {
-        {
-            std::lock_guard<std::mutex> locker { _handshakeMutex };
-            _hasReceivedHandshakeACK = true;
-        }
+        _hasReceivedHandshakeACK = true;
 
-        // Notify on the handshake ACK condition
-        _handshakeACKCondition.notify_one();
+        // have the queue serviced so that it starts sending
+        notify();
     }
 }
 
@@ -246,10 +206,8 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
 
     {
         // Insert the packet we have just sent in the sent list
-        QWriteLocker locker(&_sentLock);
-        auto& entry = _sentPackets[newPacket->getSequenceNumber()];
-        entry.first = 0; // No resend
-        entry.second.swap(newPacket);
+        std::lock_guard<std::mutex> locker(_sentLock);
+        _sentPackets.insert(sequenceNumber, std::move(newPacket));
     }
     Q_ASSERT_X(!newPacket, "SendQueue::sendNewPacketAndAddToSentList()", "Overriden packet in sent list");
 
@@ -272,100 +230,100 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     }
 }
 
-void SendQueue::run() {
+SendQueue::TimePoint SendQueue::service(TimePoint now) {
     if (_state == State::Stopped) {
-        // we've already been asked to stop before we even got a chance to start
-        // don't start now
-#ifdef UDT_CONNECTION_DEBUG
-        qDebug() << "SendQueue asked to run after being told to stop. Will not run.";
-#endif
-        return;
-    } else if (_state == State::Running) {
-#ifdef UDT_CONNECTION_DEBUG
-        qDebug() << "SendQueue asked to run but is already running (according to state). Will not re-run.";
-#endif
-        return;
+        // we've been asked to stop, or we deactivated ourselves - nothing left to do
+        return SendScheduler::NEVER;
     }
     
     _state = State::Running;
     
     // Wait for handshake to be complete
-    while (_state == State::Running && !_hasReceivedHandshakeACK) {
-        sendHandshake();
-
-        // Keep processing events
-        QCoreApplication::sendPostedEvents(this);
+    if (!_hasReceivedHandshakeACK) {
+        if (now >= _nextHandshakeTimestamp) {
+            sendHandshake();
+            
+            // we wait for the ACK or the re-send interval to expire
+            static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
+            _nextHandshakeTimestamp = now + HANDSHAKE_RESEND_INTERVAL;
+        }
         
-        // Once we're here we've either received the handshake ACK or it's going to be time to re-send a handshake.
-        // Either way let's continue processing - no packets will be sent if no handshake ACK has been received.
+        // no packets will be sent until the handshake ACK has been received
+        return _nextHandshakeTimestamp;
     }
-
-    // Keep an HRC to know when the next packet should have been
-    auto nextPacketTimestamp = p_high_resolution_clock::now();
-
-    while (_state == State::Running) {
-        bool attemptedToSendPacket = maybeResendPacket();
+    
+    // taken before we send, so that anything that happens from here on is seen by the next wait
+    bool wasNotified = _notified.exchange(false);
+    
+    if (_isIdle) {
+        // we had nothing to send, pacing picks up from now instead of catching up on the time we were idle
+        _nextPacketTimestamp = now;
+    } else if (now < _nextServiceTimestamp) {
+        // something happened before the next packet is due, it is sent at its time like the others
+        return _nextServiceTimestamp;
+    }
+    
+    auto lastPacketTimestamp = _nextPacketTimestamp;
+    
+    // send what we can - this pushes the next packet timestamp forwards by the send period of each packet sent
+    bool attemptedToSendPacket = sendBurst(_nextPacketTimestamp) > 0;
+    
+    if (_state != State::Running) {
+        return SendScheduler::NEVER;
+    }
+    
+    if (isInactive()) {
+        deactivate();
+        return SendScheduler::NEVER;
+    }
+    
+    if (!attemptedToSendPacket) {
+        _isIdle = true;
+        return waitForEvent(now, wasNotified);
+    }
+    
+    _isIdle = false;
+    _isWaitingForEvent = false;
+    
+    auto nextPacketDelta = duration_cast<microseconds>(_nextPacketTimestamp - lastPacketTimestamp).count();
+    
+    // wait as long as we need until next packet send, if we can
+    now = SendScheduler::Clock::now();
+    auto timeToSleep = duration_cast<microseconds>(_nextPacketTimestamp - now);
+    
+    // we're seeing SendQueues sleep for a long period of time here,
+    // which can lock the NodeList if it's attempting to clear connections
+    // for now we guard this by capping the time this queue can wait for
+    
+    const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
+    if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
+        qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
+        qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
+        qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
+            << "NPT:" << _nextPacketTimestamp.time_since_epoch().count()
+            << "NOW:" << now.time_since_epoch().count();
         
-        // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
-        // (this is according to the current flow window size) then we send out a new packet
-        auto newPacketCount = 0;
-        if (!attemptedToSendPacket) {
-            newPacketCount = maybeSendNewPacket();
-            attemptedToSendPacket = (newPacketCount > 0);
-        }
+        // alright, we're in a weird state
+        // we want to know why this is happening so we can implement a better fix than this guard
+        // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
+        static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
         
-        // since we're a while loop, give the thread a chance to process events
-        QCoreApplication::sendPostedEvents(this);
+        // setup a json object with the details we want
+        QJsonObject longSleepObject;
+        longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
+        longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
+        longSleepObject["nextPacketDelta"] = qint64(nextPacketDelta);
+        longSleepObject["nextPacketTimestamp"] = qint64(_nextPacketTimestamp.time_since_epoch().count());
+        longSleepObject["then"] = qint64(now.time_since_epoch().count());
         
-        // we just processed events so check now if we were just told to stop
-        // If the send queue has been innactive, skip the sleep for
-        // Either _isRunning will have been set to false and we'll break
-        // Or something happened and we'll keep going
-        if (_state != State::Running || isInactive(attemptedToSendPacket)) {
-            return;
-        }
-
-        // push the next packet timestamp forwards by the current packet send period
-        auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
-        nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
-
-        // sleep as long as we need until next packet send, if we can
-        auto now = p_high_resolution_clock::now();
-        auto timeToSleep = duration_cast<microseconds>(nextPacketTimestamp - now);
-
-        // we're seeing SendQueues sleep for a long period of time here,
-        // which can lock the NodeList if it's attempting to clear connections
-        // for now we guard this by capping the time this thread and sleep for
-
-        const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
-        if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
-            qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
-            qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
-            qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
-                << "NPT:" << nextPacketTimestamp.time_since_epoch().count()
-                << "NOW:" << now.time_since_epoch().count();
-
-            // alright, we're in a weird state
-            // we want to know why this is happening so we can implement a better fix than this guard
-            // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
-            static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
-
-            // setup a json object with the details we want
-            QJsonObject longSleepObject;
-            longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
-            longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
-            longSleepObject["nextPacketDelta"] = nextPacketDelta;
-            longSleepObject["nextPacketTimestamp"] = qint64(nextPacketTimestamp.time_since_epoch().count());
-            longSleepObject["then"] = qint64(now.time_since_epoch().count());
-
-            // hopefully send this event using the user activity logger
-            UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
-
-            timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
-        }
-
-        std::this_thread::sleep_for(timeToSleep);
+        // hopefully send this event using the user activity logger
+        UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
+        
+        timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
     }
+    
+    _nextServiceTimestamp = now + timeToSleep;
+    return _nextServiceTimestamp;
 }
 
 int SendQueue::maybeSendNewPacket() {
@@ -417,6 +375,37 @@ int SendQueue::maybeSendNewPacket() {
     return 0;
 }
 
+int SendQueue::sendBurst(TimePoint& nextPacketTimestamp) {
+    // a sleep shorter than this wakes us up too late to keep a short send period, so the packets due before then
+    // are sent together instead
+    static const microseconds MIN_SEND_QUEUE_SLEEP_USECS { 100 };
+    static const int MAX_BURST_PACKETS = 32;
+
+    int numAttempted = 0;
+    while (numAttempted < MAX_BURST_PACKETS) {
+        // re-send a lost packet, if we have one
+        int packetCount = maybeResendPacket() ? 1 : 0;
+
+        // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
+        // (this is according to the current flow window size) then we send out a new packet
+        if (packetCount == 0) {
+            packetCount = maybeSendNewPacket();
+        }
+        if (packetCount == 0) {
+            break;
+        }
+        numAttempted += packetCount;
+
+        // push the next packet timestamp forwards by the current packet send period
+        nextPacketTimestamp += microseconds(packetCount * _packetSendPeriod);
+
+        if (nextPacketTimestamp - SendScheduler::Clock::now() > MIN_SEND_QUEUE_SLEEP_USECS) {
+            break;
+        }
+    }
+    return numAttempted;
+}
+
 bool SendQueue::maybeResendPacket() {
     
     // the following while makes sure that we find a packet to re-send, if there is one
@@ -430,14 +419,14 @@ bool SendQueue::maybeResendPacket() {
             naksLocker.unlock();
             
             // pull the packet to re-send from the sent packets list
-            QReadLocker sentLocker(&_sentLock);
+            std::unique_lock<std::mutex> sentLocker(_sentLock);
             
             // see if we can find the packet to re-send
-            auto it = _sentPackets.find(resendNumber);
+            auto found = _sentPackets.find(resendNumber);
 
-            if (it != _sentPackets.end()) {
+            if (found) {
 
-                auto& entry = it->second;
+                auto& entry = *found;
                 // we found the packet - grab it
                 auto& resendPacket = *(entry.second);
                 ++entry.first; // Add 1 resend
@@ -497,7 +486,7 @@ bool SendQueue::maybeResendPacket() {
     return false;
 }
 
-bool SendQueue::isInactive(bool attemptedToSendPacket) {
+bool SendQueue::isInactive() {
     // check for connection timeout first
 
     // that will be the case if we have had 16 timeouts since hearing back from the client, and it has been
@@ -512,80 +501,77 @@ bool SendQueue::isInactive(bool attemptedToSendPacket) {
         _lastReceiverResponse > 0 &&
         sinceLastResponse > MIN_MS_BEFORE_INACTIVE) {
         // If the flow window has been full for over CONSIDER_INACTIVE_AFTER,
-        // then signal the queue is inactive and return so it can be cleaned up
+        // then signal the queue is inactive so it can be cleaned up
 
 #ifdef UDT_CONNECTION_DEBUG
         qCDebug(networking) << "SendQueue to" << _destination << "reached" << NUM_TIMEOUTS_BEFORE_INACTIVE << "timeouts"
             << "and" << MIN_MS_BEFORE_INACTIVE << "milliseconds before receiving any ACK/NAK and is now inactive. Stopping.";
 #endif
 
-        deactivate();
         return true;
     }
+    
+    return false;
+}
 
-    if (!attemptedToSendPacket) {
-        // During our processing above we didn't send any packets
+SendQueue::TimePoint SendQueue::waitForEvent(TimePoint now, bool wasNotified) {
+    // During our processing we didn't send any packets, so the packets queue (or the flow window) and the NAKs list
+    // are empty.  Anything that changes that notifies us and has us serviced again, which restarts the wait.
+    static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
+    
+    if (!_isWaitingForEvent || wasNotified) {
+        _isWaitingForEvent = true;
+        _isWaitingToDeactivate = uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber);
         
-        // If that is still the case we should use a condition_variable_any to sleep until we have data to handle.
-        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
-        using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
-        DoubleLock doubleLock(_packets.getLock(), _naksLock);
-        DoubleLock::Lock locker(doubleLock, std::try_to_lock);
+        if (_isWaitingToDeactivate) {
+            // we've sent the client as much data as we have (and they've ACKed it)
+            // either wait for new data to send or 5 seconds before cleaning up the queue
+            _eventDeadline = now + EMPTY_QUEUES_INACTIVE_TIMEOUT;
+        } else {
+            // We think the client is still waiting for data (based on the sequence number gap)
+            // Let's wait either for a response from the client or until the estimated timeout
+            // (plus the sync interval to allow the client to respond) has elapsed
+            _eventDeadline = now + std::chrono::microseconds(_estimatedTimeout + _syncInterval);
+        }
         
-        if (locker.owns_lock() && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-            // The packets queue and loss list mutexes are now both locked and they're both empty
-            
-            if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
-                // we've sent the client as much data as we have (and they've ACKed it)
-                // either wait for new data to send or 5 seconds before cleaning up the queue
-                static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
+        return _eventDeadline;
+    }
+    
+    if (now < _eventDeadline) {
+        return _eventDeadline;
+    }
+    
+    // nothing happened before the deadline
+    _isWaitingForEvent = false;
+    
+    if (_isWaitingToDeactivate) {
 #ifdef UDT_CONNECTION_DEBUG
-                    qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
-                        << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
-                        << "seconds and receiver has ACKed all packets."
-                        << "The queue is now inactive and will be stopped.";
+        qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
+            << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
+            << "seconds and receiver has ACKed all packets."
+            << "The queue is now inactive and will be stopped.";
 #endif
-
-                    // we have the lock again - Make sure to unlock it
-                    locker.unlock();
-                    
-                    // Deactivate queue
-                    deactivate();
-                    return true;
-                }
-
-            } else {
-                // We think the client is still waiting for data (based on the sequence number gap)
-                // Let's wait either for a response from the client or until the estimated timeout
-                // (plus the sync interval to allow the client to respond) has elapsed
-                auto waitDuration = std::chrono::microseconds(_estimatedTimeout + _syncInterval);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, waitDuration);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()
-                    && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
-                    // after a timeout if we still have sent packets that the client hasn't ACKed we
-                    // add them to the loss list
-                    
-                    // Note that thanks to the DoubleLock we have the _naksLock right now
-                    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
-
-                    // we have the lock again - time to unlock it
-                    locker.unlock();
-                    
-                    emit timeout();
-                }
-            }
-        }
+        
+        // Deactivate queue
+        deactivate();
+        return SendScheduler::NEVER;
     }
     
-    return false;
+    std::unique_lock<std::mutex> nakLocker(_naksLock);
+    
+    // a NAK that came in since has us serviced again and re-sends what it lists
+    if (_naks.isEmpty() && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
+        // after a timeout if we still have sent packets that the client hasn't ACKed we
+        // add them to the loss list
+        _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+        
+        nakLocker.unlock();
+        
+        emit timeout();
+    }
+    
+    // re-send what we just added to the loss list, or start waiting again
+    return now;
 }
 
 void SendQueue::deactivate() {
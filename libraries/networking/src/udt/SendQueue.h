@@ -13,17 +13,12 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
 #include <QtCore/QObject>
-#include <QtCore/QReadWriteLock>
-
-#include <PortableHighResolutionClock.h>
 
 #include "../HifiSockAddr.h"
 
@@ -31,6 +26,8 @@
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
 #include "LossList.h"
+#include "SendScheduler.h"
+#include "SentPacketBuffer.h"
 
 namespace udt {
     
@@ -40,6 +37,8 @@ class Packet;
 class PacketList;
 class Socket;
     
+// Sends the packets of one Connection.  It has no thread of its own, the SendScheduler of its Socket services it
+// whenever it is due to send or something happens to it.
 class SendQueue : public QObject {
     Q_OBJECT
     
@@ -51,6 +50,7 @@ public:
     };
     
     static std::unique_ptr<SendQueue> create(Socket* socket, HifiSockAddr destination);
+    ~SendQueue();
     
     void queuePacket(std::unique_ptr<Packet> packet);
     void queuePacketList(std::unique_ptr<PacketList> packetList);
@@ -82,14 +82,18 @@ signals:
     void shortCircuitLoss(quint32 sequenceNumber);
     void timeout();
     
-private slots:
-    void run();
-    
 private:
+    using TimePoint = SendScheduler::TimePoint;
+    
     SendQueue(Socket* socket, HifiSockAddr dest);
     SendQueue(SendQueue& other) = delete;
     SendQueue(SendQueue&& other) = delete;
     
+    // Called by the SendScheduler, sends what is due and returns when the queue next needs to be serviced
+    TimePoint service(TimePoint now);
+    
+    void notify(); // something happened that the queue may have to act on, have it serviced now
+    
     void sendHandshake();
     
     int sendPacket(const Packet& packet);
@@ -97,8 +101,12 @@ private:
     
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
+
+    // Sends the packets that are due before the queue could be serviced again, returns how many it attempted to send
+    int sendBurst(TimePoint& nextPacketTimestamp);
     
-    bool isInactive(bool attemptedToSendPacket);
+    bool isInactive(); // true when the receiver has stopped responding to us
+    TimePoint waitForEvent(TimePoint now, bool wasNotified); // with nothing to send, returns when to stop waiting
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
@@ -109,6 +117,7 @@ private:
     PacketQueue _packets;
     
     Socket* _socket { nullptr }; // Socket to send packet on
+    SendScheduler* _scheduler { nullptr }; // Services this queue, owned by the socket
     HifiSockAddr _destination; // Destination addr
 
     SequenceNumber _initialSequenceNumber; // Randomized on SendQueue creation, identifies connection during re-connect requests
@@ -130,15 +139,23 @@ private:
     mutable std::mutex _naksLock; // Protects the naks list.
     LossList _naks; // Sequence numbers of packets to resend
     
-    mutable QReadWriteLock _sentLock; // Protects the sent packet list
-    using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
-    std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
+    mutable std::mutex _sentLock; // Protects the sent packet list
+    SentPacketBuffer _sentPackets; // Packets waiting for ACK.
     
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
     
-    std::condition_variable_any _emptyCondition;
+    std::atomic<bool> _notified { false }; // set by every event, so a wait for one can tell that it happened
+    
+    // only used by service(), which is never run by two threads at once
+    TimePoint _nextHandshakeTimestamp; // when to re-send our handshake if it hasn't been ACKed yet
+    TimePoint _nextPacketTimestamp; // when the next packet should be sent, according to the send period
+    TimePoint _nextServiceTimestamp; // when we asked to be serviced again to keep up the send period
+    bool _isIdle { true }; // nothing was sent the last time the queue was serviced, or it hasn't sent yet
+    bool _isWaitingForEvent { false };
+    bool _isWaitingToDeactivate { false }; // everything was ACKed when we started waiting
+    TimePoint _eventDeadline; // when the wait for an event gives up
+    
+    friend class SendScheduler;
 };
     
 }
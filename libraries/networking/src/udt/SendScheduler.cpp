@@ -0,0 +1,251 @@
+//
+//  SendScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendScheduler.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <QtCore/QThread>
+#include <QtCore/QtGlobal>
+
+#include "SendQueue.h"
+
+using namespace udt;
+using namespace std::chrono;
+
+// the wheel turns once every ~100ms, a queue due further out than that waits in its slot for a later turn
+static const int64_t TICK_USECS = 100;
+static const int64_t WHEEL_SIZE = 1024;
+
+static const int MAX_SEND_THREADS = 4;
+
+static const int64_t NO_TICK = std::numeric_limits<int64_t>::max();
+
+const SendScheduler::TimePoint SendScheduler::NEVER = SendScheduler::TimePoint::max();
+
+SendScheduler::SendScheduler(int numThreads) :
+    _numThreads(numThreads > 0 ? numThreads : qBound(1, QThread::idealThreadCount() / 2, MAX_SEND_THREADS)),
+    _start(Clock::now()),
+    _wheel(WHEEL_SIZE),
+    _earliestTick(NO_TICK)
+{
+}
+
+SendScheduler::~SendScheduler() {
+    {
+        std::lock_guard<std::mutex> locker(_mutex);
+        _isStopping = true;
+    }
+    _workCondition.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void SendScheduler::add(SendQueue* queue) {
+    std::lock_guard<std::mutex> locker(_mutex);
+    if (_isStopping) {
+        return;
+    }
+
+    // the workers are only started once there is something for them to do
+    if (_threads.empty()) {
+        startThreads();
+    }
+
+    _entries[queue] = Entry();
+}
+
+void SendScheduler::schedule(SendQueue* queue, TimePoint when) {
+    std::lock_guard<std::mutex> locker(_mutex);
+
+    // checked under the lock, so a queue that is being stopped on another thread can't be put back on the wheel
+    auto it = _entries.find(queue);
+    if (it == _entries.end()) {
+        return;
+    }
+
+    Entry& entry = it->second;
+    if (entry.isRunning) {
+        // the worker servicing it puts it back on the wheel when it is done
+        entry.requested = std::min(entry.requested, when);
+    } else if (!entry.isScheduled || when < entry.when) {
+        insert(queue, entry, when);
+    }
+}
+
+void SendScheduler::remove(SendQueue* queue) {
+    std::unique_lock<std::mutex> locker(_mutex);
+    _doneCondition.wait(locker, [&] {
+        auto it = _entries.find(queue);
+        return it == _entries.end() || !it->second.isRunning;
+    });
+
+    // anything of it still on the wheel is skipped now that the entry is gone
+    _entries.erase(queue);
+}
+
+void SendScheduler::run() {
+    std::unique_lock<std::mutex> locker(_mutex);
+
+    while (!_isStopping) {
+        collectDueQueues(Clock::now());
+
+        if (_ready.empty()) {
+            auto nextDueTime = getNextDueTime();
+            if (nextDueTime == NEVER) {
+                _workCondition.wait(locker);
+            } else {
+                _workCondition.wait_until(locker, nextDueTime);
+            }
+            continue;
+        }
+
+        SlotEntry slotEntry = _ready.front();
+        _ready.pop_front();
+        if (!isCurrent(slotEntry)) {
+            continue;
+        }
+
+        auto queue = slotEntry.queue;
+        Entry& entry = _entries[queue];
+        entry.isScheduled = false;
+        entry.isRunning = true;
+        entry.requested = NEVER;
+
+        // let another worker pick up the next queue while we service this one
+        if (!_ready.empty()) {
+            _workCondition.notify_one();
+        }
+
+        locker.unlock();
+        auto next = queue->service(Clock::now());
+        locker.lock();
+
+        // remove() waits for us, so the entry is still there
+        Entry& finishedEntry = _entries[queue];
+        finishedEntry.isRunning = false;
+        next = std::min(next, finishedEntry.requested);
+        if (next != NEVER) {
+            insert(queue, finishedEntry, next);
+        }
+
+        _doneCondition.notify_all();
+    }
+}
+
+int64_t SendScheduler::tickForTime(TimePoint time) const {
+    if (time <= _start) {
+        return 0;
+    }
+    // rounded up, so that a queue is never serviced before the time it asked for
+    auto usecs = duration_cast<microseconds>(time - _start).count();
+    return (usecs + TICK_USECS - 1) / TICK_USECS;
+}
+
+SendScheduler::TimePoint SendScheduler::timeForTick(int64_t tick) const {
+    return _start + microseconds(tick * TICK_USECS);
+}
+
+void SendScheduler::startThreads() {
+    for (int i = 0; i < _numThreads; ++i) {
+        _threads.emplace_back(&SendScheduler::run, this);
+    }
+}
+
+void SendScheduler::insert(SendQueue* queue, Entry& entry, TimePoint when) {
+    entry.when = when;
+    entry.generation = ++_nextGeneration;
+    entry.isScheduled = true;
+
+    SlotEntry slotEntry { queue, entry.generation, tickForTime(when) };
+    if (slotEntry.tick < _nextTick) {
+        // its slot has already gone by
+        _ready.push_back(slotEntry);
+    } else {
+        _wheel[slotEntry.tick % WHEEL_SIZE].push_back(slotEntry);
+        if (_isEarliestTickKnown) {
+            _earliestTick = std::min(_earliestTick, slotEntry.tick);
+        }
+    }
+
+    // a waiting worker may be waiting for something later than this
+    _workCondition.notify_one();
+}
+
+bool SendScheduler::isCurrent(const SlotEntry& slotEntry) const {
+    auto it = _entries.find(slotEntry.queue);
+    return it != _entries.end() && it->second.isScheduled && it->second.generation == slotEntry.generation;
+}
+
+void SendScheduler::collectDueQueues(TimePoint now) {
+    if (now < _start) {
+        return;
+    }
+    int64_t lastDueTick = duration_cast<microseconds>(now - _start).count() / TICK_USECS;
+    if (lastDueTick < _nextTick) {
+        return;
+    }
+
+    // after a long wait a single turn of the wheel is enough to find everything that is due
+    int64_t firstTick = std::max(_nextTick, lastDueTick - WHEEL_SIZE + 1);
+    for (int64_t tick = firstTick; tick <= lastDueTick; ++tick) {
+        auto& slot = _wheel[tick % WHEEL_SIZE];
+
+        // keep what is due on a later turn, drop what has been rescheduled or removed since
+        auto keep = slot.begin();
+        for (auto it = slot.begin(); it != slot.end(); ++it) {
+            if (!isCurrent(*it)) {
+                continue;
+            }
+            if (it->tick <= lastDueTick) {
+                _ready.push_back(*it);
+            } else {
+                *keep++ = *it;
+            }
+        }
+        slot.erase(keep, slot.end());
+    }
+
+    _nextTick = lastDueTick + 1;
+
+    // what comes next has to be looked for again
+    if (_isEarliestTickKnown && _earliestTick <= lastDueTick) {
+        _isEarliestTickKnown = false;
+    }
+}
+
+SendScheduler::TimePoint SendScheduler::getNextDueTime() {
+    if (_isEarliestTickKnown) {
+        // it may have been rescheduled or removed since, which only costs a worker an early wake up
+        return _earliestTick == NO_TICK ? NEVER : timeForTick(_earliestTick);
+    }
+
+    int64_t earliestTick = NO_TICK;
+    for (int64_t tick = _nextTick; tick < _nextTick + WHEEL_SIZE; ++tick) {
+        for (auto& slotEntry : _wheel[tick % WHEEL_SIZE]) {
+            if (isCurrent(slotEntry)) {
+                earliestTick = std::min(earliestTick, slotEntry.tick);
+            }
+        }
+
+        // the slots still to look at can't hold anything due before this
+        if (earliestTick <= tick) {
+            break;
+        }
+    }
+
+    _earliestTick = earliestTick;
+    _isEarliestTickKnown = true;
+
+    return earliestTick == NO_TICK ? NEVER : timeForTick(earliestTick);
+}
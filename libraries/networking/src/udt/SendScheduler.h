@@ -0,0 +1,107 @@
+//
+//  SendScheduler.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SendScheduler_h
+#define hifi_SendScheduler_h
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace udt {
+
+class SendQueue;
+
+// Services the send queues of every connection on a Socket from a small, fixed set of worker threads.
+//
+// Each queue is serviced when it next wants to send (its pacing, a handshake re-send or a timeout) or as soon as
+// something happens to it.  Those times are kept on a hashed timing wheel, so scheduling a queue costs the same however
+// many are waiting.  The earliest due tick is remembered, and the wheel is only searched for the next one once that
+// tick has been collected.  A queue is only ever serviced by one worker at a time, and only between add() and remove().
+class SendScheduler {
+public:
+    // steady, so that a change of the system time can't stall or rush the waits; high_resolution_clock is the system
+    // clock on some standard libraries
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    // returned by a queue that only needs to be serviced when something happens to it
+    static const TimePoint NEVER;
+
+    SendScheduler(int numThreads = 0);
+    ~SendScheduler();
+
+    int getNumThreads() const { return _numThreads; }
+
+    // the queue can be scheduled from now on
+    void add(SendQueue* queue);
+
+    // services the queue at the given time, or earlier if it was already going to be serviced earlier; does nothing
+    // for a queue that was never added or has been removed, however late the call comes in
+    void schedule(SendQueue* queue, TimePoint when);
+    void wake(SendQueue* queue) { schedule(queue, Clock::now()); }
+
+    // forgets the queue, waiting for a worker that is servicing it to be done with it
+    void remove(SendQueue* queue);
+
+private:
+    struct Entry {
+        TimePoint when { NEVER };
+        uint64_t generation { 0 }; // changes every time the queue is put on the wheel, so older slots can be skipped
+        bool isScheduled { false };
+        bool isRunning { false };
+        TimePoint requested { NEVER }; // earliest time asked for while it was being serviced
+    };
+
+    struct SlotEntry {
+        SendQueue* queue;
+        uint64_t generation;
+        int64_t tick;
+    };
+
+    void run();
+
+    int64_t tickForTime(TimePoint time) const;
+    TimePoint timeForTick(int64_t tick) const;
+
+    // all called with _mutex locked
+    void startThreads();
+    void insert(SendQueue* queue, Entry& entry, TimePoint when);
+    bool isCurrent(const SlotEntry& slotEntry) const;
+    void collectDueQueues(TimePoint now);
+    TimePoint getNextDueTime();
+
+    const int _numThreads;
+    const TimePoint _start;
+
+    std::mutex _mutex;
+    std::condition_variable _workCondition; // workers wait on this for queues to service
+    std::condition_variable _doneCondition; // remove() waits on this for a worker to finish with a queue
+
+    std::unordered_map<SendQueue*, Entry> _entries;
+    std::vector<std::vector<SlotEntry>> _wheel;
+    int64_t _nextTick { 0 }; // first tick of the wheel that hasn't been collected yet
+    int64_t _earliestTick; // no later than anything on the wheel, when known
+    bool _isEarliestTickKnown { true };
+    uint64_t _nextGeneration { 0 };
+    std::deque<SlotEntry> _ready; // queues that are due, in the order they became due
+
+    std::vector<std::thread> _threads;
+    bool _isStopping { false };
+};
+
+}
+
+#endif // hifi_SendScheduler_h
@@ -0,0 +1,93 @@
+//
+//  SentPacketBuffer.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketBuffer.h"
+
+#include <algorithm>
+
+#include <QtCore/QtGlobal>
+
+#include "Packet.h"
+
+using namespace udt;
+
+// a power of two no bigger than SequenceNumber::MAX + 1, so the index of a sequence number is the same before and
+// after the sequence numbers wrap
+static const int MIN_CAPACITY = 64;
+
+// buffers that grew past this size for a burst are given back once they are empty
+static const int MAX_IDLE_CAPACITY = 1024;
+
+void SentPacketBuffer::insert(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet) {
+    if (_size == 0) {
+        _first = sequenceNumber;
+    }
+    Q_ASSERT_X(sequenceNumber == _first + _size, "SentPacketBuffer::insert()", "Sequence number out of order");
+
+    if (_size == getCapacity()) {
+        setCapacity(std::max(MIN_CAPACITY, 2 * getCapacity()));
+    }
+
+    auto& entry = _entries[indexOf(sequenceNumber)];
+    entry.first = 0; // No resend
+    entry.second = std::move(packet);
+    ++_size;
+}
+
+SentPacketBuffer::Entry* SentPacketBuffer::find(SequenceNumber sequenceNumber) {
+    if (_size == 0) {
+        return nullptr;
+    }
+    int offset = seqoff(_first, sequenceNumber);
+    if (offset < 0 || offset >= _size) {
+        return nullptr;
+    }
+    return &_entries[indexOf(sequenceNumber)];
+}
+
+void SentPacketBuffer::removeUpTo(SequenceNumber sequenceNumber) {
+    if (_size == 0) {
+        return;
+    }
+    int offset = seqoff(_first, sequenceNumber);
+    if (offset < 0) {
+        return;
+    }
+
+    int numToRemove = std::min(offset + 1, _size);
+    for (int i = 0; i < numToRemove; ++i) {
+        _entries[indexOf(_first)].second.reset();
+        ++_first;
+    }
+    _size -= numToRemove;
+
+    if (_size == 0 && getCapacity() > MAX_IDLE_CAPACITY) {
+        std::vector<Entry>().swap(_entries);
+    }
+}
+
+size_t SentPacketBuffer::indexOf(SequenceNumber sequenceNumber) const {
+    return (SequenceNumber::UType)sequenceNumber & (_entries.size() - 1);
+}
+
+void SentPacketBuffer::setCapacity(int capacity) {
+    Q_ASSERT(capacity >= _size && (capacity & (capacity - 1)) == 0);
+
+    std::vector<Entry> entries(capacity);
+    entries.swap(_entries);
+    int oldCapacity = (int)entries.size();
+
+    // the packets held move to where their sequence numbers fall in the new ring
+    SequenceNumber sequenceNumber = _first;
+    for (int i = 0; i < _size; ++i, ++sequenceNumber) {
+        auto& entry = entries[(SequenceNumber::UType)sequenceNumber & (oldCapacity - 1)];
+        _entries[indexOf(sequenceNumber)] = std::move(entry);
+    }
+}
@@ -0,0 +1,59 @@
+//
+//  SentPacketBuffer.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SentPacketBuffer_h
+#define hifi_SentPacketBuffer_h
+
+#include <memory>
+#include <vector>
+
+#include "SequenceNumber.h"
+
+namespace udt {
+
+class Packet;
+
+// The packets a SendQueue has sent and is waiting to have ACKed, in a ring indexed by sequence number.
+//
+// Packets are added in sequence and ACKs remove them from the front, so the ones held are always a run of consecutive
+// sequence numbers.  The ring doubles when that run outgrows it.  A ring that a burst grew past 1024 entries is freed
+// once everything has been ACKed, smaller ones are kept for the next packets.  Not thread-safe, the SendQueue locks
+// around it.
+class SentPacketBuffer {
+public:
+    using Entry = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
+
+    // sequenceNumber must follow the last one inserted, unless the buffer is empty
+    void insert(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet);
+
+    // nullptr if that packet isn't held, because it was ACKed already
+    Entry* find(SequenceNumber sequenceNumber);
+
+    // removes the packets up to and including sequenceNumber
+    void removeUpTo(SequenceNumber sequenceNumber);
+
+    int getSize() const { return _size; }
+    bool isEmpty() const { return _size == 0; }
+    int getCapacity() const { return (int)_entries.size(); }
+
+private:
+    size_t indexOf(SequenceNumber sequenceNumber) const;
+    void setCapacity(int capacity);
+
+    std::vector<Entry> _entries; // the size is always a power of two
+    SequenceNumber _first; // oldest packet held
+    int _size { 0 };
+};
+
+}
+
+#endif // hifi_SentPacketBuffer_h
@@ -24,6 +24,7 @@
 #include "../HifiSockAddr.h"
 #include "CongestionControl.h"
 #include "Connection.h"
+#include "SendScheduler.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -90,6 +91,9 @@ private slots:
 private:
     void setSystemBufferSizes();
     Connection& findOrCreateConnection(const HifiSockAddr& sockAddr);
+    
+    // used by the SendQueues of our connections
+    SendScheduler& getSendScheduler() { return _sendScheduler; }
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
     ConnectionStats::Stats sampleStatsForConnection(const HifiSockAddr& destination);
@@ -108,6 +112,8 @@ private:
     
     std::unordered_map<HifiSockAddr, BasePacketHandler> _unfilteredHandlers;
     std::unordered_map<HifiSockAddr, SequenceNumber> _unreliableSequenceNumbers;
+    
+    SendScheduler _sendScheduler; // services the SendQueues of the connections below, so it has to outlive them
     std::unordered_map<HifiSockAddr, std::unique_ptr<Connection>> _connectionsHash;
     
     int _synInterval { 10 }; // 10ms
@@ -117,6 +123,7 @@ private:
     
     std::unique_ptr<CongestionControlVirtualFactory> _ccFactory { new CongestionControlFactory<DefaultCC>() };
     
+    friend SendQueue;
     friend UDTTest;
 };
     
@@ -228,58 +228,89 @@ void OctreeEditPacketSender::queueOctreeEditMessage(PacketType type, QByteArray&
     DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node){
         // only send to the NodeTypes that are getMyNodeType()
         if (node->getActiveSocket() && node->getType() == getMyNodeType()) {
-            QUuid nodeUUID = node->getUUID();
-            bool isMyJurisdiction = true;
+            queueOctreeEditMessageToNode(type, editMessage, node);
+        }
+    });
 
-            if (type == PacketType::EntityErase) {
-                isMyJurisdiction = true; // send erase messages to all servers
-            } else if (_serverJurisdictions) {
-                // we need to get the jurisdiction for this
-                // here we need to get the "pending packet" for this server
-                _serverJurisdictions->withReadLock([&] {
-                    if ((*_serverJurisdictions).find(nodeUUID) != (*_serverJurisdictions).end()) {
-                        const JurisdictionMap& map = (*_serverJurisdictions)[nodeUUID];
-                        isMyJurisdiction = (map.isMyJurisdiction(reinterpret_cast<const unsigned char*>(editMessage.data()),
-                            CHECK_NODE_ONLY) == JurisdictionMap::WITHIN);
-                    } else {
-                        isMyJurisdiction = false;
-                    }
-                });
-            }
-            if (isMyJurisdiction) {
-                std::unique_ptr<NLPacket>& bufferedPacket = _pendingEditPackets[nodeUUID];
+    _packetsQueueLock.unlock();
 
-                if (!bufferedPacket) {
-                    bufferedPacket = initializePacket(type, node->getClockSkewUsec());
-                } else {
-                    // If we're switching type, then we send the last one and start over
-                    if ((type != bufferedPacket->getType() && bufferedPacket->getPayloadSize() > 0) ||
-                        (editMessage.size() >= bufferedPacket->bytesAvailableForWrite())) {
+}
 
-                        // create the new packet and swap it with the packet in _pendingEditPackets
-                        auto packetToRelease = initializePacket(type, node->getClockSkewUsec());
-                        bufferedPacket.swap(packetToRelease);
+void OctreeEditPacketSender::queueOctreeEditMessages(PacketType type, QVector<QByteArray>& editMessages) {
+    if (!_shouldSend || editMessages.isEmpty()) {
+        return; // bail early
+    }
 
-                        // release the previously buffered packet
-                        releaseQueuedPacket(nodeUUID, std::move(packetToRelease));
-                    }
-                }
+    if (!serversExist()) {
+        for (auto& editMessage : editMessages) {
+            queueOctreeEditMessage(type, editMessage);
+        }
+        return;
+    }
 
-                // This is really the first time we know which server/node this particular edit message
-                // is going to, so we couldn't adjust for clock skew till now. But here's our chance.
-                // We call this virtual function that allows our specific type of EditPacketSender to
-                // fixup the buffer for any clock skew
-                if (node->getClockSkewUsec() != 0) {
-                    adjustEditPacketForClockSkew(type, editMessage, node->getClockSkewUsec());
-                }
+    // the whole batch is packed under one lock and one pass over the nodes
+    _packetsQueueLock.lock();
 
-                bufferedPacket->write(editMessage);
+    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node){
+        if (node->getActiveSocket() && node->getType() == getMyNodeType()) {
+            for (auto& editMessage : editMessages) {
+                queueOctreeEditMessageToNode(type, editMessage, node);
             }
         }
     });
 
     _packetsQueueLock.unlock();
+}
+
+void OctreeEditPacketSender::queueOctreeEditMessageToNode(PacketType type, QByteArray& editMessage,
+                                                          const SharedNodePointer& node) {
+    QUuid nodeUUID = node->getUUID();
+    bool isMyJurisdiction = true;
+
+    if (type == PacketType::EntityErase) {
+        isMyJurisdiction = true; // send erase messages to all servers
+    } else if (_serverJurisdictions) {
+        // we need to get the jurisdiction for this
+        // here we need to get the "pending packet" for this server
+        _serverJurisdictions->withReadLock([&] {
+            if ((*_serverJurisdictions).find(nodeUUID) != (*_serverJurisdictions).end()) {
+                const JurisdictionMap& map = (*_serverJurisdictions)[nodeUUID];
+                isMyJurisdiction = (map.isMyJurisdiction(reinterpret_cast<const unsigned char*>(editMessage.data()),
+                    CHECK_NODE_ONLY) == JurisdictionMap::WITHIN);
+            } else {
+                isMyJurisdiction = false;
+            }
+        });
+    }
+    if (isMyJurisdiction) {
+        std::unique_ptr<NLPacket>& bufferedPacket = _pendingEditPackets[nodeUUID];
 
+        if (!bufferedPacket) {
+            bufferedPacket = initializePacket(type, node->getClockSkewUsec());
+        } else {
+            // If we're switching type, then we send the last one and start over
+            if ((type != bufferedPacket->getType() && bufferedPacket->getPayloadSize() > 0) ||
+                (editMessage.size() >= bufferedPacket->bytesAvailableForWrite())) {
+
+                // create the new packet and swap it with the packet in _pendingEditPackets
+                auto packetToRelease = initializePacket(type, node->getClockSkewUsec());
+                bufferedPacket.swap(packetToRelease);
+
+                // release the previously buffered packet
+                releaseQueuedPacket(nodeUUID, std::move(packetToRelease));
+            }
+        }
+
+        // This is really the first time we know which server/node this particular edit message
+        // is going to, so we couldn't adjust for clock skew till now. But here's our chance.
+        // We call this virtual function that allows our specific type of EditPacketSender to
+        // fixup the buffer for any clock skew
+        if (node->getClockSkewUsec() != 0) {
+            adjustEditPacketForClockSkew(type, editMessage, node->getClockSkewUsec());
+        }
+
+        bufferedPacket->write(editMessage);
+    }
 }
 
 void OctreeEditPacketSender::releaseQueuedMessages() {
@@ -14,6 +14,8 @@
 
 #include <unordered_map>
 
+#include <QVector>
+
 #include <PacketSender.h>
 #include <udt/PacketHeaders.h>
 
@@ -32,6 +34,9 @@ public:
     /// MaxPendingMessages will be buffered and processed when servers are known.
     void queueOctreeEditMessage(PacketType type, QByteArray& editMessage);
 
+    /// Queues several edit messages of one type, packing them into the pending packet of each server in a single pass.
+    void queueOctreeEditMessages(PacketType type, QVector<QByteArray>& editMessages);
+
     /// Releases all queued messages even if those messages haven't filled an MTU packet. This will move the packed message
     /// packets onto the send queue. If running in threaded mode, the caller does not need to do any further processing to
     /// have these packets get sent. If running in non-threaded mode, the caller must still call process() on a regular
@@ -91,6 +96,7 @@ protected:
     void queuePacketToNodes(std::unique_ptr<NLPacket> packet);
     std::unique_ptr<NLPacket> initializePacket(PacketType type, int nodeClockSkew);
     void releaseQueuedPacket(const QUuid& nodeUUID, std::unique_ptr<NLPacket> packetBuffer); // releases specific queued packet
+    void queueOctreeEditMessageToNode(PacketType type, QByteArray& editMessage, const SharedNodePointer& node);
 
     void processPreServerExistsPackets();
 
@@ -81,11 +81,15 @@ void OctreeElement::init(unsigned char * octalCode) {
 
 #ifdef SIMPLE_EXTERNAL_CHILDREN
     _childrenSingle.reset();
-#endif
 
     for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
         _externalChildren[i].reset();
     }
+#endif
+
+#ifdef COMPACT_CHILD_ARRAY
+    _compactChildren = nullptr;
+#endif
 
     _isDirty = true;
     _shouldRender = false;
@@ -247,7 +251,41 @@ AtomicUIntStat OctreeElement::_setChildAtIndexCalls { 0 };
 AtomicUIntStat OctreeElement::_externalChildrenCount { 0 };
 AtomicUIntStat OctreeElement::_childrenCount[NUMBER_OF_CHILDREN + 1];
 
+#ifdef COMPACT_CHILD_ARRAY
+// the position of a child in _compactChildren is the number of children before it, whose bits are above its own
+static inline int compactChildSlot(unsigned char childBitmask, int childIndex) {
+    return numberOfOnes((unsigned char)(childBitmask >> (NUMBER_OF_CHILDREN - childIndex)));
+}
+#endif
+
+#ifndef NDEBUG
+// flags an element while its children change, so that a lookup or another change racing it trips an assert
+class ChildrenChangeGuard {
+public:
+    ChildrenChangeGuard(std::atomic<bool>& isChanging) : _isChanging(isChanging) {
+        bool wasChanging = _isChanging.exchange(true);
+        assert(!wasChanging); // two threads are changing the children, the tree's write lock isn't held
+        Q_UNUSED(wasChanging);
+    }
+    ~ChildrenChangeGuard() { _isChanging = false; }
+
+private:
+    std::atomic<bool>& _isChanging;
+};
+#endif
+
 OctreeElementPointer OctreeElement::getChildAtIndex(int childIndex) const {
+#ifndef NDEBUG
+    assert(!_isChangingChildren); // a change is under way on another thread, the tree's lock isn't held
+#endif
+
+#ifdef COMPACT_CHILD_ARRAY
+    if (!oneAtBit(_childBitmask, childIndex)) {
+        return OctreeElementPointer();
+    }
+    return _compactChildren[compactChildSlot(_childBitmask, childIndex)];
+#endif // COMPACT_CHILD_ARRAY
+
 #ifdef SIMPLE_CHILD_ARRAY
     return _simpleChildArray[childIndex];
 #endif // SIMPLE_CHILD_ARRAY
@@ -287,15 +325,71 @@ void OctreeElement::deleteAllChildren() {
         }
     }
 
+#ifdef SIMPLE_EXTERNAL_CHILDREN
     if (_childrenExternal) {
         // if the children_t union represents _children.external we need to delete it here
         for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
             _externalChildren[i].reset();
         }
     }
+#endif
+
+#ifdef COMPACT_CHILD_ARRAY
+    if (_compactChildren) {
+        _externalChildrenMemoryUsage -= getChildCount() * sizeof(OctreeElementPointer);
+        delete[] _compactChildren;
+        _compactChildren = nullptr;
+    }
+    _childBitmask = 0;
+#endif
 }
 
 void OctreeElement::setChildAtIndex(int childIndex, OctreeElementPointer child) {
+#ifndef NDEBUG
+    ChildrenChangeGuard guard(_isChangingChildren);
+#endif
+
+#ifdef COMPACT_CHILD_ARRAY
+    bool hadChild = oneAtBit(_childBitmask, childIndex);
+    int slot = compactChildSlot(_childBitmask, childIndex);
+    if (hadChild && child) {
+        _compactChildren[slot] = child;
+        return;
+    } else if (!hadChild && !child) {
+        return;
+    }
+
+    // the array is resized on every add and remove, which are rare next to the lookups
+    int previousChildCount = getChildCount();
+    int newChildCount = child ? previousChildCount + 1 : previousChildCount - 1;
+    OctreeElementPointer* children = (newChildCount > 0) ? new OctreeElementPointer[newChildCount] : nullptr;
+    int previousSlot = 0;
+    for (int i = 0; i < newChildCount; i++) {
+        if (child && i == slot) {
+            children[i] = child;
+        } else {
+            if (!child && previousSlot == slot) {
+                previousSlot++; // skip the child being removed
+            }
+            children[i] = std::move(_compactChildren[previousSlot++]);
+        }
+    }
+    delete[] _compactChildren;
+    _compactChildren = children;
+
+    if (child) {
+        setAtBit(_childBitmask, childIndex);
+        _externalChildrenMemoryUsage += sizeof(OctreeElementPointer);
+    } else {
+        clearAtBit(_childBitmask, childIndex);
+        _externalChildrenMemoryUsage -= sizeof(OctreeElementPointer);
+    }
+
+    // track our population data
+    _childrenCount[previousChildCount]--;
+    _childrenCount[newChildCount]++;
+#endif // COMPACT_CHILD_ARRAY
+
 #ifdef SIMPLE_CHILD_ARRAY
     int previousChildCount = getChildCount();
     if (child) {
@@ -13,7 +13,8 @@
 #define hifi_OctreeElement_h
 
 //#define SIMPLE_CHILD_ARRAY
-#define SIMPLE_EXTERNAL_CHILDREN
+//#define SIMPLE_EXTERNAL_CHILDREN
+#define COMPACT_CHILD_ARRAY
 
 #include <atomic>
 
@@ -119,6 +120,9 @@ public:
 
     // Base class methods you don't need to implement
     const unsigned char* getOctalCode() const { return (_octcodePointer) ? _octalCode.pointer : &_octalCode.buffer[0]; }
+
+    /// Callers must hold the tree's lock, for read at least. Adding or removing a child reallocates the child array,
+    /// so a lookup racing a change could read freed memory. Debug builds assert when one overlaps a change.
     OctreeElementPointer getChildAtIndex(int childIndex) const;
     void deleteChildAtIndex(int childIndex);
     OctreeElementPointer removeChildAtIndex(int childIndex);
@@ -222,6 +226,8 @@ public:
 protected:
 
     void deleteAllChildren();
+
+    /// Callers must hold the tree's write lock, see getChildAtIndex()
     void setChildAtIndex(int childIndex, OctreeElementPointer child);
 
     void calculateAACube();
@@ -248,6 +254,11 @@ protected:
     // } _children;
 #endif
 
+#ifdef COMPACT_CHILD_ARRAY
+    /// Only the children that exist, in child index order, 8 bytes plus 16 bytes per child when enabled
+    OctreeElementPointer* _compactChildren;
+#endif
+
     uint16_t _sourceUUIDKey; /// Client only, stores node id of voxel server that sent his voxel, 2 bytes
 
     // Support for _sourceUUID, we use these static member variables to track the UUIDs that are
@@ -266,6 +277,10 @@ protected:
          _unknownBufferIndex : 1,
          _childrenExternal : 1; /// Client only, is this voxel's VBO buffer the unknown buffer index, 1 bit
 
+#ifndef NDEBUG
+    std::atomic<bool> _isChangingChildren { false }; /// Debug only, set while setChildAtIndex() runs
+#endif
+
     static AtomicUIntStat _voxelNodeCount;
     static AtomicUIntStat _voxelNodeLeafCount;
 
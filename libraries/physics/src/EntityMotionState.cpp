@@ -29,6 +29,11 @@
 const uint8_t LOOPS_FOR_SIMULATION_ORPHAN = 50;
 const quint64 USECS_BETWEEN_OWNERSHIP_BIDS = USECS_PER_SECOND / 5;
 
+// we resend the inactive update every INACTIVE_UPDATE_PERIOD * _numInactiveUpdates
+// until we've sent MAX_NUM_INACTIVE_UPDATES of them, then we let go of the simulation
+const uint8_t MAX_NUM_INACTIVE_UPDATES = 20;
+const float INACTIVE_UPDATE_PERIOD = 0.5f;
+
 #ifdef WANT_DEBUG_ENTITY_TREE_LOCKS
 bool EntityMotionState::entityTreeIsLocked() const {
     EntityTreeElementPointer element = _entity->getElement();
@@ -275,7 +280,6 @@ bool EntityMotionState::remoteSimulationOutOfSync(uint32_t simulationStep) {
     float dt = (float)(numSteps) * PHYSICS_ENGINE_FIXED_SUBSTEP;
 
     if (_numInactiveUpdates > 0) {
-        const uint8_t MAX_NUM_INACTIVE_UPDATES = 20;
         if (_numInactiveUpdates > MAX_NUM_INACTIVE_UPDATES) {
             // clear local ownership (stop sending updates) and let the server clear itself
             _entity->clearSimulationOwnership();
@@ -284,7 +288,6 @@ bool EntityMotionState::remoteSimulationOutOfSync(uint32_t simulationStep) {
         // we resend the inactive update every INACTIVE_UPDATE_PERIOD
         // until it is removed from the outgoing updates
         // (which happens when we don't own the simulation and it isn't touching our simulation)
-        const float INACTIVE_UPDATE_PERIOD = 0.5f;
         return (dt > INACTIVE_UPDATE_PERIOD * (float)_numInactiveUpdates);
     }
 
@@ -402,7 +405,25 @@ bool EntityMotionState::shouldSendUpdate(uint32_t simulationStep, const QUuid& s
     return remoteSimulationOutOfSync(simulationStep);
 }
 
-void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, const QUuid& sessionID, uint32_t step) {
+bool EntityMotionState::isAtRest(const QUuid& sessionID) const {
+    assert(_body);
+    assert(_entity);
+    return _lastStep > 0 && _numInactiveUpdates > 0 && !_body->isActive() &&
+        _entity->getSimulatorID() == sessionID &&
+        !_entity->actionDataNeedsTransmit() && !_entity->queryAABoxNeedsUpdate();
+}
+
+uint32_t EntityMotionState::getNextInactiveUpdateStep() const {
+    if (_numInactiveUpdates > MAX_NUM_INACTIVE_UPDATES) {
+        // due now: the next look will let go of the simulation
+        return _lastStep;
+    }
+    // the first step at which remoteSimulationOutOfSync() will want to resend the inactive update
+    float period = INACTIVE_UPDATE_PERIOD * (float)_numInactiveUpdates;
+    return _lastStep + (uint32_t)(period / PHYSICS_ENGINE_FIXED_SUBSTEP) + 1;
+}
+
+void EntityMotionState::sendUpdate(EntityEditPacketSender::EntityEdits& edits, const QUuid& sessionID, uint32_t step) {
     assert(_entity);
     assert(entityTreeIsLocked());
 
@@ -518,12 +539,12 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, const Q
     }
 
     EntityItemID id(_entity->getID());
-    EntityEditPacketSender* entityPacketSender = static_cast<EntityEditPacketSender*>(packetSender);
     #ifdef WANT_DEBUG
-        qCDebug(physics) << "EntityMotionState::sendUpdate()... calling queueEditEntityMessage()...";
+        qCDebug(physics) << "EntityMotionState::sendUpdate()... adding edit to the outgoing batch...";
     #endif
 
-    entityPacketSender->queueEditEntityMessage(PacketType::EntityEdit, id, properties);
+    // the edits of one step are packed together by PhysicalEntitySimulation
+    edits.push_back({ id, properties });
     _entity->setLastBroadcast(usecTimestampNow());
 
     // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
@@ -535,7 +556,7 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, const Q
                 EntityItemProperties newQueryCubeProperties;
                 newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
                 newQueryCubeProperties.setLastEdited(properties.getLastEdited());
-                entityPacketSender->queueEditEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
+                edits.push_back({ descendant->getID(), newQueryCubeProperties });
                 entityDescendant->setLastBroadcast(usecTimestampNow());
             }
         }
@@ -13,6 +13,7 @@
 #define hifi_EntityMotionState_h
 
 #include <EntityTypes.h>
+#include <EntityEditPacketSender.h>
 #include <AACube.h>
 
 #include "ObjectMotionState.h"
@@ -46,7 +47,12 @@ public:
     bool isCandidateForOwnership(const QUuid& sessionID) const;
     bool remoteSimulationOutOfSync(uint32_t simulationStep);
     bool shouldSendUpdate(uint32_t simulationStep, const QUuid& sessionID);
-    void sendUpdate(OctreeEditPacketSender* packetSender, const QUuid& sessionID, uint32_t step);
+    void sendUpdate(EntityEditPacketSender::EntityEdits& edits, const QUuid& sessionID, uint32_t step);
+
+    // true when we own a sleeping object whose stopped state has been sent: it has nothing to send until
+    // getNextInactiveUpdateStep() unless something wakes it or changes it
+    bool isAtRest(const QUuid& sessionID) const;
+    uint32_t getNextInactiveUpdateStep() const;
 
     virtual uint32_t getIncomingDirtyFlags() override;
     virtual void clearIncomingDirtyFlags() override;
@@ -126,6 +132,11 @@ protected:
     uint8_t _accelerationNearlyGravityCount;
     uint8_t _numInactiveUpdates { 1 };
     uint8_t _outgoingPriority { 0 };
+
+    // where PhysicalEntitySimulation is tracking this object for outgoing updates
+    enum OutgoingTracking : uint8_t { NOT_TRACKED, TRACKED_AWAKE, TRACKED_AT_REST };
+    uint8_t _outgoingTracking { NOT_TRACKED };
+    uint32_t _outgoingRestStep { 0 }; // when tracked at rest: the step it is due to be looked at again
 };
 
 #endif // hifi_EntityMotionState_h
@@ -0,0 +1,212 @@
+//
+//  ParallelCollisionDispatcher.cpp
+//  libraries/physics/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParallelCollisionDispatcher.h"
+
+#include <algorithm>
+
+#include <QMutexLocker>
+#include <BulletCollision/CollisionDispatch/btCollisionObjectWrapper.h>
+#include <BulletCollision/CollisionDispatch/btConvexConvexAlgorithm.h>
+#include <BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h>
+
+#include "PhysicsWorkerPool.h"
+
+// pairs are handed to the workers this many at a time
+static const int PAIRS_PER_JOB = 16;
+
+class ConvexConvexAlgorithm : public btConvexConvexAlgorithm {
+public:
+    // the base class only stores the address of _simplexSolver, so it can be handed over before it is constructed
+    ConvexConvexAlgorithm(const btCollisionAlgorithmConstructionInfo& ci, const btCollisionObjectWrapper* body0Wrap,
+                          const btCollisionObjectWrapper* body1Wrap, const btConvexConvexAlgorithm::CreateFunc& defaults) :
+        btConvexConvexAlgorithm(ci.m_manifold, ci, body0Wrap, body1Wrap, &_simplexSolver, defaults.m_pdSolver,
+                                defaults.m_numPerturbationIterations, defaults.m_minimumPointsPerturbationThreshold) {
+    }
+
+private:
+    btVoronoiSimplexSolver _simplexSolver;
+};
+
+class ConvexConvexCreateFunc : public btCollisionAlgorithmCreateFunc {
+public:
+    ConvexConvexCreateFunc(const btConvexConvexAlgorithm::CreateFunc* defaults) : _defaults(defaults) {}
+
+    virtual btCollisionAlgorithm* CreateCollisionAlgorithm(btCollisionAlgorithmConstructionInfo& ci,
+                                                           const btCollisionObjectWrapper* body0Wrap,
+                                                           const btCollisionObjectWrapper* body1Wrap) override {
+        void* memory = ci.m_dispatcher1->allocateCollisionAlgorithm(sizeof(ConvexConvexAlgorithm));
+        return new (memory) ConvexConvexAlgorithm(ci, body0Wrap, body1Wrap, *_defaults);
+    }
+
+private:
+    // read at creation, so changes to the default multipoint iterations still apply
+    const btConvexConvexAlgorithm::CreateFunc* _defaults;
+};
+
+static btDefaultCollisionConstructionInfo parallelConstructionInfo() {
+    btDefaultCollisionConstructionInfo constructionInfo;
+    // the pooled algorithms must have room for a simplex solver each
+    constructionInfo.m_customCollisionAlgorithmMaxElementSize = sizeof(ConvexConvexAlgorithm);
+    return constructionInfo;
+}
+
+ParallelCollisionConfiguration::ParallelCollisionConfiguration() :
+    btDefaultCollisionConfiguration(parallelConstructionInfo()),
+    _convexConvexCreateFunc(new ConvexConvexCreateFunc(
+        static_cast<btConvexConvexAlgorithm::CreateFunc*>(m_convexConvexCreateFunc)))
+{
+}
+
+ParallelCollisionConfiguration::~ParallelCollisionConfiguration() {
+    delete _convexConvexCreateFunc;
+}
+
+btCollisionAlgorithmCreateFunc* ParallelCollisionConfiguration::getCollisionAlgorithmCreateFunc(int proxyType0,
+                                                                                               int proxyType1) {
+    btCollisionAlgorithmCreateFunc* createFunc =
+        btDefaultCollisionConfiguration::getCollisionAlgorithmCreateFunc(proxyType0, proxyType1);
+    return (createFunc == m_convexConvexCreateFunc) ? _convexConvexCreateFunc : createFunc;
+}
+
+// collects the pairs that need their narrowphase run, finding algorithms for new ones on the way
+class PairCollector : public btOverlapCallback {
+public:
+    PairCollector(btCollisionDispatcher& dispatcher, std::vector<btBroadphasePair*>& pairs) :
+        _dispatcher(dispatcher), _pairs(pairs) {}
+
+    virtual bool processOverlap(btBroadphasePair& pair) override {
+        btCollisionObject* object0 = static_cast<btCollisionObject*>(pair.m_pProxy0->m_clientObject);
+        btCollisionObject* object1 = static_cast<btCollisionObject*>(pair.m_pProxy1->m_clientObject);
+        if (_dispatcher.needsCollision(object0, object1)) {
+            if (!pair.m_algorithm) {
+                btCollisionObjectWrapper wrapper0(0, object0->getCollisionShape(), object0,
+                                                  object0->getWorldTransform(), -1, -1);
+                btCollisionObjectWrapper wrapper1(0, object1->getCollisionShape(), object1,
+                                                  object1->getWorldTransform(), -1, -1);
+                pair.m_algorithm = _dispatcher.findAlgorithm(&wrapper0, &wrapper1);
+            }
+            if (pair.m_algorithm) {
+                _pairs.push_back(&pair);
+            }
+        }
+        // keep the pair
+        return false;
+    }
+
+private:
+    btCollisionDispatcher& _dispatcher;
+    std::vector<btBroadphasePair*>& _pairs;
+};
+
+ParallelCollisionDispatcher::ParallelCollisionDispatcher(ParallelCollisionConfiguration* collisionConfiguration) :
+    btCollisionDispatcher(collisionConfiguration)
+{
+}
+
+void ParallelCollisionDispatcher::dispatchAllCollisionPairs(btOverlappingPairCache* pairCache,
+                                                            const btDispatcherInfo& dispatchInfo,
+                                                            btDispatcher* dispatcher) {
+    // continuous dispatch accumulates the time of impact of every pair in dispatchInfo, so it stays serial
+    if (!_workerPool || dispatchInfo.m_dispatchFunc != btDispatcherInfo::DISPATCH_DISCRETE) {
+        btCollisionDispatcher::dispatchAllCollisionPairs(pairCache, dispatchInfo, dispatcher);
+        return;
+    }
+
+    _pairs.clear();
+    PairCollector collector(*this, _pairs);
+    pairCache->processAllOverlappingPairs(&collector, dispatcher);
+
+    // every pair has an algorithm and manifold of its own, so their narrowphases don't touch each other
+    int firstNewManifold = getNumManifolds();
+    btNearCallback nearCallback = getNearCallback();
+    int numPairs = (int)_pairs.size();
+    int numJobs = (numPairs + PAIRS_PER_JOB - 1) / PAIRS_PER_JOB;
+    _isDispatching = true;
+    _workerPool->forEach(numJobs, [&](int job, int) {
+        int end = std::min(numPairs, (job + 1) * PAIRS_PER_JOB);
+        for (int i = job * PAIRS_PER_JOB; i < end; i++) {
+            nearCallback(*_pairs[i], *this, dispatchInfo);
+        }
+    });
+    _isDispatching = false;
+
+    sortNewManifolds(firstNewManifold);
+
+    // released from the back so that releasing one never moves another that is still to be released
+    std::sort(_releasedManifolds.begin(), _releasedManifolds.end(),
+              [](const btPersistentManifold* a, const btPersistentManifold* b) {
+        return a->m_index1a > b->m_index1a;
+    });
+    for (auto manifold : _releasedManifolds) {
+        btCollisionDispatcher::releaseManifold(manifold);
+    }
+    _releasedManifolds.clear();
+}
+
+void ParallelCollisionDispatcher::sortNewManifolds(int firstNewManifold) {
+    // manifolds made by the workers were appended in whatever order the workers got to them, move them to the
+    // order of the pairs that own them, which is where btCollisionDispatcher would have appended them
+    int numManifolds = m_manifoldsPtr.size();
+    int next = firstNewManifold;
+    btManifoldArray pairManifolds;
+    for (size_t i = 0; i < _pairs.size() && next < numManifolds - 1; i++) {
+        pairManifolds.resize(0);
+        _pairs[i]->m_algorithm->getAllContactManifolds(pairManifolds);
+        for (int j = 0; j < pairManifolds.size(); j++) {
+            btPersistentManifold* manifold = pairManifolds[j];
+            int index = manifold->m_index1a;
+            if (index >= next && index < numManifolds && m_manifoldsPtr[index] == manifold) {
+                btPersistentManifold* other = m_manifoldsPtr[next];
+                m_manifoldsPtr[index] = other;
+                other->m_index1a = index;
+                m_manifoldsPtr[next] = manifold;
+                manifold->m_index1a = next;
+                next++;
+            }
+        }
+    }
+}
+
+btPersistentManifold* ParallelCollisionDispatcher::getNewManifold(const btCollisionObject* body0,
+                                                                  const btCollisionObject* body1) {
+    if (_isDispatching) {
+        QMutexLocker locker(&_mutex);
+        return btCollisionDispatcher::getNewManifold(body0, body1);
+    }
+    return btCollisionDispatcher::getNewManifold(body0, body1);
+}
+
+void ParallelCollisionDispatcher::releaseManifold(btPersistentManifold* manifold) {
+    if (_isDispatching) {
+        // removing it now would reorder the manifolds under the other workers, it goes once they are done
+        QMutexLocker locker(&_mutex);
+        _releasedManifolds.push_back(manifold);
+        return;
+    }
+    btCollisionDispatcher::releaseManifold(manifold);
+}
+
+void* ParallelCollisionDispatcher::allocateCollisionAlgorithm(int size) {
+    if (_isDispatching) {
+        QMutexLocker locker(&_mutex);
+        return btCollisionDispatcher::allocateCollisionAlgorithm(size);
+    }
+    return btCollisionDispatcher::allocateCollisionAlgorithm(size);
+}
+
+void ParallelCollisionDispatcher::freeCollisionAlgorithm(void* ptr) {
+    if (_isDispatching) {
+        QMutexLocker locker(&_mutex);
+        btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+        return;
+    }
+    btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+}
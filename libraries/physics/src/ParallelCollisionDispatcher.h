@@ -0,0 +1,66 @@
+//
+//  ParallelCollisionDispatcher.h
+//  libraries/physics/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParallelCollisionDispatcher_h
+#define hifi_ParallelCollisionDispatcher_h
+
+#include <vector>
+
+#include <QMutex>
+#include <btBulletDynamicsCommon.h>
+
+class PhysicsWorkerPool;
+
+// The default convex-convex algorithms all share the configuration's simplex solver, which can't be used by two
+// threads at once.  This configuration gives each of those algorithms a simplex solver of its own instead.
+class ParallelCollisionConfiguration : public btDefaultCollisionConfiguration {
+public:
+    ParallelCollisionConfiguration();
+    virtual ~ParallelCollisionConfiguration();
+
+    virtual btCollisionAlgorithmCreateFunc* getCollisionAlgorithmCreateFunc(int proxyType0, int proxyType1) override;
+
+private:
+    btCollisionAlgorithmCreateFunc* _convexConvexCreateFunc;
+};
+
+// Runs the narrowphase of every overlapping pair on a PhysicsWorkerPool.
+//
+// Algorithms are found for new pairs on the calling thread, then the pairs are processed in parallel.  Manifolds
+// made or released by the workers are put in pair order afterwards, so the solver sees them in the same order
+// however the pairs were spread over the threads, and the simulation stays deterministic.  Without a pool, or for
+// continuous dispatch, this behaves exactly like btCollisionDispatcher.
+class ParallelCollisionDispatcher : public btCollisionDispatcher {
+public:
+    ParallelCollisionDispatcher(ParallelCollisionConfiguration* collisionConfiguration);
+
+    void setWorkerPool(PhysicsWorkerPool* workerPool) { _workerPool = workerPool; }
+
+    virtual void dispatchAllCollisionPairs(btOverlappingPairCache* pairCache, const btDispatcherInfo& dispatchInfo,
+                                           btDispatcher* dispatcher) override;
+
+    virtual btPersistentManifold* getNewManifold(const btCollisionObject* body0, const btCollisionObject* body1) override;
+    virtual void releaseManifold(btPersistentManifold* manifold) override;
+    virtual void* allocateCollisionAlgorithm(int size) override;
+    virtual void freeCollisionAlgorithm(void* ptr) override;
+
+private:
+    void sortNewManifolds(int firstNewManifold);
+
+    PhysicsWorkerPool* _workerPool { nullptr };
+    std::vector<btBroadphasePair*> _pairs;
+
+    // only used while the workers are processing pairs
+    bool _isDispatching { false };
+    QMutex _mutex;
+    std::vector<btPersistentManifold*> _releasedManifolds;
+};
+
+#endif // hifi_ParallelCollisionDispatcher_h
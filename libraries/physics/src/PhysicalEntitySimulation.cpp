@@ -9,7 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
-
+#include <algorithm>
 
 #include "PhysicsHelpers.h"
 #include "PhysicsLogging.h"
@@ -33,7 +33,7 @@ void PhysicalEntitySimulation::init(
     assert(physicsEngine);
     _physicsEngine = physicsEngine;
 
-    assert(packetSender);
+    // may be null when a subclass overrides queueOutgoingEdits()
     _entityPacketSender = packetSender;
 }
 
@@ -64,7 +64,7 @@ void PhysicalEntitySimulation::removeEntityInternal(EntityItemPointer entity) {
 
         EntityMotionState* motionState = static_cast<EntityMotionState*>(entity->getPhysicsInfo());
         if (motionState) {
-            _outgoingChanges.remove(motionState);
+            removeOutgoingChange(motionState);
             _entitiesToRemoveFromPhysics.insert(entity);
         } else {
             _entitiesToDelete.insert(entity);
@@ -98,13 +98,17 @@ void PhysicalEntitySimulation::changeEntityInternal(EntityItemPointer entity) {
             // the entity should be removed from the physical simulation
             _pendingChanges.remove(motionState);
             _physicalObjects.remove(motionState);
-            _outgoingChanges.remove(motionState);
+            removeOutgoingChange(motionState);
             _entitiesToRemoveFromPhysics.insert(entity);
             if (entity->isMovingRelativeToParent()) {
                 _simpleKinematicEntities.insert(entity);
             }
         } else {
             _pendingChanges.insert(motionState);
+            if (motionState->_outgoingTracking == EntityMotionState::TRACKED_AT_REST) {
+                // the change may be something to tell the server about (e.g. new owner or action data)
+                addOutgoingChange(motionState);
+            }
         }
     } else if (entity->shouldBePhysical()) {
         // The intent is for this object to be in the PhysicsEngine, but it has no MotionState yet.
@@ -150,6 +154,7 @@ void PhysicalEntitySimulation::clearEntitiesInternal() {
     _entitiesToAddToPhysics.clear();
     _pendingChanges.clear();
     _outgoingChanges.clear();
+    _restingOutgoingChanges.clear();
 }
 
 // virtual
@@ -171,7 +176,7 @@ void PhysicalEntitySimulation::getObjectsToRemoveFromPhysics(VectorOfMotionState
         EntityMotionState* motionState = static_cast<EntityMotionState*>(entity->getPhysicsInfo());
         if (motionState) {
             _pendingChanges.remove(motionState);
-            _outgoingChanges.remove(motionState);
+            removeOutgoingChange(motionState);
             _physicalObjects.remove(motionState);
             result.push_back(motionState);
             _entitiesToRelease.insert(entity);
@@ -251,18 +256,45 @@ void PhysicalEntitySimulation::getObjectsToChange(VectorOfMotionStates& result)
     _pendingChanges.clear();
 }
 
+void PhysicalEntitySimulation::addOutgoingChange(EntityMotionState* motionState) {
+    if (motionState->_outgoingTracking == EntityMotionState::TRACKED_AT_REST) {
+        removeOutgoingChange(motionState);
+    }
+    if (motionState->_outgoingTracking == EntityMotionState::NOT_TRACKED) {
+        _outgoingChanges.insert(motionState);
+        motionState->_outgoingTracking = EntityMotionState::TRACKED_AWAKE;
+    }
+}
+
+void PhysicalEntitySimulation::removeOutgoingChange(EntityMotionState* motionState) {
+    if (motionState->_outgoingTracking == EntityMotionState::TRACKED_AWAKE) {
+        _outgoingChanges.remove(motionState);
+    } else if (motionState->_outgoingTracking == EntityMotionState::TRACKED_AT_REST) {
+        auto range = _restingOutgoingChanges.equal_range(motionState->_outgoingRestStep);
+        for (auto itr = range.first; itr != range.second; ++itr) {
+            if (itr->second == motionState) {
+                _restingOutgoingChanges.erase(itr);
+                break;
+            }
+        }
+    }
+    motionState->_outgoingTracking = EntityMotionState::NOT_TRACKED;
+}
+
 void PhysicalEntitySimulation::handleOutgoingChanges(const VectorOfMotionStates& motionStates, const QUuid& sessionID) {
     QMutexLocker lock(&_mutex);
 
     // walk the motionStates looking for those that correspond to entities
+    // (these are the objects Bullet moved this frame, so anything here that was resting has woken up)
     for (auto stateItr : motionStates) {
         ObjectMotionState* state = &(*stateItr);
         if (state && state->getType() == MOTIONSTATE_TYPE_ENTITY) {
             EntityMotionState* entityState = static_cast<EntityMotionState*>(state);
             EntityItemPointer entity = entityState->getEntity();
             assert(entity.get());
-            if (entityState->isCandidateForOwnership(sessionID)) {
-                _outgoingChanges.insert(entityState);
+            if (entityState->_outgoingTracking != EntityMotionState::TRACKED_AWAKE &&
+                    entityState->isCandidateForOwnership(sessionID)) {
+                addOutgoingChange(entityState);
             }
             _entitiesToSort.insert(entity);
         }
@@ -274,28 +306,60 @@ void PhysicalEntitySimulation::handleOutgoingChanges(const VectorOfMotionStates&
 
         if (sessionID.isNull()) {
             // usually don't get here, but if so --> nothing to do
+            for (auto state : _outgoingChanges) {
+                state->_outgoingTracking = EntityMotionState::NOT_TRACKED;
+            }
+            for (auto& restingState : _restingOutgoingChanges) {
+                restingState.second->_outgoingTracking = EntityMotionState::NOT_TRACKED;
+            }
             _outgoingChanges.clear();
+            _restingOutgoingChanges.clear();
             return;
         }
 
-        // look for entities to prune or update
+        // resting objects whose next inactive update is due are looked at with the awake ones
+        auto restingEnd = _restingOutgoingChanges.upper_bound(numSubsteps);
+        for (auto itr = _restingOutgoingChanges.begin(); itr != restingEnd; ++itr) {
+            _outgoingChanges.insert(itr->second);
+            itr->second->_outgoingTracking = EntityMotionState::TRACKED_AWAKE;
+        }
+        _restingOutgoingChanges.erase(_restingOutgoingChanges.begin(), restingEnd);
+
+        // look for entities to prune, update or put to rest
+        EntityEditPacketSender::EntityEdits edits;
         QSet<EntityMotionState*>::iterator stateItr = _outgoingChanges.begin();
         while (stateItr != _outgoingChanges.end()) {
             EntityMotionState* state = *stateItr;
             if (!state->isCandidateForOwnership(sessionID)) {
                 // prune
+                state->_outgoingTracking = EntityMotionState::NOT_TRACKED;
                 stateItr = _outgoingChanges.erase(stateItr);
-            } else if (state->shouldSendUpdate(numSubsteps, sessionID)) {
+                continue;
+            }
+            if (state->shouldSendUpdate(numSubsteps, sessionID)) {
                 // update
-                state->sendUpdate(_entityPacketSender, sessionID, numSubsteps);
-                ++stateItr;
+                state->sendUpdate(edits, sessionID, numSubsteps);
+            }
+            if (state->isAtRest(sessionID)) {
+                // nothing more to check until its next inactive update is due
+                uint32_t restStep = std::max(state->getNextInactiveUpdateStep(), numSubsteps + 1);
+                state->_outgoingTracking = EntityMotionState::TRACKED_AT_REST;
+                state->_outgoingRestStep = restStep;
+                _restingOutgoingChanges.insert({ restStep, state });
+                stateItr = _outgoingChanges.erase(stateItr);
             } else {
                 ++stateItr;
             }
         }
+        queueOutgoingEdits(edits);
     }
 }
 
+void PhysicalEntitySimulation::queueOutgoingEdits(const EntityEditPacketSender::EntityEdits& edits) {
+    assert(_entityPacketSender);
+    _entityPacketSender->queueEditEntityMessages(PacketType::EntityEdit, edits);
+}
+
 void PhysicalEntitySimulation::handleCollisionEvents(const CollisionEvents& collisionEvents) {
     for (auto collision : collisionEvents) {
         // NOTE: The collision event is always aligned such that idA is never NULL.
@@ -13,6 +13,7 @@
 #define hifi_PhysicalEntitySimulation_h
 
 #include <stdint.h>
+#include <map>
 
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
@@ -59,17 +60,27 @@ public:
 
     EntityEditPacketSender* getPacketSender() { return _entityPacketSender; }
 
+protected:
+    // where the edits for the updates decided on by handleOutgoingChanges() go, by default to the entity-server
+    virtual void queueOutgoingEdits(const EntityEditPacketSender::EntityEdits& edits);
+
+    SetOfMotionStates _physicalObjects; // MotionStates of entities in PhysicsEngine
+
+    PhysicsEnginePointer _physicsEngine = nullptr;
+
 private:
+    void addOutgoingChange(EntityMotionState* motionState);
+    void removeOutgoingChange(EntityMotionState* motionState);
+
     SetOfEntities _entitiesToRemoveFromPhysics;
     SetOfEntities _entitiesToRelease;
     SetOfEntities _entitiesToAddToPhysics;
 
     SetOfEntityMotionStates _pendingChanges; // EntityMotionStates already in PhysicsEngine that need their physics changed
-    SetOfEntityMotionStates _outgoingChanges; // EntityMotionStates for which we need to send updates to entity-server
-
-    SetOfMotionStates _physicalObjects; // MotionStates of entities in PhysicsEngine
+    SetOfEntityMotionStates _outgoingChanges; // awake EntityMotionStates for which we may need to send updates to entity-server
+    // EntityMotionStates we own which have gone to sleep, by the step their next inactive update is due
+    std::multimap<uint32_t, EntityMotionState*> _restingOutgoingChanges;
 
-    PhysicsEnginePointer _physicsEngine = nullptr;
     EntityEditPacketSender* _entityPacketSender = nullptr;
 
     uint32_t _lastStepSendPackets { 0 };
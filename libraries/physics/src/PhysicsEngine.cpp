@@ -38,8 +38,8 @@ PhysicsEngine::~PhysicsEngine() {
 
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
-        _collisionConfig = new btDefaultCollisionConfiguration();
-        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
+        _collisionConfig = new ParallelCollisionConfiguration();
+        _collisionDispatcher = new ParallelCollisionDispatcher(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
         _constraintSolver = new btSequentialImpulseConstraintSolver;
         _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
@@ -50,6 +50,21 @@ void PhysicsEngine::init() {
         // default gravity of the world is zero, so each object must specify its own gravity
         // TODO: set up gravity zones
         _dynamicsWorld->setGravity(btVector3(0.0f, 0.0f, 0.0f));
+
+        _collisionDispatcher->setWorkerPool(_workerPool.get());
+        _dynamicsWorld->setWorkerPool(_workerPool.get());
+    }
+}
+
+void PhysicsEngine::setNumWorkerThreads(int numThreads) {
+    if (numThreads == getNumWorkerThreads()) {
+        return;
+    }
+    // must not be called while stepping
+    _workerPool.reset(numThreads > 0 ? new PhysicsWorkerPool(numThreads) : nullptr);
+    if (_dynamicsWorld) {
+        _collisionDispatcher->setWorkerPool(_workerPool.get());
+        _dynamicsWorld->setWorkerPool(_workerPool.get());
     }
 }
 
@@ -226,7 +241,9 @@ void PhysicsEngine::removeContacts(ObjectMotionState* motionState) {
 }
 
 void PhysicsEngine::stepSimulation() {
+#ifndef BT_NO_PROFILE
     CProfileManager::Reset();
+#endif
     BT_PROFILE("stepSimulation");
     // NOTE: the grand order of operations is:
     // (1) pull incoming changes
@@ -396,7 +413,9 @@ const VectorOfMotionStates& PhysicsEngine::getOutgoingChanges() {
 void PhysicsEngine::dumpStatsIfNecessary() {
     if (_dumpNextStats) {
         _dumpNextStats = false;
+#ifndef BT_NO_PROFILE
         CProfileManager::dumpAll();
+#endif
     }
 }
 
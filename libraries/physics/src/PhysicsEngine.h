@@ -12,6 +12,7 @@
 #ifndef hifi_PhysicsEngine_h
 #define hifi_PhysicsEngine_h
 
+#include <memory>
 #include <stdint.h>
 
 #include <QUuid>
@@ -22,6 +23,8 @@
 #include "BulletUtil.h"
 #include "ContactInfo.h"
 #include "ObjectMotionState.h"
+#include "ParallelCollisionDispatcher.h"
+#include "PhysicsWorkerPool.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "ObjectAction.h"
 
@@ -49,6 +52,10 @@ public:
     ~PhysicsEngine();
     void init();
 
+    /// \brief steps the narrowphase and the islands on this many worker threads, 0 steps on the calling thread only
+    void setNumWorkerThreads(int numThreads);
+    int getNumWorkerThreads() const { return _workerPool ? _workerPool->getNumThreads() : 0; }
+
     uint32_t getNumSubsteps();
 
     void removeObjects(const VectorOfMotionStates& objects);
@@ -100,12 +107,13 @@ private:
     void doOwnershipInfection(const btCollisionObject* objectA, const btCollisionObject* objectB);
 
     btClock _clock;
-    btDefaultCollisionConfiguration* _collisionConfig = NULL;
-    btCollisionDispatcher* _collisionDispatcher = NULL;
+    ParallelCollisionConfiguration* _collisionConfig = NULL;
+    ParallelCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
     btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
+    std::unique_ptr<PhysicsWorkerPool> _workerPool;
 
     ContactMap _contactMap;
     CollisionEvents _collisionEvents;
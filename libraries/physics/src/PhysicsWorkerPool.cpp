@@ -0,0 +1,92 @@
+//
+//  PhysicsWorkerPool.cpp
+//  libraries/physics/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsWorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QWaitCondition>
+
+// shared between the pool and its workers, so that a worker which starts late never touches a finished batch.
+struct PhysicsWorkerPool::Batch {
+    Batch(int count, const Job& job) : count(count), job(job), remainingJobs(count) {}
+
+    const int count;
+    const Job& job;
+    std::atomic<int> nextJob { 0 };
+    std::atomic<int> nextWorker { 0 };
+    std::atomic<int> remainingJobs;
+    QMutex mutex;
+    QWaitCondition finished;
+
+    // run jobs until there are none left to claim.
+    void run() {
+        int index = nextJob++;
+        if (index >= count) {
+            return;
+        }
+        int workerIndex = nextWorker++;
+        while (index < count) {
+            job(index, workerIndex);
+            if (--remainingJobs == 0) {
+                QMutexLocker locker(&mutex);
+                finished.wakeAll();
+            }
+            index = nextJob++;
+        }
+    }
+};
+
+class PhysicsWorker : public QRunnable {
+public:
+    PhysicsWorker(std::shared_ptr<PhysicsWorkerPool::Batch> batch) : _batch(batch) {}
+    virtual void run() override { _batch->run(); }
+private:
+    std::shared_ptr<PhysicsWorkerPool::Batch> _batch;
+};
+
+PhysicsWorkerPool::PhysicsWorkerPool(int numThreads) {
+    _threadPool.setMaxThreadCount(std::max(1, numThreads));
+    // workers are woken every substep, don't let them expire between steps
+    _threadPool.setExpiryTimeout(-1);
+}
+
+PhysicsWorkerPool::~PhysicsWorkerPool() {
+    _threadPool.waitForDone();
+}
+
+void PhysicsWorkerPool::forEach(int count, const Job& job) {
+    if (count <= 0) {
+        return;
+    }
+    if (count == 1) {
+        job(0, 0);
+        return;
+    }
+
+    // the job is only referenced while this call waits, workers that start late find nothing left to claim
+    auto batch = std::make_shared<Batch>(count, job);
+    int numWorkers = std::min(getNumThreads(), count - 1);
+    for (int i = 0; i < numWorkers; i++) {
+        _threadPool.start(new PhysicsWorker(batch));
+    }
+
+    // help out on this thread, then wait for any jobs still running on workers.
+    batch->run();
+    QMutexLocker locker(&batch->mutex);
+    while (batch->remainingJobs > 0) {
+        batch->finished.wait(&batch->mutex);
+    }
+}
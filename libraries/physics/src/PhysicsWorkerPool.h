@@ -0,0 +1,41 @@
+//
+//  PhysicsWorkerPool.h
+//  libraries/physics/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsWorkerPool_h
+#define hifi_PhysicsWorkerPool_h
+
+#include <functional>
+
+#include <QThreadPool>
+
+// Runs the independent parts of a simulation step in parallel.
+//
+// forEach() is a sync point: it returns once the job has been called for every index.  The calling thread
+// also runs jobs, so a pool of N threads has up to N + 1 participants.  Each participant gets its own
+// workerIndex in [0, getNumParticipants()) for the duration of one forEach(), for per-thread scratch data.
+class PhysicsWorkerPool {
+public:
+    using Job = std::function<void(int index, int workerIndex)>;
+
+    explicit PhysicsWorkerPool(int numThreads);
+    ~PhysicsWorkerPool();
+
+    int getNumThreads() const { return _threadPool.maxThreadCount(); }
+    int getNumParticipants() const { return getNumThreads() + 1; }
+
+    void forEach(int count, const Job& job);
+
+    struct Batch;
+
+private:
+    QThreadPool _threadPool;
+};
+
+#endif // hifi_PhysicsWorkerPool_h
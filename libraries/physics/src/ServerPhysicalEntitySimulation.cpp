@@ -0,0 +1,129 @@
+//
+//  ServerPhysicalEntitySimulation.cpp
+//  libraries/physics/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ServerPhysicalEntitySimulation.h"
+
+#include <DirtyOctreeElementOperator.h>
+#include <EntityTree.h>
+#include <GLMHelpers.h>
+#include <NodeList.h>
+#include <PhysicsHelpers.h>
+#include <SharedUtil.h>
+
+// the average step time reported in the server stats is over about this many steps
+static const quint64 STEP_USECS_AVERAGING_WEIGHT = 16;
+
+ServerPhysicalEntitySimulation::ServerPhysicalEntitySimulation() {
+}
+
+ServerPhysicalEntitySimulation::~ServerPhysicalEntitySimulation() {
+    // the motion states hold shapes from our ShapeManager, so they have to go before it does
+    if (_physicsEngine) {
+        clearEntities();
+        _physicsEngine.reset();
+    }
+}
+
+void ServerPhysicalEntitySimulation::init(EntityTreePointer tree, int numWorkerThreads) {
+    ObjectMotionState::setShapeManager(&_shapeManager);
+
+    PhysicsEnginePointer physicsEngine = std::make_shared<PhysicsEngine>(Vectors::ZERO);
+    physicsEngine->setNumWorkerThreads(numWorkerThreads);
+    physicsEngine->init();
+
+    // outgoing edits are applied to the tree by queueOutgoingEdits(), not sent
+    PhysicalEntitySimulation::init(tree, physicsEngine, nullptr);
+}
+
+void ServerPhysicalEntitySimulation::clearOwnership(const QUuid& ownerID) {
+    QMutexLocker lock(&_mutex);
+    for (auto stateItr : _physicalObjects) {
+        EntityMotionState* motionState = static_cast<EntityMotionState*>(&(*stateItr));
+        EntityItemPointer entity = motionState->getEntity();
+        if (entity && entity->getSimulatorID() == ownerID) {
+            // the simulator has abandoned this object --> remove ownership and dirty all the tree elements that contain it
+            entity->clearSimulationOwnership();
+            entity->markAsChangedOnServer();
+            DirtyOctreeElementOperator op(entity->getElement());
+            getEntityTree()->recurseTreeWithOperator(&op);
+
+            if (entity->getDynamic() && entity->hasLocalVelocity()) {
+                // it is still moving dynamically --> we'll carry on simulating it
+                motionState->bump(VOLUNTEER_SIMULATION_PRIORITY);
+            }
+        }
+    }
+}
+
+void ServerPhysicalEntitySimulation::applyActionChanges() {
+    // the server's actions only hold their arguments, they can't act on our bodies, so they stay out of the
+    // PhysicsEngine and objects with actions are left to the clients that made them
+    EntitySimulation::applyActionChanges();
+}
+
+void ServerPhysicalEntitySimulation::updateEntitiesInternal(const quint64& now) {
+    // NOTE: we get here from EntityTree::update(), with the tree locked for write
+    quint64 start = usecTimestampNow();
+
+    const QUuid& sessionID = DependencyManager::get<NodeList>()->getSessionUUID();
+    Physics::setSessionUUID(sessionID);
+    _physicsEngine->setSessionUUID(sessionID);
+
+    getObjectsToRemoveFromPhysics(_motionStates);
+    _physicsEngine->removeObjects(_motionStates);
+    deleteObjectsRemovedFromPhysics();
+
+    getObjectsToAddToPhysics(_motionStates);
+    _physicsEngine->addObjects(_motionStates);
+    volunteerForOwnerlessObjects(_motionStates);
+
+    getObjectsToChange(_motionStates);
+    VectorOfMotionStates stillNeedChange = _physicsEngine->changeObjects(_motionStates);
+    setObjectsToChange(stillNeedChange);
+    volunteerForOwnerlessObjects(_motionStates);
+
+    _physicsEngine->stepSimulation();
+
+    if (_physicsEngine->hasOutgoingChanges()) {
+        handleOutgoingChanges(_physicsEngine->getOutgoingChanges(), sessionID);
+
+        // nothing on the server listens for collisions, but this is also where finished contacts are forgotten
+        _physicsEngine->getCollisionEvents();
+
+        // only updates that stepped count, the others are too soon after the last step to do anything
+        quint64 stepUsecs = usecTimestampNow() - start;
+        _averageStepUsecs = (_averageStepUsecs * (STEP_USECS_AVERAGING_WEIGHT - 1) + stepUsecs) /
+            STEP_USECS_AVERAGING_WEIGHT;
+    }
+}
+
+void ServerPhysicalEntitySimulation::queueOutgoingEdits(const EntityEditPacketSender::EntityEdits& edits) {
+    // we are the entity-server: our edits go straight into the tree, where viewers will pick them up
+    EntityTreePointer tree = getEntityTree();
+    for (auto& edit : edits) {
+        if (tree->updateEntity(edit.first, edit.second)) {
+            EntityItemPointer entity = tree->findEntityByEntityItemID(edit.first);
+            if (entity) {
+                entity->markAsChangedOnServer();
+            }
+        }
+    }
+}
+
+void ServerPhysicalEntitySimulation::volunteerForOwnerlessObjects(const VectorOfMotionStates& motionStates) {
+    for (auto state : motionStates) {
+        EntityMotionState* motionState = static_cast<EntityMotionState*>(state);
+        EntityItemPointer entity = motionState->getEntity();
+        // dynamic objects that are moving with nobody simulating them are the ones we're here for
+        if (entity && entity->getSimulatorID().isNull() && entity->getDynamic() && entity->hasLocalVelocity()) {
+            motionState->bump(VOLUNTEER_SIMULATION_PRIORITY);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+//
+//  ServerPhysicalEntitySimulation.h
+//  libraries/physics/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ServerPhysicalEntitySimulation_h
+#define hifi_ServerPhysicalEntitySimulation_h
+
+#include "PhysicalEntitySimulation.h"
+#include "ShapeManager.h"
+
+// Runs the physics of an entity-server's tree headlessly, as one more simulator alongside the clients.
+//
+// It volunteers (at the lowest priority) for dynamic entities that are moving without an owner, and gives
+// them up to any client that bids.  Its updates are applied straight to the tree under the server's own
+// session ID, so they go through the same ownership rules as a client's edits and out to viewers through the
+// normal octree send path.  The simulation is stepped from EntityTree::update().
+class ServerPhysicalEntitySimulation : public PhysicalEntitySimulation {
+public:
+    ServerPhysicalEntitySimulation();
+    ~ServerPhysicalEntitySimulation();
+
+    void init(EntityTreePointer tree, int numWorkerThreads = 0);
+
+    // the simulator has gone away: what it was moving is released, and taken over if it is still moving
+    void clearOwnership(const QUuid& ownerID);
+
+    virtual void applyActionChanges() override;
+
+    quint64 getAverageStepUsecs() const { return _averageStepUsecs; }
+    int getNumPhysicalEntities() const { return _physicalObjects.size(); }
+
+protected:
+    virtual void updateEntitiesInternal(const quint64& now) override;
+    virtual void queueOutgoingEdits(const EntityEditPacketSender::EntityEdits& edits) override;
+
+private:
+    void volunteerForOwnerlessObjects(const VectorOfMotionStates& motionStates);
+
+    ShapeManager _shapeManager;
+    VectorOfMotionStates _motionStates;
+    quint64 _averageStepUsecs { 0 };
+};
+
+#endif // hifi_ServerPhysicalEntitySimulation_h
@@ -15,8 +15,12 @@
  * Copied and modified from btDiscreteDynamicsWorld.cpp by AndrewMeadows on 2014.11.12.
  * */
 
+#include <algorithm>
+
 #include <LinearMath/btQuickprof.h>
+#include <BulletCollision/CollisionDispatch/btSimulationIslandManager.h>
 
+#include "PhysicsWorkerPool.h"
 #include "ThreadSafeDynamicsWorld.h"
 
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
@@ -143,3 +147,154 @@ void ThreadSafeDynamicsWorld::synchronizeMotionStates() {
     }
 }
 
+
+bool ThreadSafeDynamicsWorld::canSolveIslandsInParallel() {
+    // Bullet's profiler keeps a single global stack of samples that the solver records into, so solvers may only
+    // run side by side when Bullet was built without it.
+#ifdef BT_NO_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ThreadSafeDynamicsWorld::setWorkerPool(PhysicsWorkerPool* workerPool) {
+    _workerPool = workerPool;
+    _islandSolvers.clear();
+    if (_workerPool && canSolveIslandsInParallel()) {
+        // one per participant, since a solver keeps its scratch pools in itself
+        for (int i = 0; i < _workerPool->getNumParticipants(); i++) {
+            _islandSolvers.emplace_back(new btSequentialImpulseConstraintSolver());
+        }
+    }
+}
+
+void ThreadSafeDynamicsWorld::solveConstraints(btContactSolverInfo& solverInfo) {
+    if (_workerPool && canSolveIslandsInParallel()) {
+        solveIslandsInParallel(solverInfo);
+    } else {
+        btDiscreteDynamicsWorld::solveConstraints(solverInfo);
+    }
+}
+
+// copies out the awake islands, since the island manager reuses its arrays from one island to the next
+class IslandCollector : public btSimulationIslandManager::IslandCallback {
+public:
+    struct Island {
+        int id;
+        std::vector<btCollisionObject*> bodies;
+        std::vector<btPersistentManifold*> manifolds;
+    };
+
+    virtual void processIsland(btCollisionObject** bodies, int numBodies, btPersistentManifold** manifolds,
+                               int numManifolds, int islandId) override {
+        islands.push_back({ islandId, std::vector<btCollisionObject*>(bodies, bodies + numBodies),
+                            std::vector<btPersistentManifold*>(manifolds, manifolds + numManifolds) });
+    }
+
+    std::vector<Island> islands;
+};
+
+static int getConstraintIslandId(const btTypedConstraint* constraint) {
+    const btCollisionObject& objectA = constraint->getRigidBodyA();
+    const btCollisionObject& objectB = constraint->getRigidBodyB();
+    return (objectA.getIslandTag() >= 0) ? objectA.getIslandTag() : objectB.getIslandTag();
+}
+
+void ThreadSafeDynamicsWorld::solveIslandsInParallel(btContactSolverInfo& solverInfo) {
+    IslandCollector collector;
+    m_islandManager->buildAndProcessIslands(getDispatcher(), this, &collector);
+
+    // constraints in the order they were added, grouped by island
+    std::vector<std::pair<int, btTypedConstraint*>> constraints;
+    constraints.reserve(m_constraints.size());
+    for (int i = 0; i < m_constraints.size(); i++) {
+        constraints.push_back({ getConstraintIslandId(m_constraints[i]), m_constraints[i] });
+    }
+    std::stable_sort(constraints.begin(), constraints.end(),
+                     [](const std::pair<int, btTypedConstraint*>& a, const std::pair<int, btTypedConstraint*>& b) {
+        return a.first < b.first;
+    });
+
+    // Small islands are batched like btDiscreteDynamicsWorld does, the batches only depend on the islands so the
+    // results don't depend on the threads.  A solver writes to the kinematic objects it touches and those are
+    // shared between islands, so every island that touches one goes into the same batch.
+    int numBatches = 0;
+    int kinematicBatch = -1;
+    int openBatch = -1;
+    auto newBatch = [&]() -> int {
+        if (numBatches == (int)_islandBatches.size()) {
+            _islandBatches.emplace_back();
+        }
+        IslandBatch& batch = _islandBatches[numBatches];
+        batch.bodies.clear();
+        batch.manifolds.clear();
+        batch.constraints.clear();
+        return numBatches++;
+    };
+
+    for (auto& island : collector.islands) {
+        auto constraintsBegin = constraints.begin();
+        auto constraintsEnd = constraints.end();
+        if (island.id >= 0) {
+            constraintsBegin = std::lower_bound(constraints.begin(), constraints.end(),
+                                                std::pair<int, btTypedConstraint*>(island.id, nullptr),
+                                                [](const std::pair<int, btTypedConstraint*>& a,
+                                                   const std::pair<int, btTypedConstraint*>& b) {
+                return a.first < b.first;
+            });
+            constraintsEnd = constraintsBegin;
+            while (constraintsEnd != constraints.end() && constraintsEnd->first == island.id) {
+                constraintsEnd++;
+            }
+        }
+        if (island.manifolds.empty() && constraintsBegin == constraintsEnd) {
+            // nothing to solve
+            continue;
+        }
+
+        bool touchesKinematic = false;
+        for (auto manifold : island.manifolds) {
+            touchesKinematic = touchesKinematic || manifold->getBody0()->isKinematicObject() ||
+                manifold->getBody1()->isKinematicObject();
+        }
+        for (auto constraint = constraintsBegin; constraint != constraintsEnd; constraint++) {
+            touchesKinematic = touchesKinematic || constraint->second->getRigidBodyA().isKinematicObject() ||
+                constraint->second->getRigidBodyB().isKinematicObject();
+        }
+
+        int batchIndex;
+        if (touchesKinematic) {
+            if (kinematicBatch < 0) {
+                kinematicBatch = newBatch();
+            }
+            batchIndex = kinematicBatch;
+        } else {
+            if (openBatch < 0) {
+                openBatch = newBatch();
+            }
+            batchIndex = openBatch;
+        }
+
+        IslandBatch& batch = _islandBatches[batchIndex];
+        batch.bodies.insert(batch.bodies.end(), island.bodies.begin(), island.bodies.end());
+        batch.manifolds.insert(batch.manifolds.end(), island.manifolds.begin(), island.manifolds.end());
+        for (auto constraint = constraintsBegin; constraint != constraintsEnd; constraint++) {
+            batch.constraints.push_back(constraint->second);
+        }
+        if (batchIndex == openBatch &&
+                (int)(batch.bodies.size() + batch.manifolds.size()) >= solverInfo.m_minimumSolverBatchSize) {
+            openBatch = -1;
+        }
+    }
+
+    btIDebugDraw* debugDrawer = getDebugDrawer();
+    btDispatcher* dispatcher = getDispatcher();
+    _workerPool->forEach(numBatches, [&](int index, int workerIndex) {
+        IslandBatch& batch = _islandBatches[index];
+        _islandSolvers[workerIndex]->solveGroup(batch.bodies.data(), (int)batch.bodies.size(),
+                                                batch.manifolds.data(), (int)batch.manifolds.size(),
+                                                batch.constraints.data(), (int)batch.constraints.size(),
+                                                solverInfo, debugDrawer, dispatcher);
+    });
+}
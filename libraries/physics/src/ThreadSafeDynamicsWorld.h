@@ -20,10 +20,15 @@
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
 
 #include "ObjectMotionState.h"
 
 #include <functional>
+#include <memory>
+#include <vector>
+
+class PhysicsWorkerPool;
 
 using SubStepCallback = std::function<void()>;
 
@@ -49,11 +54,30 @@ public:
 
     const VectorOfMotionStates& getChangedMotionStates() const { return _changedMotionStates; }
 
+    // with a pool, batches of independent islands are solved in parallel, each by a solver of its own
+    void setWorkerPool(PhysicsWorkerPool* workerPool);
+    static bool canSolveIslandsInParallel();
+
+protected:
+    virtual void solveConstraints(btContactSolverInfo& solverInfo) override;
+
 private:
     // call this instead of non-virtual btDiscreteDynamicsWorld::synchronizeSingleMotionState()
     void synchronizeMotionState(btRigidBody* body);
 
+    struct IslandBatch {
+        std::vector<btCollisionObject*> bodies;
+        std::vector<btPersistentManifold*> manifolds;
+        std::vector<btTypedConstraint*> constraints;
+    };
+
+    void solveIslandsInParallel(btContactSolverInfo& solverInfo);
+
     VectorOfMotionStates _changedMotionStates;
+
+    PhysicsWorkerPool* _workerPool { nullptr };
+    std::vector<std::unique_ptr<btSequentialImpulseConstraintSolver>> _islandSolvers;
+    std::vector<IslandBatch> _islandBatches;
 };
 
 #endif // hifi_ThreadSafeDynamicsWorld_h
@@ -250,17 +250,48 @@ bool Model::findRayIntersectionAgainstSubMeshes(const glm::vec3& origin, const g
 
         const FBXGeometry& geometry = getFBXGeometry();
 
+        // precision picks traverse the per-mesh BVHs shared by every instance of this geometry, in mesh space,
+        // falling back to testing every triangle in world space until they are built.
+        std::shared_ptr<const Geometry::TriangleBVHs> triangleBVHs;
+        if (pickAgainstTriangles) {
+            triangleBVHs = getGeometry()->getGeometry()->getTriangleBVHs();
+        }
+        bool pickAgainstWorldTriangles = pickAgainstTriangles && !triangleBVHs;
+
+        // this maps mesh space to world space exactly as calculateScaledOffsetPoint does
+        glm::mat4 meshToWorldMatrix = modelToWorldMatrix * glm::scale(_scale) * glm::translate(_offset) * geometry.offset;
+        glm::mat4 worldToMeshMatrix = glm::inverse(meshToWorldMatrix);
+        glm::vec3 meshFrameOrigin = glm::vec3(worldToMeshMatrix * glm::vec4(origin, 1.0f));
+        glm::vec3 meshFrameDirection = glm::vec3(worldToMeshMatrix * glm::vec4(direction, 0.0f));
+
         // If we hit the models box, then consider the submeshes...
         _mutex.lock();
-        if (!_calculatedMeshBoxesValid || (pickAgainstTriangles && !_calculatedMeshTrianglesValid)) {
-            recalculateMeshBoxes(pickAgainstTriangles);
+        if (!_calculatedMeshBoxesValid || (pickAgainstWorldTriangles && !_calculatedMeshTrianglesValid)) {
+            recalculateMeshBoxes(pickAgainstWorldTriangles);
         }
 
         for (const auto& subMeshBox : _calculatedMeshBoxes) {
 
             if (subMeshBox.findRayIntersection(origin, direction, distanceToSubMesh, subMeshFace, subMeshSurfaceNormal)) {
                 if (distanceToSubMesh < bestDistance) {
-                    if (pickAgainstTriangles) {
+                    if (pickAgainstTriangles && !pickAgainstWorldTriangles) {
+                        // the affine mapping into mesh space preserves the distance along the ray
+                        float triangleDistance;
+                        int triangleIndex;
+                        const TriangleBVH& bvh = triangleBVHs->at(subMeshIndex);
+                        if (bvh.findRayIntersection(meshFrameOrigin, meshFrameDirection, triangleDistance, triangleIndex) &&
+                                triangleDistance < bestDistance) {
+                            const Triangle& triangle = bvh.getTriangles()[triangleIndex];
+                            Triangle worldTriangle = { glm::vec3(meshToWorldMatrix * glm::vec4(triangle.v0, 1.0f)),
+                                                       glm::vec3(meshToWorldMatrix * glm::vec4(triangle.v1, 1.0f)),
+                                                       glm::vec3(meshToWorldMatrix * glm::vec4(triangle.v2, 1.0f)) };
+                            bestDistance = triangleDistance;
+                            intersectedSomething = true;
+                            face = subMeshFace;
+                            surfaceNormal = worldTriangle.getNormal();
+                            extraInfo = geometry.getModelNameOfMesh(subMeshIndex);
+                        }
+                    } else if (pickAgainstTriangles) {
                         // check our triangles here....
                         const QVector<Triangle>& meshTriangles = _calculatedMeshTriangles[subMeshIndex];
                         for(const auto& triangle : meshTriangles) {
@@ -809,7 +840,7 @@ class Blender : public QRunnable {
 public:
 
     Blender(ModelPointer model, int blendNumber, const std::weak_ptr<NetworkGeometry>& geometry,
-        const QVector<FBXMesh>& meshes, const QVector<float>& blendshapeCoefficients);
+        const std::shared_ptr<BlendshapeEngine>& engine, const QVector<float>& blendshapeCoefficients);
 
     virtual void run();
 
@@ -818,16 +849,16 @@ private:
     ModelPointer _model;
     int _blendNumber;
     std::weak_ptr<NetworkGeometry> _geometry;
-    QVector<FBXMesh> _meshes;
+    std::shared_ptr<BlendshapeEngine> _engine;
     QVector<float> _blendshapeCoefficients;
 };
 
 Blender::Blender(ModelPointer model, int blendNumber, const std::weak_ptr<NetworkGeometry>& geometry,
-        const QVector<FBXMesh>& meshes, const QVector<float>& blendshapeCoefficients) :
+        const std::shared_ptr<BlendshapeEngine>& engine, const QVector<float>& blendshapeCoefficients) :
     _model(model),
     _blendNumber(blendNumber),
     _geometry(geometry),
-    _meshes(meshes),
+    _engine(engine),
     _blendshapeCoefficients(blendshapeCoefficients) {
 }
 
@@ -835,32 +866,7 @@ void Blender::run() {
     PROFILE_RANGE(__FUNCTION__);
     QVector<glm::vec3> vertices, normals;
     if (_model) {
-        int offset = 0;
-        foreach (const FBXMesh& mesh, _meshes) {
-            if (mesh.blendshapes.isEmpty()) {
-                continue;
-            }
-            vertices += mesh.vertices;
-            normals += mesh.normals;
-            glm::vec3* meshVertices = vertices.data() + offset;
-            glm::vec3* meshNormals = normals.data() + offset;
-            offset += mesh.vertices.size();
-            const float NORMAL_COEFFICIENT_SCALE = 0.01f;
-            for (int i = 0, n = qMin(_blendshapeCoefficients.size(), mesh.blendshapes.size()); i < n; i++) {
-                float vertexCoefficient = _blendshapeCoefficients.at(i);
-                const float EPSILON = 0.0001f;
-                if (vertexCoefficient < EPSILON) {
-                    continue;
-                }
-                float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
-                const FBXBlendshape& blendshape = mesh.blendshapes.at(i);
-                for (int j = 0; j < blendshape.indices.size(); j++) {
-                    int index = blendshape.indices.at(j);
-                    meshVertices[index] += blendshape.vertices.at(j) * vertexCoefficient;
-                    meshNormals[index] += blendshape.normals.at(j) * normalCoefficient;
-                }
-            }
-        }
+        _engine->blend(_blendshapeCoefficients, vertices, normals);
     }
     // post the result to the geometry cache, which will dispatch to the model if still alive
     QMetaObject::invokeMethod(DependencyManager::get<ModelBlender>().data(), "setBlendedVertices",
@@ -1072,12 +1078,23 @@ float Model::getLimbLength(int jointIndex) const {
     return _rig->getLimbLength(jointIndex, freeLineage, _scale, geometry.joints);
 }
 
+void Model::setLoadPriority(float priority) {
+    if (_geometry) {
+        _geometry->setLoadPriority(this, priority);
+    }
+}
+
 bool Model::maybeStartBlender() {
     if (isLoaded()) {
         const FBXGeometry& fbxGeometry = getFBXGeometry();
         if (fbxGeometry.hasBlendedMeshes()) {
+            if (!_blendshapeEngine) {
+                // the packed blendshapes are shared with every other model of this geometry
+                _blendshapeEngine = std::make_shared<BlendshapeEngine>(
+                    getGeometry()->getGeometry()->getPackedBlendshapes());
+            }
             QThreadPool::globalInstance()->start(new Blender(getThisPointer(), ++_blendNumber, _geometry,
-                fbxGeometry.meshes, _blendshapeCoefficients));
+                _blendshapeEngine, _blendshapeCoefficients));
             return true;
         }
     }
@@ -1113,6 +1130,7 @@ void Model::deleteGeometry() {
     _meshStates.clear();
     _rig->destroyAnimGraph();
     _blendedBlendshapeCoefficients.clear();
+    _blendshapeEngine.reset();
 }
 
 AABox Model::getPartBounds(int meshIndex, int partIndex, glm::vec3 modelPosition, glm::quat modelOrientation) const {
@@ -30,6 +30,7 @@
 
 #include "GeometryCache.h"
 #include "TextureCache.h"
+#include "BlendshapeEngine.h"
 #include "Rig.h"
 
 class AbstractViewStateInterface;
@@ -123,6 +124,12 @@ public:
     virtual void simulate(float deltaTime, bool fullUpdate = true);
     virtual void updateClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrientation);
 
+    /// Returns true once the geometry and all of its textures have loaded.
+    bool isLoadComplete() const { return isLoaded() && _geometry->getGeometry()->areTexturesLoaded(); }
+
+    /// Sets the priority of the model's downloads relative to the others waiting, higher loads sooner.
+    void setLoadPriority(float priority);
+
     /// Returns a reference to the shared geometry.
     const NetworkGeometry::Pointer& getGeometry() const { return _geometry; }
     /// Returns a reference to the shared collision geometry.
@@ -343,6 +350,7 @@ protected:
     QVector<QVector<QSharedPointer<Texture> > > _dilatedTextures;
 
     QVector<float> _blendedBlendshapeCoefficients;
+    std::shared_ptr<BlendshapeEngine> _blendshapeEngine;
     int _blendNumber;
     int _appliedBlendNumber;
 
@@ -0,0 +1,90 @@
+//
+//  EntityScriptEnginePool.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptEnginePool.h"
+
+#include <algorithm>
+
+#include <QtCore/QThread>
+
+#include "ScriptEngine.h"
+
+EntityScriptEnginePool::EntityScriptEnginePool(int numEngines, EngineInitializer initializer) {
+    numEngines = std::max(1, std::min(numEngines, QThread::idealThreadCount()));
+    for (int i = 0; i < numEngines; i++) {
+        // a single engine keeps the name entity scripts have always run under
+        QString name = (numEngines == 1) ? QString("Entities") : QString("Entities %1").arg(i + 1);
+        auto engine = new ScriptEngine(NO_SCRIPT, name);
+        _engines.push_back(engine);
+        initializer(engine);
+    }
+}
+
+ScriptEngine* EntityScriptEnginePool::getEngine(const EntityItemID& entityID) const {
+    // the hash of an ID doesn't change between runs, so neither does the engine it maps to, while that one runs
+    size_t first = qHash(entityID) % _engines.size();
+    for (size_t i = 0; i < _engines.size(); i++) {
+        ScriptEngine* engine = _engines[(first + i) % _engines.size()];
+        if (engine && !engine->isFinished()) {
+            return engine;
+        }
+    }
+    return nullptr;
+}
+
+void EntityScriptEnginePool::loadEntityScript(const EntityItemID& entityID, const QString& entityScript,
+                                              bool forceRedownload) {
+    if (auto engine = getEngine(entityID)) {
+        engine->loadEntityScript(entityID, entityScript, forceRedownload);
+    }
+}
+
+void EntityScriptEnginePool::unloadEntityScript(const EntityItemID& entityID) {
+    if (auto engine = getEngine(entityID)) {
+        engine->unloadEntityScript(entityID);
+    }
+}
+
+void EntityScriptEnginePool::unloadAllEntityScripts() {
+    for (auto& engine : _engines) {
+        if (engine) {
+            engine->unloadAllEntityScripts();
+        }
+    }
+}
+
+void EntityScriptEnginePool::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                    const QStringList& params) {
+    if (auto engine = getEngine(entityID)) {
+        engine->callEntityScriptMethod(entityID, methodName, params);
+    }
+}
+
+void EntityScriptEnginePool::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                    const MouseEvent& event) {
+    if (auto engine = getEngine(entityID)) {
+        engine->callEntityScriptMethod(entityID, methodName, event);
+    }
+}
+
+void EntityScriptEnginePool::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                    const EntityItemID& otherID, const Collision& collision) {
+    if (auto engine = getEngine(entityID)) {
+        engine->callEntityScriptMethod(entityID, methodName, otherID, collision);
+    }
+}
+
+void EntityScriptEnginePool::disconnectNonEssentialSignals() {
+    for (auto& engine : _engines) {
+        if (engine) {
+            engine->disconnectNonEssentialSignals();
+        }
+    }
+}
@@ -0,0 +1,57 @@
+//
+//  EntityScriptEnginePool.h
+//  libraries/script-engine/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptEnginePool_h
+#define hifi_EntityScriptEnginePool_h
+
+#include <functional>
+#include <vector>
+
+#include <QtCore/QPointer>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <EntityItemID.h>
+
+#include "MouseEvent.h"
+
+class Collision;
+class ScriptEngine;
+
+/// Spreads the entity scripts over a number of ScriptEngines, each running in its own thread, so a slow script only
+/// delays the scripts sharing its engine.  The engine of a script is picked from its entity ID, and calls to it are
+/// queued to that engine's thread.  An engine that stops, after an uncaught error for instance, is deleted by the
+/// application; the pool only watches it go, and its entities move on to the next engine that is still running.
+class EntityScriptEnginePool : public EntitiesScriptEngineProvider {
+public:
+    using EngineInitializer = std::function<void(ScriptEngine*)>;
+
+    /// The initializer is called for each engine, and starts it running.
+    EntityScriptEnginePool(int numEngines, EngineInitializer initializer);
+
+    int getNumEngines() const { return (int)_engines.size(); }
+    ScriptEngine* getEngine(const EntityItemID& entityID) const; // nullptr once every engine has stopped
+
+    void loadEntityScript(const EntityItemID& entityID, const QString& entityScript, bool forceRedownload = false);
+    void unloadEntityScript(const EntityItemID& entityID);
+    void unloadAllEntityScripts();
+
+    virtual void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                        const QStringList& params = QStringList()) override;
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName, const MouseEvent& event);
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const EntityItemID& otherID, const Collision& collision);
+
+    void disconnectNonEssentialSignals();
+
+private:
+    std::vector<QPointer<ScriptEngine>> _engines;
+};
+
+#endif // hifi_EntityScriptEnginePool_h
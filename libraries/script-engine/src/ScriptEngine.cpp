@@ -12,6 +12,7 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QEventLoop>
 #include <QtCore/QFileInfo>
+#include <QtCore/QMutexLocker>
 #include <QtCore/QTimer>
 #include <QtCore/QThread>
 #include <QtNetwork/QNetworkRequest>
@@ -28,6 +29,7 @@
 #include <NetworkAccessManager.h>
 #include <ResourceScriptingInterface.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <UUID.h>
 
@@ -1106,6 +1108,13 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         QString file = QUrl(scriptOrURL).toLocalFile();
         lastModified = (quint64)QFileInfo(file).lastModified().toMSecsSinceEpoch();
     }
+    {
+        QMutexLocker locker(&_entityScriptTimingsLock);
+        EntityScriptTiming timing;
+        timing.scriptText = scriptOrURL;
+        _entityScriptTimings[entityID] = timing;
+    }
+
     QScriptValue entityScriptConstructor, entityScriptObject;
     auto initialization = [&]{
         entityScriptConstructor = evaluate(contents, fileName);
@@ -1140,6 +1149,11 @@ void ScriptEngine::unloadEntityScript(const EntityItemID& entityID) {
 #endif
 
     if (_entityScripts.contains(entityID)) {
+        {
+            // no longer throttled, so the unload always runs
+            QMutexLocker locker(&_entityScriptTimingsLock);
+            _entityScriptTimings.remove(entityID);
+        }
         callEntityScriptMethod(entityID, "unload");
         _entityScripts.remove(entityID);
         stopAllTimersForEntityScript(entityID);
@@ -1158,6 +1172,10 @@ void ScriptEngine::unloadAllEntityScripts() {
 #ifdef THREAD_DEBUGGING
     qDebug() << "ScriptEngine::unloadAllEntityScripts() called on correct thread [" << thread() << "]";
 #endif
+    {
+        QMutexLocker locker(&_entityScriptTimingsLock);
+        _entityScriptTimings.clear();
+    }
     foreach(const EntityItemID& entityID, _entityScripts.keys()) {
         callEntityScriptMethod(entityID, "unload");
     }
@@ -1206,6 +1224,10 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, std::function
     EntityItemID oldIdentifier = currentEntityIdentifier;
     currentEntityIdentifier = entityID;
 
+    // time spent in an entity script calling into another is counted for the outermost one
+    bool isTimed = !entityID.isInvalidID() && oldIdentifier.isInvalidID();
+    quint64 startTime = isTimed ? usecTimestampNow() : 0;
+
 #if DEBUG_CURRENT_ENTITY
     QScriptValue oldData = this->globalObject().property("debugEntityID");
     this->globalObject().setProperty("debugEntityID", entityID.toScriptValue(this)); // Make the entityID available to javascript as a global.
@@ -1216,14 +1238,74 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, std::function
 #endif
 
     currentEntityIdentifier = oldIdentifier;
+
+    if (isTimed) {
+        quint64 elapsed = usecTimestampNow() - startTime;
+        QMutexLocker locker(&_entityScriptTimingsLock);
+        auto timing = _entityScriptTimings.find(entityID);
+        if (timing != _entityScriptTimings.end()) {
+            timing->totalUsecs += elapsed;
+            timing->maxUsecs = std::max(timing->maxUsecs, elapsed);
+            timing->numCalls++;
+        }
+    }
 }
 void ScriptEngine::callWithEnvironment(const EntityItemID& entityID, QScriptValue function, QScriptValue thisObject, QScriptValueList args) {
+    if (shouldThrottleEntityScript(entityID)) {
+        return;
+    }
     auto operation = [&]() {
         function.call(thisObject, args);
     };
     doWithEnvironment(entityID, operation);
 }
 
+bool ScriptEngine::shouldThrottleEntityScript(const EntityItemID& entityID) {
+    if (entityID.isInvalidID()) {
+        return false;
+    }
+    QMutexLocker locker(&_entityScriptTimingsLock);
+    auto timing = _entityScriptTimings.find(entityID);
+    if (timing == _entityScriptTimings.end() || timing->minCallIntervalMsecs <= 0) {
+        return false;
+    }
+    quint64 now = usecTimestampNow();
+    if (now - timing->lastCallUsecs < (quint64)timing->minCallIntervalMsecs * USECS_PER_MSEC) {
+        timing->numThrottledCalls++;
+        return true;
+    }
+    timing->lastCallUsecs = now;
+    return false;
+}
+
+QVariantList ScriptEngine::getEntityScriptTimings() const {
+    QVariantList result;
+    QMutexLocker locker(&_entityScriptTimingsLock);
+    for (auto it = _entityScriptTimings.constBegin(); it != _entityScriptTimings.constEnd(); it++) {
+        QVariantMap timing;
+        timing.insert("entityID", it.key().toString());
+        timing.insert("engine", _fileNameString);
+        timing.insert("script", it->scriptText);
+        timing.insert("totalTime", (double)it->totalUsecs / USECS_PER_MSEC);
+        timing.insert("maxTime", (double)it->maxUsecs / USECS_PER_MSEC);
+        timing.insert("calls", it->numCalls);
+        timing.insert("throttledCalls", it->numThrottledCalls);
+        timing.insert("minCallInterval", it->minCallIntervalMsecs);
+        result.append(timing);
+    }
+    return result;
+}
+
+bool ScriptEngine::setEntityScriptThrottle(const EntityItemID& entityID, int minCallIntervalMsecs) {
+    QMutexLocker locker(&_entityScriptTimingsLock);
+    auto timing = _entityScriptTimings.find(entityID);
+    if (timing == _entityScriptTimings.end()) {
+        return false;
+    }
+    timing->minCallIntervalMsecs = std::max(minCallIntervalMsecs, 0);
+    return true;
+}
+
 void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName, const QStringList& params) {
     if (QThread::currentThread() != thread()) {
 #ifdef THREAD_DEBUGGING
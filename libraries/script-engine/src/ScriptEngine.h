@@ -14,6 +14,7 @@
 
 #include <vector>
 
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QUrl>
 #include <QtCore/QSet>
@@ -59,6 +60,18 @@ public:
     int64_t lastModified;
 };
 
+// the time an entity script has spent running, and how often its callbacks are allowed to run
+class EntityScriptTiming {
+public:
+    QString scriptText;
+    quint64 totalUsecs { 0 };
+    quint64 maxUsecs { 0 };
+    int numCalls { 0 };
+    int numThrottledCalls { 0 };
+    int minCallIntervalMsecs { 0 };
+    quint64 lastCallUsecs { 0 };
+};
+
 class ScriptEngine : public QScriptEngine, public ScriptUser, public EntitiesScriptEngineProvider {
     Q_OBJECT
 public:
@@ -129,6 +142,10 @@ public:
     Q_INVOKABLE void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName, const MouseEvent& event);
     Q_INVOKABLE void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName, const EntityItemID& otherID, const Collision& collision);
 
+    // These are safe to call from any thread
+    QVariantList getEntityScriptTimings() const;
+    bool setEntityScriptThrottle(const EntityItemID& entityID, int minCallIntervalMsecs); // false if not loaded here
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // NOTE - this is intended to be a public interface for Agent scripts, and local scripts, but not for EntityScripts
     Q_INVOKABLE void stop();
@@ -216,6 +233,10 @@ protected:
     EntityItemID currentEntityIdentifier {}; // Contains the defining entity script entity id during execution, if any. Empty for interface script execution.
     void doWithEnvironment(const EntityItemID& entityID, std::function<void()> operation);
     void callWithEnvironment(const EntityItemID& entityID, QScriptValue function, QScriptValue thisObject, QScriptValueList args);
+    bool shouldThrottleEntityScript(const EntityItemID& entityID);
+
+    mutable QMutex _entityScriptTimingsLock;
+    QHash<EntityItemID, EntityScriptTiming> _entityScriptTimings;
 
     friend class ScriptEngines;
     static std::atomic<bool> _stoppingAllScripts;
@@ -211,6 +211,23 @@ QVariantList ScriptEngines::getRunning() {
     return result;
 }
 
+QVariantList ScriptEngines::getEntityScriptTimings() {
+    QVariantList result;
+    QMutexLocker locker(&_allScriptsMutex);
+    for (auto scriptEngine : _allKnownScriptEngines) {
+        result.append(scriptEngine->getEntityScriptTimings());
+    }
+    return result;
+}
+
+bool ScriptEngines::throttleEntityScript(const QUuid& entityID, int minCallIntervalMsecs) {
+    bool found = false;
+    QMutexLocker locker(&_allScriptsMutex);
+    for (auto scriptEngine : _allKnownScriptEngines) {
+        found = scriptEngine->setEntityScriptThrottle(entityID, minCallIntervalMsecs) || found;
+    }
+    return found;
+}
 
 static const QString SETTINGS_KEY = "Settings";
 static const QString DEFAULT_SCRIPTS_JS_URL = "http://s3.amazonaws.com/hifi-public/scripts/defaultScripts.js";
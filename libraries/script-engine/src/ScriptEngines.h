@@ -62,6 +62,11 @@ public:
     Q_INVOKABLE QVariantList getPublic();
     Q_INVOKABLE QVariantList getLocal();
 
+    // The time each entity script has spent running, across all of the engines running entity scripts
+    Q_INVOKABLE QVariantList getEntityScriptTimings();
+    // Runs the callbacks of an entity script at most once per interval, 0 removes the limit
+    Q_INVOKABLE bool throttleEntityScript(const QUuid& entityID, int minCallIntervalMsecs);
+
     // Called at shutdown time
     void shutdownScripting();
 
@@ -47,6 +47,11 @@ public:
         _offset += result.decode(_data + _offset, remaining());
     }
 
+    template <typename T, int N>
+    inline void readFlags(FixedPropertyFlags<T, N>& result) {
+        _offset += result.decode(_data + _offset, remaining());
+    }
+
     template<typename T>
     inline void readCompressedCount(T& result) {
         // FIXME switch to a heapless implementation as soon as Brad provides it.
@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <cstring>
 
 #include <QBitArray>
 #include <QByteArray>
@@ -460,5 +461,300 @@ template<typename Enum> inline QByteArray& operator>>(QByteArray& in, PropertyFl
     return in;
 }
 
+/// A PropertyFlags whose flags all fit below NumFlags, known at compile time.  The flags are kept in a fixed array of
+/// words instead of a QBitArray, so copying and combining them never allocates, and they can be encoded to and decoded
+/// from a caller's buffer.  The encoding is the same as PropertyFlags'.
+template<typename Enum, int NumFlags> class FixedPropertyFlags {
+public:
+    typedef Enum enum_type;
+
+    /// the most bytes encode() will write
+    static const int MAX_ENCODED_LENGTH = ((NumFlags - 1) / (BITS_PER_BYTE - 1)) + 1;
+
+    constexpr FixedPropertyFlags() : _words(), _encodedLength(0) { }
+    FixedPropertyFlags(Enum flag) : _words(), _encodedLength(0) { setHasProperty(flag); }
+    FixedPropertyFlags(const QByteArray& fromEncoded) : _words(), _encodedLength(0) { decode(fromEncoded); }
+
+    // as with PropertyFlags, only the flags are copied, a copy hasn't been encoded or decoded itself
+    FixedPropertyFlags(const FixedPropertyFlags& other) : _encodedLength(0) { memcpy(_words, other._words, sizeof(_words)); }
+    FixedPropertyFlags& operator=(const FixedPropertyFlags& other) {
+        memcpy(_words, other._words, sizeof(_words));
+        return *this;
+    }
+
+    void clear() { memset(_words, 0, sizeof(_words)); _encodedLength = 0; }
+    bool isEmpty() const { return !*this && _encodedLength == 0; }
+
+    Enum firstFlag() const;
+    Enum lastFlag() const;
+
+    void setHasProperty(Enum flag, bool value = true);
+    constexpr bool getHasProperty(Enum flag) const {
+        return flag >= 0 && flag < NumFlags && (_words[flag / BITS_PER_WORD] >> (flag % BITS_PER_WORD)) & 1;
+    }
+
+    /// writes the encoded flags to buffer, which must have room for MAX_ENCODED_LENGTH bytes, returns the bytes written
+    int encode(uint8_t* buffer);
+    QByteArray encode();
+    size_t decode(const uint8_t* data, size_t length);
+    size_t decode(const QByteArray& fromEncoded);
+
+    operator QByteArray() { return encode(); };
+
+    bool operator==(const FixedPropertyFlags& other) const { return memcmp(_words, other._words, sizeof(_words)) == 0; }
+    bool operator!=(const FixedPropertyFlags& other) const { return !(*this == other); }
+    bool operator!() const;
+
+    FixedPropertyFlags& operator|=(const FixedPropertyFlags& other);
+    FixedPropertyFlags& operator|=(Enum flag) { setHasProperty(flag, true); return *this; }
+
+    FixedPropertyFlags& operator&=(const FixedPropertyFlags& other);
+    FixedPropertyFlags& operator&=(Enum flag) { return *this &= FixedPropertyFlags(flag); }
+
+    FixedPropertyFlags& operator+=(const FixedPropertyFlags& other) { return *this |= other; }
+    FixedPropertyFlags& operator+=(Enum flag) { setHasProperty(flag, true); return *this; }
+
+    FixedPropertyFlags& operator-=(const FixedPropertyFlags& other);
+    FixedPropertyFlags& operator-=(Enum flag) { setHasProperty(flag, false); return *this; }
+
+    FixedPropertyFlags& operator<<=(const FixedPropertyFlags& other) { return *this |= other; }
+    FixedPropertyFlags& operator<<=(Enum flag) { setHasProperty(flag, true); return *this; }
+
+    FixedPropertyFlags& operator^=(const FixedPropertyFlags& other);
+    FixedPropertyFlags& operator^=(Enum flag) { return *this ^= FixedPropertyFlags(flag); }
+
+    FixedPropertyFlags operator|(const FixedPropertyFlags& other) const { FixedPropertyFlags result(*this); return result |= other; }
+    FixedPropertyFlags operator|(Enum flag) const { FixedPropertyFlags result(*this); return result |= flag; }
+    FixedPropertyFlags operator&(const FixedPropertyFlags& other) const { FixedPropertyFlags result(*this); return result &= other; }
+    FixedPropertyFlags operator&(Enum flag) const { FixedPropertyFlags result(*this); return result &= flag; }
+    FixedPropertyFlags operator+(const FixedPropertyFlags& other) const { FixedPropertyFlags result(*this); return result += other; }
+    FixedPropertyFlags operator+(Enum flag) const { FixedPropertyFlags result(*this); return result += flag; }
+    FixedPropertyFlags operator-(const FixedPropertyFlags& other) const { FixedPropertyFlags result(*this); return result -= other; }
+    FixedPropertyFlags operator-(Enum flag) const { FixedPropertyFlags result(*this); return result -= flag; }
+    FixedPropertyFlags operator<<(const FixedPropertyFlags& other) const { FixedPropertyFlags result(*this); return result <<= other; }
+    FixedPropertyFlags operator<<(Enum flag) const { FixedPropertyFlags result(*this); return result <<= flag; }
+    FixedPropertyFlags operator^(const FixedPropertyFlags& other) const { FixedPropertyFlags result(*this); return result ^= other; }
+    FixedPropertyFlags operator^(Enum flag) const { FixedPropertyFlags result(*this); return result ^= flag; }
+
+    // NOTE: unlike PropertyFlags, all of the flags below NumFlags are flipped, not just those up to the last one set
+    FixedPropertyFlags operator~() const;
+
+    void debugDumpBits();
+
+    int getEncodedLength() const { return _encodedLength; }
+
+private:
+    typedef uint64_t Word;
+    static const int BITS_PER_WORD = sizeof(Word) * BITS_PER_BYTE;
+    static const int NUM_WORDS = (NumFlags + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+    void clearUnusedBits();
+
+    Word _words[NUM_WORDS];
+    int _encodedLength;
+};
+
+template<typename Enum, int NumFlags>
+inline Enum FixedPropertyFlags<Enum, NumFlags>::firstFlag() const {
+    for (int i = 0; i < NUM_WORDS; i++) {
+        if (_words[i]) {
+            Word word = _words[i];
+            int bit = 0;
+            while (!(word & 1)) {
+                word >>= 1;
+                bit++;
+            }
+            return (Enum)(i * BITS_PER_WORD + bit);
+        }
+    }
+    return (Enum)INT_MAX;
+}
+
+template<typename Enum, int NumFlags>
+inline Enum FixedPropertyFlags<Enum, NumFlags>::lastFlag() const {
+    for (int i = NUM_WORDS - 1; i >= 0; i--) {
+        if (_words[i]) {
+            Word word = _words[i];
+            int bit = -1;
+            while (word) {
+                word >>= 1;
+                bit++;
+            }
+            return (Enum)(i * BITS_PER_WORD + bit);
+        }
+    }
+    return (Enum)INT_MIN;
+}
+
+template<typename Enum, int NumFlags>
+inline void FixedPropertyFlags<Enum, NumFlags>::setHasProperty(Enum flag, bool value) {
+    if (flag < 0 || flag >= NumFlags) {
+        Q_ASSERT(!value);
+        return;
+    }
+    Word bit = (Word)1 << (flag % BITS_PER_WORD);
+    if (value) {
+        _words[flag / BITS_PER_WORD] |= bit;
+    } else {
+        _words[flag / BITS_PER_WORD] &= ~bit;
+    }
+}
+
+template<typename Enum, int NumFlags> inline bool FixedPropertyFlags<Enum, NumFlags>::operator!() const {
+    for (int i = 0; i < NUM_WORDS; i++) {
+        if (_words[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Enum, int NumFlags> inline int FixedPropertyFlags<Enum, NumFlags>::encode(uint8_t* buffer) {
+    int lastFlag = (int)this->lastFlag();
+    if (lastFlag < 0) {
+        buffer[0] = 0;
+        _encodedLength = 1;
+        return _encodedLength; // no flags... nothing to encode
+    }
+
+    int lengthInBytes = (lastFlag / (BITS_PER_BYTE - 1)) + 1;
+    memset(buffer, 0, lengthInBytes);
+
+    // the first N-1 header bits are set to 1, the last to 0
+    for (int i = 0; i < lengthInBytes - 1; i++) {
+        buffer[i / BITS_PER_BYTE] |= 0x80 >> (i % BITS_PER_BYTE);
+    }
+
+    // followed by the flags, only the set ones need to be visited
+    for (int i = 0; i < NUM_WORDS; i++) {
+        Word word = _words[i];
+        for (int bit = i * BITS_PER_WORD; word; word >>= 1, bit++) {
+            if (word & 1) {
+                int outputIndex = lengthInBytes + bit;
+                buffer[outputIndex / BITS_PER_BYTE] |= 0x80 >> (outputIndex % BITS_PER_BYTE);
+            }
+        }
+    }
+
+    _encodedLength = lengthInBytes;
+    return _encodedLength;
+}
+
+template<typename Enum, int NumFlags> inline QByteArray FixedPropertyFlags<Enum, NumFlags>::encode() {
+    uint8_t buffer[MAX_ENCODED_LENGTH];
+    int length = encode(buffer);
+    return QByteArray(reinterpret_cast<const char*>(buffer), length);
+}
+
+template<typename Enum, int NumFlags>
+inline size_t FixedPropertyFlags<Enum, NumFlags>::decode(const uint8_t* data, size_t size) {
+    clear();
+    if (size == 0) {
+        return 0;
+    }
+
+    // count the lead bits, one for each byte after the first
+    int leadBits = 0;
+    int bitCount = BITS_PER_BYTE * (int)size;
+    while (leadBits < bitCount && (data[leadBits / BITS_PER_BYTE] & (0x80 >> (leadBits % BITS_PER_BYTE)))) {
+        leadBits++;
+    }
+    int encodedByteCount = leadBits + 1;
+    leadBits++; // the terminating 0 is a lead bit too
+
+    // a truncated buffer is consumed to its end, keeping whichever flags made it
+    int expectedBitCount = (encodedByteCount * BITS_PER_BYTE) - leadBits;
+    if (encodedByteCount > (int)size) {
+        encodedByteCount = (int)size;
+        expectedBitCount = std::max(bitCount - leadBits, 0);
+    }
+
+    for (int flag = 0; flag < expectedBitCount; flag++) {
+        int bitAt = leadBits + flag;
+        if (data[bitAt / BITS_PER_BYTE] & (0x80 >> (bitAt % BITS_PER_BYTE))) {
+            // flags newer than this build knows about are dropped
+            if (flag < NumFlags) {
+                _words[flag / BITS_PER_WORD] |= (Word)1 << (flag % BITS_PER_WORD);
+            }
+        }
+    }
+    _encodedLength = encodedByteCount;
+    return _encodedLength;
+}
+
+template<typename Enum, int NumFlags>
+inline size_t FixedPropertyFlags<Enum, NumFlags>::decode(const QByteArray& fromEncodedBytes) {
+    return decode(reinterpret_cast<const uint8_t*>(fromEncodedBytes.data()), fromEncodedBytes.size());
+}
+
+template<typename Enum, int NumFlags>
+inline FixedPropertyFlags<Enum, NumFlags>& FixedPropertyFlags<Enum, NumFlags>::operator|=(const FixedPropertyFlags& other) {
+    for (int i = 0; i < NUM_WORDS; i++) {
+        _words[i] |= other._words[i];
+    }
+    return *this;
+}
+
+template<typename Enum, int NumFlags>
+inline FixedPropertyFlags<Enum, NumFlags>& FixedPropertyFlags<Enum, NumFlags>::operator&=(const FixedPropertyFlags& other) {
+    for (int i = 0; i < NUM_WORDS; i++) {
+        _words[i] &= other._words[i];
+    }
+    return *this;
+}
+
+template<typename Enum, int NumFlags>
+inline FixedPropertyFlags<Enum, NumFlags>& FixedPropertyFlags<Enum, NumFlags>::operator-=(const FixedPropertyFlags& other) {
+    for (int i = 0; i < NUM_WORDS; i++) {
+        _words[i] &= ~other._words[i];
+    }
+    return *this;
+}
+
+template<typename Enum, int NumFlags>
+inline FixedPropertyFlags<Enum, NumFlags>& FixedPropertyFlags<Enum, NumFlags>::operator^=(const FixedPropertyFlags& other) {
+    for (int i = 0; i < NUM_WORDS; i++) {
+        _words[i] ^= other._words[i];
+    }
+    return *this;
+}
+
+template<typename Enum, int NumFlags>
+inline FixedPropertyFlags<Enum, NumFlags> FixedPropertyFlags<Enum, NumFlags>::operator~() const {
+    FixedPropertyFlags result(*this);
+    for (int i = 0; i < NUM_WORDS; i++) {
+        result._words[i] = ~_words[i];
+    }
+    result.clearUnusedBits();
+    return result;
+}
+
+template<typename Enum, int NumFlags> inline void FixedPropertyFlags<Enum, NumFlags>::clearUnusedBits() {
+    if (NumFlags % BITS_PER_WORD) {
+        _words[NUM_WORDS - 1] &= ((Word)1 << (NumFlags % BITS_PER_WORD)) - 1;
+    }
+}
+
+template<typename Enum, int NumFlags> inline void FixedPropertyFlags<Enum, NumFlags>::debugDumpBits() {
+    qDebug() << "firstFlag=" << (int)firstFlag();
+    qDebug() << "lastFlag=" << (int)lastFlag();
+    QString bits;
+    for (int i = 0; i < NumFlags; i++) {
+        bits += (getHasProperty((Enum)i) ? "1" : "0");
+    }
+    qDebug() << "bits:" << bits;
+}
+
+template<typename Enum, int NumFlags>
+inline QByteArray& operator<<(QByteArray& out, FixedPropertyFlags<Enum, NumFlags>& value) {
+    return out = value;
+}
+
+template<typename Enum, int NumFlags>
+inline QByteArray& operator>>(QByteArray& in, FixedPropertyFlags<Enum, NumFlags>& value) {
+    value.decode(in);
+    return in;
+}
+
 #endif // hifi_PropertyFlags_h
 
@@ -16,6 +16,10 @@
 
 const float defaultAACubeSize = 1.0f;
 const int maxParentingChain = 30;
+const quint16 noParentJointIndex = 65535;
+
+thread_local quint64 SpatiallyNestable::_worldTransformCacheHits { 0 };
+thread_local quint64 SpatiallyNestable::_worldTransformCacheMisses { 0 };
 
 SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
     _nestableType(nestableType),
@@ -55,6 +59,7 @@ void SpatiallyNestable::setParentID(const QUuid& parentID) {
             _parentKnowsMe = false;
         }
     });
+    invalidateWorldTransforms();
 }
 
 Transform SpatiallyNestable::getParentTransform(bool& success, int depth) const {
@@ -106,6 +111,10 @@ SpatiallyNestablePointer SpatiallyNestable::getParentPointer(bool& success) cons
         return nullptr;
     }
     _parent = parentFinder->find(parentID, success);
+    if (_worldTransformHasParent) {
+        // our cached parent went away, and anything computed below us went with it
+        invalidateWorldTransforms();
+    }
     if (!success) {
         return nullptr;
     }
@@ -139,6 +148,7 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
     _parentJointIndex = parentJointIndex;
+    invalidateWorldTransforms();
 }
 
 glm::vec3 SpatiallyNestable::worldToLocal(const glm::vec3& position,
@@ -330,6 +340,7 @@ void SpatiallyNestable::setPosition(const glm::vec3& position, bool& success) {
     if (success) {
         locationChanged();
     } else {
+        invalidateWorldTransforms();
         qDebug() << "setPosition failed for" << getID();
     }
 }
@@ -379,6 +390,8 @@ void SpatiallyNestable::setOrientation(const glm::quat& orientation, bool& succe
     });
     if (success) {
         locationChanged();
+    } else {
+        invalidateWorldTransforms();
     }
 }
 
@@ -502,11 +515,42 @@ glm::vec3 SpatiallyNestable::getParentAngularVelocity(bool& success) const {
 
 const Transform SpatiallyNestable::getTransform(bool& success, int depth) const {
     Transform result;
+    quint32 version = _worldTransformVersion;
+    bool cacheHit = false;
+    _worldTransformLock.withReadLock([&] {
+        if (_worldTransformCachedVersion == version && !(_worldTransformHasParent && _parent.expired())) {
+            result = _worldTransform;
+            cacheHit = true;
+        }
+    });
+    if (cacheHit) {
+        _worldTransformCacheHits++;
+        success = true;
+        return result;
+    }
+    _worldTransformCacheMisses++;
+
     // return a world-space transform for this object's location
     Transform parentTransform = getParentTransform(success, depth);
     _transformLock.withReadLock([&] {
         Transform::mult(result, parentTransform, _transform);
     });
+
+    if (success) {
+        // the joints of a model entity can animate without calling locationChanged, so only cache transforms
+        // relative to avatar joints, which always do.
+        SpatiallyNestablePointer parent = _parent.lock();
+        if (!parent || _parentJointIndex == noParentJointIndex || parent->getNestableType() == NestableType::Avatar) {
+            _worldTransformLock.withWriteLock([&] {
+                // skip it if we moved while this was being computed
+                if (_worldTransformVersion == version) {
+                    _worldTransform = result;
+                    _worldTransformCachedVersion = version;
+                    _worldTransformHasParent = (bool)parent;
+                }
+            });
+        }
+    }
     return result;
 }
 
@@ -552,6 +596,8 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
     });
     if (success) {
         locationChanged();
+    } else {
+        invalidateWorldTransforms();
     }
 }
 
@@ -579,6 +625,7 @@ void SpatiallyNestable::setScale(const glm::vec3& scale) {
     _transformLock.withWriteLock([&] {
         _transform.setScale(scale);
     });
+    invalidateWorldTransforms();
     dimensionsChanged();
 }
 
@@ -689,6 +736,7 @@ void SpatiallyNestable::setLocalScale(const glm::vec3& scale) {
     _transformLock.withWriteLock([&] {
         _transform.setScale(scale);
     });
+    invalidateWorldTransforms();
     dimensionsChanged();
 }
 
@@ -751,7 +799,23 @@ void SpatiallyNestable::forEachDescendant(std::function<void(SpatiallyNestablePo
     }
 }
 
+void SpatiallyNestable::invalidateWorldTransforms(int depth) const {
+    _worldTransformVersion++;
+    if (depth > maxParentingChain) {
+        return;
+    }
+    foreach (SpatiallyNestablePointer child, getChildren()) {
+        child->invalidateWorldTransforms(depth + 1);
+    }
+}
+
+void SpatiallyNestable::resetWorldTransformCacheStats() {
+    _worldTransformCacheHits = 0;
+    _worldTransformCacheMisses = 0;
+}
+
 void SpatiallyNestable::locationChanged() {
+    _worldTransformVersion++;
     forEachChild([&](SpatiallyNestablePointer object) {
         object->locationChanged();
     });
@@ -12,6 +12,8 @@
 #ifndef hifi_SpatiallyNestable_h
 #define hifi_SpatiallyNestable_h
 
+#include <atomic>
+
 #include <QUuid>
 
 #include "Transform.h"
@@ -141,6 +143,12 @@ public:
 
     bool isParentIDValid() const { bool success = false; getParentPointer(success); return success; }
 
+    // getTransform(success) is cached until this object, its parent, or an ancestor moves.  These count
+    // how often the cache was used, across all objects, by the calling thread.
+    static quint64 getWorldTransformCacheHits() { return _worldTransformCacheHits; }
+    static quint64 getWorldTransformCacheMisses() { return _worldTransformCacheMisses; }
+    static void resetWorldTransformCacheStats();
+
 protected:
     const NestableType _nestableType; // EntityItem or an AvatarData
     QUuid _id;
@@ -157,6 +165,7 @@ protected:
     mutable QHash<QUuid, SpatiallyNestableWeakPointer> _children;
 
     virtual void locationChanged(); // called when a this object's location has changed
+    void invalidateWorldTransforms(int depth = 0) const; // forget the cached world transforms of this object and its descendants
     virtual void dimensionsChanged() { } // called when a this object's dimensions have changed
 
     // _queryAACube is used to decide where something lives in the octree
@@ -175,6 +184,17 @@ private:
     glm::vec3 _angularVelocity;
     mutable bool _parentKnowsMe { false };
     bool _isDead { false };
+
+    // the cache is valid while _worldTransformVersion matches the version it was computed at
+    mutable ReadWriteLockable _worldTransformLock;
+    mutable Transform _worldTransform;
+    mutable quint32 _worldTransformCachedVersion { 0 };
+    mutable bool _worldTransformHasParent { false };
+    mutable std::atomic<quint32> _worldTransformVersion { 1 };
+
+    // per thread, so that counting doesn't make every reader of every object contend for one cache line
+    static thread_local quint64 _worldTransformCacheHits;
+    static thread_local quint64 _worldTransformCacheMisses;
 };
 
 
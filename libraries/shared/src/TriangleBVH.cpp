@@ -0,0 +1,181 @@
+//
+//  TriangleBVH.cpp
+//  libraries/shared/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TriangleBVH.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+const int MAX_TRIANGLES_PER_LEAF = 4;
+
+// median splits keep the tree balanced, so this is far deeper than any tree we can build
+const int MAX_TRAVERSAL_DEPTH = 64;
+
+TriangleBVH::TriangleBVH(const std::vector<Triangle>& triangles) {
+    int numTriangles = (int)triangles.size();
+    if (numTriangles == 0) {
+        return;
+    }
+
+    std::vector<glm::vec3> centroids;
+    centroids.reserve(numTriangles);
+    std::vector<int> order;
+    order.reserve(numTriangles);
+    for (int i = 0; i < numTriangles; i++) {
+        const Triangle& triangle = triangles[i];
+        centroids.push_back((triangle.v0 + triangle.v1 + triangle.v2) / 3.0f);
+        order.push_back(i);
+    }
+
+    _nodes.reserve(2 * (numTriangles / MAX_TRIANGLES_PER_LEAF) + 1);
+    _nodes.push_back(Node());
+    buildNode(0, 0, numTriangles, triangles, order, centroids);
+
+    // store the triangles in leaf order, so each leaf reads a contiguous range
+    _triangles.reserve(numTriangles);
+    for (int index : order) {
+        _triangles.push_back(triangles[index]);
+    }
+}
+
+void TriangleBVH::buildNode(int nodeIndex, int first, int count, const std::vector<Triangle>& triangles,
+                            std::vector<int>& order, const std::vector<glm::vec3>& centroids) {
+    glm::vec3 minimum(std::numeric_limits<float>::max());
+    glm::vec3 maximum(-std::numeric_limits<float>::max());
+    glm::vec3 centroidMinimum = minimum;
+    glm::vec3 centroidMaximum = maximum;
+    for (int i = first; i < first + count; i++) {
+        const Triangle& triangle = triangles[order[i]];
+        minimum = glm::min(minimum, glm::min(triangle.v0, glm::min(triangle.v1, triangle.v2)));
+        maximum = glm::max(maximum, glm::max(triangle.v0, glm::max(triangle.v1, triangle.v2)));
+        centroidMinimum = glm::min(centroidMinimum, centroids[order[i]]);
+        centroidMaximum = glm::max(centroidMaximum, centroids[order[i]]);
+    }
+    _nodes[nodeIndex].minimum = minimum;
+    _nodes[nodeIndex].maximum = maximum;
+
+    glm::vec3 extent = centroidMaximum - centroidMinimum;
+    int axis = (extent.x > extent.y) ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+    if (count <= MAX_TRIANGLES_PER_LEAF || extent[axis] <= 0.0f) {
+        _nodes[nodeIndex].first = first;
+        _nodes[nodeIndex].count = count;
+        return;
+    }
+
+    int half = count / 2;
+    std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+        [&](int a, int b) { return centroids[a][axis] < centroids[b][axis]; });
+
+    // left child directly follows its parent
+    _nodes.push_back(Node());
+    buildNode(nodeIndex + 1, first, half, triangles, order, centroids);
+
+    int rightIndex = (int)_nodes.size();
+    _nodes.push_back(Node());
+    buildNode(rightIndex, first + half, count - half, triangles, order, centroids);
+
+    _nodes[nodeIndex].first = rightIndex;
+    _nodes[nodeIndex].count = 0;
+}
+
+// returns the distance along the ray at which it enters the box, or a value greater than maxDistance if it misses
+static inline float findRayEntry(const glm::vec3& minimum, const glm::vec3& maximum, const glm::vec3& origin,
+                                 const glm::vec3& inverseDirection, float maxDistance) {
+    glm::vec3 t0 = (minimum - origin) * inverseDirection;
+    glm::vec3 t1 = (maximum - origin) * inverseDirection;
+    glm::vec3 nearest = glm::min(t0, t1);
+    glm::vec3 farthest = glm::max(t0, t1);
+    float entry = std::max(std::max(nearest.x, nearest.y), std::max(nearest.z, 0.0f));
+    float exit = std::min(std::min(farthest.x, farthest.y), std::min(farthest.z, maxDistance));
+    return (entry <= exit) ? entry : std::numeric_limits<float>::max();
+}
+
+bool TriangleBVH::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
+                                      float& distance, int& triangleIndex) const {
+    if (_nodes.empty()) {
+        return false;
+    }
+
+    // avoid infinities (and the NaNs they make at box faces) for axis aligned rays
+    glm::vec3 inverseDirection;
+    for (int i = 0; i < 3; i++) {
+        const float MIN_DIRECTION = 1.0e-20f;
+        float component = (fabsf(direction[i]) < MIN_DIRECTION) ? std::copysign(MIN_DIRECTION, direction[i]) : direction[i];
+        inverseDirection[i] = 1.0f / component;
+    }
+
+    float bestDistance = std::numeric_limits<float>::max();
+    int bestTriangle = -1;
+    if (findRayEntry(_nodes[0].minimum, _nodes[0].maximum, origin, inverseDirection, bestDistance) >= bestDistance) {
+        return false;
+    }
+
+    int stack[MAX_TRAVERSAL_DEPTH];
+    int stackSize = 0;
+    int nodeIndex = 0;
+    while (true) {
+        const Node& node = _nodes[nodeIndex];
+        if (node.count > 0) {
+            for (int i = node.first; i < node.first + node.count; i++) {
+                float triangleDistance;
+                if (findRayTriangleIntersection(origin, direction, _triangles[i], triangleDistance) &&
+                        triangleDistance < bestDistance) {
+                    bestDistance = triangleDistance;
+                    bestTriangle = i;
+                }
+            }
+        } else {
+            // visit the nearer child first, and only remember the other if the ray enters it before our best hit
+            int left = nodeIndex + 1;
+            int right = node.first;
+            float leftEntry = findRayEntry(_nodes[left].minimum, _nodes[left].maximum, origin, inverseDirection, bestDistance);
+            float rightEntry = findRayEntry(_nodes[right].minimum, _nodes[right].maximum, origin, inverseDirection, bestDistance);
+            bool hitLeft = leftEntry < bestDistance;
+            bool hitRight = rightEntry < bestDistance;
+            if (hitLeft && hitRight) {
+                if (rightEntry < leftEntry) {
+                    std::swap(left, right);
+                }
+                stack[stackSize++] = right;
+                nodeIndex = left;
+                continue;
+            } else if (hitLeft) {
+                nodeIndex = left;
+                continue;
+            } else if (hitRight) {
+                nodeIndex = right;
+                continue;
+            }
+        }
+
+        // pop the next node the ray still enters before our best hit
+        bool found = false;
+        while (stackSize > 0 && !found) {
+            nodeIndex = stack[--stackSize];
+            const Node& next = _nodes[nodeIndex];
+            found = findRayEntry(next.minimum, next.maximum, origin, inverseDirection, bestDistance) < bestDistance;
+        }
+        if (!found) {
+            break;
+        }
+    }
+
+    if (bestTriangle < 0) {
+        return false;
+    }
+    distance = bestDistance;
+    triangleIndex = bestTriangle;
+    return true;
+}
+
+size_t TriangleBVH::getMemoryUsage() const {
+    return _nodes.capacity() * sizeof(Node) + _triangles.capacity() * sizeof(Triangle);
+}
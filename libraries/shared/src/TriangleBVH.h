@@ -0,0 +1,52 @@
+//
+//  TriangleBVH.h
+//  libraries/shared/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TriangleBVH_h
+#define hifi_TriangleBVH_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "GeometryUtil.h"
+
+// Immutable bounding volume hierarchy over a triangle soup, for ray picking against high-poly meshes.
+// Nodes are split at the median centroid along their longest axis, and stored depth first.
+class TriangleBVH {
+public:
+    TriangleBVH() {}
+    explicit TriangleBVH(const std::vector<Triangle>& triangles);
+
+    // finds the closest front facing triangle hit by the ray, with the same culling and distance semantics as
+    // findRayTriangleIntersection.  triangleIndex refers to getTriangles(), which is not in the original order.
+    bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, float& distance, int& triangleIndex) const;
+
+    const std::vector<Triangle>& getTriangles() const { return _triangles; }
+    int getNodeCount() const { return (int)_nodes.size(); }
+    size_t getMemoryUsage() const;
+
+private:
+    // leaves have count > 0 and hold triangles [first, first + count)
+    // interior nodes have count == 0, their left child follows them and their right child is at first
+    struct Node {
+        glm::vec3 minimum;
+        int first;
+        glm::vec3 maximum;
+        int count;
+    };
+
+    void buildNode(int nodeIndex, int first, int count, const std::vector<Triangle>& triangles,
+                   std::vector<int>& order, const std::vector<glm::vec3>& centroids);
+
+    std::vector<Node> _nodes;
+    std::vector<Triangle> _triangles;
+};
+
+#endif // hifi_TriangleBVH_h
@@ -0,0 +1,195 @@
+//
+//  AnimPoseBufferTests.cpp
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBufferTests.h"
+
+#include <AnimPoseBuffer.h>
+#include <AnimSkeleton.h>
+#include <AnimUtil.h>
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include "TestSkeleton.h"
+#include "../QTestExtensions.h"
+
+QTEST_MAIN(AnimPoseBufferTests)
+
+const float EPSILON = 0.001f;
+const int NUM_BENCHMARK_ITERATIONS = 10000;
+
+static AnimPoseVec makeTestPoses(const AnimSkeleton& skeleton, float phase) {
+    AnimPoseVec poses = skeleton.getRelativeDefaultPoses();
+    for (int i = 0; i < (int)poses.size(); i++) {
+        float angle = phase + 0.1f * (float)i;
+        poses[i].rot = glm::normalize(poses[i].rot * glm::angleAxis(angle, glm::normalize(glm::vec3(0.3f, 1.0f, -0.2f))));
+    }
+    return poses;
+}
+
+static void comparePoses(const AnimPoseVec& actual, const AnimPoseVec& expected) {
+    QCOMPARE(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); i++) {
+        QCOMPARE_WITH_ABS_ERROR(actual[i].scale, expected[i].scale, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(actual[i].rot, expected[i].rot, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(actual[i].trans, expected[i].trans, EPSILON);
+    }
+}
+
+void AnimPoseBufferTests::testCompose() {
+    AnimPose a(glm::vec3(2.0f), glm::angleAxis(PI / 3.0f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f))), glm::vec3(1.0f, -2.0f, 3.0f));
+    AnimPose b(glm::vec3(1.0f, 0.5f, 1.5f), glm::angleAxis(PI / 5.0f, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(-4.0f, 5.0f, 6.0f));
+
+    // uniform scale on the left uses the quaternion path, compare it against the matrix product.
+    glm::mat4 expected = static_cast<glm::mat4>(a) * static_cast<glm::mat4>(b);
+    QCOMPARE_WITH_ABS_ERROR(static_cast<glm::mat4>(a * b), expected, EPSILON);
+
+    // non-uniform scale on the left falls back to matrices.
+    AnimPose c = b * a;
+    AnimPose expectedC(static_cast<glm::mat4>(b) * static_cast<glm::mat4>(a));
+    QCOMPARE_WITH_ABS_ERROR(c.scale, expectedC.scale, EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(c.rot, expectedC.rot, EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(c.trans, expectedC.trans, EPSILON);
+}
+
+void AnimPoseBufferTests::testInverse() {
+    AnimPose a(glm::vec3(0.5f), glm::angleAxis(PI / 3.0f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f))), glm::vec3(1.0f, -2.0f, 3.0f));
+    QCOMPARE_WITH_ABS_ERROR(static_cast<glm::mat4>(a.inverse()), glm::inverse(static_cast<glm::mat4>(a)), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(static_cast<glm::mat4>(a.inverse() * a), glm::mat4(), EPSILON);
+}
+
+void AnimPoseBufferTests::testBlend() {
+    AnimSkeleton skeleton(makeHumanoidTestJoints());
+    AnimPoseVec a = makeTestPoses(skeleton, 0.0f);
+    AnimPoseVec b = makeTestPoses(skeleton, 2.5f);
+
+    const float ALPHA = 0.3f;
+    AnimPoseVec expected(a.size());
+    ::blend(a.size(), &a[0], &b[0], ALPHA, &expected[0]);
+
+    AnimPoseBuffer result;
+    ::blend(AnimPoseBuffer(a), AnimPoseBuffer(b), ALPHA, result);
+    AnimPoseVec actual;
+    result.store(actual);
+
+    comparePoses(actual, expected);
+}
+
+void AnimPoseBufferTests::testConvertRelativeToAbsolute() {
+    AnimSkeleton skeleton(makeHumanoidTestJoints());
+    QCOMPARE(skeleton.getNumJoints(), 60);
+
+    AnimPoseVec expected = makeTestPoses(skeleton, 1.0f);
+    AnimPoseBuffer buffer(expected);
+    skeleton.convertRelativePosesToAbsolute(expected);
+    skeleton.convertRelativePosesToAbsolute(buffer);
+
+    AnimPoseVec actual;
+    buffer.store(actual);
+    comparePoses(actual, expected);
+}
+
+void AnimPoseBufferTests::testConvertAbsoluteToRelative() {
+    AnimSkeleton skeleton(makeHumanoidTestJoints());
+
+    AnimPoseVec relativePoses = makeTestPoses(skeleton, 1.0f);
+    AnimPoseBuffer buffer(relativePoses);
+    skeleton.convertRelativePosesToAbsolute(buffer);
+    skeleton.convertAbsolutePosesToRelative(buffer);
+
+    AnimPoseVec actual;
+    buffer.store(actual);
+    comparePoses(actual, relativePoses);
+}
+
+void AnimPoseBufferTests::testMirror() {
+    AnimSkeleton skeleton(makeHumanoidTestJoints());
+
+    AnimPoseVec expected = makeTestPoses(skeleton, 0.5f);
+    AnimPoseBuffer buffer(expected);
+    skeleton.mirrorRelativePoses(expected);
+    skeleton.mirrorRelativePoses(buffer);
+
+    AnimPoseVec actual;
+    buffer.store(actual);
+    comparePoses(actual, expected);
+}
+
+void AnimPoseBufferTests::benchmarkBlend() {
+    AnimSkeleton skeleton(makeHumanoidTestJoints());
+    AnimPoseVec a = makeTestPoses(skeleton, 0.0f);
+    AnimPoseVec b = makeTestPoses(skeleton, 2.5f);
+    AnimPoseVec result(a.size());
+
+    quint64 start = usecTimestampNow();
+    for (int i = 0; i < NUM_BENCHMARK_ITERATIONS; i++) {
+        ::blend(a.size(), &a[0], &b[0], (float)i / NUM_BENCHMARK_ITERATIONS, &result[0]);
+    }
+    quint64 aosTime = usecTimestampNow() - start;
+
+    AnimPoseBuffer aBuffer(a);
+    AnimPoseBuffer bBuffer(b);
+    AnimPoseBuffer resultBuffer(a.size());
+
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_BENCHMARK_ITERATIONS; i++) {
+        ::blend(aBuffer, bBuffer, (float)i / NUM_BENCHMARK_ITERATIONS, resultBuffer);
+    }
+    quint64 soaTime = usecTimestampNow() - start;
+
+    qDebug() << "blend" << skeleton.getNumJoints() << "joints x" << NUM_BENCHMARK_ITERATIONS
+             << ": AnimPoseVec" << aosTime << "usecs, AnimPoseBuffer" << soaTime << "usecs";
+}
+
+void AnimPoseBufferTests::benchmarkConvertRelativeToAbsolute() {
+    AnimSkeleton skeleton(makeHumanoidTestJoints());
+    AnimPoseVec relativePoses = makeTestPoses(skeleton, 1.0f);
+
+    AnimPoseVec poses;
+    quint64 start = usecTimestampNow();
+    for (int i = 0; i < NUM_BENCHMARK_ITERATIONS; i++) {
+        poses = relativePoses;
+        skeleton.convertRelativePosesToAbsolute(poses);
+    }
+    quint64 aosTime = usecTimestampNow() - start;
+
+    AnimPoseBuffer relativeBuffer(relativePoses);
+    AnimPoseBuffer buffer;
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_BENCHMARK_ITERATIONS; i++) {
+        buffer = relativeBuffer;
+        skeleton.convertRelativePosesToAbsolute(buffer);
+    }
+    quint64 soaTime = usecTimestampNow() - start;
+
+    qDebug() << "convertRelativePosesToAbsolute" << skeleton.getNumJoints() << "joints x" << NUM_BENCHMARK_ITERATIONS
+             << ": AnimPoseVec" << aosTime << "usecs, AnimPoseBuffer" << soaTime << "usecs";
+}
+
+void AnimPoseBufferTests::benchmarkMirror() {
+    AnimSkeleton skeleton(makeHumanoidTestJoints());
+    AnimPoseVec relativePoses = makeTestPoses(skeleton, 1.0f);
+
+    AnimPoseVec poses = relativePoses;
+    quint64 start = usecTimestampNow();
+    for (int i = 0; i < NUM_BENCHMARK_ITERATIONS; i++) {
+        skeleton.mirrorRelativePoses(poses);
+    }
+    quint64 aosTime = usecTimestampNow() - start;
+
+    AnimPoseBuffer buffer(relativePoses);
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_BENCHMARK_ITERATIONS; i++) {
+        skeleton.mirrorRelativePoses(buffer);
+    }
+    quint64 soaTime = usecTimestampNow() - start;
+
+    qDebug() << "mirrorRelativePoses" << skeleton.getNumJoints() << "joints x" << NUM_BENCHMARK_ITERATIONS
+             << ": AnimPoseVec" << aosTime << "usecs, AnimPoseBuffer" << soaTime << "usecs";
+}
@@ -0,0 +1,30 @@
+//
+//  AnimPoseBufferTests.h
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBufferTests_h
+#define hifi_AnimPoseBufferTests_h
+
+#include <QtTest/QtTest>
+#include <glm/glm.hpp>
+
+class AnimPoseBufferTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testCompose();
+    void testInverse();
+    void testBlend();
+    void testConvertRelativeToAbsolute();
+    void testConvertAbsoluteToRelative();
+    void testMirror();
+    void benchmarkBlend();
+    void benchmarkConvertRelativeToAbsolute();
+    void benchmarkMirror();
+};
+
+#endif // hifi_AnimPoseBufferTests_h
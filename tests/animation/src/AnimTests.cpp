@@ -15,6 +15,7 @@
 #include <AnimVariant.h>
 #include <AnimExpression.h>
 #include <AnimUtil.h>
+#include <AnimClipData.h>
 
 #include <../QTestExtensions.h>
 
@@ -422,6 +423,39 @@ void AnimTests::testAnimPose() {
     }
 }
 
+void AnimTests::testClipDataCompression() {
+    const int NUM_FRAMES = 300;
+    const int NUM_JOINTS = 3;
+    const float EPSILON = 0.005f;
+
+    // joint 0 is static, joint 1 rotates at a constant rate and joint 2 moves along a curve.
+    std::vector<AnimPoseVec> frames(NUM_FRAMES);
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        float t = (float)i / (float)NUM_FRAMES;
+        frames[i].push_back(AnimPose(glm::vec3(1.0f), glm::quat(), glm::vec3(0.0f, 1.0f, 0.0f)));
+        frames[i].push_back(AnimPose(glm::vec3(1.0f), glm::angleAxis(t, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(0.1f, 0.0f, 0.0f)));
+        frames[i].push_back(AnimPose(glm::vec3(1.0f), glm::quat(), glm::vec3(sinf(10.0f * t), cosf(7.0f * t), 0.0f)));
+    }
+
+    AnimClipData clipData(frames, NUM_JOINTS);
+    QCOMPARE(clipData.getFrameCount(), NUM_FRAMES);
+    QCOMPARE(clipData.getJointCount(), NUM_JOINTS);
+
+    // compressed clip should be much smaller than the expanded frames.
+    size_t rawSize = NUM_FRAMES * NUM_JOINTS * sizeof(AnimPose);
+    QVERIFY(clipData.getMemoryUsage() < rawSize / 2);
+
+    AnimPoseVec poses(NUM_JOINTS);
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        clipData.sampleFrame(i, poses);
+        for (int j = 0; j < NUM_JOINTS; j++) {
+            QCOMPARE_WITH_ABS_ERROR(poses[j].scale, frames[i][j].scale, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(poses[j].rot, frames[i][j].rot, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(poses[j].trans, frames[i][j].trans, EPSILON);
+        }
+    }
+}
+
 void AnimTests::testExpressionTokenizer() {
     QString str = "(10 +  x) >= 20.1 && (y != !z)";
     AnimExpression e("x");
@@ -27,6 +27,7 @@ private slots:
     void testVariant();
     void testAccumulateTime();
     void testAnimPose();
+    void testClipDataCompression();
     void testExpressionTokenizer();
     void testExpressionParser();
     void testExpressionEvaluator();
@@ -0,0 +1,184 @@
+//
+//  BlendshapeEngineTests.cpp
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BlendshapeEngineTests.h"
+
+#include <BlendshapeEngine.h>
+#include <SharedUtil.h>
+
+#include <../GLMTestUtils.h>
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(BlendshapeEngineTests)
+
+const float EPSILON = 0.00001f;
+
+// a face-like model: a head mesh with the blendshapes, around a mesh without any
+static QVector<FBXMesh> makeTestMeshes(int numVertices, int numBlendshapes, float density) {
+    QVector<FBXMesh> meshes;
+    FBXMesh unblended;
+    unblended.vertices.fill(glm::vec3(1.0f), 100);
+    unblended.normals.fill(glm::vec3(0.0f, 1.0f, 0.0f), 100);
+    meshes.push_back(unblended);
+
+    FBXMesh face;
+    for (int i = 0; i < numVertices; i++) {
+        face.vertices.push_back(glm::vec3(randFloat(), randFloat(), randFloat()));
+        face.normals.push_back(glm::normalize(glm::vec3(randFloat(), 1.0f, randFloat())));
+    }
+    for (int i = 0; i < numBlendshapes; i++) {
+        FBXBlendshape blendshape;
+        for (int j = 0; j < numVertices; j++) {
+            // always include the last vertex, to exercise the end of the buffers
+            if (randFloat() < density || j == numVertices - 1) {
+                blendshape.indices.push_back(j);
+                blendshape.vertices.push_back(glm::vec3(randFloatInRange(-0.1f, 0.1f), randFloatInRange(-0.1f, 0.1f),
+                                                        randFloatInRange(-0.1f, 0.1f)));
+                blendshape.normals.push_back(glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f),
+                                                       randFloatInRange(-1.0f, 1.0f)));
+            }
+        }
+        face.blendshapes.push_back(blendshape);
+    }
+    meshes.push_back(face);
+    return meshes;
+}
+
+// the blend the Blender job did before BlendshapeEngine
+static void referenceBlend(const QVector<FBXMesh>& meshes, const QVector<float>& coefficients,
+                           QVector<glm::vec3>& vertices, QVector<glm::vec3>& normals) {
+    vertices.clear();
+    normals.clear();
+    int offset = 0;
+    foreach (const FBXMesh& mesh, meshes) {
+        if (mesh.blendshapes.isEmpty()) {
+            continue;
+        }
+        vertices += mesh.vertices;
+        normals += mesh.normals;
+        glm::vec3* meshVertices = vertices.data() + offset;
+        glm::vec3* meshNormals = normals.data() + offset;
+        offset += mesh.vertices.size();
+        for (int i = 0, n = qMin(coefficients.size(), mesh.blendshapes.size()); i < n; i++) {
+            float vertexCoefficient = coefficients.at(i);
+            if (vertexCoefficient < BlendshapeEngine::COEFFICIENT_EPSILON) {
+                continue;
+            }
+            float normalCoefficient = vertexCoefficient * BlendshapeEngine::NORMAL_COEFFICIENT_SCALE;
+            const FBXBlendshape& blendshape = mesh.blendshapes.at(i);
+            for (int j = 0; j < blendshape.indices.size(); j++) {
+                int index = blendshape.indices.at(j);
+                meshVertices[index] += blendshape.vertices.at(j) * vertexCoefficient;
+                meshNormals[index] += blendshape.normals.at(j) * normalCoefficient;
+            }
+        }
+    }
+}
+
+// changes a few coefficients per frame, the way facial animation data arrives
+static void animateCoefficients(QVector<float>& coefficients, int numChanges) {
+    for (int i = 0; i < numChanges; i++) {
+        int index = randIntInRange(0, coefficients.size() - 1);
+        float value = randFloat();
+        if (value < 0.2f) {
+            // zero, negative and below epsilon values are all ignored
+            value = randFloatInRange(-0.1f, BlendshapeEngine::COEFFICIENT_EPSILON);
+        }
+        coefficients[index] = value;
+    }
+}
+
+void BlendshapeEngineTests::testMatchesFullBlend() {
+    const int NUM_BLENDSHAPES = 20;
+    auto meshes = makeTestMeshes(500, NUM_BLENDSHAPES, 0.2f);
+    BlendshapeEngine engine(meshes);
+    QCOMPARE(engine.getNumVertices(), 500);
+    QCOMPARE(engine.getNumBlendshapes(), NUM_BLENDSHAPES);
+
+    // fewer coefficients than blendshapes
+    QVector<float> coefficients(NUM_BLENDSHAPES - 2, 0.0f);
+
+    // enough blends to go through the periodic rebuild of both buffers
+    QVector<glm::vec3> expectedVertices, expectedNormals;
+    QVector<glm::vec3> vertices, normals;
+    for (int frame = 0; frame < BlendshapeEngine::MAX_INCREMENTAL_BLENDS * 2 + 10; frame++) {
+        animateCoefficients(coefficients, 5);
+        referenceBlend(meshes, coefficients, expectedVertices, expectedNormals);
+        engine.blend(coefficients, vertices, normals);
+
+        QVERIFY(vertices.size() >= expectedVertices.size());
+        QVERIFY(normals.size() >= expectedNormals.size());
+        for (int i = 0; i < expectedVertices.size(); i++) {
+            QCOMPARE_WITH_ABS_ERROR(vertices.at(i), expectedVertices.at(i), EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(normals.at(i), expectedNormals.at(i), EPSILON);
+        }
+    }
+}
+
+void BlendshapeEngineTests::testSkipsUnchangedCoefficients() {
+    const int NUM_BLENDSHAPES = 10;
+    auto meshes = makeTestMeshes(100, NUM_BLENDSHAPES, 0.5f);
+    BlendshapeEngine engine(meshes);
+
+    QVector<float> coefficients(NUM_BLENDSHAPES, 0.0f);
+    coefficients[3] = 0.5f;
+    coefficients[7] = 0.25f;
+
+    QVector<glm::vec3> vertices, normals;
+    engine.blend(coefficients, vertices, normals);
+    QCOMPARE(engine.getLastNumBlendshapesApplied(), 2);
+    engine.blend(coefficients, vertices, normals);
+    QCOMPARE(engine.getLastNumBlendshapesApplied(), 2);
+
+    // both buffers are now up to date
+    engine.blend(coefficients, vertices, normals);
+    QCOMPARE(engine.getLastNumBlendshapesApplied(), 0);
+    QCOMPARE(engine.getLastNumDeltasApplied(), 0);
+
+    coefficients[3] = 0.0f;
+    engine.blend(coefficients, vertices, normals);
+    QCOMPARE(engine.getLastNumBlendshapesApplied(), 1);
+    QCOMPARE(engine.getLastNumDeltasApplied(), meshes.at(1).blendshapes.at(3).indices.size());
+}
+
+void BlendshapeEngineTests::benchmarkBlend() {
+    const int NUM_VERTICES = 5000;
+    const int NUM_BLENDSHAPES = 50;
+    const int NUM_FRAMES = 1000;
+    const int NUM_CHANGES_PER_FRAME = 10;
+    auto meshes = makeTestMeshes(NUM_VERTICES, NUM_BLENDSHAPES, 0.1f);
+
+    QVector<float> coefficients(NUM_BLENDSHAPES, 0.0f);
+    std::vector<QVector<float>> frames;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        animateCoefficients(coefficients, NUM_CHANGES_PER_FRAME);
+        frames.push_back(coefficients);
+    }
+
+    QVector<glm::vec3> vertices, normals;
+    quint64 start = usecTimestampNow();
+    for (const auto& frameCoefficients : frames) {
+        referenceBlend(meshes, frameCoefficients, vertices, normals);
+    }
+    quint64 referenceTime = usecTimestampNow() - start;
+
+    BlendshapeEngine engine(meshes);
+    vertices.clear();
+    normals.clear();
+    start = usecTimestampNow();
+    for (const auto& frameCoefficients : frames) {
+        engine.blend(frameCoefficients, vertices, normals);
+    }
+    quint64 engineTime = usecTimestampNow() - start;
+
+    qDebug() << NUM_VERTICES << "vertices x" << NUM_BLENDSHAPES << "blendshapes," << NUM_CHANGES_PER_FRAME
+             << "changes per frame, usecs per blend: full" << ((float)referenceTime / NUM_FRAMES)
+             << ", BlendshapeEngine" << ((float)engineTime / NUM_FRAMES)
+             << ", engine memory" << engine.getMemoryUsage() << "bytes";
+}
@@ -0,0 +1,24 @@
+//
+//  BlendshapeEngineTests.h
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BlendshapeEngineTests_h
+#define hifi_BlendshapeEngineTests_h
+
+#include <QtTest/QtTest>
+#include <glm/glm.hpp>
+
+class BlendshapeEngineTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testMatchesFullBlend();
+    void testSkipsUnchangedCoefficients();
+    void benchmarkBlend();
+};
+
+#endif // hifi_BlendshapeEngineTests_h
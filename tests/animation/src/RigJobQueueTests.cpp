@@ -0,0 +1,109 @@
+//
+//  RigJobQueueTests.cpp
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RigJobQueueTests.h"
+
+#include <RigJobQueue.h>
+#include <SharedUtil.h>
+
+#include "TestSkeleton.h"
+#include "../QTestExtensions.h"
+
+QTEST_MAIN(RigJobQueueTests)
+
+const float EPSILON = 0.001f;
+const float DELTA_TIME = 1.0f / 60.0f;
+
+static std::vector<RigPointer> makeTestRigs(int numRigs) {
+    FBXGeometry geometry;
+    for (auto& joint : makeHumanoidTestJoints()) {
+        geometry.joints.push_back(joint);
+    }
+    geometry.rootJointIndex = 0;
+
+    std::vector<RigPointer> rigs;
+    for (int i = 0; i < numRigs; i++) {
+        auto rig = std::make_shared<Rig>();
+        rig->initJointStates(geometry, glm::mat4());
+        rigs.push_back(rig);
+    }
+    return rigs;
+}
+
+// simulate joint data arriving from the avatar mixer, different for every rig and frame.
+static void animateTestRigs(const std::vector<RigPointer>& rigs, int frame) {
+    QVector<JointData> jointData(rigs.front()->getJointStateCount());
+    for (int i = 0; i < (int)rigs.size(); i++) {
+        for (int j = 0; j < jointData.size(); j++) {
+            float angle = 0.01f * (float)(frame + i + j);
+            jointData[j].rotation = glm::angleAxis(angle, glm::normalize(glm::vec3(1.0f, (float)(j % 3), 0.5f)));
+            jointData[j].rotationSet = true;
+        }
+        rigs[i]->copyJointsFromJointData(jointData);
+    }
+}
+
+void RigJobQueueTests::testMatchesSerialEvaluation() {
+    const int NUM_RIGS = 16;
+    auto serialRigs = makeTestRigs(NUM_RIGS);
+    auto parallelRigs = makeTestRigs(NUM_RIGS);
+
+    animateTestRigs(serialRigs, 1);
+    animateTestRigs(parallelRigs, 1);
+
+    RigJobQueue queue;
+    for (int i = 0; i < NUM_RIGS; i++) {
+        serialRigs[i]->updateAnimations(DELTA_TIME, glm::mat4());
+        queue.push(parallelRigs[i], DELTA_TIME, glm::mat4());
+    }
+    QCOMPARE(queue.getNumQueued(), NUM_RIGS);
+    queue.evaluate();
+    QCOMPARE(queue.getNumQueued(), 0);
+    QCOMPARE(queue.getLastNumEvaluated(), NUM_RIGS);
+
+    for (int i = 0; i < NUM_RIGS; i++) {
+        for (int j = 0; j < serialRigs[i]->getJointStateCount(); j++) {
+            QCOMPARE_WITH_ABS_ERROR(parallelRigs[i]->getJointTransform(j), serialRigs[i]->getJointTransform(j), EPSILON);
+        }
+    }
+}
+
+void RigJobQueueTests::benchmarkEvaluate() {
+    const int NUM_FRAMES = 200;
+    RigJobQueue queue;
+
+    for (int numRigs : { 10, 100, 200 }) {
+        auto rigs = makeTestRigs(numRigs);
+
+        quint64 serialTime = 0;
+        for (int frame = 0; frame < NUM_FRAMES; frame++) {
+            animateTestRigs(rigs, frame);
+            quint64 start = usecTimestampNow();
+            for (auto& rig : rigs) {
+                rig->updateAnimations(DELTA_TIME, glm::mat4());
+            }
+            serialTime += usecTimestampNow() - start;
+        }
+
+        quint64 parallelTime = 0;
+        for (int frame = 0; frame < NUM_FRAMES; frame++) {
+            animateTestRigs(rigs, frame);
+            quint64 start = usecTimestampNow();
+            for (auto& rig : rigs) {
+                queue.push(rig, DELTA_TIME, glm::mat4());
+            }
+            queue.evaluate();
+            parallelTime += usecTimestampNow() - start;
+        }
+
+        qDebug() << numRigs << "rigs x" << rigs.front()->getJointStateCount() << "joints, usecs per frame: serial"
+                 << (serialTime / NUM_FRAMES) << ", RigJobQueue with" << queue.getNumThreads() << "workers"
+                 << (parallelTime / NUM_FRAMES);
+    }
+}
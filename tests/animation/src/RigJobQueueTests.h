@@ -0,0 +1,23 @@
+//
+//  RigJobQueueTests.h
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RigJobQueueTests_h
+#define hifi_RigJobQueueTests_h
+
+#include <QtTest/QtTest>
+#include <glm/glm.hpp>
+
+class RigJobQueueTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testMatchesSerialEvaluation();
+    void benchmarkEvaluate();
+};
+
+#endif // hifi_RigJobQueueTests_h
@@ -0,0 +1,80 @@
+//
+//  TestSkeleton.h
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TestSkeleton_h
+#define hifi_TestSkeleton_h
+
+#include <vector>
+
+#include <glm/gtx/transform.hpp>
+
+#include <FBXReader.h>
+#include <NumericalConstants.h>
+
+// builds a 60 joint humanoid hierarchy, with the same joint names and left/right pairing as a typical avatar.
+inline std::vector<FBXJoint> makeHumanoidTestJoints() {
+    std::vector<FBXJoint> joints;
+
+    auto addJoint = [&](const QString& name, int parentIndex, const glm::vec3& translation) -> int {
+        FBXJoint joint;
+        joint.isFree = false;
+        joint.parentIndex = parentIndex;
+        joint.distanceToParent = glm::length(translation);
+        joint.translation = translation;
+        joint.preTransform = glm::mat4();
+        joint.preRotation = glm::quat();
+        // give every joint a small, distinct rotation so the math is not trivially identity.
+        joint.rotation = glm::angleAxis(0.05f * (float)(joints.size() % 7), glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f)));
+        joint.postRotation = glm::quat();
+        joint.postTransform = glm::mat4();
+        joint.rotationMin = glm::vec3(-PI);
+        joint.rotationMax = glm::vec3(PI);
+        joint.inverseDefaultRotation = glm::quat();
+        joint.inverseBindRotation = glm::quat();
+        joint.bindTransformFoundInCluster = false;
+        joint.name = name;
+        joint.isSkeletonJoint = true;
+        joints.push_back(joint);
+        return (int)joints.size() - 1;
+    };
+
+    int hips = addJoint("Hips", -1, glm::vec3(0.0f, 1.0f, 0.0f));
+    int spine = addJoint("Spine", hips, glm::vec3(0.0f, 0.1f, 0.0f));
+    int spine1 = addJoint("Spine1", spine, glm::vec3(0.0f, 0.1f, 0.0f));
+    int spine2 = addJoint("Spine2", spine1, glm::vec3(0.0f, 0.1f, 0.0f));
+    int neck = addJoint("Neck", spine2, glm::vec3(0.0f, 0.15f, 0.0f));
+    addJoint("Head", neck, glm::vec3(0.0f, 0.1f, 0.0f));
+
+    const QString FINGERS[] = { "Thumb", "Index", "Middle", "Ring", "Pinky" };
+    for (auto side : { QString("Left"), QString("Right") }) {
+        float sign = (side == "Left") ? 1.0f : -1.0f;
+
+        int upLeg = addJoint(side + "UpLeg", hips, glm::vec3(sign * 0.1f, 0.0f, 0.0f));
+        int leg = addJoint(side + "Leg", upLeg, glm::vec3(0.0f, -0.45f, 0.0f));
+        int foot = addJoint(side + "Foot", leg, glm::vec3(0.0f, -0.45f, 0.0f));
+        addJoint(side + "ToeBase", foot, glm::vec3(0.0f, -0.05f, 0.1f));
+
+        int shoulder = addJoint(side + "Shoulder", spine2, glm::vec3(sign * 0.05f, 0.1f, 0.0f));
+        int arm = addJoint(side + "Arm", shoulder, glm::vec3(sign * 0.1f, 0.0f, 0.0f));
+        int foreArm = addJoint(side + "ForeArm", arm, glm::vec3(sign * 0.3f, 0.0f, 0.0f));
+        int hand = addJoint(side + "Hand", foreArm, glm::vec3(sign * 0.25f, 0.0f, 0.0f));
+
+        for (auto& finger : FINGERS) {
+            int numKnuckles = (finger == "Thumb") ? 3 : 4;
+            int parent = hand;
+            for (int k = 1; k <= numKnuckles; k++) {
+                parent = addJoint(side + "Hand" + finger + QString::number(k), parent, glm::vec3(sign * 0.03f, 0.0f, 0.0f));
+            }
+        }
+    }
+
+    return joints;
+}
+
+#endif // hifi_TestSkeleton_h
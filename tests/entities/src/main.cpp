@@ -8,6 +8,10 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
 #include <QCoreApplication>
 #include <QFile>
 #include <QTimer>
@@ -18,8 +22,28 @@
 
 #include <BoxEntityItem.h>
 #include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <NodeList.h>
 #include <Octree.h>
+#include <OctreePacketData.h>
 #include <PathUtils.h>
+#include <ServerPhysicalEntitySimulation.h>
+
+// every heap allocation made by the test is counted
+static std::atomic<size_t> allocationCount { 0 };
+
+void* operator new(size_t size) {
+    allocationCount++;
+    void* result = malloc(size);
+    if (!result) {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void operator delete(void* pointer) noexcept {
+    free(pointer);
+}
 
 const QString& getTestResourceDir() {
     static QString dir;
@@ -135,6 +159,137 @@ void testPropertyFlags() {
     testPropertyFlags(0xFFFF);
 }
 
+// the property flag work appendEntityData() does for each entity, with the dynamic flags it used to use
+int encodeDynamicFlags(const PropertyFlags<EntityPropertyList>& entityProperties) {
+    PropertyFlags<EntityPropertyList> propertyFlags(PROP_LAST_ITEM);
+    PropertyFlags<EntityPropertyList> requestedProperties = entityProperties;
+    PropertyFlags<EntityPropertyList> propertiesDidntFit = requestedProperties;
+    QByteArray encoded = propertyFlags;
+    propertyFlags -= PROP_LAST_ITEM;
+    for (int i = 0; i < PROP_LAST_ITEM; i++) {
+        if (requestedProperties.getHasProperty((EntityPropertyList)i)) {
+            propertyFlags |= (EntityPropertyList)i;
+            propertiesDidntFit -= (EntityPropertyList)i;
+        }
+    }
+    encoded = propertyFlags;
+    return encoded.size();
+}
+
+// and with the fixed width ones it uses now
+int encodeFixedFlags(const EntityPropertyFlags& entityProperties) {
+    EntityPropertyFlags propertyFlags(PROP_LAST_ITEM);
+    EntityPropertyFlags requestedProperties = entityProperties;
+    EntityPropertyFlags propertiesDidntFit = requestedProperties;
+    uint8_t encoded[EntityPropertyFlags::MAX_ENCODED_LENGTH];
+    propertyFlags.encode(encoded);
+    propertyFlags -= PROP_LAST_ITEM;
+    for (int i = 0; i < PROP_LAST_ITEM; i++) {
+        if (requestedProperties.getHasProperty((EntityPropertyList)i)) {
+            propertyFlags |= (EntityPropertyList)i;
+            propertiesDidntFit -= (EntityPropertyList)i;
+        }
+    }
+    return propertyFlags.encode(encoded);
+}
+
+void benchmarkPropertyFlagsEncode() {
+    const int NUM_ENCODES = 100000;
+
+    PropertyFlags<EntityPropertyList> dynamicProperties;
+    EntityPropertyFlags fixedProperties;
+    for (int i = PROP_VISIBLE; i < PROP_LAST_ITEM; i += 3) {
+        dynamicProperties += (EntityPropertyList)i;
+        fixedProperties += (EntityPropertyList)i;
+    }
+    QByteArray dynamicEncoded = dynamicProperties;
+    QByteArray fixedEncoded = fixedProperties;
+    Q_ASSERT(dynamicEncoded == fixedEncoded);
+
+    int encodedSize = 0;
+    size_t allocationsBefore = allocationCount;
+    auto start = usecTimestampNow();
+    for (int i = 0; i < NUM_ENCODES; ++i) {
+        encodedSize += encodeDynamicFlags(dynamicProperties);
+    }
+    auto dynamicDuration = usecTimestampNow() - start;
+    size_t dynamicAllocations = allocationCount - allocationsBefore;
+
+    allocationsBefore = allocationCount;
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_ENCODES; ++i) {
+        encodedSize -= encodeFixedFlags(fixedProperties);
+    }
+    auto fixedDuration = usecTimestampNow() - start;
+    size_t fixedAllocations = allocationCount - allocationsBefore;
+    Q_ASSERT(encodedSize == 0);
+
+    qDebug() << "property flags per entity: PropertyFlags" << ((float)dynamicDuration / NUM_ENCODES) << "usecs,"
+             << ((float)dynamicAllocations / NUM_ENCODES) << "allocations; EntityPropertyFlags"
+             << ((float)fixedDuration / NUM_ENCODES) << "usecs," << ((float)fixedAllocations / NUM_ENCODES)
+             << "allocations";
+}
+
+void benchmarkEntityEncode(const EntityItemPointer& item) {
+    const int NUM_ENCODES = 10000;
+    OctreePacketData packetData;
+    EncodeBitstreamParams params;
+
+    size_t allocationsBefore = allocationCount;
+    auto start = usecTimestampNow();
+    for (int i = 0; i < NUM_ENCODES; ++i) {
+        packetData.reset();
+        item->appendEntityData(&packetData, params, nullptr);
+    }
+    auto duration = usecTimestampNow() - start;
+    size_t allocations = allocationCount - allocationsBefore;
+
+    qDebug() << "appendEntityData:" << ((float)duration / NUM_ENCODES) << "usecs,"
+             << ((float)allocations / NUM_ENCODES) << "allocations per entity";
+}
+
+// steps the entity-server's headless physics over a field of boxes thrown up from a floor, none of them owned
+void benchmarkServerPhysics(int numEntities) {
+    const float SPACING = 2.0f;
+    const quint64 RUN_USECS = 2 * USECS_PER_SECOND;
+    const quint64 USECS_BETWEEN_UPDATES = 10 * USECS_PER_MSEC; // as often as the persist thread updates the tree
+
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    ServerPhysicalEntitySimulation simulation;
+    simulation.init(tree);
+    tree->setSimulation(&simulation);
+
+    int side = (int)ceilf(sqrtf((float)numEntities));
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setDimensions(glm::vec3(SPACING * side, 1.0f, SPACING * side));
+    properties.setPosition(glm::vec3(SPACING * side / 2.0f, -0.5f, SPACING * side / 2.0f));
+    tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+
+    properties.setDimensions(glm::vec3(0.5f));
+    properties.setDynamic(true);
+    properties.setGravity(glm::vec3(0.0f, -9.8f, 0.0f));
+    for (int i = 0; i < numEntities; i++) {
+        properties.setPosition(glm::vec3(SPACING * (i % side), 1.0f, SPACING * (i / side)));
+        properties.setVelocity(glm::vec3(0.0f, 2.0f + (float)(i % 7), 0.0f));
+        tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+    }
+
+    int numUpdates = 0;
+    auto start = usecTimestampNow();
+    while (usecTimestampNow() - start < RUN_USECS) {
+        tree->update();
+        numUpdates++;
+        usleep(USECS_BETWEEN_UPDATES);
+    }
+
+    qDebug() << "server physics:" << numEntities << "entities," << simulation.getNumPhysicalEntities()
+             << "in physics," << simulation.getAverageStepUsecs() << "usecs per step over" << numUpdates << "updates";
+    tree->setSimulation(nullptr);
+}
+
 int main(int argc, char** argv) {
     QCoreApplication app(argc, argv);
     {
@@ -150,6 +305,8 @@ int main(int argc, char** argv) {
         qDebug() << duration;
 
     }
+    benchmarkPropertyFlagsEncode();
+
     DependencyManager::set<NodeList>(NodeType::Unassigned);
 
     QFile file(getTestResourceDir() + "packet.bin");
@@ -165,6 +322,13 @@ int main(int argc, char** argv) {
     }
     float duration = (usecTimestampNow() - start);
     qDebug() << (duration / 1000.0f);
+
+    benchmarkEntityEncode(item);
+
+    DependencyManager::get<NodeList>()->setSessionUUID(QUuid::createUuid());
+    for (int numEntities : { 100, 1000, 5000 }) {
+        benchmarkServerPhysics(numEntities);
+    }
     return 0;
 }
 
@@ -0,0 +1,379 @@
+//
+//  FBXReaderTests.cpp
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXReaderTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+
+#include <QBuffer>
+#include <QStack>
+#include <QTemporaryFile>
+#include <QtEndian>
+
+#include <FBXReader.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(FBXReaderTests)
+
+// set to the path of a large binary .fbx to benchmark that instead of the generated model
+const char* BENCHMARK_MODEL_VARIABLE = "HIFI_FBX_BENCHMARK_MODEL";
+const int SMALL_VERTEX_COUNT = 1000;
+const int LARGE_VERTEX_COUNT = 250000;
+const int LARGE_GEOMETRY_COUNT = 4;
+
+// writes just enough binary FBX to exercise the reader: the header, every property type, and large mesh arrays.
+class BinaryFBXWriter {
+public:
+    BinaryFBXWriter() {
+        _data.append("Kaydara FBX Binary  ");
+        _data.append('\0');
+        _data.append('\x1a');
+        _data.append('\0');
+        append<quint32>(7400);
+    }
+
+    void beginNode(const QByteArray& name) {
+        if (!_nodes.isEmpty()) {
+            endProperties();
+        }
+        Node node;
+        node.start = _data.size();
+        _nodes.push(node);
+        append<quint32>(0); // end offset
+        append<quint32>(0); // property count
+        append<quint32>(0); // property list length
+        append<quint8>((quint8)name.size());
+        _data.append(name);
+        _nodes.top().propertiesStart = _data.size();
+    }
+
+    void endNode() {
+        Node& node = _nodes.top();
+        bool hasChildren = (node.propertiesEnd >= 0);
+        endProperties();
+        if (hasChildren) {
+            appendNullNode();
+        }
+        patch(node.start, (quint32)_data.size());
+        patch(node.start + sizeof(quint32), node.propertyCount);
+        patch(node.start + 2 * sizeof(quint32), (quint32)(node.propertiesEnd - node.propertiesStart));
+        _nodes.pop();
+    }
+
+    template<class T> void addProperty(char type, T value) {
+        _nodes.top().propertyCount++;
+        _data.append(type);
+        append<T>(value);
+    }
+
+    void addProperty(const QByteArray& value) {
+        _nodes.top().propertyCount++;
+        _data.append('S');
+        append<quint32>((quint32)value.size());
+        _data.append(value);
+    }
+
+    template<class T> void addArray(char type, const QVector<T>& values, bool compress) {
+        _nodes.top().propertyCount++;
+        _data.append(type);
+        append<quint32>((quint32)values.size());
+
+        QByteArray raw;
+        for (const T& value : values) {
+            append<T>(value, raw);
+        }
+        if (compress) {
+            // skip the uncompressed length that qCompress prefaces its zlib stream with
+            QByteArray compressed = qCompress(raw).mid(sizeof(quint32));
+            append<quint32>(1);
+            append<quint32>((quint32)compressed.size());
+            _data.append(compressed);
+        } else {
+            append<quint32>(0);
+            append<quint32>((quint32)raw.size());
+            _data.append(raw);
+        }
+    }
+
+    QByteArray finish() {
+        appendNullNode();
+        return _data;
+    }
+
+private:
+    struct Node {
+        int start { 0 };
+        int propertiesStart { 0 };
+        int propertiesEnd { -1 };
+        quint32 propertyCount { 0 };
+    };
+
+    template<class T> static void append(T value, QByteArray& data) {
+        char bytes[sizeof(T)];
+        memcpy(bytes, &value, sizeof(T));
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        std::reverse(bytes, bytes + sizeof(T));
+#endif
+        data.append(bytes, sizeof(T));
+    }
+    template<class T> void append(T value) { append<T>(value, _data); }
+
+    void patch(int offset, quint32 value) {
+        qToLittleEndian<quint32>(value, (uchar*)_data.data() + offset);
+    }
+
+    void endProperties() {
+        if (_nodes.top().propertiesEnd < 0) {
+            _nodes.top().propertiesEnd = _data.size();
+        }
+    }
+
+    void appendNullNode() {
+        _data.append(QByteArray(3 * sizeof(quint32) + sizeof(quint8), 0));
+    }
+
+    QByteArray _data;
+    QStack<Node> _nodes;
+};
+
+static QVector<double> makeVertices(int vertexCount, int seed) {
+    QVector<double> vertices(3 * vertexCount);
+    for (int i = 0; i < vertices.size(); i++) {
+        vertices[i] = 10.0 * sin(0.01 * (double)(i + seed));
+    }
+    return vertices;
+}
+
+static QVector<int> makeIndices(int vertexCount) {
+    QVector<int> indices;
+    for (int i = 0; i + 2 < vertexCount; i += 3) {
+        indices << i << i + 1 << ~(i + 2);
+    }
+    return indices;
+}
+
+static QByteArray makeBinaryFBX(int geometryCount, int vertexCount) {
+    BinaryFBXWriter writer;
+    writer.beginNode("FBXHeaderExtension");
+    writer.beginNode("FBXVersion");
+    writer.addProperty<qint32>('I', 7400);
+    writer.endNode();
+    writer.endNode();
+
+    writer.beginNode("Objects");
+    for (int i = 0; i < geometryCount; i++) {
+        writer.beginNode("Geometry");
+        writer.addProperty<qint64>('L', 1000 + i);
+        writer.addProperty(QByteArray("Geometry::mesh") + QByteArray::number(i));
+        writer.addProperty(QByteArray("Mesh"));
+
+        writer.beginNode("Properties");
+        writer.addProperty<qint16>('Y', -7);
+        writer.addProperty<quint8>('C', 1);
+        writer.addProperty<float>('F', 0.25f);
+        writer.addProperty<double>('D', -1.5);
+        writer.endNode();
+
+        writer.beginNode("Vertices");
+        writer.addArray<double>('d', makeVertices(vertexCount, i), true);
+        writer.endNode();
+
+        writer.beginNode("PolygonVertexIndex");
+        writer.addArray<qint32>('i', makeIndices(vertexCount), true);
+        writer.endNode();
+
+        writer.beginNode("LayerElementNormal");
+        writer.beginNode("Normals");
+        writer.addArray<double>('d', makeVertices(vertexCount, -i), false);
+        writer.endNode();
+        writer.beginNode("Weights");
+        writer.addArray<float>('f', QVector<float>(vertexCount, 0.5f), false);
+        writer.endNode();
+        writer.beginNode("Flags");
+        writer.addArray<quint8>('b', QVector<quint8>(vertexCount, 2), true);
+        writer.endNode();
+        writer.beginNode("Ids");
+        writer.addArray<qint64>('l', QVector<qint64>(vertexCount, -3), true);
+        writer.endNode();
+        writer.endNode();
+
+        writer.endNode();
+    }
+    writer.endNode();
+    return writer.finish();
+}
+
+template<class T> static bool equalArrays(const QVariant& actual, const QVariant& expected) {
+    return actual.value<QVector<T>>() == expected.value<QVector<T>>();
+}
+
+static void compareNodes(const FBXNode& actual, const FBXNode& expected) {
+    QCOMPARE(actual.name, expected.name);
+    QCOMPARE(actual.properties.size(), expected.properties.size());
+    for (int i = 0; i < actual.properties.size(); i++) {
+        const QVariant& actualProperty = actual.properties.at(i);
+        const QVariant& expectedProperty = expected.properties.at(i);
+        int type = expectedProperty.userType();
+        QCOMPARE(actualProperty.userType(), type);
+        if (type == qMetaTypeId<QVector<double>>()) {
+            QVERIFY(equalArrays<double>(actualProperty, expectedProperty));
+        } else if (type == qMetaTypeId<QVector<float>>()) {
+            QVERIFY(equalArrays<float>(actualProperty, expectedProperty));
+        } else if (type == qMetaTypeId<QVector<qint32>>()) {
+            QVERIFY(equalArrays<qint32>(actualProperty, expectedProperty));
+        } else if (type == qMetaTypeId<QVector<qint64>>()) {
+            QVERIFY(equalArrays<qint64>(actualProperty, expectedProperty));
+        } else if (type == qMetaTypeId<QVector<bool>>()) {
+            QVERIFY(equalArrays<bool>(actualProperty, expectedProperty));
+        } else {
+            QCOMPARE(actualProperty, expectedProperty);
+        }
+    }
+    QCOMPARE(actual.children.size(), expected.children.size());
+    for (int i = 0; i < actual.children.size(); i++) {
+        compareNodes(actual.children.at(i), expected.children.at(i));
+    }
+}
+
+static FBXNode parseStream(const QByteArray& data) {
+    QBuffer buffer(const_cast<QByteArray*>(&data));
+    buffer.open(QIODevice::ReadOnly);
+    return FBXReader::parseBinaryFBX(&buffer);
+}
+
+// the peak resident set size in kilobytes since the last resetPeakMemory, or -1 if unknown on this platform.
+static qint64 getPeakMemory() {
+#ifdef Q_OS_LINUX
+    QFile status("/proc/self/status");
+    if (status.open(QIODevice::ReadOnly)) {
+        foreach (const QByteArray& line, status.readAll().split('\n')) {
+            if (line.startsWith("VmHWM:")) {
+                return line.mid(6).trimmed().split(' ').at(0).toLongLong();
+            }
+        }
+    }
+#endif
+    return -1;
+}
+
+static void resetPeakMemory() {
+#ifdef Q_OS_LINUX
+    QFile clearRefs("/proc/self/clear_refs");
+    if (clearRefs.open(QIODevice::WriteOnly)) {
+        clearRefs.write("5");
+    }
+#endif
+}
+
+void FBXReaderTests::testBinaryMatchesStream() {
+    QByteArray data = makeBinaryFBX(3, SMALL_VERTEX_COUNT);
+    FBXNode expected = parseStream(data);
+    FBXNode actual = FBXReader::parseBinaryFBX(data.constData(), data.size());
+    QCOMPARE(actual.children.size(), 2);
+    compareNodes(actual, expected);
+
+    // parseFBX picks the in-memory path for buffers and files
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    compareNodes(FBXReader::parseFBX(&buffer), expected);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(data);
+    file.seek(0);
+    compareNodes(FBXReader::parseFBX(&file), expected);
+}
+
+void FBXReaderTests::testBinaryMesh() {
+    QByteArray data = makeBinaryFBX(1, SMALL_VERTEX_COUNT);
+    FBXNode top = FBXReader::parseBinaryFBX(data.constData(), data.size());
+    const FBXNode& geometry = top.children.at(1).children.at(0);
+    QCOMPARE(geometry.name, QByteArray("Geometry"));
+    QCOMPARE(geometry.properties.at(0).value<qint64>(), (qint64)1000);
+
+    QVector<double> vertices = FBXReader::getDoubleVector(geometry.children.at(1));
+    QCOMPARE(vertices, makeVertices(SMALL_VERTEX_COUNT, 0));
+    QCOMPARE(FBXReader::createVec3Vector(vertices).size(), SMALL_VERTEX_COUNT);
+    QCOMPARE(FBXReader::getIntVector(geometry.children.at(2)), makeIndices(SMALL_VERTEX_COUNT));
+
+    QVector<bool> flags = geometry.children.at(3).children.at(2).properties.at(0).value<QVector<bool>>();
+    QCOMPARE(flags, QVector<bool>(SMALL_VERTEX_COUNT, true));
+}
+
+void FBXReaderTests::testTruncatedBinary() {
+    QByteArray data = makeBinaryFBX(1, SMALL_VERTEX_COUNT);
+    data.truncate(data.size() / 2);
+    bool threw = false;
+    try {
+        FBXReader::parseBinaryFBX(data.constData(), data.size());
+    } catch (const QString&) {
+        threw = true;
+    }
+    QVERIFY(threw);
+}
+
+void FBXReaderTests::benchmarkParseBinary() {
+    QByteArray data;
+    QByteArray path = qgetenv(BENCHMARK_MODEL_VARIABLE);
+    if (!path.isEmpty()) {
+        QFile model(path);
+        QVERIFY(model.open(QIODevice::ReadOnly));
+        data = model.readAll();
+    } else {
+        data = makeBinaryFBX(LARGE_GEOMETRY_COUNT, LARGE_VERTEX_COUNT);
+    }
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(data);
+
+    qint64 streamMemory;
+    quint64 streamTime;
+    {
+        resetPeakMemory();
+        qint64 baseline = getPeakMemory();
+        quint64 start = usecTimestampNow();
+        FBXNode top = parseStream(data);
+        streamTime = usecTimestampNow() - start;
+        streamMemory = getPeakMemory() - baseline;
+    }
+
+    qint64 bufferMemory;
+    quint64 bufferTime;
+    {
+        resetPeakMemory();
+        qint64 baseline = getPeakMemory();
+        quint64 start = usecTimestampNow();
+        FBXNode top = FBXReader::parseBinaryFBX(data.constData(), data.size());
+        bufferTime = usecTimestampNow() - start;
+        bufferMemory = getPeakMemory() - baseline;
+    }
+
+    // release our copy so the mapped file is measured on its own
+    int size = data.size();
+    data = QByteArray();
+
+    qint64 fileMemory;
+    quint64 fileTime;
+    {
+        file.seek(0);
+        resetPeakMemory();
+        qint64 baseline = getPeakMemory();
+        quint64 start = usecTimestampNow();
+        FBXNode top = FBXReader::parseFBX(&file);
+        fileTime = usecTimestampNow() - start;
+        fileMemory = getPeakMemory() - baseline;
+    }
+
+    qDebug() << "parse" << size / 1024 << "KB binary FBX" << (path.isEmpty() ? "(generated)" : path);
+    qDebug() << "    QDataStream:" << streamTime << "usecs," << streamMemory << "KB peak";
+    qDebug() << "    in memory:" << bufferTime << "usecs," << bufferMemory << "KB peak";
+    qDebug() << "    mapped file:" << fileTime << "usecs," << fileMemory << "KB peak";
+}
@@ -0,0 +1,151 @@
+//
+//  ProcessedTextureCacheTests.cpp
+//  tests/model-networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ProcessedTextureCacheTests.h"
+
+#include <memory>
+
+#include <QTemporaryDir>
+
+#include <model/TextureMap.h>
+#include <model-networking/ProcessedTextureCache.h>
+
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(ProcessedTextureCacheTests)
+
+static std::unique_ptr<gpu::Texture> makeTexture(int width, int height, QRgb color) {
+    QImage image(width, height, QImage::Format_ARGB32);
+    image.fill(color);
+    image.setPixel(0, 0, qRgba(255, 0, 0, 0));
+    return std::unique_ptr<gpu::Texture>(model::TextureUsage::create2DTextureFromImage(image, "test"));
+}
+
+void ProcessedTextureCacheTests::testSerializeRoundTrip() {
+    auto texture = makeTexture(37, 20, qRgba(10, 200, 30, 128));
+    QVERIFY(ProcessedTextureCache::isCacheable(*texture));
+
+    QByteArray data = ProcessedTextureCache::serialize(*texture, 74, 40);
+    QVERIFY(!data.isEmpty());
+
+    int originalWidth = 0;
+    int originalHeight = 0;
+    std::unique_ptr<gpu::Texture> loaded(ProcessedTextureCache::deserialize(data.constData(), data.size(),
+                                                                            originalWidth, originalHeight));
+    QVERIFY(loaded != nullptr);
+    QCOMPARE(originalWidth, 74);
+    QCOMPARE(originalHeight, 40);
+    QCOMPARE(loaded->getWidth(), texture->getWidth());
+    QCOMPARE(loaded->getHeight(), texture->getHeight());
+    QVERIFY(loaded->getTexelFormat() == texture->getTexelFormat());
+    QVERIFY(loaded->getUsage() == texture->getUsage());
+    QCOMPARE(loaded->maxMip(), texture->maxMip());
+    for (uint16_t level = 0; level <= texture->maxMip(); level++) {
+        auto expected = texture->accessStoredMipFace(level);
+        auto mip = loaded->accessStoredMipFace(level);
+        QVERIFY(mip->getFormat() == expected->getFormat());
+        QCOMPARE(mip->getSize(), expected->getSize());
+        QVERIFY(memcmp(mip->readData(), expected->readData(), mip->getSize()) == 0);
+    }
+
+    // truncated data is rejected rather than read past the end
+    int width, height;
+    QVERIFY(ProcessedTextureCache::deserialize(data.constData(), data.size() - 1, width, height) == nullptr);
+    QVERIFY(ProcessedTextureCache::deserialize(data.constData(), 16, width, height) == nullptr);
+}
+
+void ProcessedTextureCacheTests::testStoreAndLoad() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    QByteArray content("not really an image");
+    QByteArray key = ProcessedTextureCache::computeKey(content, 0);
+    QVERIFY(key != ProcessedTextureCache::computeKey(content, 1));
+
+    auto texture = makeTexture(16, 16, qRgba(1, 2, 3, 255));
+    int width, height;
+    {
+        ProcessedTextureCache cache(directory.path());
+        QVERIFY(cache.load(key, width, height) == nullptr);
+        QVERIFY(cache.store(key, ProcessedTextureCache::serialize(*texture, 16, 16)));
+        std::unique_ptr<gpu::Texture> loaded(cache.load(key, width, height));
+        QVERIFY(loaded != nullptr);
+        QCOMPARE(cache.getNumHits(), 1);
+        QCOMPARE(cache.getNumMisses(), 1);
+        QCOMPARE(cache.getHitRate(), 0.5f);
+    }
+
+    // entries outlive the session
+    ProcessedTextureCache cache(directory.path());
+    QCOMPARE(cache.getNumEntries(), 1);
+    QVERIFY(cache.getSize() > 0);
+    std::unique_ptr<gpu::Texture> loaded(cache.load(key, width, height));
+    QVERIFY(loaded != nullptr);
+
+    cache.clear();
+    QCOMPARE(cache.getNumEntries(), 0);
+    QCOMPARE(cache.getSize(), (qint64)0);
+    QVERIFY(cache.load(key, width, height) == nullptr);
+}
+
+void ProcessedTextureCacheTests::testEviction() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    auto texture = makeTexture(32, 32, qRgba(100, 100, 100, 255));
+    QByteArray data = ProcessedTextureCache::serialize(*texture, 32, 32);
+    ProcessedTextureCache cache(directory.path(), data.size() * 2 + data.size() / 2);
+
+    QByteArray first = ProcessedTextureCache::computeKey("first", 0);
+    QByteArray second = ProcessedTextureCache::computeKey("second", 0);
+    QByteArray third = ProcessedTextureCache::computeKey("third", 0);
+    QVERIFY(cache.store(first, data));
+    QVERIFY(cache.store(second, data));
+
+    // using the first entry makes the second one the least recently used
+    int width, height;
+    std::unique_ptr<gpu::Texture> loaded(cache.load(first, width, height));
+    QVERIFY(loaded != nullptr);
+
+    QVERIFY(cache.store(third, data));
+    QCOMPARE(cache.getNumEntries(), 2);
+    QCOMPARE(cache.getNumEvictions(), 1);
+    QVERIFY(cache.getSize() <= cache.getMaximumSize());
+    QVERIFY(!QFile::exists(directory.path() + "/" + second + ProcessedTextureCache::FILE_EXTENSION));
+
+    loaded.reset(cache.load(second, width, height));
+    QVERIFY(loaded == nullptr);
+    loaded.reset(cache.load(first, width, height));
+    QVERIFY(loaded != nullptr);
+
+    cache.setMaximumSize(data.size());
+    QCOMPARE(cache.getNumEntries(), 1);
+}
+
+void ProcessedTextureCacheTests::testCorruptEntry() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    QByteArray key = ProcessedTextureCache::computeKey("corrupt", 0);
+    QString path = directory.path() + "/" + key + ProcessedTextureCache::FILE_EXTENSION;
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(QByteArray(200, 'x'));
+    }
+
+    ProcessedTextureCache cache(directory.path());
+    QCOMPARE(cache.getNumEntries(), 1);
+
+    int width, height;
+    QVERIFY(cache.load(key, width, height) == nullptr);
+    QCOMPARE(cache.getNumEntries(), 0);
+    QVERIFY(!QFile::exists(path));
+}
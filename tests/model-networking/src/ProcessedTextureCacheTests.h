@@ -0,0 +1,25 @@
+//
+//  ProcessedTextureCacheTests.h
+//  tests/model-networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ProcessedTextureCacheTests_h
+#define hifi_ProcessedTextureCacheTests_h
+
+#include <QtTest/QtTest>
+
+class ProcessedTextureCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testSerializeRoundTrip();
+    void testStoreAndLoad();
+    void testEviction();
+    void testCorruptEntry();
+};
+
+#endif // hifi_ProcessedTextureCacheTests_h
@@ -0,0 +1,238 @@
+//
+//  TextureProcessingTests.cpp
+//  tests/model/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureProcessingTests.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+#include <SharedUtil.h>
+#include <gpu/Texture.h>
+#include <model/TextureProcessing.h>
+
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(TextureProcessingTests)
+
+using namespace model;
+
+// deterministic noise, with a mix of opaque, transparent and translucent pixels when hasAlpha is set
+static QImage makeNoiseImage(int width, int height, bool hasAlpha) {
+    QImage image(width, height, hasAlpha ? QImage::Format_ARGB32 : QImage::Format_RGB32);
+    quint32 seed = 12345;
+    for (int y = 0; y < height; y++) {
+        QRgb* row = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < width; x++) {
+            seed = seed * 1664525 + 1013904223;
+            int alpha = 255;
+            if (hasAlpha) {
+                int kind = (seed >> 8) % 4;
+                alpha = (kind == 0) ? 0 : (kind == 1) ? (int)((seed >> 12) & 0xff) : 255;
+            }
+            row[x] = qRgba((seed >> 24) & 0xff, (seed >> 16) & 0xff, (seed >> 4) & 0xff, alpha);
+        }
+    }
+    return image;
+}
+
+static uint8_t average(uint8_t a, uint8_t b) {
+    return (uint8_t)((a + b + 1) >> 1);
+}
+
+// straightforward box filter, with the same rounding as TextureProcessing's non sRGB path
+static QImage downsampleReference(const QImage& image) {
+    int width = std::max(image.width() / 2, 1);
+    int height = std::max(image.height() / 2, 1);
+    int pixelSize = image.depth() / 8;
+    QImage result(width, height, image.format());
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row0 = image.constScanLine(2 * y);
+        const uint8_t* row1 = image.constScanLine(std::min(2 * y + 1, image.height() - 1));
+        uint8_t* dest = result.scanLine(y);
+        for (int x = 0; x < width; x++) {
+            int left = 2 * x * pixelSize;
+            int right = std::min(2 * x + 1, image.width() - 1) * pixelSize;
+            for (int c = 0; c < pixelSize; c++) {
+                dest[x * pixelSize + c] = average(average(row0[left + c], row1[left + c]),
+                                                  average(row0[right + c], row1[right + c]));
+            }
+        }
+    }
+    return result;
+}
+
+static bool compareImages(const QImage& a, const QImage& b) {
+    if (a.size() != b.size() || a.format() != b.format()) {
+        return false;
+    }
+    int rowBytes = a.width() * a.depth() / 8;
+    for (int y = 0; y < a.height(); y++) {
+        if (memcmp(a.constScanLine(y), b.constScanLine(y), rowBytes) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TextureProcessingTests::testAnalyzeMatchesPixelLoop() {
+    // big enough to be split across threads, and with a width that isn't a multiple of the SIMD width
+    QImage image = makeNoiseImage(1027, 301, true);
+    auto stats = TextureProcessing::analyzeImage(image);
+
+    quint64 redTotal = 0, greenTotal = 0, blueTotal = 0, alphaTotal = 0;
+    int numOpaque = 0, numTransparent = 0;
+    for (int y = 0; y < image.height(); y++) {
+        for (int x = 0; x < image.width(); x++) {
+            QRgb pixel = image.pixel(x, y);
+            redTotal += qRed(pixel);
+            greenTotal += qGreen(pixel);
+            blueTotal += qBlue(pixel);
+            alphaTotal += qAlpha(pixel);
+            numOpaque += (qAlpha(pixel) == 255);
+            numTransparent += (qAlpha(pixel) == 0);
+        }
+    }
+
+    QCOMPARE(stats.numPixels, image.width() * image.height());
+    QCOMPARE(stats.redTotal, redTotal);
+    QCOMPARE(stats.greenTotal, greenTotal);
+    QCOMPARE(stats.blueTotal, blueTotal);
+    QCOMPARE(stats.alphaTotal, alphaTotal);
+    QCOMPARE(stats.numOpaque, numOpaque);
+    QCOMPARE(stats.numTransparent, numTransparent);
+    QCOMPARE(stats.hasValidAlpha(), true);
+    QCOMPARE(stats.isAlphaUniform(), false);
+
+    // an opaque image never has valid alpha, whatever the unused byte of RGB32 holds
+    auto opaqueStats = TextureProcessing::analyzeImage(makeNoiseImage(33, 17, false));
+    QCOMPARE(opaqueStats.hasValidAlpha(), false);
+    QCOMPARE(opaqueStats.getNumTranslucent(), 0);
+
+    QImage transparent(21, 5, QImage::Format_ARGB32);
+    transparent.fill(qRgba(10, 20, 30, 0));
+    auto transparentStats = TextureProcessing::analyzeImage(transparent);
+    QCOMPARE(transparentStats.hasValidAlpha(), true);
+    QCOMPARE(transparentStats.isAlphaUniform(), true);
+    QCOMPARE(transparentStats.getAverageColor(), QColor(10, 20, 30, 0));
+}
+
+void TextureProcessingTests::testConversionsMatchQImage() {
+    QImage image = makeNoiseImage(515, 263, false);
+
+    QVERIFY(compareImages(TextureProcessing::convertToRGB888(image), image.convertToFormat(QImage::Format_RGB888)));
+    QVERIFY(compareImages(TextureProcessing::convertToGrayscale8(image), image.convertToFormat(QImage::Format_Grayscale8)));
+
+    QImage inverted = image;
+    inverted.invertPixels(QImage::InvertRgb);
+    QVERIFY(compareImages(TextureProcessing::convertToGrayscale8(image, true),
+                          inverted.convertToFormat(QImage::Format_Grayscale8)));
+}
+
+void TextureProcessingTests::testMipChain() {
+    // odd sizes, down to 1x1
+    QImage image = makeNoiseImage(37, 19, true);
+    auto mips = TextureProcessing::generateMips(image, false);
+    QCOMPARE((int)mips.size(), 5);
+    QCOMPARE(mips[0].size(), QSize(18, 9));
+    QCOMPARE(mips[4].size(), QSize(1, 1));
+
+    // the SIMD and scalar paths agree with a plain box filter
+    QImage expected = image;
+    for (const auto& mip : mips) {
+        expected = downsampleReference(expected);
+        QVERIFY(compareImages(mip, expected));
+    }
+    QImage gray = TextureProcessing::convertToGrayscale8(makeNoiseImage(70, 33, false));
+    QVERIFY(compareImages(TextureProcessing::generateMips(gray, false)[0], downsampleReference(gray)));
+    QImage rgb = TextureProcessing::convertToRGB888(makeNoiseImage(13, 40, false));
+    QVERIFY(compareImages(TextureProcessing::generateMips(rgb, false)[0], downsampleReference(rgb)));
+
+    // sRGB colors are averaged in linear space, alpha isn't
+    QImage checker(2, 2, QImage::Format_ARGB32);
+    checker.setPixel(0, 0, qRgba(0, 0, 0, 0));
+    checker.setPixel(1, 1, qRgba(0, 0, 0, 0));
+    checker.setPixel(1, 0, qRgba(255, 255, 255, 255));
+    checker.setPixel(0, 1, qRgba(255, 255, 255, 255));
+    QRgb linearAverage = TextureProcessing::generateMips(checker, false)[0].pixel(0, 0);
+    QCOMPARE(qRed(linearAverage), 128);
+    QCOMPARE(qAlpha(linearAverage), 128);
+    QRgb srgbAverage = TextureProcessing::generateMips(checker, true)[0].pixel(0, 0);
+    QVERIFY(qRed(srgbAverage) >= 186 && qRed(srgbAverage) <= 189);
+    QCOMPARE(qAlpha(srgbAverage), 128);
+
+    // a constant color survives the round trip through linear space
+    QImage flat(64, 64, QImage::Format_RGB888);
+    for (int value = 0; value < 256; value += 5) {
+        flat.fill(QColor(value, value, value));
+        QRgb mip = TextureProcessing::generateMips(flat, true).back().pixel(0, 0);
+        QVERIFY(std::abs(qRed(mip) - value) <= 1);
+    }
+}
+
+void TextureProcessingTests::testAssignMips() {
+    QImage image = makeNoiseImage(64, 32, true);
+    gpu::Element format(gpu::VEC4, gpu::NUINT8, gpu::BGRA);
+    gpu::Texture* texture = gpu::Texture::create2D(gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA), 64, 32);
+    QVERIFY(texture->assignStoredMip(0, format, image.byteCount(), image.constBits()));
+    QCOMPARE(texture->maxMip(), (uint16_t)0);
+
+    QCOMPARE(TextureProcessing::assignMips(texture, format, image), 6);
+    QCOMPARE(texture->maxMip(), (uint16_t)6);
+    QCOMPARE(texture->isAutogenerateMips(), false);
+    QVERIFY(texture->isStoredMipFaceAvailable(6));
+    QCOMPARE(texture->getStoredMipWidth(1), (uint16_t)32);
+    QCOMPARE(texture->getStoredMipHeight(1), (uint16_t)16);
+    delete texture;
+}
+
+void TextureProcessingTests::benchmarkPreprocess() {
+    const int SIZE = 2048;
+    QImage image = makeNoiseImage(SIZE, SIZE, true);
+
+    // what create2DTextureFromImage and the cube / lightmap loaders used to do
+    quint64 start = usecTimestampNow();
+    std::map<uint8_t, uint32_t> alphaHistogram;
+    quint64 redTotal = 0;
+    for (int y = 0; y < image.height(); y++) {
+        for (int x = 0; x < image.width(); x++) {
+            QRgb pixel = image.pixel(x, y);
+            alphaHistogram[qAlpha(pixel)]++;
+            redTotal += qRed(pixel);
+        }
+    }
+    quint64 pixelLoopUsecs = usecTimestampNow() - start;
+
+    start = usecTimestampNow();
+    auto stats = TextureProcessing::analyzeImage(image);
+    quint64 analyzeUsecs = usecTimestampNow() - start;
+    QCOMPARE(stats.redTotal, redTotal);
+
+    start = usecTimestampNow();
+    QImage qtGray = image.convertToFormat(QImage::Format_RGB32).convertToFormat(QImage::Format_Grayscale8);
+    quint64 qtGrayUsecs = usecTimestampNow() - start;
+
+    start = usecTimestampNow();
+    QImage gray = TextureProcessing::convertToGrayscale8(image);
+    quint64 grayUsecs = usecTimestampNow() - start;
+
+    start = usecTimestampNow();
+    auto mips = TextureProcessing::generateMips(image, true);
+    quint64 srgbMipsUsecs = usecTimestampNow() - start;
+
+    start = usecTimestampNow();
+    mips = TextureProcessing::generateMips(image, false);
+    quint64 linearMipsUsecs = usecTimestampNow() - start;
+
+    qDebug() << SIZE << "x" << SIZE << "ARGB32 image";
+    qDebug() << "  analysis, QImage::pixel loop:" << pixelLoopUsecs << "usecs, scanline:" << analyzeUsecs << "usecs";
+    qDebug() << "  grayscale, QImage::convertToFormat:" << qtGrayUsecs << "usecs, scanline:" << grayUsecs << "usecs";
+    qDebug() << "  mip chain, sRGB:" << srgbMipsUsecs << "usecs, linear:" << linearMipsUsecs << "usecs";
+}
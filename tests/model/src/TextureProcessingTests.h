@@ -0,0 +1,26 @@
+//
+//  TextureProcessingTests.h
+//  tests/model/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureProcessingTests_h
+#define hifi_TextureProcessingTests_h
+
+#include <QtTest/QtTest>
+
+class TextureProcessingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testAnalyzeMatchesPixelLoop();
+    void testConversionsMatchQImage();
+    void testMipChain();
+    void testAssignMips();
+    void benchmarkPreprocess();
+};
+
+#endif // hifi_TextureProcessingTests_h
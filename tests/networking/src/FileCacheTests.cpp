@@ -0,0 +1,103 @@
+//
+//  FileCacheTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FileCacheTests.h"
+
+#include <QTemporaryDir>
+
+#include "AssetUtils.h"
+#include "FileCache.h"
+
+QTEST_MAIN(FileCacheTests)
+
+const QString EXTENSION = ".test";
+
+static bool readEntry(FileCache& cache, const QByteArray& key, QByteArray& data) {
+    return cache.read(key, [&](const char* bytes, qint64 size) {
+        data = QByteArray(bytes, size);
+        return true;
+    });
+}
+
+void FileCacheTests::testWriteAndRead() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    QByteArray asset(1000, 'a');
+    QByteArray key = hashData(asset).toHex();
+    QByteArray data;
+    {
+        FileCache cache(directory.path(), EXTENSION, 1024 * 1024);
+        QVERIFY(!readEntry(cache, key, data));
+        QVERIFY(cache.write(key, asset));
+        QVERIFY(cache.contains(key));
+        QVERIFY(readEntry(cache, key, data));
+        QCOMPARE(data, asset);
+        QCOMPARE(cache.getNumHits(), 1);
+        QCOMPARE(cache.getNumMisses(), 1);
+    }
+
+    // entries outlive the session
+    FileCache cache(directory.path(), EXTENSION, 1024 * 1024);
+    QCOMPARE(cache.getNumEntries(), 1);
+    QCOMPARE(cache.getSize(), (qint64)asset.size());
+    QVERIFY(readEntry(cache, key, data));
+    QCOMPARE(data, asset);
+
+    cache.clear();
+    QCOMPARE(cache.getNumEntries(), 0);
+    QVERIFY(!QFile::exists(cache.getFilePath(key)));
+}
+
+void FileCacheTests::testLeastRecentlyUsedEviction() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    QByteArray entry(100, 'x');
+    FileCache cache(directory.path(), EXTENSION, 250);
+    QVERIFY(cache.write("first", entry));
+    QVERIFY(cache.write("second", entry));
+
+    // reading the first entry makes the second one the least recently used
+    QByteArray data;
+    QVERIFY(readEntry(cache, "first", data));
+    QVERIFY(cache.write("third", entry));
+    QCOMPARE(cache.getNumEvictions(), 1);
+    QVERIFY(cache.contains("first"));
+    QVERIFY(!cache.contains("second"));
+    QVERIFY(cache.contains("third"));
+    QVERIFY(!QFile::exists(cache.getFilePath("second")));
+
+    // too large to ever fit
+    QVERIFY(!cache.write("large", QByteArray(300, 'x')));
+
+    cache.setMaximumSize(100);
+    QCOMPARE(cache.getNumEntries(), 1);
+    QVERIFY(cache.contains("third"));
+}
+
+void FileCacheTests::testRejectedEntry() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    QByteArray asset("some asset");
+    QByteArray key = hashData(asset).toHex();
+    FileCache cache(directory.path(), EXTENSION, 1024 * 1024);
+
+    // stored under the wrong hash, as if the file had been damaged
+    QVERIFY(cache.write(key, QByteArray("some other asset")));
+    bool verified = cache.read(key, [&](const char* bytes, qint64 size) {
+        return hashData(QByteArray::fromRawData(bytes, size)).toHex() == key;
+    });
+    QVERIFY(!verified);
+    QVERIFY(!cache.contains(key));
+    QVERIFY(!QFile::exists(cache.getFilePath(key)));
+    QCOMPARE(cache.getSize(), (qint64)0);
+}
@@ -0,0 +1,24 @@
+//
+//  FileCacheTests.h
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FileCacheTests_h
+#define hifi_FileCacheTests_h
+
+#include <QtTest/QtTest>
+
+class FileCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testWriteAndRead();
+    void testLeastRecentlyUsedEviction();
+    void testRejectedEntry();
+};
+
+#endif // hifi_FileCacheTests_h
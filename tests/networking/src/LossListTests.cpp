@@ -0,0 +1,162 @@
+//
+//  LossListTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LossListTests.h"
+
+#include <udt/ControlPacket.h>
+#include <udt/LossList.h>
+
+QTEST_MAIN(LossListTests)
+
+using namespace udt;
+
+using Ranges = QVector<QPair<int, int>>;
+
+SequenceNumber seq(int value) {
+    return SequenceNumber(value);
+}
+
+// the ranges held, as the list writes them into a NAK
+Ranges rangesOf(LossList& lossList) {
+    auto packet = ControlPacket::create(ControlPacket::TimeoutNAK);
+    lossList.write(*packet);
+    packet->seek(0);
+
+    Ranges ranges;
+    SequenceNumber start, end;
+    while (packet->readPrimitive(&start) == (qint64)sizeof(start) && packet->readPrimitive(&end) == (qint64)sizeof(end)) {
+        ranges.push_back({ (SequenceNumber::Type)start, (SequenceNumber::Type)end });
+    }
+    return ranges;
+}
+
+void LossListTests::insertTest() {
+    LossList lossList;
+    lossList.append(seq(10), seq(12));
+    lossList.append(seq(20), seq(22));
+    QCOMPARE(lossList.getLength(), 6);
+
+    // before everything, and between two ranges
+    lossList.insert(seq(2), seq(4));
+    lossList.insert(seq(15), seq(16));
+    QCOMPARE(rangesOf(lossList), Ranges({ { 2, 4 }, { 10, 12 }, { 15, 16 }, { 20, 22 } }));
+    QCOMPARE(lossList.getLength(), 11);
+
+    // inside a range changes nothing
+    lossList.insert(seq(11), seq(11));
+    QCOMPARE(lossList.getLength(), 11);
+
+    // over the end of one range and the start of another
+    lossList.insert(seq(11), seq(15));
+    QCOMPARE(rangesOf(lossList), Ranges({ { 2, 4 }, { 10, 16 }, { 20, 22 } }));
+    QCOMPARE(lossList.getLength(), 13);
+
+    // over several ranges at once
+    lossList.insert(seq(0), seq(30));
+    QCOMPARE(rangesOf(lossList), Ranges({ { 0, 30 } }));
+    QCOMPARE(lossList.getLength(), 31);
+}
+
+void LossListTests::mergeTest() {
+    LossList lossList;
+    lossList.append(seq(10), seq(12));
+    lossList.append(seq(20), seq(22));
+
+    // right after a range
+    lossList.insert(seq(13), seq(14));
+    QCOMPARE(rangesOf(lossList), Ranges({ { 10, 14 }, { 20, 22 } }));
+
+    // right before a range
+    lossList.insert(seq(17), seq(19));
+    QCOMPARE(rangesOf(lossList), Ranges({ { 10, 14 }, { 17, 22 } }));
+
+    // filling the gap between two ranges exactly
+    lossList.insert(seq(15), seq(16));
+    QCOMPARE(rangesOf(lossList), Ranges({ { 10, 22 } }));
+    QCOMPARE(lossList.getLength(), 13);
+
+    // single sequence numbers next to both ends
+    lossList.insert(seq(9), seq(9));
+    lossList.insert(seq(23), seq(23));
+    QCOMPARE(rangesOf(lossList), Ranges({ { 9, 23 } }));
+    QCOMPARE(lossList.getLength(), 15);
+
+    // the merged list pops in order with nothing left over
+    for (int i = 9; i <= 23; ++i) {
+        QCOMPARE(lossList.popFirstSequenceNumber(), seq(i));
+    }
+    QVERIFY(lossList.isEmpty());
+
+    // a range starting at 0 joins one ending at the largest sequence number, and no other
+    SequenceNumber last(SequenceNumber::MAX);
+    lossList.append(last - 5, last - 2);
+    lossList.insert(seq(0), seq(3));
+    QCOMPARE(rangesOf(lossList), Ranges({ { SequenceNumber::MAX - 5, SequenceNumber::MAX - 2 }, { 0, 3 } }));
+    lossList.insert(last - 1, last);
+    QCOMPARE(rangesOf(lossList), Ranges({ { SequenceNumber::MAX - 5, 3 } }));
+    QCOMPARE(lossList.getLength(), 10);
+}
+
+void LossListTests::removeTest() {
+    LossList lossList;
+    lossList.append(seq(10), seq(20));
+
+    QVERIFY(!lossList.remove(seq(5)));
+    QVERIFY(lossList.remove(seq(10)));
+    QVERIFY(lossList.remove(seq(20)));
+    QVERIFY(lossList.remove(seq(15)));
+    QVERIFY(!lossList.remove(seq(15)));
+    QCOMPARE(rangesOf(lossList), Ranges({ { 11, 14 }, { 16, 19 } }));
+    QCOMPARE(lossList.getLength(), 8);
+
+    // a range inside one range splits it
+    lossList.remove(seq(12), seq(13));
+    QCOMPARE(rangesOf(lossList), Ranges({ { 11, 11 }, { 14, 14 }, { 16, 19 } }));
+
+    // a range over several removes those inside and trims the last
+    lossList.remove(seq(11), seq(17));
+    QCOMPARE(rangesOf(lossList), Ranges({ { 18, 19 } }));
+    QCOMPARE(lossList.getLength(), 2);
+
+    // removing then inserting again merges back into one range
+    lossList.insert(seq(11), seq(17));
+    QCOMPARE(rangesOf(lossList), Ranges({ { 11, 19 } }));
+
+    lossList.remove(seq(0), seq(100));
+    QVERIFY(lossList.isEmpty());
+    QVERIFY(rangesOf(lossList).isEmpty());
+}
+
+void LossListTests::popTest() {
+    LossList lossList;
+    lossList.append(seq(5));
+    lossList.append(seq(7), seq(8));
+    lossList.append(seq(10));
+    QCOMPARE(lossList.getLength(), 4);
+
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(5));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(5));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(7));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(8));
+    QCOMPARE(rangesOf(lossList), Ranges({ { 10, 10 } }));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(10));
+    QVERIFY(lossList.isEmpty());
+
+    // across the point where sequence numbers wrap
+    SequenceNumber last(SequenceNumber::MAX);
+    lossList.append(last - 1, last);
+    lossList.append(last + 1, last + 2);
+    QCOMPARE(rangesOf(lossList), Ranges({ { SequenceNumber::MAX - 1, 1 } }));
+    QCOMPARE(lossList.popFirstSequenceNumber(), last - 1);
+    QCOMPARE(lossList.popFirstSequenceNumber(), last);
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(0));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(1));
+    QVERIFY(lossList.isEmpty());
+}
@@ -0,0 +1,34 @@
+//
+//  LossListTests.h
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LossListTests_h
+#define hifi_LossListTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class LossListTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test inserting ranges before, between, over and next to the ones held
+    void insertTest();
+
+    // Test that inserted ranges touching the ones held are merged with them
+    void mergeTest();
+
+    // Test removing single sequence numbers and ranges, splitting the ranges held
+    void removeTest();
+
+    // Test popping the first sequence number from one range into the next
+    void popTest();
+};
+
+#endif // hifi_LossListTests_h
@@ -0,0 +1,225 @@
+//
+//  PacketReceiverTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketReceiverTests.h"
+
+#include <DependencyManager.h>
+#include <NLPacket.h>
+#include <NodeList.h>
+
+QTEST_MAIN(PacketReceiverTests)
+
+// non-sourced, so that delivering them doesn't need a NodeList
+static const PacketType HANDLED_TYPE = PacketType::ICEPing;
+static const PacketType OTHER_TYPE = PacketType::ICEPingReply;
+
+static const PacketType SOURCED_TYPE = PacketType::OctreeDataNack;
+
+// the packets a message of this data would arrive as, split into payloads of at most payloadSize bytes
+static std::vector<std::unique_ptr<udt::Packet>> receivedPackets(PacketType type, const QByteArray& message,
+                                                                 int payloadSize = 1000,
+                                                                 const QUuid& sourceID = QUuid()) {
+    std::vector<std::unique_ptr<udt::Packet>> packets;
+    int numPackets = std::max(1, (message.size() + payloadSize - 1) / payloadSize);
+    for (int i = 0; i < numPackets; i++) {
+        auto packet = NLPacket::create(type, -1, true, numPackets > 1);
+        packet->write(message.mid(i * payloadSize, payloadSize));
+        if (!sourceID.isNull()) {
+            packet->writeSourceID(sourceID);
+        }
+
+        if (numPackets > 1) {
+            udt::Packet::PacketPosition position = udt::Packet::PacketPosition::MIDDLE;
+            if (i == 0) {
+                position = udt::Packet::PacketPosition::FIRST;
+            } else if (i == numPackets - 1) {
+                position = udt::Packet::PacketPosition::LAST;
+            }
+            packet->writeMessageNumber(1, position, i);
+        }
+
+        auto size = packet->getDataSize();
+        auto data = std::unique_ptr<char[]>(new char[size]);
+        memcpy(data.get(), packet->getData(), size);
+        packets.push_back(udt::Packet::fromReceivedPacket(std::move(data), size, HifiSockAddr()));
+    }
+    return packets;
+}
+
+void PacketReceiverTests::packetHandlerTest() {
+    PacketReceiver receiver;
+    QByteArray data(100, 'a');
+
+    int numCalls = 0;
+    QByteArray received;
+    receiver.registerPacketHandler({ HANDLED_TYPE }, [&](ReceivedMessage& message, SharedNodePointer sendingNode) {
+        ++numCalls;
+        QVERIFY(message.isComplete());
+        QCOMPARE(message.getType(), HANDLED_TYPE);
+        received = message.getMessage();
+    });
+
+    receiver.handleVerifiedPacket(std::move(receivedPackets(HANDLED_TYPE, data).front()));
+    QCOMPARE(numCalls, 1);
+    QCOMPARE(received, data);
+
+    // other types don't reach it
+    receiver.handleVerifiedPacket(std::move(receivedPackets(OTHER_TYPE, data).front()));
+    QCOMPARE(numCalls, 1);
+}
+
+void PacketReceiverTests::messageHandlerTest() {
+    QByteArray data(2500, 'b');
+
+    // delivered once all of the message is in
+    {
+        PacketReceiver receiver;
+        int numCalls = 0;
+        receiver.registerMessageHandler({ HANDLED_TYPE }, [&](QSharedPointer<ReceivedMessage> message,
+                                                               SharedNodePointer sendingNode) {
+            ++numCalls;
+            QVERIFY(message->isComplete());
+            QCOMPARE(message->getMessage(), data);
+        });
+
+        auto packets = receivedPackets(HANDLED_TYPE, data);
+        QCOMPARE((int)packets.size(), 3);
+        for (auto& packet : packets) {
+            QCOMPARE(numCalls, 0);
+            receiver.handleVerifiedMessagePacket(std::move(packet));
+        }
+        QCOMPARE(numCalls, 1);
+    }
+
+    // delivered with the first packet, and filled in as the rest arrive
+    {
+        PacketReceiver receiver;
+        int numCalls = 0;
+        QSharedPointer<ReceivedMessage> pendingMessage;
+        receiver.registerMessageHandler({ HANDLED_TYPE }, [&](QSharedPointer<ReceivedMessage> message,
+                                                               SharedNodePointer sendingNode) {
+            ++numCalls;
+            QVERIFY(!message->isComplete());
+            pendingMessage = message;
+        }, true);
+
+        for (auto& packet : receivedPackets(HANDLED_TYPE, data)) {
+            receiver.handleVerifiedMessagePacket(std::move(packet));
+            QCOMPARE(numCalls, 1);
+        }
+        QVERIFY(pendingMessage->isComplete());
+        QCOMPARE(pendingMessage->getMessage(), data);
+    }
+
+    // a packet handler only ever gets the complete message
+    {
+        PacketReceiver receiver;
+        int numCalls = 0;
+        receiver.registerPacketHandler({ HANDLED_TYPE }, [&](ReceivedMessage& message, SharedNodePointer sendingNode) {
+            ++numCalls;
+            QVERIFY(message.isComplete());
+            QCOMPARE(message.getMessage(), data);
+        });
+
+        for (auto& packet : receivedPackets(HANDLED_TYPE, data)) {
+            receiver.handleVerifiedMessagePacket(std::move(packet));
+        }
+        QCOMPARE(numCalls, 1);
+    }
+}
+
+void PacketReceiverTests::handlerPrecedenceTest() {
+    PacketReceiver receiver;
+    TestListener listener;
+    QVERIFY(receiver.registerListener(HANDLED_TYPE, &listener, "listenMessage"));
+
+    receiver.handleVerifiedPacket(std::move(receivedPackets(HANDLED_TYPE, QByteArray(10, 'c')).front()));
+    QCOMPARE(listener.numListenedMessages, 1);
+
+    // the handler takes over from the listener
+    receiver.registerPacketHandler({ HANDLED_TYPE }, &listener, &TestListener::handlePacket);
+    receiver.handleVerifiedPacket(std::move(receivedPackets(HANDLED_TYPE, QByteArray(10, 'c')).front()));
+    QCOMPARE(listener.numHandledPackets, 1);
+    QCOMPARE(listener.numListenedMessages, 1);
+}
+
+void PacketReceiverTests::droppedHandlerTest() {
+    PacketReceiver receiver;
+
+    // destroyed without unregistering
+    {
+        auto listener = new TestListener();
+        receiver.registerPacketHandler({ HANDLED_TYPE }, listener, &TestListener::handlePacket);
+        receiver.handleVerifiedPacket(std::move(receivedPackets(HANDLED_TYPE, QByteArray(10, 'd')).front()));
+        QCOMPARE(listener->numHandledPackets, 1);
+        delete listener;
+
+        // this would crash if it still reached the listener
+        receiver.handleVerifiedPacket(std::move(receivedPackets(HANDLED_TYPE, QByteArray(10, 'd')).front()));
+    }
+
+    // unregistered
+    {
+        TestListener listener;
+        receiver.registerPacketHandler({ HANDLED_TYPE, OTHER_TYPE }, &listener, &TestListener::handlePacket);
+        receiver.handleVerifiedPacket(std::move(receivedPackets(OTHER_TYPE, QByteArray(10, 'd')).front()));
+        QCOMPARE(listener.numHandledPackets, 1);
+
+        receiver.unregisterListener(&listener);
+        receiver.handleVerifiedPacket(std::move(receivedPackets(HANDLED_TYPE, QByteArray(10, 'd')).front()));
+        receiver.handleVerifiedPacket(std::move(receivedPackets(OTHER_TYPE, QByteArray(10, 'd')).front()));
+        QCOMPARE(listener.numHandledPackets, 1);
+    }
+
+    // unregistered from inside its own call, which must not wait on itself
+    {
+        TestListener listener;
+        listener.receiver = &receiver;
+        receiver.registerPacketHandler({ HANDLED_TYPE }, &listener, &TestListener::handlePacketAndUnregister);
+        receiver.handleVerifiedPacket(std::move(receivedPackets(HANDLED_TYPE, QByteArray(10, 'd')).front()));
+        receiver.handleVerifiedPacket(std::move(receivedPackets(HANDLED_TYPE, QByteArray(10, 'd')).front()));
+        QCOMPARE(listener.numHandledPackets, 1);
+    }
+}
+
+void PacketReceiverTests::unknownSourceTest() {
+    // the sending node is looked up in the NodeList, which has never heard of this one
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+    QUuid unknownSourceID = QUuid::createUuid();
+
+    PacketReceiver receiver;
+    int numCalls = 0;
+    receiver.registerPacketHandler({ SOURCED_TYPE }, [&](ReceivedMessage& message, SharedNodePointer sendingNode) {
+        ++numCalls;
+    });
+    receiver.handleVerifiedPacket(std::move(receivedPackets(SOURCED_TYPE, QByteArray(10, 'e'), 1000,
+                                                            unknownSourceID).front()));
+    QCOMPARE(numCalls, 0);
+
+    receiver.registerMessageHandler({ SOURCED_TYPE }, [&](QSharedPointer<ReceivedMessage> message,
+                                                          SharedNodePointer sendingNode) {
+        ++numCalls;
+    });
+    for (auto& packet : receivedPackets(SOURCED_TYPE, QByteArray(2500, 'e'), 1000, unknownSourceID)) {
+        receiver.handleVerifiedMessagePacket(std::move(packet));
+    }
+    QCOMPARE(numCalls, 0);
+
+    // non-sourced packets still get through without a node
+    receiver.registerPacketHandler({ HANDLED_TYPE }, [&](ReceivedMessage& message, SharedNodePointer sendingNode) {
+        QVERIFY(!sendingNode);
+        ++numCalls;
+    });
+    receiver.handleVerifiedPacket(std::move(receivedPackets(HANDLED_TYPE, QByteArray(10, 'e')).front()));
+    QCOMPARE(numCalls, 1);
+
+    DependencyManager::destroy<NodeList>();
+}
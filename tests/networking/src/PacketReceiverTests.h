@@ -0,0 +1,59 @@
+//
+//  PacketReceiverTests.h
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketReceiverTests_h
+#define hifi_PacketReceiverTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+#include <Node.h>
+#include <PacketReceiver.h>
+#include <ReceivedMessage.h>
+
+// counts what reaches it through the receiver's handlers and slots
+class TestListener : public QObject {
+    Q_OBJECT
+public:
+    void handlePacket(ReceivedMessage& message, SharedNodePointer sendingNode) { ++numHandledPackets; }
+    void handlePacketAndUnregister(ReceivedMessage& message, SharedNodePointer sendingNode) {
+        ++numHandledPackets;
+        receiver->unregisterListener(this);
+    }
+
+    PacketReceiver* receiver { nullptr };
+    int numHandledPackets { 0 };
+    int numListenedMessages { 0 };
+
+public slots:
+    void listenMessage(QSharedPointer<ReceivedMessage> message) { ++numListenedMessages; }
+};
+
+class PacketReceiverTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test a single packet handed to a PacketHandler
+    void packetHandlerTest();
+
+    // Test messages of several packets, delivered complete or as soon as they start
+    void messageHandlerTest();
+
+    // Test that a handler is called instead of a listener registered for the same type
+    void handlerPrecedenceTest();
+
+    // Test that handlers of a listener are dropped once it is destroyed or unregistered
+    void droppedHandlerTest();
+
+    // Test that a sourced packet from a node we don't know doesn't reach the handlers
+    void unknownSourceTest();
+};
+
+#endif // hifi_PacketReceiverTests_h
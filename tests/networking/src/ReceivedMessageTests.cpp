@@ -0,0 +1,165 @@
+//
+//  ReceivedMessageTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReceivedMessageTests.h"
+
+#include <NLPacket.h>
+#include <ReceivedMessage.h>
+#include <udt/PacketBufferPool.h>
+
+QTEST_MAIN(ReceivedMessageTests)
+
+static const PacketType MESSAGE_TYPE = PacketType::EntityEdit;
+
+// the packets a message of this data would be received as, split into payloads of at most payloadSize bytes
+std::vector<std::unique_ptr<NLPacket>> receivedPackets(const QByteArray& message, int payloadSize) {
+    std::vector<std::unique_ptr<NLPacket>> packets;
+    int numPackets = std::max(1, (message.size() + payloadSize - 1) / payloadSize);
+    for (int i = 0; i < numPackets; i++) {
+        auto packet = NLPacket::create(MESSAGE_TYPE, -1, true, true);
+        packet->write(message.mid(i * payloadSize, payloadSize));
+
+        udt::Packet::PacketPosition position = udt::Packet::PacketPosition::MIDDLE;
+        if (numPackets == 1) {
+            position = udt::Packet::PacketPosition::ONLY;
+        } else if (i == 0) {
+            position = udt::Packet::PacketPosition::FIRST;
+        } else if (i == numPackets - 1) {
+            position = udt::Packet::PacketPosition::LAST;
+        }
+        packet->writeMessageNumber(1, position, i);
+
+        auto size = packet->getDataSize();
+        auto data = std::unique_ptr<char[]>(new char[size]);
+        memcpy(data.get(), packet->getData(), size);
+        packets.push_back(NLPacket::fromReceivedPacket(std::move(data), size, HifiSockAddr()));
+    }
+    return packets;
+}
+
+QByteArray testData(int size) {
+    QByteArray data;
+    for (int i = 0; i < size; i++) {
+        data.append((char)(i % 251));
+    }
+    return data;
+}
+
+void ReceivedMessageTests::singlePacketTest() {
+    QByteArray data = testData(100);
+    auto packets = receivedPackets(data, 1000);
+    ReceivedMessage message(std::move(packets.front()));
+
+    QVERIFY(message.isComplete());
+    QCOMPARE(message.getType(), MESSAGE_TYPE);
+    QCOMPARE(message.getSize(), (qint64)data.size());
+    QCOMPARE(message.getNumPackets(), (qint64)1);
+
+    uint32_t first;
+    message.readPrimitive(&first);
+    QCOMPARE(memcmp(&first, data.constData(), sizeof(first)), 0);
+    QCOMPARE(message.getBytesLeftToRead(), (qint64)(data.size() - sizeof(first)));
+    QCOMPARE(message.readAll(), data.mid(sizeof(first)));
+    QCOMPARE(QByteArray(message.getRawMessage(), (int)message.getSize()), data);
+}
+
+void ReceivedMessageTests::readAcrossPacketsTest() {
+    const int PAYLOAD_SIZE = 10;
+    QByteArray data = testData(95);
+    auto packets = receivedPackets(data, PAYLOAD_SIZE);
+    QCOMPARE(packets.size(), (size_t)10);
+
+    ReceivedMessage message(std::move(packets.front()));
+    QVERIFY(!message.isComplete());
+    for (size_t i = 1; i < packets.size(); i++) {
+        message.appendPacket(std::move(packets[i]));
+    }
+    QVERIFY(message.isComplete());
+    QCOMPARE(message.getSize(), (qint64)data.size());
+    QCOMPARE(message.getNumPackets(), (qint64)10);
+
+    // a primitive split over two packets
+    message.seek(8);
+    uint32_t value;
+    message.readPrimitive(&value);
+    QCOMPARE(memcmp(&value, data.constData() + 8, sizeof(value)), 0);
+
+    // a read over several packets, and a peek that doesn't move the position
+    QCOMPARE(message.peek(25), data.mid(12, 25));
+    QCOMPARE(message.read(25), data.mid(12, 25));
+    QCOMPARE(message.getPosition(), (qint64)37);
+
+    // reads past the end stop there
+    message.seek(90);
+    QCOMPARE(message.read(20), data.mid(90));
+    QCOMPARE(message.getBytesLeftToRead(), (qint64)0);
+
+    // a string that crosses a packet boundary
+    QString string("a string longer than one packet");
+    QByteArray stringData = string.toUtf8();
+    uint32_t length = stringData.size();
+    QByteArray stringMessage = QByteArray(reinterpret_cast<const char*>(&length), sizeof(length)) + stringData;
+    auto stringPackets = receivedPackets(stringMessage, PAYLOAD_SIZE);
+    ReceivedMessage received(std::move(stringPackets.front()));
+    for (size_t i = 1; i < stringPackets.size(); i++) {
+        received.appendPacket(std::move(stringPackets[i]));
+    }
+    QCOMPARE(received.readString(), string);
+}
+
+void ReceivedMessageTests::contiguousMessageTest() {
+    const int PAYLOAD_SIZE = 16;
+    QByteArray data = testData(200);
+    auto packets = receivedPackets(data, PAYLOAD_SIZE);
+
+    ReceivedMessage message(std::move(packets.front()));
+    message.appendPacket(std::move(packets[1]));
+
+    // what has been received so far, in one piece, with more still to come
+    QCOMPARE(message.readAvailable(), data.left(2 * PAYLOAD_SIZE));
+    QCOMPARE(message.getMessage(), data.left(2 * PAYLOAD_SIZE));
+    const char* rawMessage = message.getRawMessage();
+
+    for (size_t i = 2; i < packets.size(); i++) {
+        message.appendPacket(std::move(packets[i]));
+    }
+    QCOMPARE(message.readAvailable(), data.mid(2 * PAYLOAD_SIZE));
+    QCOMPARE(message.getMessage(), data);
+    QCOMPARE(QByteArray(message.getRawMessage(), (int)message.getSize()), data);
+
+    // copying the whole message into one piece again left the earlier raw pointer valid
+    QCOMPARE(QByteArray(rawMessage, 2 * PAYLOAD_SIZE), data.left(2 * PAYLOAD_SIZE));
+
+    message.seek(PAYLOAD_SIZE - 2);
+    QCOMPARE(message.readWithoutCopy(PAYLOAD_SIZE), data.mid(PAYLOAD_SIZE - 2, PAYLOAD_SIZE));
+}
+
+void ReceivedMessageTests::packetBufferPoolTest() {
+    auto& pool = udt::PacketBufferPool::getInstance();
+
+    const char* buffer;
+    {
+        auto packet = NLPacket::create(MESSAGE_TYPE);
+        buffer = packet->getData();
+        packet->write(testData(100));
+    }
+    size_t numPooled = pool.getNumPooledBuffers();
+    QVERIFY(numPooled > 0);
+
+    // the next full size packet gets the same buffer back, zeroed
+    auto packet = NLPacket::create(MESSAGE_TYPE);
+    QCOMPARE(packet->getData(), buffer);
+    QCOMPARE(pool.getNumPooledBuffers(), numPooled - 1);
+    QCOMPARE(packet->getPayload()[1], (char)0);
+
+    // smaller packets don't use the pool
+    auto smallPacket = NLPacket::create(MESSAGE_TYPE, 10);
+    QCOMPARE(pool.getNumPooledBuffers(), numPooled - 1);
+}
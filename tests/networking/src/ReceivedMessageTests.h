@@ -0,0 +1,34 @@
+//
+//  ReceivedMessageTests.h
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReceivedMessageTests_h
+#define hifi_ReceivedMessageTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class ReceivedMessageTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test a message that came in one packet
+    void singlePacketTest();
+
+    // Test reads that cross from one packet of a message to the next
+    void readAcrossPacketsTest();
+
+    // Test the message in one piece, after and while it is received
+    void contiguousMessageTest();
+
+    // Test that full size packet buffers are reused
+    void packetBufferPoolTest();
+};
+
+#endif // hifi_ReceivedMessageTests_h
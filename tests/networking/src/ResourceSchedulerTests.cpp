@@ -0,0 +1,125 @@
+//
+//  ResourceSchedulerTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceSchedulerTests.h"
+
+#include <memory>
+#include <vector>
+
+#include "DependencyManager.h"
+#include "ResourceCache.h"
+
+QTEST_MAIN(ResourceSchedulerTests)
+
+using ResourcePointer = std::unique_ptr<Resource>;
+
+// resources queued behind a zero request limit, so that nothing is actually requested
+static std::vector<ResourcePointer> makePendingResources(const QString& baseUrl, int count) {
+    std::vector<ResourcePointer> resources;
+    for (int i = 0; i < count; i++) {
+        resources.emplace_back(new Resource(QUrl(baseUrl + QString::number(i)), true));
+        resources.back()->ensureLoading();
+    }
+    return resources;
+}
+
+void ResourceSchedulerTests::init() {
+    auto sharedItems = DependencyManager::set<ResourceCacheSharedItems>();
+    sharedItems->setRequestLimit(ResourceProtocol::File, 0);
+    sharedItems->setRequestLimit(ResourceProtocol::Http, 0);
+    sharedItems->setRequestLimit(ResourceProtocol::Atp, 0);
+}
+
+void ResourceSchedulerTests::testProtocols() {
+    QVERIFY(ResourceManager::getProtocol(QUrl("file:///tmp/model.fbx")) == ResourceProtocol::File);
+    QVERIFY(ResourceManager::getProtocol(QUrl("http://example.com/model.fbx")) == ResourceProtocol::Http);
+    QVERIFY(ResourceManager::getProtocol(QUrl("https://example.com/model.fbx")) == ResourceProtocol::Http);
+    QVERIFY(ResourceManager::getProtocol(QUrl("atp:0123456789abcdef.fbx")) == ResourceProtocol::Atp);
+}
+
+void ResourceSchedulerTests::testPriorityOrder() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto resources = makePendingResources("http://example.com/", 5);
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)5);
+    QCOMPARE(sharedItems->getPendingRequestsCount(ResourceProtocol::Http), (uint32_t)5);
+
+    // still at the limit
+    QVERIFY(sharedItems->getHighestPendingRequest() == nullptr);
+
+    QObject owner;
+    resources[3]->setLoadPriority(&owner, 2.0f);
+    resources[1]->setLoadPriority(&owner, 1.0f);
+    sharedItems->setRequestLimit(ResourceProtocol::Http, 1);
+
+    // highest priority first, then in the order they were queued
+    QVERIFY(sharedItems->getHighestPendingRequest() == resources[3].get());
+    QVERIFY(sharedItems->getHighestPendingRequest() == resources[1].get());
+    QVERIFY(sharedItems->getHighestPendingRequest() == resources[0].get());
+
+    // destroyed resources are skipped
+    resources[2].reset();
+    QVERIFY(sharedItems->getHighestPendingRequest() == resources[4].get());
+    QVERIFY(sharedItems->getHighestPendingRequest() == nullptr);
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)0);
+}
+
+void ResourceSchedulerTests::testReprioritize() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto resources = makePendingResources("http://example.com/", 4);
+
+    QObject near, far;
+    for (auto& resource : resources) {
+        resource->setLoadPriority(&far, 0.1f);
+    }
+    resources[2]->setLoadPriority(&near, 0.5f);
+
+    // the viewer moved, so another resource is now the nearest
+    resources[0]->setLoadPriority(&far, 0.9f);
+    resources[2]->clearLoadPriority(&near);
+
+    sharedItems->setRequestLimit(ResourceProtocol::Http, 1);
+    QVERIFY(sharedItems->getHighestPendingRequest() == resources[0].get());
+    QVERIFY(sharedItems->getHighestPendingRequest() == resources[1].get());
+}
+
+void ResourceSchedulerTests::testProtocolLimits() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto fileResources = makePendingResources("file:///tmp/model", 2);
+    auto httpResources = makePendingResources("http://example.com/", 2);
+
+    QObject owner;
+    httpResources[0]->setLoadPriority(&owner, 10.0f);
+
+    // a busy protocol doesn't hold back the others
+    sharedItems->setRequestLimit(ResourceProtocol::File, 1);
+    sharedItems->setRequestLimit(ResourceProtocol::Http, 1);
+    Resource active(QUrl("http://example.com/active"), true);
+    sharedItems->appendActiveRequest(&active);
+    QCOMPARE(sharedItems->getLoadingRequestsCount(ResourceProtocol::Http), 1);
+    QVERIFY(!sharedItems->isBelowRequestLimit(ResourceProtocol::Http));
+    QVERIFY(sharedItems->isBelowRequestLimit(ResourceProtocol::File));
+
+    QVERIFY(sharedItems->getHighestPendingRequest() == fileResources[0].get());
+    QVERIFY(sharedItems->getHighestPendingRequest() == fileResources[1].get());
+    QVERIFY(sharedItems->getHighestPendingRequest() == nullptr);
+
+    sharedItems->removeRequest(&active);
+    QCOMPARE(sharedItems->getLoadingRequestsCount(ResourceProtocol::Http), 0);
+    QVERIFY(sharedItems->getHighestPendingRequest() == httpResources[0].get());
+}
+
+void ResourceSchedulerTests::testTimeToFirstByte() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    QCOMPARE(sharedItems->getAverageTimeToFirstByte(ResourceProtocol::Atp), 0.0f);
+
+    sharedItems->recordTimeToFirstByte(ResourceProtocol::Atp, 2000);
+    QCOMPARE(sharedItems->getAverageTimeToFirstByte(ResourceProtocol::Atp), 2.0f);
+    QCOMPARE(sharedItems->getAverageTimeToFirstByte(ResourceProtocol::Http), 0.0f);
+}
@@ -0,0 +1,27 @@
+//
+//  ResourceSchedulerTests.h
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceSchedulerTests_h
+#define hifi_ResourceSchedulerTests_h
+
+#include <QtTest/QtTest>
+
+class ResourceSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void init();
+    void testProtocols();
+    void testPriorityOrder();
+    void testReprioritize();
+    void testProtocolLimits();
+    void testTimeToFirstByte();
+};
+
+#endif // hifi_ResourceSchedulerTests_h
@@ -0,0 +1,105 @@
+//
+//  SentPacketBufferTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketBufferTests.h"
+
+#include <udt/Packet.h>
+#include <udt/SentPacketBuffer.h>
+
+QTEST_MAIN(SentPacketBufferTests)
+
+using namespace udt;
+
+// packets are told apart by their first payload byte
+void insertPacket(SentPacketBuffer& buffer, SequenceNumber sequenceNumber, char tag) {
+    auto packet = Packet::create(1);
+    packet->writePrimitive(tag);
+    buffer.insert(sequenceNumber, std::move(packet));
+}
+
+char tagOf(SentPacketBuffer& buffer, SequenceNumber sequenceNumber) {
+    auto entry = buffer.find(sequenceNumber);
+    return (entry && entry->second) ? entry->second->getPayload()[0] : -1;
+}
+
+void SentPacketBufferTests::insertFindRemoveTest() {
+    SentPacketBuffer buffer;
+    QVERIFY(buffer.isEmpty());
+    QVERIFY(!buffer.find(SequenceNumber(0)));
+
+    SequenceNumber first(100);
+    for (int i = 0; i < 10; ++i) {
+        insertPacket(buffer, first + i, (char)i);
+    }
+    QCOMPARE(buffer.getSize(), 10);
+    QCOMPARE(tagOf(buffer, first), (char)0);
+    QCOMPARE(tagOf(buffer, first + 9), (char)9);
+    QVERIFY(!buffer.find(first - 1));
+    QVERIFY(!buffer.find(first + 10));
+
+    // the resend count is kept with the packet
+    ++buffer.find(first + 3)->first;
+    QCOMPARE(buffer.find(first + 3)->first, (uint8_t)1);
+
+    // an ACK for packets already ACKed does nothing
+    buffer.removeUpTo(first - 5);
+    QCOMPARE(buffer.getSize(), 10);
+
+    buffer.removeUpTo(first + 4);
+    QCOMPARE(buffer.getSize(), 5);
+    QVERIFY(!buffer.find(first + 4));
+    QCOMPARE(tagOf(buffer, first + 5), (char)5);
+
+    // an ACK past what was sent clears everything
+    buffer.removeUpTo(first + 20);
+    QVERIFY(buffer.isEmpty());
+
+    // and the next packet can start anywhere
+    insertPacket(buffer, SequenceNumber(5000), 42);
+    QCOMPARE(tagOf(buffer, SequenceNumber(5000)), (char)42);
+}
+
+void SentPacketBufferTests::growTest() {
+    SentPacketBuffer buffer;
+    SequenceNumber first(1000);
+    const int NUM_PACKETS = 3000;
+    for (int i = 0; i < NUM_PACKETS; ++i) {
+        insertPacket(buffer, first + i, (char)(i % 100));
+        if (i == 10) {
+            // the front moves while the ring is still small
+            buffer.removeUpTo(first + 4);
+        }
+    }
+    QCOMPARE(buffer.getSize(), NUM_PACKETS - 5);
+    QVERIFY(buffer.getCapacity() >= buffer.getSize());
+    for (int i = 5; i < NUM_PACKETS; ++i) {
+        QCOMPARE(tagOf(buffer, first + i), (char)(i % 100));
+    }
+
+    // a ring that grew for a burst is given back once it is empty
+    buffer.removeUpTo(first + NUM_PACKETS - 1);
+    QVERIFY(buffer.isEmpty());
+    QCOMPARE(buffer.getCapacity(), 0);
+}
+
+void SentPacketBufferTests::wrapTest() {
+    SentPacketBuffer buffer;
+    SequenceNumber first(SequenceNumber::MAX - 20);
+    for (int i = 0; i < 50; ++i) {
+        insertPacket(buffer, first + i, (char)i);
+    }
+    QCOMPARE(tagOf(buffer, SequenceNumber(SequenceNumber::MAX)), (char)20);
+    QCOMPARE(tagOf(buffer, SequenceNumber(0)), (char)21);
+
+    buffer.removeUpTo(SequenceNumber(2));
+    QCOMPARE(buffer.getSize(), 26);
+    QVERIFY(!buffer.find(SequenceNumber(SequenceNumber::MAX)));
+    QCOMPARE(tagOf(buffer, SequenceNumber(3)), (char)24);
+}
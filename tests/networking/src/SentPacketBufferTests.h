@@ -0,0 +1,31 @@
+//
+//  SentPacketBufferTests.h
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SentPacketBufferTests_h
+#define hifi_SentPacketBufferTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class SentPacketBufferTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test inserting, finding and ACKing packets
+    void insertFindRemoveTest();
+
+    // Test that held packets survive the ring growing
+    void growTest();
+
+    // Test sequence numbers wrapping around inside the ring
+    void wrapTest();
+};
+
+#endif // hifi_SentPacketBufferTests_h
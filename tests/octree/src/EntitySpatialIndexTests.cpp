@@ -0,0 +1,178 @@
+//
+//  EntitySpatialIndexTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndexTests.h"
+
+#include <EntitySpatialIndex.h>
+#include <EntityTree.h>
+#include <SharedUtil.h>
+
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(EntitySpatialIndexTests)
+
+const int GRID_SIZE = 10;
+const float GRID_SPACING = 4.0f;
+const glm::vec3 GRID_CORNER(100.0f);
+
+// a grid of one meter boxes, GRID_SPACING meters apart
+static EntityTreePointer createGridTree() {
+    auto tree = std::make_shared<EntityTree>();
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setDimensions(glm::vec3(1.0f));
+    for (int x = 0; x < GRID_SIZE; x++) {
+        for (int y = 0; y < GRID_SIZE; y++) {
+            for (int z = 0; z < GRID_SIZE; z++) {
+                properties.setPosition(GRID_CORNER + glm::vec3(x, y, z) * GRID_SPACING);
+                tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+            }
+        }
+    }
+    return tree;
+}
+
+static QSet<EntityItem*> toSet(const QVector<EntityItemPointer>& entities) {
+    QSet<EntityItem*> set;
+    for (auto& entity : entities) {
+        set.insert(entity.get());
+    }
+    return set;
+}
+
+void EntitySpatialIndexTests::testMatchesSingleQueries() {
+    auto tree = createGridTree();
+
+    QVector<EntitySpatialQuery> queries;
+    const int NUM_QUERIES = 20;
+    for (int i = 0; i < NUM_QUERIES; i++) {
+        glm::vec3 position = GRID_CORNER + glm::vec3(i * 1.7f, i * 2.3f, i * 0.9f);
+        queries.push_back(EntitySpatialQuery::sphere(position, 0.5f + i * 0.5f));
+        queries.push_back(EntitySpatialQuery::box(AABox(position, glm::vec3(1.0f + i, 2.0f, 3.0f + i * 0.5f))));
+    }
+    // one far away from every entity
+    queries.push_back(EntitySpatialQuery::sphere(glm::vec3(-1000.0f), 1.0f));
+
+    QVector<EntitySpatialQueryResult> results;
+    tree->findEntities(queries, results);
+    QCOMPARE(results.size(), queries.size());
+
+    int numFound = 0;
+    for (int i = 0; i < queries.size(); i++) {
+        const EntitySpatialQuery& query = queries[i];
+        QVector<EntityItemPointer> expected;
+        if (query.type == EntitySpatialQuery::Sphere) {
+            tree->findEntities(query.position, query.radius, expected);
+        } else {
+            tree->findEntities(AABox(query.position, query.vector), expected);
+        }
+        QCOMPARE(results[i].entities.size(), expected.size());
+        QCOMPARE(toSet(results[i].entities), toSet(expected));
+        numFound += expected.size();
+    }
+    QVERIFY(numFound > 0);
+    QVERIFY(results.last().entities.isEmpty());
+}
+
+void EntitySpatialIndexTests::testRayFindsClosest() {
+    auto tree = createGridTree();
+
+    // down a row of the grid, and past it
+    glm::vec3 origin = GRID_CORNER - glm::vec3(10.0f, 0.0f, 0.0f);
+    QVector<EntitySpatialQuery> queries;
+    queries.push_back(EntitySpatialQuery::ray(origin, glm::vec3(1.0f, 0.0f, 0.0f)));
+    queries.push_back(EntitySpatialQuery::ray(origin, glm::vec3(-1.0f, 0.0f, 0.0f)));
+
+    EntitySpatialIndex index;
+    tree->withReadLock([&] {
+        index.build(tree->getRoot());
+    });
+    QCOMPARE(index.getNumEntities(), GRID_SIZE * GRID_SIZE * GRID_SIZE);
+
+    QVector<EntitySpatialQueryResult> results;
+    index.findEntities(queries, results);
+
+    QCOMPARE(results[0].entities.size(), 1);
+    QCOMPARE(results[0].entities[0]->getPosition(), GRID_CORNER);
+    QCOMPARE(results[0].face, MIN_X_FACE);
+    QCOMPARE(results[0].distance, 9.5f);
+
+    QVERIFY(results[1].entities.isEmpty());
+    QCOMPARE(results[1].distance, FLT_MAX);
+
+    OctreeElementPointer element;
+    float distance;
+    BoxFace face;
+    glm::vec3 surfaceNormal;
+    void* intersectedObject = nullptr;
+    QVERIFY(tree->findRayIntersection(origin, glm::vec3(1.0f, 0.0f, 0.0f), element, distance, face, surfaceNormal,
+                                      QVector<EntityItemID>(), QVector<EntityItemID>(), &intersectedObject));
+    QCOMPARE(intersectedObject, (void*)results[0].entities[0].get());
+    QCOMPARE(distance, results[0].distance);
+}
+
+void EntitySpatialIndexTests::testDeletedEntitiesAreReleased() {
+    auto tree = createGridTree();
+
+    EntitySpatialIndex index;
+    tree->withReadLock([&] {
+        index.build(tree->getRoot());
+    });
+    QVector<EntitySpatialQuery> queries { EntitySpatialQuery::sphere(GRID_CORNER, 0.5f) };
+    QVector<EntitySpatialQueryResult> results;
+    index.findEntities(queries, results);
+    QCOMPARE(results[0].entities.size(), 1);
+
+    // the index mustn't keep the entity alive until it is rebuilt
+    EntityItemWeakPointer deleted = results[0].entities[0];
+    EntityItemID deletedID = results[0].entities[0]->getEntityItemID();
+    results.clear();
+    tree->withWriteLock([&] {
+        tree->deleteEntity(deletedID, true);
+    });
+    QVERIFY(deleted.expired());
+
+    index.findEntities(queries, results);
+    QVERIFY(results[0].entities.isEmpty());
+}
+
+void EntitySpatialIndexTests::benchmarkBatchedQueries() {
+    auto tree = createGridTree();
+
+    const int NUM_QUERIES = 200;
+    QVector<EntitySpatialQuery> queries;
+    for (int i = 0; i < NUM_QUERIES; i++) {
+        glm::vec3 position = GRID_CORNER + glm::vec3((i * 7) % 40, (i * 13) % 40, (i * 3) % 40);
+        queries.push_back(EntitySpatialQuery::sphere(position, 2.0f));
+    }
+
+    quint64 start = usecTimestampNow();
+    int numSingleFound = 0;
+    for (auto& query : queries) {
+        QVector<EntityItemPointer> entities;
+        tree->findEntities(query.position, query.radius, entities);
+        numSingleFound += entities.size();
+    }
+    quint64 singleTime = usecTimestampNow() - start;
+
+    start = usecTimestampNow();
+    QVector<EntitySpatialQueryResult> results;
+    tree->findEntities(queries, results);
+    quint64 batchTime = usecTimestampNow() - start;
+
+    int numBatchFound = 0;
+    for (auto& result : results) {
+        numBatchFound += result.entities.size();
+    }
+    QCOMPARE(numBatchFound, numSingleFound);
+
+    qDebug() << NUM_QUERIES << "sphere queries found" << numBatchFound << "entities, usecs one at a time"
+             << singleTime << ", usecs batched" << batchTime;
+}
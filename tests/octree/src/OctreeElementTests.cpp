@@ -0,0 +1,140 @@
+//
+//  OctreeElementTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeElementTests.h"
+
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <OctalCode.h>
+#include <SharedUtil.h>
+
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(OctreeElementTests)
+
+static void addChildren(const OctreeElementPointer& element, int levels) {
+    if (levels == 0) {
+        return;
+    }
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        addChildren(element->addChildAtIndex(i), levels - 1);
+    }
+}
+
+static int countElements(const OctreeElementPointer& element) {
+    int count = 1;
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        OctreeElementPointer child = element->getChildAtIndex(i);
+        if (child) {
+            count += countElements(child);
+        }
+    }
+    return count;
+}
+
+void OctreeElementTests::testChildStorage() {
+    auto tree = std::make_shared<EntityTree>();
+    OctreeElementPointer root = tree->getRoot();
+    QVERIFY(root->isLeaf());
+
+    // added out of order, so later children land in between earlier ones
+    const int ADD_ORDER[NUMBER_OF_CHILDREN] = { 5, 0, 7, 2, 3, 6, 1, 4 };
+    OctreeElementPointer children[NUMBER_OF_CHILDREN];
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        int childIndex = ADD_ORDER[i];
+        children[childIndex] = root->addChildAtIndex(childIndex);
+        QCOMPARE(root->getChildCount(), i + 1);
+        for (int j = 0; j <= i; j++) {
+            QCOMPARE(root->getChildAtIndex(ADD_ORDER[j]), children[ADD_ORDER[j]]);
+        }
+        for (int j = i + 1; j < NUMBER_OF_CHILDREN; j++) {
+            QVERIFY(!root->getChildAtIndex(ADD_ORDER[j]));
+        }
+    }
+
+    // adding an existing child returns it rather than replacing it
+    QCOMPARE(root->addChildAtIndex(3), children[3]);
+
+    OctreeElementPointer removed = root->removeChildAtIndex(2);
+    QCOMPARE(removed, children[2]);
+    QVERIFY(!root->getChildAtIndex(2));
+    QCOMPARE(root->getChildCount(), NUMBER_OF_CHILDREN - 1);
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        if (i != 2) {
+            QCOMPARE(root->getChildAtIndex(i), children[i]);
+        }
+    }
+
+    for (int i = NUMBER_OF_CHILDREN - 1; i >= 0; i--) {
+        root->deleteChildAtIndex(i);
+        QVERIFY(!root->getChildAtIndex(i));
+    }
+    QVERIFY(root->isLeaf());
+}
+
+void OctreeElementTests::testChildOctalCodes() {
+    auto tree = std::make_shared<EntityTree>();
+    OctreeElementPointer element = tree->getRoot();
+
+    // deep enough for the octal codes to outgrow the element's inline buffer
+    const int NUM_LEVELS = 24;
+    for (int level = 0; level < NUM_LEVELS; level++) {
+        int childIndex = level % NUMBER_OF_CHILDREN;
+        OctreeElementPointer child = element->addChildAtIndex(childIndex);
+        QCOMPARE(child->getLevel(), element->getLevel() + 1);
+        QCOMPARE(branchIndexWithDescendant(element->getOctalCode(), child->getOctalCode()), childIndex);
+        QCOMPARE(child->getScale(), element->getScale() / 2.0f);
+        element = child;
+    }
+}
+
+void OctreeElementTests::benchmarkTreeWalk() {
+    const int NUM_LEVELS = 5;
+    const int NUM_WALKS = 20;
+
+    quint64 memoryBefore = OctreeElement::getTotalMemoryUsage();
+    quint64 childrenMemoryBefore = OctreeElement::getExternalChildrenMemoryUsage();
+    auto tree = std::make_shared<EntityTree>();
+    OctreeElementPointer root = tree->getRoot();
+
+    quint64 start = usecTimestampNow();
+    addChildren(root, NUM_LEVELS);
+    quint64 buildTime = usecTimestampNow() - start;
+    quint64 memoryUsage = OctreeElement::getTotalMemoryUsage() - memoryBefore;
+    quint64 childrenMemoryUsage = OctreeElement::getExternalChildrenMemoryUsage() - childrenMemoryBefore;
+
+    int numElements = 0;
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_WALKS; i++) {
+        numElements = countElements(root);
+    }
+    quint64 walkTime = usecTimestampNow() - start;
+
+    int expectedElements = 0;
+    for (int level = 0, levelElements = 1; level <= NUM_LEVELS; level++, levelElements *= NUMBER_OF_CHILDREN) {
+        expectedElements += levelElements;
+    }
+    QCOMPARE(numElements, expectedElements);
+
+    qDebug() << numElements << "elements, build usecs" << buildTime
+             << ", usecs per walk" << ((float)walkTime / NUM_WALKS)
+             << ", bytes per element" << ((float)memoryUsage / numElements)
+             << "(sizeof(EntityTreeElement)" << sizeof(EntityTreeElement) << ")";
+
+#ifdef COMPACT_CHILD_ARRAY
+    // the layouts are a compile time switch, so the baseline swaps this tree's child storage for the nine inline
+    // pointers every element carries under SIMPLE_EXTERNAL_CHILDREN
+    quint64 compactChildrenMemory = childrenMemoryUsage + numElements * sizeof(OctreeElementPointer*);
+    quint64 externalChildrenMemory = numElements * (NUMBER_OF_CHILDREN + 1) * sizeof(OctreeElementPointer);
+    quint64 baselineMemoryUsage = memoryUsage - compactChildrenMemory + externalChildrenMemory;
+    qDebug() << "SIMPLE_EXTERNAL_CHILDREN baseline, bytes per element" << ((float)baselineMemoryUsage / numElements);
+    QVERIFY(baselineMemoryUsage > memoryUsage);
+#endif
+}
@@ -0,0 +1,24 @@
+//
+//  OctreeElementTests.h
+//  tests/octree/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeElementTests_h
+#define hifi_OctreeElementTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeElementTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testChildStorage();
+    void testChildOctalCodes();
+    void benchmarkTreeWalk();
+};
+
+#endif // hifi_OctreeElementTests_h
@@ -50,6 +50,7 @@ enum ExamplePropertyList {
 };
 
 typedef PropertyFlags<ExamplePropertyList> ExamplePropertyFlags;
+typedef FixedPropertyFlags<ExamplePropertyList, EXAMPLE_PROP_PAUSE_SIMULATION + 1> ExampleFixedPropertyFlags;
 
 QTEST_MAIN(OctreeTests)
 
@@ -480,6 +481,63 @@ typedef ByteCountCoded<quint64> ByteCountCodedQUINT64;
 
 typedef ByteCountCoded<int> ByteCountCodedINT;
 
+void OctreeTests::fixedPropertyFlagsTests() {
+    // every combination of a few flags spread over the list encodes the same way as PropertyFlags
+    const ExamplePropertyList FLAGS[] = { EXAMPLE_PROP_VISIBLE, EXAMPLE_PROP_ANIMATION_URL, EXAMPLE_PROP_VELOCITY,
+                                          EXAMPLE_PROP_PAUSE_SIMULATION };
+    const int NUM_FLAGS = sizeof(FLAGS) / sizeof(FLAGS[0]);
+    for (int combination = 0; combination < (1 << NUM_FLAGS); combination++) {
+        ExamplePropertyFlags props;
+        ExampleFixedPropertyFlags fixedProps;
+        for (int i = 0; i < NUM_FLAGS; i++) {
+            if (combination & (1 << i)) {
+                props += FLAGS[i];
+                fixedProps += FLAGS[i];
+            }
+        }
+        QByteArray encoded = props.encode();
+        QCOMPARE(fixedProps.encode(), encoded);
+
+        uint8_t buffer[ExampleFixedPropertyFlags::MAX_ENCODED_LENGTH];
+        int length = fixedProps.encode(buffer);
+        QCOMPARE(QByteArray((const char*)buffer, length), encoded);
+        QCOMPARE(fixedProps.getEncodedLength(), encoded.size());
+
+        // followed by garbage, as if it was part of a bitstream with more content
+        QByteArray extraContent;
+        extraContent.fill(0xbaU, 10);
+        encoded.append(extraContent);
+
+        ExampleFixedPropertyFlags fixedDecoded;
+        QCOMPARE((int)fixedDecoded.decode(encoded), length);
+        QCOMPARE(fixedDecoded, fixedProps);
+        QCOMPARE(fixedDecoded.getEncodedLength(), length);
+
+        // like PropertyFlags, a copy doesn't take the encoded length with it, and assigning flags keeps it
+        ExampleFixedPropertyFlags fixedCopy(fixedDecoded);
+        QCOMPARE(fixedCopy, fixedDecoded);
+        QCOMPARE(fixedCopy.getEncodedLength(), 0);
+        fixedCopy.encode();
+        fixedCopy = ExampleFixedPropertyFlags();
+        QVERIFY(!fixedCopy);
+        QCOMPARE(fixedCopy.getEncodedLength(), length);
+        for (int flag = 0; flag <= EXAMPLE_PROP_PAUSE_SIMULATION; flag++) {
+            QCOMPARE(fixedDecoded.getHasProperty((ExamplePropertyList)flag),
+                     props.getHasProperty((ExamplePropertyList)flag));
+        }
+    }
+
+    ExampleFixedPropertyFlags props = ExampleFixedPropertyFlags(EXAMPLE_PROP_VISIBLE) | EXAMPLE_PROP_MASS;
+    QCOMPARE(props.firstFlag(), EXAMPLE_PROP_VISIBLE);
+    QCOMPARE(props.lastFlag(), EXAMPLE_PROP_MASS);
+    props -= EXAMPLE_PROP_MASS;
+    QCOMPARE(props.lastFlag(), EXAMPLE_PROP_VISIBLE);
+    QCOMPARE(props.encode(), ExamplePropertyFlags(EXAMPLE_PROP_VISIBLE).encode());
+    props -= EXAMPLE_PROP_VISIBLE;
+    QVERIFY(!props);
+    QCOMPARE(props.encode(), makeQByteArray({ (char) 0 }));
+}
+
 void OctreeTests::byteCountCodingTests() {
     bool verbose = true;
     
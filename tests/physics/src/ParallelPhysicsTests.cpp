@@ -0,0 +1,151 @@
+//
+//  ParallelPhysicsTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParallelPhysicsTests.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <QThread>
+
+#include <ParallelCollisionDispatcher.h>
+#include <PhysicsWorkerPool.h>
+#include <SharedUtil.h>
+#include <ThreadSafeDynamicsWorld.h>
+
+// Add additional qtest functionality (the include order is important!)
+#include "BulletTestUtils.h"
+#include "../QTestExtensions.h"
+
+QTEST_MAIN(ParallelPhysicsTests)
+
+static const btScalar BOX_HALF_EXTENT = 0.5f;
+static const btScalar STACK_SPACING = 3.0f;
+static const btScalar STEP = 1.0f / 60.0f;
+
+// Steps numStacks stacks of numBoxes dynamic boxes on a static floor and returns where every box ended up.  The
+// setup is the same on every call, so any difference between two calls comes from the stepping.
+static std::vector<btTransform> simulateStacks(int numThreads, int numStacks, int numBoxes, int numSteps,
+                                               quint64* stepUsecs = nullptr) {
+    std::unique_ptr<PhysicsWorkerPool> workerPool(numThreads > 0 ? new PhysicsWorkerPool(numThreads) : nullptr);
+    ParallelCollisionConfiguration collisionConfig;
+    ParallelCollisionDispatcher dispatcher(&collisionConfig);
+    btDbvtBroadphase broadphase;
+    btSequentialImpulseConstraintSolver solver;
+    ThreadSafeDynamicsWorld world(&dispatcher, &broadphase, &solver, &collisionConfig);
+    dispatcher.setWorkerPool(workerPool.get());
+    world.setWorkerPool(workerPool.get());
+    world.setGravity(btVector3(0.0f, -9.8f, 0.0f));
+
+    btScalar floorHalfExtent = STACK_SPACING * (btScalar)numStacks;
+    btBoxShape floorShape(btVector3(floorHalfExtent, BOX_HALF_EXTENT, floorHalfExtent));
+    btBoxShape boxShape(btVector3(BOX_HALF_EXTENT, BOX_HALF_EXTENT, BOX_HALF_EXTENT));
+
+    std::vector<std::unique_ptr<btRigidBody>> bodies;
+    auto addBody = [&](btScalar mass, btCollisionShape* shape, const btVector3& position) {
+        btVector3 inertia(0.0f, 0.0f, 0.0f);
+        shape->calculateLocalInertia(mass, inertia);
+        btRigidBody::btRigidBodyConstructionInfo info(mass, nullptr, shape, inertia);
+        info.m_startWorldTransform = btTransform(btQuaternion::getIdentity(), position);
+        bodies.emplace_back(new btRigidBody(info));
+        world.addRigidBody(bodies.back().get());
+    };
+
+    addBody(0.0f, &floorShape, btVector3(0.0f, -BOX_HALF_EXTENT, 0.0f));
+    int side = (int)ceilf(sqrtf((float)numStacks));
+    for (int i = 0; i < numStacks; i++) {
+        btScalar x = STACK_SPACING * (btScalar)(i % side - side / 2);
+        btScalar z = STACK_SPACING * (btScalar)(i / side - side / 2);
+        for (int j = 0; j < numBoxes; j++) {
+            // a little gap between the boxes, so they land on each other
+            btScalar y = BOX_HALF_EXTENT + (2.0f * BOX_HALF_EXTENT + 0.01f) * (btScalar)j;
+            addBody(1.0f, &boxShape, btVector3(x, y, z));
+        }
+    }
+
+    quint64 start = usecTimestampNow();
+    for (int i = 0; i < numSteps; i++) {
+        world.stepSimulationWithSubstepCallback(STEP, 1, STEP);
+    }
+    if (stepUsecs) {
+        *stepUsecs = (usecTimestampNow() - start) / numSteps;
+    }
+
+    std::vector<btTransform> transforms;
+    for (auto& body : bodies) {
+        transforms.push_back(body->getWorldTransform());
+        world.removeRigidBody(body.get());
+    }
+    return transforms;
+}
+
+void ParallelPhysicsTests::testStacksSettle() {
+    const int NUM_STACKS = 9;
+    const int NUM_BOXES = 5;
+    const int NUM_STEPS = 180;
+    const btScalar acceptableError = 0.1f;
+
+    for (int numThreads : { 0, 3 }) {
+        std::vector<btTransform> transforms = simulateStacks(numThreads, NUM_STACKS, NUM_BOXES, NUM_STEPS);
+        QCOMPARE((int)transforms.size(), 1 + NUM_STACKS * NUM_BOXES);
+
+        // every box should be resting on the one below it
+        for (int i = 0; i < NUM_STACKS; i++) {
+            for (int j = 0; j < NUM_BOXES; j++) {
+                const btTransform& transform = transforms[1 + i * NUM_BOXES + j];
+                const btTransform& bottom = transforms[1 + i * NUM_BOXES];
+                btVector3 expected(bottom.getOrigin().getX(), BOX_HALF_EXTENT * (btScalar)(2 * j + 1),
+                                   bottom.getOrigin().getZ());
+                QCOMPARE_WITH_ABS_ERROR(transform.getOrigin(), expected, acceptableError);
+            }
+        }
+    }
+}
+
+void ParallelPhysicsTests::testDeterministicStacks() {
+    const int NUM_STACKS = 16;
+    const int NUM_BOXES = 6;
+    const int NUM_STEPS = 120;
+
+    // however the work lands on the threads, the results must be the same
+    std::vector<btTransform> first = simulateStacks(4, NUM_STACKS, NUM_BOXES, NUM_STEPS);
+    for (int numThreads : { 1, 2, 4 }) {
+        std::vector<btTransform> other = simulateStacks(numThreads, NUM_STACKS, NUM_BOXES, NUM_STEPS);
+        QCOMPARE(other.size(), first.size());
+        for (size_t i = 0; i < first.size(); i++) {
+            QCOMPARE(other[i].getOrigin() == first[i].getOrigin(), true);
+            QCOMPARE(other[i].getRotation() == first[i].getRotation(), true);
+        }
+    }
+
+    // parallel islands are solved in batches of their own, so only the narrowphase is comparable bit for bit
+    if (!ThreadSafeDynamicsWorld::canSolveIslandsInParallel()) {
+        std::vector<btTransform> serial = simulateStacks(0, NUM_STACKS, NUM_BOXES, NUM_STEPS);
+        for (size_t i = 0; i < first.size(); i++) {
+            QCOMPARE(serial[i].getOrigin() == first[i].getOrigin(), true);
+        }
+    }
+}
+
+void ParallelPhysicsTests::benchmarkStackedBoxes() {
+    const int NUM_STACKS = 100;
+    const int NUM_BOXES = 10;
+    const int NUM_STEPS = 120;
+
+    qDebug() << "Stepping" << NUM_STACKS * NUM_BOXES << "stacked boxes," << NUM_STEPS << "steps"
+        << (ThreadSafeDynamicsWorld::canSolveIslandsInParallel() ? "" : "(islands are solved serially)");
+    int maxThreads = std::max(1, QThread::idealThreadCount() - 1);
+    for (int numThreads = 0; numThreads <= maxThreads; numThreads = std::max(1, numThreads * 2)) {
+        quint64 stepUsecs;
+        simulateStacks(numThreads, NUM_STACKS, NUM_BOXES, NUM_STEPS, &stepUsecs);
+        qDebug() << "  " << numThreads << "worker threads:" << stepUsecs << "usecs per step";
+    }
+}
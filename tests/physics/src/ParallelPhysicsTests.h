@@ -0,0 +1,25 @@
+//
+//  ParallelPhysicsTests.h
+//  tests/physics/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParallelPhysicsTests_h
+#define hifi_ParallelPhysicsTests_h
+
+#include <QtTest/QtTest>
+
+class ParallelPhysicsTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testStacksSettle();
+    void testDeterministicStacks();
+    void benchmarkStackedBoxes();
+};
+
+#endif // hifi_ParallelPhysicsTests_h
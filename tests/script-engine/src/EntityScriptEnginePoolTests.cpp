@@ -0,0 +1,93 @@
+//
+//  EntityScriptEnginePoolTests.cpp
+//  tests/script-engine/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptEnginePoolTests.h"
+
+#include <DependencyManager.h>
+#include <EntityScriptEnginePool.h>
+#include <ScriptEngine.h>
+#include <ScriptEngines.h>
+
+QTEST_MAIN(EntityScriptEnginePoolTests)
+
+const int NUM_ENTITIES = 100;
+
+static QVector<EntityItemID> createEntityIDs() {
+    QVector<EntityItemID> entityIDs;
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        entityIDs.push_back(EntityItemID(QUuid::createUuid()));
+    }
+    return entityIDs;
+}
+
+void EntityScriptEnginePoolTests::initTestCase() {
+    // engines add and remove themselves here
+    DependencyManager::set<ScriptEngines>();
+}
+
+void EntityScriptEnginePoolTests::engineReuseTest() {
+    // the engines are never run, so their entity calls stay on this thread
+    QList<ScriptEngine*> created;
+    EntityScriptEnginePool pool(4, [&](ScriptEngine* engine) {
+        created.push_back(engine);
+    });
+    QVERIFY(pool.getNumEngines() >= 1);
+    QVERIFY(pool.getNumEngines() <= 4);
+    QCOMPARE(created.size(), pool.getNumEngines());
+
+    QSet<ScriptEngine*> used;
+    for (auto& entityID : createEntityIDs()) {
+        ScriptEngine* engine = pool.getEngine(entityID);
+        QVERIFY(created.contains(engine));
+        QCOMPARE(pool.getEngine(entityID), engine);
+        used.insert(engine);
+    }
+    QVERIFY(used.size() > 1 || pool.getNumEngines() == 1);
+
+    qDeleteAll(created);
+}
+
+void EntityScriptEnginePoolTests::crashCleanupTest() {
+    QList<ScriptEngine*> created;
+    EntityScriptEnginePool pool(4, [&](ScriptEngine* engine) {
+        created.push_back(engine);
+    });
+
+    auto entityIDs = createEntityIDs();
+    QHash<EntityItemID, ScriptEngine*> before;
+    for (auto& entityID : entityIDs) {
+        before[entityID] = pool.getEngine(entityID);
+    }
+
+    // the application deletes an engine once it stops, after an uncaught error for instance
+    ScriptEngine* crashed = created.takeFirst();
+    delete crashed;
+
+    for (auto& entityID : entityIDs) {
+        ScriptEngine* engine = pool.getEngine(entityID);
+        if (before[entityID] != crashed) {
+            QCOMPARE(engine, before[entityID]);
+        } else if (created.isEmpty()) {
+            QVERIFY(!engine);
+        } else {
+            QVERIFY(created.contains(engine));
+            QCOMPARE(pool.getEngine(entityID), engine);
+        }
+    }
+
+    // with every engine gone, calls are dropped
+    qDeleteAll(created);
+    for (auto& entityID : entityIDs) {
+        QVERIFY(!pool.getEngine(entityID));
+    }
+    pool.callEntityScriptMethod(entityIDs.front(), "preload");
+    pool.unloadAllEntityScripts();
+    pool.disconnectNonEssentialSignals();
+}
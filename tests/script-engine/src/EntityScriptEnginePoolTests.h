@@ -0,0 +1,28 @@
+//
+//  EntityScriptEnginePoolTests.h
+//  tests/script-engine/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptEnginePoolTests_h
+#define hifi_EntityScriptEnginePoolTests_h
+
+#include <QtTest/QtTest>
+
+class EntityScriptEnginePoolTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that an entity keeps getting the same engine, and that every engine is one the pool made
+    void engineReuseTest();
+
+    // Test that the entities of a deleted engine move to one still running, and the others stay put
+    void crashCleanupTest();
+};
+
+#endif // hifi_EntityScriptEnginePoolTests_h
@@ -0,0 +1,134 @@
+//
+//  SpatiallyNestableTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatiallyNestableTests.h"
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <SpatiallyNestable.h>
+
+#include <../GLMTestUtils.h>
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(SpatiallyNestableTests)
+
+const float EPSILON = 0.0001f;
+
+class TestNestable : public SpatiallyNestable {
+public:
+    TestNestable() : SpatiallyNestable(NestableType::Entity, QUuid::createUuid()) {}
+
+    virtual glm::quat getAbsoluteJointRotationInObjectFrame(int index) const override { return glm::quat(); }
+    virtual glm::vec3 getAbsoluteJointTranslationInObjectFrame(int index) const override { return glm::vec3(0.0f); }
+    virtual bool setAbsoluteJointRotationInObjectFrame(int index, const glm::quat& rotation) override { return false; }
+    virtual bool setAbsoluteJointTranslationInObjectFrame(int index, const glm::vec3& translation) override { return false; }
+};
+
+class TestParentFinder : public SpatialParentFinder {
+public:
+    virtual SpatiallyNestableWeakPointer find(QUuid parentID, bool& success) const override {
+        success = true;
+        return _nestables.value(parentID);
+    }
+
+    void add(const SpatiallyNestablePointer& nestable) { _nestables[nestable->getID()] = nestable; }
+
+private:
+    QHash<QUuid, SpatiallyNestableWeakPointer> _nestables;
+};
+
+// a chain of nestables each parented to the previous one, offset by one meter and rotated a little
+static std::vector<std::shared_ptr<TestNestable>> makeChain(int length) {
+    auto finder = DependencyManager::get<TestParentFinder>();
+    std::vector<std::shared_ptr<TestNestable>> chain;
+    for (int i = 0; i < length; i++) {
+        auto nestable = std::make_shared<TestNestable>();
+        finder->add(nestable);
+        if (i > 0) {
+            nestable->setParentID(chain.back()->getID());
+            nestable->setParentJointIndex(65535);
+        }
+        nestable->setLocalPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+        nestable->setLocalOrientation(glm::angleAxis(0.1f, glm::vec3(0.0f, 1.0f, 0.0f)));
+        chain.push_back(nestable);
+    }
+    return chain;
+}
+
+void SpatiallyNestableTests::initTestCase() {
+    DependencyManager::registerInheritance<SpatialParentFinder, TestParentFinder>();
+    DependencyManager::set<TestParentFinder>();
+}
+
+void SpatiallyNestableTests::testCachedTransform() {
+    auto chain = makeChain(3);
+    bool success;
+    glm::vec3 position = chain[2]->getPosition(success);
+    QVERIFY(success);
+
+    SpatiallyNestable::resetWorldTransformCacheStats();
+    QCOMPARE_WITH_ABS_ERROR(chain[2]->getPosition(success), position, EPSILON);
+    QCOMPARE(SpatiallyNestable::getWorldTransformCacheHits(), (quint64)1);
+    QCOMPARE(SpatiallyNestable::getWorldTransformCacheMisses(), (quint64)0);
+
+    // moving the root must move its grandchild
+    chain[0]->setPosition(glm::vec3(0.0f, 5.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(chain[2]->getPosition(success), position + glm::vec3(0.0f, 5.0f, 0.0f), EPSILON);
+    QVERIFY(SpatiallyNestable::getWorldTransformCacheMisses() > 0);
+}
+
+void SpatiallyNestableTests::testParentChangeInvalidatesChildren() {
+    auto chain = makeChain(3);
+    auto other = std::make_shared<TestNestable>();
+    DependencyManager::get<TestParentFinder>()->add(other);
+    other->setPosition(glm::vec3(0.0f, 0.0f, -20.0f));
+
+    bool success;
+    chain[2]->getPosition(success);
+
+    // reparent the middle link, its child has to follow
+    chain[1]->setParentID(other->getID());
+    glm::vec3 expected = other->getPosition() + other->getOrientation() * chain[1]->getLocalPosition();
+    QCOMPARE_WITH_ABS_ERROR(chain[1]->getPosition(success), expected, EPSILON);
+    expected += chain[1]->getOrientation() * chain[2]->getLocalPosition();
+    QCOMPARE_WITH_ABS_ERROR(chain[2]->getPosition(success), expected, EPSILON);
+}
+
+void SpatiallyNestableTests::benchmarkDeepHierarchy() {
+    const int CHAIN_LENGTH = 20;
+    const int NUM_ITERATIONS = 100000;
+    auto chain = makeChain(CHAIN_LENGTH);
+
+    SpatiallyNestable::resetWorldTransformCacheStats();
+    bool success;
+    glm::vec3 sum;
+    quint64 start = usecTimestampNow();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        for (auto& nestable : chain) {
+            sum += nestable->getPosition(success);
+        }
+    }
+    quint64 cachedTime = usecTimestampNow() - start;
+
+    // move the root every iteration, so every read misses
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_ITERATIONS / 10; i++) {
+        chain[0]->setLocalPosition(glm::vec3((float)i, 0.0f, 0.0f));
+        sum += chain.back()->getPosition(success);
+    }
+    quint64 movingTime = usecTimestampNow() - start;
+
+    quint64 hits = SpatiallyNestable::getWorldTransformCacheHits();
+    quint64 misses = SpatiallyNestable::getWorldTransformCacheMisses();
+    qDebug() << CHAIN_LENGTH << "deep x" << NUM_ITERATIONS << ": cached" << cachedTime << "usecs, moving root"
+             << movingTime << "usecs for" << NUM_ITERATIONS / 10 << "reads, hit rate"
+             << (float)hits / (float)std::max(hits + misses, (quint64)1) << sum.x;
+}
@@ -0,0 +1,137 @@
+//
+//  TriangleBVHTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TriangleBVHTests.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <TriangleBVH.h>
+
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(TriangleBVHTests)
+
+const float EPSILON = 0.0001f;
+
+// an inward facing triangulated sphere, so rays from inside it always hit something
+static std::vector<Triangle> makeSphere(int rings, int segments, float radius) {
+    auto getPoint = [&](int ring, int segment) {
+        float polar = PI * (float)ring / (float)rings;
+        float azimuth = TWO_PI * (float)segment / (float)segments;
+        return radius * glm::vec3(sinf(polar) * cosf(azimuth), cosf(polar), sinf(polar) * sinf(azimuth));
+    };
+    std::vector<Triangle> triangles;
+    for (int ring = 0; ring < rings; ring++) {
+        for (int segment = 0; segment < segments; segment++) {
+            glm::vec3 v0 = getPoint(ring, segment);
+            glm::vec3 v1 = getPoint(ring + 1, segment);
+            glm::vec3 v2 = getPoint(ring + 1, segment + 1);
+            glm::vec3 v3 = getPoint(ring, segment + 1);
+            triangles.push_back({ v0, v1, v2 });
+            triangles.push_back({ v0, v2, v3 });
+        }
+    }
+    return triangles;
+}
+
+static void makeRay(int index, glm::vec3& origin, glm::vec3& direction) {
+    origin = glm::vec3(0.3f * sinf(0.37f * index), 0.2f * cosf(0.53f * index), 0.1f * sinf(0.11f * index));
+    direction = glm::normalize(glm::vec3(sinf(1.3f * index), cosf(0.7f * index), sinf(2.9f * index + 1.0f)));
+}
+
+static bool findLinearRayIntersection(const std::vector<Triangle>& triangles, const glm::vec3& origin,
+                                      const glm::vec3& direction, float& distance) {
+    bool hit = false;
+    distance = std::numeric_limits<float>::max();
+    for (const auto& triangle : triangles) {
+        float triangleDistance;
+        if (findRayTriangleIntersection(origin, direction, triangle, triangleDistance) && triangleDistance < distance) {
+            distance = triangleDistance;
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+void TriangleBVHTests::testEmpty() {
+    TriangleBVH bvh;
+    float distance;
+    int triangleIndex;
+    QVERIFY(!bvh.findRayIntersection(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), distance, triangleIndex));
+}
+
+void TriangleBVHTests::testMatchesLinearSearch() {
+    std::vector<Triangle> triangles = makeSphere(20, 40, 2.0f);
+    TriangleBVH bvh(triangles);
+    QCOMPARE(bvh.getTriangles().size(), triangles.size());
+
+    const int NUM_RAYS = 1000;
+    for (int i = 0; i < NUM_RAYS; i++) {
+        glm::vec3 origin;
+        glm::vec3 direction;
+        makeRay(i, origin, direction);
+
+        float expectedDistance;
+        bool expectedHit = findLinearRayIntersection(triangles, origin, direction, expectedDistance);
+
+        float distance;
+        int triangleIndex;
+        bool hit = bvh.findRayIntersection(origin, direction, distance, triangleIndex);
+        QCOMPARE(hit, expectedHit);
+        if (hit) {
+            QCOMPARE_WITH_ABS_ERROR(distance, expectedDistance, EPSILON);
+            float triangleDistance;
+            QVERIFY(findRayTriangleIntersection(origin, direction, bvh.getTriangles()[triangleIndex], triangleDistance));
+        }
+
+        // the sphere faces inward, so rays from outside pointing away miss everything
+        QVERIFY(!bvh.findRayIntersection(origin + 10.0f * direction, direction, distance, triangleIndex));
+    }
+}
+
+void TriangleBVHTests::benchmarkRayThroughput() {
+    std::vector<Triangle> triangles = makeSphere(200, 400, 2.0f);
+
+    quint64 start = usecTimestampNow();
+    TriangleBVH bvh(triangles);
+    quint64 buildTime = usecTimestampNow() - start;
+
+    const int NUM_LINEAR_RAYS = 100;
+    int hits = 0;
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_LINEAR_RAYS; i++) {
+        glm::vec3 origin;
+        glm::vec3 direction;
+        makeRay(i, origin, direction);
+        float distance;
+        hits += findLinearRayIntersection(triangles, origin, direction, distance) ? 1 : 0;
+    }
+    quint64 linearTime = usecTimestampNow() - start;
+
+    const int NUM_BVH_RAYS = 100000;
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_BVH_RAYS; i++) {
+        glm::vec3 origin;
+        glm::vec3 direction;
+        makeRay(i, origin, direction);
+        float distance;
+        int triangleIndex;
+        hits += bvh.findRayIntersection(origin, direction, distance, triangleIndex) ? 1 : 0;
+    }
+    quint64 bvhTime = usecTimestampNow() - start;
+
+    qDebug() << triangles.size() << "triangles," << bvh.getNodeCount() << "nodes," << bvh.getMemoryUsage() / 1024 << "KB,"
+             << "built in" << buildTime << "usecs," << hits << "hits";
+    qDebug() << "    linear:" << (float)NUM_LINEAR_RAYS * USECS_PER_SECOND / (float)std::max(linearTime, (quint64)1) << "rays/sec";
+    qDebug() << "    bvh:" << (float)NUM_BVH_RAYS * USECS_PER_SECOND / (float)std::max(bvhTime, (quint64)1) << "rays/sec";
+}
@@ -0,0 +1,24 @@
+//
+//  TriangleBVHTests.h
+//  tests/shared/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TriangleBVHTests_h
+#define hifi_TriangleBVHTests_h
+
+#include <QtTest/QtTest>
+
+class TriangleBVHTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testEmpty();
+    void testMatchesLinearSearch();
+    void benchmarkRayThroughput();
+};
+
+#endif // hifi_TriangleBVHTests_h
@@ -12,6 +12,7 @@
 #include "UDTTest.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QFile>
 
 #include <udt/Constants.h>
 #include <udt/Packet.h>
@@ -55,6 +56,13 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption LOOPBACK_BULK {
+    "loopback-bulk", "time a reliable ordered message of this many megabytes sent to a second socket in this process",
+    "megabytes"
+};
+const QCommandLineOption SEND_SCALING {
+    "send-scaling", "report the threads and CPU used to send to 10, 100 and 1000 sockets in this process"
+};
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (P/s)", "Est. Max (P/s)", "RTT (ms)", "CW (P)", "Period (us)",
@@ -171,7 +179,11 @@ UDTTest::UDTTest(int& argc, char** argv) :
     // seed the generator with a value that the receiver will also use when verifying the ordered message
     _generator.seed(messageSeed);
     
-    if (!_target.isNull()) {
+    if (_argumentParser.isSet(LOOPBACK_BULK)) {
+        startLoopbackBulk(_argumentParser.value(LOOPBACK_BULK).toInt());
+    } else if (_argumentParser.isSet(SEND_SCALING)) {
+        startSendScaling(0);
+    } else if (!_target.isNull()) {
         sendInitialPackets();
     } else {
         // this is a receiver - in case there are ordered packets (messages) being sent to us make sure that we handle them
@@ -213,9 +225,12 @@ UDTTest::UDTTest(int& argc, char** argv) :
         _statsInterval = _argumentParser.value(STATS_INTERVAL).toInt();
     }
     
-    QTimer* statsTimer = new QTimer(this);
-    connect(statsTimer, &QTimer::timeout, this, &UDTTest::sampleStats);
-    statsTimer->start(_statsInterval);
+    // the scaling run reports on its own, and sampling would only add to the CPU it measures
+    if (!_argumentParser.isSet(SEND_SCALING)) {
+        QTimer* statsTimer = new QTimer(this);
+        connect(statsTimer, &QTimer::timeout, this, &UDTTest::sampleStats);
+        statsTimer->start(_statsInterval);
+    }
 }
 
 void UDTTest::parseArguments() {
@@ -228,7 +243,7 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, LOOPBACK_BULK, SEND_SCALING
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -335,6 +350,131 @@ void UDTTest::sendPacket() {
     
 }
 
+void UDTTest::startLoopbackBulk(int megabytes) {
+    static const qint64 BYTES_PER_MEGABYTE = 1000000;
+    qint64 messageSize = megabytes * BYTES_PER_MEGABYTE;
+
+    _loopbackSocket = new udt::Socket(this);
+    _loopbackSocket->bind(QHostAddress::LocalHost);
+    _target = HifiSockAddr(QHostAddress::LocalHost, _loopbackSocket->localPort());
+
+    qDebug() << "Sending a" << megabytes << "MB message to" << _target;
+
+    _loopbackSocket->setMessageHandler([this](std::unique_ptr<udt::Packet> packet) {
+        _loopbackReceivedBytes += packet->getPayloadSize();
+
+        if (packet->getPacketPosition() == udt::Packet::LAST || packet->getPacketPosition() == udt::Packet::ONLY) {
+            static const double MEGABITS_PER_BYTE = 8.0 / 1000000.0;
+            double seconds = _loopbackTimer.nsecsElapsed() / 1000000000.0;
+
+            qDebug() << "Received" << _loopbackReceivedBytes << "bytes in" << QString::number(seconds, 'f', 3) << "s -"
+                << QString::number(_loopbackReceivedBytes * MEGABITS_PER_BYTE / seconds, 'f', 2) << "Mb/s";
+
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        }
+    });
+
+    // the contents don't matter here, only how fast they get across
+    auto packetList = udt::PacketList::create(PacketType::BulkAvatarData, QByteArray(), true, true);
+    QByteArray payload { udt::Packet::maxPayloadSize(true), 'x' };
+    for (qint64 written = 0; written < messageSize; written += payload.size()) {
+        packetList->write(payload);
+    }
+    packetList->closeCurrentPacket();
+
+    _totalQueuedBytes += (int)packetList->getDataSize();
+    _totalQueuedPackets += (int)packetList->getNumPackets();
+
+    _loopbackTimer.start();
+    _socket.writePacketList(std::move(packetList), _target);
+}
+
+static const std::vector<int> SEND_SCALING_CONNECTIONS { 10, 100, 1000 };
+static const int SEND_SCALING_INTERVAL_MSECS = 10;
+static const int SEND_SCALING_DURATION_MSECS = 5000;
+
+static int numThreadsInProcess() {
+#ifdef Q_OS_LINUX
+    QFile status("/proc/self/status");
+    if (status.open(QIODevice::ReadOnly)) {
+        static const QByteArray THREADS_KEY = "Threads:";
+        for (auto& line : status.readAll().split('\n')) {
+            if (line.startsWith(THREADS_KEY)) {
+                return line.mid(THREADS_KEY.size()).trimmed().toInt();
+            }
+        }
+    }
+#endif
+    return -1;
+}
+
+void UDTTest::startSendScaling(int step) {
+    if (step >= (int)SEND_SCALING_CONNECTIONS.size()) {
+        QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        return;
+    }
+
+    int numConnections = SEND_SCALING_CONNECTIONS[step];
+    for (int i = 0; i < numConnections; ++i) {
+        auto receiver = new udt::Socket(this);
+        receiver->bind(QHostAddress::LocalHost);
+        if (receiver->localPort() == 0) {
+            qWarning() << "Could only bind" << i << "of" << numConnections << "sockets, check the open file limit";
+            delete receiver;
+            break;
+        }
+        receiver->setPacketHandler([this](std::unique_ptr<udt::Packet> packet) {
+            ++_scalingReceivedPackets;
+        });
+        _scalingReceivers.push_back(receiver);
+    }
+
+    qDebug() << "Sending to" << _scalingReceivers.size() << "connections every" << SEND_SCALING_INTERVAL_MSECS << "ms";
+
+    _scalingReceivedPackets = 0;
+    _scalingStartClock = std::clock();
+    _scalingTimer.start();
+
+    _scalingSendTimer = new QTimer(this);
+    connect(_scalingSendTimer, &QTimer::timeout, this, [this] {
+        for (auto receiver : _scalingReceivers) {
+            auto packet = udt::Packet::create(-1, true);
+            packet->write(QByteArray(64, 'x'));
+            _socket.writePacket(std::move(packet), HifiSockAddr(QHostAddress::LocalHost, receiver->localPort()));
+        }
+    });
+    _scalingSendTimer->start(SEND_SCALING_INTERVAL_MSECS);
+
+    QTimer::singleShot(SEND_SCALING_DURATION_MSECS, this, [this, step] { finishSendScaling(step); });
+}
+
+void UDTTest::finishSendScaling(int step) {
+    double seconds = _scalingTimer.nsecsElapsed() / 1000000000.0;
+    double cpuMsecs = (std::clock() - _scalingStartClock) * 1000.0 / CLOCKS_PER_SEC;
+    int numConnections = std::max((int)_scalingReceivers.size(), 1);
+
+    // the receivers run on this thread too, so this is an upper bound for the sending side
+    qDebug() << "Connections:" << _scalingReceivers.size()
+        << "- process threads:" << numThreadsInProcess()
+        << "- send threads:" << _socket.getSendScheduler().getNumThreads()
+        << "- CPU per connection:" << QString::number(cpuMsecs / numConnections / seconds, 'f', 3) << "ms/s"
+        << "- received" << _scalingReceivedPackets << "packets";
+
+    _scalingSendTimer->stop();
+    _scalingSendTimer->deleteLater();
+    _scalingSendTimer = nullptr;
+
+    _socket.clearConnections();
+    for (auto receiver : _scalingReceivers) {
+        receiver->deleteLater();
+    }
+    _scalingReceivers.clear();
+
+    // give the sockets a moment to go away before the next, larger, round
+    static const int SEND_SCALING_PAUSE_MSECS = 500;
+    QTimer::singleShot(SEND_SCALING_PAUSE_MSECS, this, [this, step] { startSendScaling(step + 1); });
+}
+
 void UDTTest::handleMessage(std::unique_ptr<Message> message) {
     // generate the byte array that should match this message - using the same seed the sender did
     
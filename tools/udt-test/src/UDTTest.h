@@ -15,10 +15,12 @@
 #define hifi_UDTTest_h
 
 
+#include <ctime>
 #include <random>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QCommandLineParser>
+#include <QtCore/QElapsedTimer>
 
 #include <udt/Constants.h>
 #include <udt/Socket.h>
@@ -45,6 +47,12 @@ private:
     
     void sendInitialPackets(); // fills the queue with packets to start
     void sendPacket(); // constructs and sends a packet according to the test parameters
+
+    void startLoopbackBulk(int megabytes); // sends one large message to a second socket in this process and times it
+    
+    // sends a small reliable packet to each of a number of sockets in this process, then reports the threads and CPU used
+    void startSendScaling(int step);
+    void finishSendScaling(int step);
     
     QCommandLineParser _argumentParser;
     udt::Socket _socket;
@@ -71,6 +79,16 @@ private:
     int _totalQueuedBytes { 0 }; // keeps track of the number of bytes we have already queued
     
     int _statsInterval { 100 }; // recording interval for stats in milliseconds
+
+    udt::Socket* _loopbackSocket { nullptr }; // receives the loopback bulk transfer
+    QElapsedTimer _loopbackTimer;
+    qint64 _loopbackReceivedBytes { 0 };
+
+    std::vector<udt::Socket*> _scalingReceivers; // one connection from _socket each
+    QTimer* _scalingSendTimer { nullptr };
+    QElapsedTimer _scalingTimer;
+    std::clock_t _scalingStartClock { 0 };
+    int _scalingReceivedPackets { 0 };
 };
 
 #endif // hifi_UDTTest_h